@@ -34,6 +34,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/experimental_plugin_framework.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/fsckUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/future.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/genquery_columnar.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/getRodsEnv.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/getUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/group.hpp
@@ -97,6 +98,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_tcp_object.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_threads.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_virtual_path.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/job_tracker.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/key_value_proxy.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/lifetime_manager.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/lsUtil.h
@@ -111,6 +113,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/objInfo.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/osauth.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/packStruct.h
+  ${CMAKE_SOURCE_DIR}/lib/core/include/pack_instruction_cache.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/parallel_transfer_engine.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/parseCommandLine.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/phybunUtil.h
@@ -251,6 +254,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/api/include/fileUnlink.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/fileWrite.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/genQuery.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/genQueryColumnar.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/get_file_descriptor_info.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/generalAdmin.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/generalRowInsert.h
@@ -406,6 +410,7 @@ set(
   ${CMAKE_SOURCE_DIR}/server/api/include/rsFileUnlink.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rsFileWrite.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rsGenQuery.hpp
+  ${CMAKE_SOURCE_DIR}/server/api/include/rsGenQueryColumnar.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rsGeneralAdmin.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rsGeneralRowInsert.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rsGeneralRowPurge.hpp
@@ -484,8 +489,10 @@ set(
   ${CMAKE_SOURCE_DIR}/server/core/include/client_api_whitelist.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/collection.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/dataObjOpr.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/descriptor_table.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_access_table.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_state_table.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/resource_snapshot.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/fileOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/finalize_utilities.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/initServer.hpp
@@ -141,6 +141,7 @@ API_NUMBER(TICKET_ADMIN_AN,                         723)
 API_NUMBER(GET_TEMP_PASSWORD_FOR_OTHER_AN,          724)
 API_NUMBER(PAM_AUTH_REQUEST_AN,                     725)
 API_NUMBER(GET_LIMITED_PASSWORD_AN,                 726)
+API_NUMBER(GEN_QUERY_COLUMNAR_AN,                   727)
 
 /* 1100 - 1200 - SSL API calls */
 API_NUMBER(SSL_START_AN,                            1100)
@@ -79,6 +79,7 @@
 #include "rsFileUnlink.hpp"
 #include "rsFileWrite.hpp"
 #include "rsGenQuery.hpp"
+#include "rsGenQueryColumnar.hpp"
 #include "rsGeneralAdmin.hpp"
 #include "rsGeneralRowInsert.hpp"
 #include "rsGeneralRowPurge.hpp"
@@ -225,6 +226,7 @@
 #define RS_GENERAL_ROW_PURGE NULLPTR_FOR_CLIENT_TABLE(rsGeneralRowPurge)
 #define RS_GENERAL_UPDATE NULLPTR_FOR_CLIENT_TABLE(rsGeneralUpdate)
 #define RS_GEN_QUERY NULLPTR_FOR_CLIENT_TABLE(rsGenQuery)
+#define RS_GEN_QUERY_COLUMNAR NULLPTR_FOR_CLIENT_TABLE(rsGenQueryColumnar)
 #define RS_GET_HIER_FOR_RESC NULLPTR_FOR_CLIENT_TABLE(rsGetHierarchyForResc)
 #define RS_GET_HIER_FROM_LEAF_ID NULLPTR_FOR_CLIENT_TABLE(rsGetHierFromLeafId)
 #define RS_GET_HOST_FOR_GET NULLPTR_FOR_CLIENT_TABLE(rsGetHostForGet)
@@ -583,6 +585,13 @@ static irods::apidef_t client_api_table_inp[] = {
         "api_gen_query", clearGenQueryInp,
         (funcPtr)CALL_GENQUERYINP_GENQUERYOUT
     },
+    {
+        GEN_QUERY_COLUMNAR_AN, RODS_API_VERSION, REMOTE_USER_AUTH, REMOTE_USER_AUTH,
+        "GenQueryInp_PI", 0, "GenQueryColumnarOut_PI", 0,
+        boost::any(std::function<int(rsComm_t*,genQueryInp_t*,genQueryColumnarOut_t**)>(RS_GEN_QUERY_COLUMNAR)),
+        "api_gen_query_columnar", clearGenQueryInp,
+        (funcPtr)CALL_GENQUERYINP_GENQUERYCOLUMNAROUT
+    },
     {
         AUTH_REQUEST_AN, RODS_API_VERSION, NO_USER_AUTH, NO_USER_AUTH,
         NULL, 0,  "authRequestOut_PI", 0,
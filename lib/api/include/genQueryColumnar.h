@@ -0,0 +1,12 @@
+#ifndef GENERAL_QUERY_COLUMNAR_H__
+#define GENERAL_QUERY_COLUMNAR_H__
+
+#include "rcConnect.h"
+#include "rodsGenQuery.h"
+
+#ifdef __cplusplus
+extern "C"
+#endif
+int rcGenQueryColumnar( rcComm_t *conn, genQueryInp_t *genQueryInp, genQueryColumnarOut_t **genQueryColumnarOut );
+
+#endif
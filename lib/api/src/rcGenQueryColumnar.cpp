@@ -0,0 +1,68 @@
+/* See genQueryColumnar.h for a description of this API call.*/
+
+#include "genQueryColumnar.h"
+#include "procApiRequest.h"
+#include "apiNumber.h"
+#include "rcMisc.h"
+
+/**
+ * \fn rcGenQueryColumnar (rcComm_t *conn, genQueryInp_t *genQueryInp, genQueryColumnarOut_t **genQueryColumnarOut)
+ *
+ * \brief Perform a general-query and return the rows in the columnar format.
+ *
+ * \user client and server
+ *
+ * \ingroup metadata
+ *
+ * \since 4.3.0
+ *
+ *
+ * \remark
+ * Perform a general-query, like rcGenQuery:
+ * \n The input and the paging (maxRows, continueInx) are the same as for
+ * \n rcGenQuery.  The rows are returned in a genQueryColumnarOut_t, which
+ * \n stores each value once without padding it to the widest value of the
+ * \n page, and dictionary encodes columns holding few distinct values.
+ * \n maxRows may be larger than MAX_SQL_ROWS, up to the server's
+ * \n maximum_number_of_rows_per_genquery_page.  Fewer rows may be returned
+ * \n when the page reaches maximum_size_for_single_buffer_in_megabytes.
+ * \n The page is validated before it is returned, so that its values can be
+ * \n read with getGenQueryColumnValue without further checks.
+ * \n Servers older than 4.3.0 do not provide this API and may not reply to
+ * \n it, so check the server's version before calling it.
+ *
+ * \note none
+ *
+ * \usage
+ *
+ * \param[in] conn - A rcComm_t connection handle to the server
+ * \param[in] genQueryInp - input general-query structure
+ * \param[out] genQueryColumnarOut - output columnar general-query structure,
+ *             to be released with freeGenQueryColumnarOut
+ * \return integer
+ * \retval 0 on success
+ * \retval SYS_INVALID_INPUT_PARAM if the server returned a malformed page
+ *
+ * \sideeffect none
+ * \pre none
+ * \post none
+ * \sa rcGenQuery
+**/
+
+int
+rcGenQueryColumnar( rcComm_t *conn, genQueryInp_t *genQueryInp,
+                    genQueryColumnarOut_t **genQueryColumnarOut ) {
+    int status = procApiRequest( conn, GEN_QUERY_COLUMNAR_AN, genQueryInp, NULL,
+                                 ( void ** )genQueryColumnarOut, NULL );
+
+    if ( status >= 0 && genQueryColumnarOut != NULL && *genQueryColumnarOut != NULL ) {
+        const int ec = validateGenQueryColumnarOut( *genQueryColumnarOut );
+        if ( ec < 0 ) {
+            rodsLog( LOG_ERROR, "rcGenQueryColumnar: received a malformed page [status=%d]", ec );
+            freeGenQueryColumnarOut( genQueryColumnarOut );
+            return ec;
+        }
+    }
+
+    return status;
+}
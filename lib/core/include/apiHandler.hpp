@@ -350,45 +350,65 @@ namespace irods
 #ifdef ENABLE_RE
         template<typename... types_t>
         error invoke_policy_enforcement_point(
-            rule_engine_context_manager_type _re_ctx_mgr,
-            plugin_context                   _ctx,
-            const std::string&               _operation_name,
-            const std::string&               _class,
-            types_t...                       _t)
+            rule_engine_context_manager_type& _re_ctx_mgr,
+            const plugin_context&             _ctx,
+            const std::string&                _operation_name,
+            const std::string&                _class,
+            types_t...                        _t)
         {
             using log = irods::experimental::log::rule_engine;
 
-            bool ret = false;
+            auto* rule_exists_helper = RuleExistsHelper::Instance();
+
+            // Most operations have no policy.  Skip building the rule names
+            // once it is known that no namespace defines this PEP.
+            if (!rule_exists_helper->pepMayExist(_operation_name, _class)) {
+                return SUCCESS();
+            }
+
+            plugin_context ctx{_ctx};
+            bool pep_exists = false;
+            bool lookup_failed = false;
             error saved_op_err = SUCCESS();
             error skip_op_err = SUCCESS();
 
-            for (auto& ns : NamespacesHelper::Instance()->getNamespaces()) {
+            for (const auto& ns : NamespacesHelper::Instance()->getNamespaces()) {
                 std::string rule_name = ns + "pep_" + _operation_name + "_" + _class;
 
-                if (RuleExistsHelper::Instance()->checkOperation( rule_name ) ) {
-                    if (_re_ctx_mgr.rule_exists(rule_name, ret).ok() && ret) {
-                        error op_err = _re_ctx_mgr.exec_rule(rule_name, instance_name_, _ctx, std::forward<types_t>(_t)...);
+                const auto rule_exists = rule_exists_helper->ruleExists(rule_name, _re_ctx_mgr);
 
-                        if (!op_err.ok()) {
-                            log::debug("{}-pep rule [{}] failed with error code [{}]", _class, rule_name, op_err.code());
-                            saved_op_err = op_err;
-                        }
-                        else if (op_err.code() == RULE_ENGINE_SKIP_OPERATION) {
-                            skip_op_err = op_err;
-
-                            if (_class != "pre") {
-                                log::warn("RULE_ENGINE_SKIP_OPERATION ({}) incorrectly returned from PEP [{}]! "
-                                          "RULE_ENGINE_SKIP_OPERATION should only be returned from pre-PEPs!",
-                                          RULE_ENGINE_SKIP_OPERATION, rule_name);
-                            }
-                        }
-                    }
-                    else {
-                        log::trace("Rule [{}] passes regex test, but does not exist", rule_name);
+                if (!rule_exists) {
+                    lookup_failed = true;
+                    continue;
+                }
+
+                if (!*rule_exists) {
+                    continue;
+                }
+
+                pep_exists = true;
+
+                error op_err = _re_ctx_mgr.exec_rule(rule_name, instance_name_, ctx, std::forward<types_t>(_t)...);
+
+                if (!op_err.ok()) {
+                    log::debug("{}-pep rule [{}] failed with error code [{}]", _class, rule_name, op_err.code());
+                    saved_op_err = op_err;
+                }
+                else if (op_err.code() == RULE_ENGINE_SKIP_OPERATION) {
+                    skip_op_err = op_err;
+
+                    if (_class != "pre") {
+                        log::warn("RULE_ENGINE_SKIP_OPERATION ({}) incorrectly returned from PEP [{}]! "
+                                  "RULE_ENGINE_SKIP_OPERATION should only be returned from pre-PEPs!",
+                                  RULE_ENGINE_SKIP_OPERATION, rule_name);
                     }
                 }
             }
 
+            if (!lookup_failed) {
+                rule_exists_helper->cachePepExistence(_operation_name, _class, pep_exists);
+            }
+
             if (!saved_op_err.ok()) {
                 return saved_op_err;
             }
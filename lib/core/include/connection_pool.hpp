@@ -3,15 +3,42 @@
 
 #include "rcConnect.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
 #include <memory>
 #include <vector>
 #include <mutex>
-#include <atomic>
 #include <string>
+#include <thread>
 #include <functional>
 
 namespace irods
 {
+    /// Controls the size and maintenance of a connection_pool.
+    ///
+    /// \since 4.3.0
+    struct connection_pool_options
+    {
+        /// The number of connections created by the constructor. The pool never closes
+        /// idle connections below this number.
+        int min_size = 1;
+
+        /// The maximum number of connections the pool will hold open at once.
+        int max_size = 1;
+
+        /// Idle connections above \p min_size are closed after this amount of time.
+        std::chrono::seconds idle_timeout{60};
+
+        /// How often idle connections are verified and idle connections above
+        /// \p min_size are closed. Zero disables background maintenance. Each
+        /// checkout then verifies its connection instead.
+        std::chrono::seconds maintenance_interval{30};
+    }; // struct connection_pool_options
+
     class connection_pool
     {
     public:
@@ -47,6 +74,25 @@ namespace irods
             int index_;
         };
 
+        /// Counters describing how the pool has been used.
+        ///
+        /// \since 4.3.0
+        struct statistics
+        {
+            int max_size;                                 ///< The maximum number of connections.
+            int open;                                     ///< The number of open connections.
+            int in_use;                                   ///< The number of connections checked out.
+            int waiting;                                  ///< The number of threads waiting for a connection.
+            std::uint64_t checkouts;                      ///< The number of connections handed out.
+            std::uint64_t waits;                          ///< The number of checkouts which had to wait.
+            std::uint64_t timeouts;                       ///< The number of checkouts which timed out.
+            std::uint64_t health_check_failures;          ///< The number of connections found broken.
+            std::chrono::nanoseconds total_wait_time;     ///< The sum of the time spent waiting.
+            std::chrono::nanoseconds max_wait_time;       ///< The longest time spent waiting.
+        }; // struct statistics
+
+        // Creates a fixed-size pool. No maintenance thread is started, and each
+        // checkout verifies its connection.
         connection_pool(int _size,
                         const std::string& _host,
                         const int _port,
@@ -54,24 +100,63 @@ namespace irods
                         const std::string& _zone,
                         const int _refresh_time);
 
+        /// \since 4.3.0
+        connection_pool(const connection_pool_options& _options,
+                        const std::string& _host,
+                        const int _port,
+                        const std::string& _username,
+                        const std::string& _zone,
+                        const int _refresh_time);
+
         connection_pool(const connection_pool&) = delete;
         connection_pool& operator=(const connection_pool&) = delete;
 
+        ~connection_pool();
+
+        // Blocks until a connection is available. Waiting threads are served in
+        // the order in which they called this function.
         connection_proxy get_connection();
 
+        /// Waits up to \p _timeout for a connection.
+        ///
+        /// Waiting threads are served in the order in which they arrived.
+        ///
+        /// \return A connection_proxy which evaluates to false if the timeout expired.
+        ///
+        /// \since 4.3.0
+        connection_proxy try_get_connection(std::chrono::milliseconds _timeout);
+
+        /// \since 4.3.0
+        statistics get_statistics() const;
+
     private:
         using connection_pointer = std::unique_ptr<rcComm_t, int(*)(rcComm_t*)>;
+        using clock_type = std::chrono::steady_clock;
 
         struct connection_context
         {
-            std::mutex mutex{};
-            std::atomic<bool> in_use{};
-            bool refresh{};
             connection_pointer conn{nullptr, rcDisconnect};
             rErrMsg_t error{};
             std::time_t creation_time{};
+            clock_type::time_point last_used{};
+            bool counted_open{};    // Guarded by mutex_. Whether the slot is included in open_.
         };
 
+        // A thread blocked in acquire(). A slot is handed to the waiter by setting index.
+        struct waiter
+        {
+            std::condition_variable cv;
+            int index = -1;
+        };
+
+        int acquire(const clock_type::time_point* _deadline);
+
+        connection_proxy make_proxy(int _index);
+
+        void make_available(int _index);
+
+        void update_open_count(int _index);
+
         void create_connection(int _index,
                                std::function<void()> _on_connect_error,
                                std::function<void()> _on_login_error);
@@ -84,16 +169,35 @@ namespace irods
 
         void release_connection(int _index);
 
+        void maintain();
+
         const std::string host_;
         const int port_;
         const std::string username_;
         const std::string zone_;
         const int refresh_time_;
+        const connection_pool_options options_;
         std::vector<connection_context> conn_ctxs_;
+
+        // Guards everything below. A connection_context is only accessed by the thread
+        // which holds its slot, so the contexts are not guarded.
+        mutable std::mutex mutex_;
+        std::vector<int> idle_;         // Slots holding an open connection. The most recently used is last.
+        std::vector<int> empty_;        // Slots without a connection.
+        std::deque<waiter*> waiters_;
+        int open_ = 0;
+        int in_use_ = 0;
+        statistics stats_{};
+
+        bool stop_ = false;
+        std::condition_variable stop_cv_;
+        std::thread maintenance_thread_;
     };
 
     std::shared_ptr<connection_pool> make_connection_pool(int size = 1);
+
+    /// \since 4.3.0
+    std::shared_ptr<connection_pool> make_connection_pool(const connection_pool_options& _options);
 } // namespace irods
 
 #endif // IRODS_CONNECTION_POOL_HPP
-
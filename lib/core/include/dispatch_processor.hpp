@@ -5,8 +5,12 @@
 #include "connection_pool.hpp"
 #include "irods_exception.hpp"
 #include "future.hpp"
+#include "job_tracker.hpp"
 #include "rodsErrorTable.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <functional>
 #include <vector>
@@ -21,43 +25,37 @@ namespace irods::experimental
     public:
         using job = std::function<void (const typename IteratorType::value_type)>;
 
-        dispatch_processor(std::atomic_bool& stop_flag, const IteratorType& _i, job _j)
+        dispatch_processor(std::atomic_bool& stop_flag,
+                           const IteratorType& _i,
+                           job _j,
+                           std::uint32_t _max_jobs_in_flight = job_tracker::default_max_jobs_in_flight)
             : stop_flag_(stop_flag)
             , iterator_{_i}
             , job_{_j}
+            , max_jobs_in_flight_{_max_jobs_in_flight}
         {
         }
 
         dispatch_processor(const dispatch_processor&) = delete;
         dispatch_processor& operator=(const dispatch_processor&) = delete;
 
+        // Posts one job per entry to the thread pool. No more than the maximum number of
+        // jobs are in flight at once. Once that many are in flight, this function stops
+        // advancing the iterator until a job finishes.
         auto execute(thread_pool& _tp) -> future
         {
-            future f{stop_flag_};
+            auto tracker = std::make_shared<job_tracker>(max_jobs_in_flight_);
 
             try {
                 for (auto r : iterator_) {
                     if(stop_flag_) {
                         break;
                     }
-                    auto p = std::make_shared<future::promise_type>();
 
-                    f.push_back(p);
+                    tracker->acquire();
 
-                    thread_pool::post(_tp, [this, p, r] () mutable {
-                        try {
-                            job_(r);
-                            try {p->set_value({0, ""});} catch(...){}
-                        }
-                        catch (const irods::exception& e) {
-                            try{p->set_value({e.code(), e.what()});} catch(...) {}
-                        }
-                        catch (const std::exception& e) {
-                            try{p->set_value({SYS_UNKNOWN_ERROR, e.what()});} catch(...) {}
-                        }
-                        catch (...) {
-                            try{p->set_value({SYS_UNKNOWN_ERROR, "Unknown error occurred while processing job."});} catch(...) {}
-                        }
+                    thread_pool::post(_tp, [this, tracker, r] () mutable noexcept {
+                        tracker->run([this, &r] { job_(r); });
                     });
 
                 } // for row
@@ -66,13 +64,14 @@ namespace irods::experimental
                 rodsLog(LOG_ERROR, "exception caught in dispatch_processor");
             }
 
-            return f;
+            return future{stop_flag_, tracker};
         }
 
     private:
         std::atomic_bool& stop_flag_;
         IteratorType iterator_;
         job job_;
+        std::uint32_t max_jobs_in_flight_;
     };
 } // namespace irods::experimental
 
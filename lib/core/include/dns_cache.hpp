@@ -44,7 +44,7 @@ namespace irods::experimental::net::dns_cache
     ///
     /// \return A boolean value.
     /// \retval true  If a new entry was inserted.
-    /// \retval false If an existing entry was updated.
+    /// \retval false If an existing entry was updated or the cache is full.
     ///
     /// \since 4.2.9
     auto insert_or_assign(const std::string_view _key,
@@ -1,45 +1,37 @@
+#include "job_tracker.hpp"
 
-#include <future>
+#include <atomic>
+#include <memory>
 
 namespace irods {
     class future
     {
     public:
         // clang-format off
-        using error_type   = std::tuple<int, std::string>;
-        using errors_type  = std::vector<error_type>;
-        using promise_type = std::promise<error_type>;
+        using error_type   = job_tracker::error_type;
+        using errors_type  = job_tracker::errors_type;
         // clang-format on
 
-        future(std::atomic_bool& s) : stop_flag_{s}
+        future(std::atomic_bool& s, std::shared_ptr<job_tracker> t)
+            : stop_flag_{s}
+            , tracker_{std::move(t)}
         {
         }
 
-        void push_back(std::shared_ptr<promise_type> p) {
-            promises.push_back(p);
-        }
-
+        // Blocks until every job has finished or the stop flag is set, and returns the
+        // errors of the jobs which failed.
         auto get() const {
-            errors_type x{};
-            x.reserve(promises.size());
-
-            for(auto&& p : promises) {
-                if(stop_flag_) {
-                    break;
-                }
-
-                auto&& e = p->get_future().get();
-                if(std::get<0>(e) < 0) {
-                    x.emplace_back(std::move(e));
-                }
-            }
-
-            return x;
+            return tracker_->wait(&stop_flag_);
         } // get
 
+        // Returns the number of jobs posted to the thread pool.
+        auto size() const {
+            return tracker_->submitted();
+        } // size
+
     private:
         std::atomic_bool& stop_flag_;
-        std::vector<std::shared_ptr<promise_type>> promises;
+        std::shared_ptr<job_tracker> tracker_;
     }; // class future
 
 } // irods
@@ -0,0 +1,174 @@
+#ifndef IRODS_GENQUERY_COLUMNAR_HPP
+#define IRODS_GENQUERY_COLUMNAR_HPP
+
+/// \file
+
+#include "rodsGenQuery.h"
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace irods::experimental::genquery
+{
+    /// Collects the rows of one or more GenQuery pages into a single page in the columnar
+    /// format (genQueryColumnarOut_t).
+    ///
+    /// Each value is copied once, without the padding of the [rowCnt][len] arrays of
+    /// genQueryOut_t. When the page is released, every column holding few distinct values
+    /// is dictionary encoded if that makes it smaller.
+    ///
+    /// \since 4.3.0
+    class columnar_page_builder
+    {
+    public:
+        /// Appends the rows of \p _page.
+        ///
+        /// Every page must select the same columns, in the same order, as the first one.
+        ///
+        /// \param[in] _page The page holding the rows to append.
+        ///
+        /// \return An integer.
+        /// \retval 0                       On success.
+        /// \retval SYS_INVALID_INPUT_PARAM If the columns do not match or the page would grow
+        ///                                 beyond the offsets of a genQueryColumn_t.
+        ///
+        /// \since 4.3.0
+        auto append(const genQueryOut_t& _page) -> int;
+
+        /// Returns the number of rows appended since the builder was last released.
+        ///
+        /// \since 4.3.0
+        auto row_count() const noexcept -> int
+        {
+            return rows_;
+        }
+
+        /// Returns the number of value bytes appended since the builder was last released.
+        ///
+        /// \since 4.3.0
+        auto byte_count() const noexcept -> std::size_t
+        {
+            return bytes_;
+        }
+
+        /// Moves the appended rows into \p _out and empties the builder.
+        ///
+        /// rowCnt, attriCnt and columns are set. continueInx and totalRowCount are left to
+        /// the caller. \p _out must not hold any columns. Its members are allocated with
+        /// malloc() and are released by clearGenQueryColumnarOut().
+        ///
+        /// \param[out] _out The columnar page.
+        ///
+        /// \return An integer.
+        /// \retval 0              On success.
+        /// \retval SYS_MALLOC_ERR If memory could not be allocated.
+        ///
+        /// \since 4.3.0
+        auto release(genQueryColumnarOut_t& _out) -> int;
+
+    private:
+        struct column
+        {
+            int attribute_index;
+            std::string bytes;
+            std::vector<int> offsets;
+        };
+
+        std::vector<column> columns_;
+        int rows_ = 0;
+        std::size_t bytes_ = 0;
+    }; // class columnar_page_builder
+
+    /// A view of one row of a GenQuery page, in either result format.
+    ///
+    /// Values are read in place. The view is invalidated when the page is freed, which for
+    /// rows of an irods::query happens once its iterator moves past the last row of the page.
+    ///
+    /// Columnar pages are not bounds checked on access. Pages received from a peer must
+    /// have passed validateGenQueryColumnarOut(), as the pages of rcGenQueryColumnar() have.
+    ///
+    /// \since 4.3.0
+    class row_view
+    {
+    public:
+        row_view(const genQueryOut_t& _page, int _row) noexcept
+            : gen_page_{&_page}
+            , columnar_page_{}
+            , row_{_row}
+        {
+        }
+
+        row_view(const genQueryColumnarOut_t& _page, int _row) noexcept
+            : gen_page_{}
+            , columnar_page_{&_page}
+            , row_{_row}
+        {
+        }
+
+        /// Returns the number of columns.
+        auto size() const noexcept -> std::size_t
+        {
+            return columnar_page_ ? columnar_page_->attriCnt : gen_page_->attriCnt;
+        }
+
+        /// Returns the attribute index (e.g. COL_DATA_NAME) of \p _column.
+        auto attribute_index(std::size_t _column) const noexcept -> int
+        {
+            return columnar_page_ ? columnar_page_->columns[_column].attriInx
+                                  : gen_page_->sqlResult[_column].attriInx;
+        }
+
+        /// Returns the value of \p _column. The value is followed by a null character.
+        auto operator[](std::size_t _column) const noexcept -> std::string_view
+        {
+            if (!columnar_page_) {
+                const auto& result = gen_page_->sqlResult[_column];
+                const char* value = result.value + static_cast<std::size_t>(result.len) * row_;
+                return {value, ::strnlen(value, result.len)};
+            }
+
+            const auto& column = columnar_page_->columns[_column];
+            const int inx = GEN_QUERY_COLUMN_DICT == column.encoding ? column.codes[row_] : row_;
+            const int end = inx + 1 < column.offsetCnt ? column.offsets[inx + 1] : column.byteCnt;
+
+            // The value's null terminator is not part of the view.
+            return {column.bytes + column.offsets[inx], static_cast<std::size_t>(end - column.offsets[inx] - 1)};
+        }
+
+        /// Returns the value of \p _column.
+        ///
+        /// \throws std::out_of_range If \p _column is not less than size().
+        auto at(std::size_t _column) const -> std::string_view
+        {
+            if (_column >= size()) {
+                throw std::out_of_range{"row_view: column index out of range"};
+            }
+
+            return (*this)[_column];
+        }
+
+        /// Returns a copy of the values of the row.
+        auto to_vector() const -> std::vector<std::string>
+        {
+            std::vector<std::string> values;
+            values.reserve(size());
+
+            for (std::size_t i = 0; i < size(); ++i) {
+                values.emplace_back((*this)[i]);
+            }
+
+            return values;
+        }
+
+    private:
+        const genQueryOut_t* gen_page_;
+        const genQueryColumnarOut_t* columnar_page_;
+        int row_;
+    }; // class row_view
+} // namespace irods::experimental::genquery
+
+#endif // IRODS_GENQUERY_COLUMNAR_HPP
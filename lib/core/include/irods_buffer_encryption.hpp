@@ -55,6 +55,30 @@ namespace irods {
                 const array_t&, // encrypted buffer
                 array_t& );     // plaintext buffer
 
+            /// =-=-=-=-=-=-=-
+            /// @brief encrypt a buffer into memory owned by the caller.
+            ///        the output buffer must hold at least the input
+            ///        size plus EVP_MAX_BLOCK_LENGTH bytes
+            irods::error encrypt(
+                const array_t&,       // key
+                const array_t&,       // initialization vector
+                const unsigned char*, // plaintext buffer
+                int,                  // plaintext size
+                unsigned char*,       // encrypted buffer
+                int& );               // encrypted size
+
+            /// =-=-=-=-=-=-=-
+            /// @brief decrypt a buffer into memory owned by the caller.
+            ///        the output buffer must hold at least the input
+            ///        size plus EVP_MAX_BLOCK_LENGTH bytes
+            irods::error decrypt(
+                const array_t&,       // key
+                const array_t&,       // initialization vector
+                const unsigned char*, // encrypted buffer
+                int,                  // encrypted size
+                unsigned char*,       // plaintext buffer
+                int& );               // plaintext size
+
             /// =-=-=-=-=-=-=-
             /// @brief given a key, create a hashed key and IV
             irods::error initialization_vector(
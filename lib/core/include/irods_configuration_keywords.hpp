@@ -64,6 +64,12 @@ namespace irods
     extern const std::string CFG_MAX_TEMP_PASSWORD_LIFETIME;
     extern const std::string CFG_MAX_NUMBER_OF_CONCURRENT_RE_PROCS;
     extern const std::string DEFAULT_LOG_ROTATION_IN_DAYS;
+    extern const std::string CFG_DB_PREPARED_STATEMENT_CACHE_SIZE_KW;
+    extern const std::string CFG_AGENT_FACTORY_POOL_SIZE_KW;
+    extern const std::string CFG_AGENT_FACTORY_POOL_MAX_IDLE_TIME_IN_SECONDS_KW;
+    extern const std::string CFG_CHECKSUM_READ_BUFFER_SIZE_IN_BYTES_KW;
+    extern const std::string CFG_NUMBER_OF_TRANSFER_BUFFERS_FOR_PARA_TRANS_KW;
+    extern const std::string CFG_MAX_NUMBER_OF_ROWS_PER_GENQUERY_PAGE_KW;
 
     extern const std::string CFG_RE_CACHE_SALT_KW;
     extern const std::string CFG_RE_SERVER_SLEEP_TIME;
@@ -71,6 +77,7 @@ namespace irods
 
     extern const std::string CFG_DNS_CACHE_KW;
     extern const std::string CFG_HOSTNAME_CACHE_KW;
+    extern const std::string CFG_RESOURCE_SNAPSHOT_KW;
 
     extern const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW;
     extern const std::string CFG_EVICTION_AGE_IN_SECONDS_KW;
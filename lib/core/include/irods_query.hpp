@@ -5,16 +5,25 @@
 
 #ifdef IRODS_QUERY_ENABLE_SERVER_SIDE_API
     #include "rsGenQuery.hpp"
+    #include "rsGenQueryColumnar.hpp"
     #include "rsSpecificQuery.hpp"
 #else
     #include "genQuery.h"
+    #include "genQueryColumnar.h"
 #endif // IRODS_QUERY_ENABLE_SERVER_SIDE_API
 
+#include "genquery_columnar.hpp"
 #include "irods_log.hpp"
 #include "rcMisc.h"
+#include "version.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 char *getCondFromString( char * t );
@@ -26,6 +35,10 @@ namespace irods {
     public:
         using value_type = std::vector<std::string>;
 
+        // A view of the current row which reads the values in place. It is valid
+        // until the iterator moves past the last row of the page holding the row.
+        using row_view = irods::experimental::genquery::row_view;
+
         enum query_type {
             GENERAL = 0,
             SPECIFIC = 1
@@ -73,26 +86,37 @@ namespace irods {
                 , row_offset_{_row_offset}
                 , query_string_{_query_string}
                 , gen_output_{}
+                , columnar_output_{}
             {
             }
 
             virtual ~query_impl_base() {
                 freeGenQueryOut(&this->gen_output_);
+                freeGenQueryColumnarOut(&this->columnar_output_);
             }
 
             size_t size() {
-                if(!gen_output_) {
-                    return 0;
-                }
-                return gen_output_->rowCnt;
+                return row_cnt();
             }
 
             int cont_idx() {
-                return gen_output_->continueInx;
+                if(columnar_output_) {
+                    return columnar_output_->continueInx;
+                }
+                if(gen_output_) {
+                    return gen_output_->continueInx;
+                }
+                return 0;
             }
 
             int row_cnt() {
-                return gen_output_->rowCnt;
+                if(columnar_output_) {
+                    return columnar_output_->rowCnt;
+                }
+                if(gen_output_) {
+                    return gen_output_->rowCnt;
+                }
+                return 0;
             }
 
             std::string query_string() {
@@ -113,22 +137,18 @@ namespace irods {
             }
 
             value_type capture_results(int _row_idx) {
-                value_type res;
-                for(int attr_idx = 0; attr_idx < gen_output_->attriCnt; ++attr_idx) {
-                    uint32_t offset = gen_output_->sqlResult[attr_idx].len * _row_idx;
-                    std::string str{&gen_output_->sqlResult[attr_idx].value[offset]};
-                    res.push_back(str);
+                return capture_view(_row_idx).to_vector();
+            }
+
+            row_view capture_view(int _row_idx) {
+                if(columnar_output_) {
+                    return {*columnar_output_, _row_idx};
                 }
-                return res;
+                return {*gen_output_, _row_idx};
             }
 
             bool results_valid() {
-                if(gen_output_) {
-                    return (gen_output_->rowCnt > 0);
-                }
-                else {
-                    return false;
-                }
+                return row_cnt() > 0;
             }
 
             virtual int fetch_page() = 0;
@@ -141,6 +161,7 @@ namespace irods {
             const uint32_t row_offset_;
             const std::string query_string_;
             genQueryOut_t* gen_output_;
+            genQueryColumnarOut_t* columnar_output_;
         }; // class query_impl_base
 
         class gen_query_impl : public query_impl_base
@@ -150,11 +171,13 @@ namespace irods {
                            int                _query_limit,
                            int                _row_offset,
                            const std::string& _query_string,
-                           const std::string& _zone_hint)
+                           const std::string& _zone_hint,
+                           int                _page_size)
                 : query_impl_base(_comm, _query_limit, _row_offset, _query_string)
+                , columnar_{_page_size > MAX_SQL_ROWS && supports_columnar_results(_comm)}
             {
                 memset(&gen_input_, 0, sizeof(gen_input_));
-                gen_input_.maxRows = MAX_SQL_ROWS;
+                gen_input_.maxRows = columnar_ ? _page_size : MAX_SQL_ROWS;
                 gen_input_.rowOffset = _row_offset;
 
                 if (!_zone_hint.empty()) {
@@ -173,11 +196,12 @@ namespace irods {
             } // ctor
 
             virtual ~gen_query_impl() {
-                if(this->gen_output_ && this->gen_output_->continueInx) {
+                if(this->cont_idx()) {
                     rodsLog(LOG_NOTICE, "[%s] - continueInx is not 0", __FUNCTION__);
                     // Close statements for this query
-                    gen_input_.continueInx = this->gen_output_->continueInx;
+                    gen_input_.continueInx = this->cont_idx();
                     freeGenQueryOut(&this->gen_output_);
+                    freeGenQueryColumnarOut(&this->columnar_output_);
                     gen_input_.maxRows = 0;
                     auto err = gen_query_fcn(
                                    this->comm_,
@@ -194,6 +218,10 @@ namespace irods {
             }
 
             void reset_for_page_boundary() override {
+                if(this->columnar_output_) {
+                    gen_input_.continueInx = this->columnar_output_->continueInx;
+                    freeGenQueryColumnarOut(&this->columnar_output_);
+                }
                 if(this->gen_output_) {
                     gen_input_.continueInx = this->gen_output_->continueInx;
                     freeGenQueryOut(&this->gen_output_);
@@ -201,6 +229,22 @@ namespace irods {
             }
 
             int fetch_page() override {
+                if(columnar_) {
+                    const int ec = gen_query_columnar_fcn(
+                                       this->comm_,
+                                       &gen_input_,
+                                       &this->columnar_output_);
+                    if(SYS_UNMATCHED_API_NUM != ec) {
+                        return ec;
+                    }
+
+                    // The server does not provide the columnar format. Fall back to the
+                    // fixed width format, whose pages are kept to the usual size.
+                    freeGenQueryColumnarOut(&this->columnar_output_);
+                    columnar_ = false;
+                    gen_input_.maxRows = std::min(gen_input_.maxRows, MAX_SQL_ROWS);
+                }
+
                 return gen_query_fcn(
                            this->comm_,
                            &gen_input_,
@@ -208,6 +252,30 @@ namespace irods {
             } // fetch_page
 
         private:
+            // Servers which predate GEN_QUERY_COLUMNAR_AN do not reply to it, so it is
+            // only sent to servers whose release provides it. Agents always provide it.
+            static bool supports_columnar_results(connection_type* _comm) {
+                if constexpr (std::is_same_v<connection_type, rcComm_t>) {
+                    int major = 0;
+                    int minor = 0;
+                    int patch = 0;
+
+                    if(!_comm || !_comm->svrVersion ||
+                       std::sscanf(_comm->svrVersion->relVersion, "rods%d.%d.%d", &major, &minor, &patch) != 3) {
+                        return false;
+                    }
+
+                    const irods::version server_version{static_cast<std::uint16_t>(major),
+                                                        static_cast<std::uint16_t>(minor),
+                                                        static_cast<std::uint16_t>(patch)};
+                    return server_version >= irods::version{4, 3, 0};
+                }
+                else {
+                    return true;
+                }
+            } // supports_columnar_results
+
+            bool columnar_;
             genQueryInp_t gen_input_;
 #ifdef IRODS_QUERY_ENABLE_SERVER_SIDE_API
             const std::function<
@@ -215,12 +283,22 @@ namespace irods {
                     genQueryInp_t*,
                     genQueryOut_t**)>
                         gen_query_fcn{rsGenQuery};
+            const std::function<
+                int(connection_type*,
+                    genQueryInp_t*,
+                    genQueryColumnarOut_t**)>
+                        gen_query_columnar_fcn{rsGenQueryColumnar};
 #else
             const std::function<
                 int(connection_type*,
                     genQueryInp_t*,
                     genQueryOut_t**)>
                         gen_query_fcn{rcGenQuery};
+            const std::function<
+                int(connection_type*,
+                    genQueryInp_t*,
+                    genQueryColumnarOut_t**)>
+                        gen_query_columnar_fcn{rcGenQueryColumnar};
 #endif // IRODS_QUERY_ENABLE_SERVER_SIDE_API
         }; // class gen_query_impl
 
@@ -416,15 +494,69 @@ namespace irods {
             value_type capture_results() {
                 return query_impl_->capture_results(row_idx_);
             }
+
+            // Returns a view of the current row, without copying its values.
+            row_view view() {
+                return query_impl_->capture_view(row_idx_);
+            }
         }; // class iterator
 
+        // Iterates over the rows like iterator, but yields a row_view for each row.
+        class view_iterator {
+            public:
+            using value_type        = row_view;
+            using pointer           = void;
+            using reference         = row_view;
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            explicit view_iterator(iterator _iter) :
+                iter_{std::move(_iter)} {
+            }
+
+            view_iterator& operator++() {
+                ++iter_;
+                return *this;
+            }
+
+            bool operator==(const view_iterator& _rhs) const {
+                return iter_ == _rhs.iter_;
+            }
+
+            bool operator!=(const view_iterator& _rhs) const {
+                return !(*this == _rhs);
+            }
+
+            row_view operator*() {
+                return iter_.view();
+            }
+
+            private:
+            iterator iter_;
+        }; // class view_iterator
+
+        class view_range {
+            public:
+            explicit view_range(query& _query) :
+                query_{_query} {
+            }
+
+            view_iterator begin() { return view_iterator{query_.begin()}; }
+
+            view_iterator end()   { return view_iterator{query_.end()}; }
+
+            private:
+            query& query_;
+        }; // class view_range
+
         query(connection_type*                _comm,
               const std::string&              _query_string,
               const std::vector<std::string>* _specific_query_args,
               const std::string&              _zone_hint,
               uintmax_t                       _query_limit,
               uintmax_t                       _row_offset,
-              query_type                      _query_type)
+              query_type                      _query_type,
+              int                             _page_size = MAX_SQL_ROWS)
             : iter_{}
             , query_impl_{}
         {
@@ -434,7 +566,8 @@ namespace irods {
                                   _query_limit,
                                   _row_offset,
                                   _query_string,
-                                  _zone_hint);
+                                  _zone_hint,
+                                  _page_size);
             }
             else if(_query_type == SPECIFIC) {
                 query_impl_ = std::make_shared<spec_query_impl>(
@@ -486,6 +619,9 @@ namespace irods {
 
         iterator   end()   { return iterator(); }
 
+        // Returns the rows as row_views, e.g. for (auto row : q.views()) { ... }
+        view_range views() { return view_range{*this}; }
+
         value_type front() { return (*(*iter_)); }
 
         value_type front() const { return (*(*iter_)); }
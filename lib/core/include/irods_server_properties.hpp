@@ -170,6 +170,15 @@ namespace irods
     /// \since 4.2.9
     auto get_hostname_cache_eviction_age() noexcept -> int;
 
+    /// Returns the amount of shared memory that should be allocated for the resource snapshot.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 2500000          If an error occurred or the size was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_resource_snapshot_shared_memory_size() noexcept -> int;
+
     /// Parses hosts_config.json into a JSON object if available and stores it in the server
     /// property map with key \p irods::HOSTS_CONFIG_JSON_OBJECT_KW.
     ///
@@ -0,0 +1,163 @@
+#ifndef IRODS_JOB_TRACKER_HPP
+#define IRODS_JOB_TRACKER_HPP
+
+/// \file
+
+#include "irods_exception.hpp"
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace irods
+{
+    /// Applies back-pressure to a producer of jobs and collects the errors of failed jobs.
+    ///
+    /// A producer calls acquire() before posting each job to a thread pool. acquire() blocks
+    /// while the maximum number of jobs are in flight. Each job reports its outcome through
+    /// run(), which frees its place for the next job. Only a bounded number of errors is
+    /// kept, so the memory used does not depend on the number of jobs.
+    ///
+    /// \since 4.3.0
+    class job_tracker
+    {
+    public:
+        // clang-format off
+        using error_type  = std::tuple<int, std::string>;
+        using errors_type = std::vector<error_type>;
+        // clang-format on
+
+        static constexpr std::uint32_t default_max_jobs_in_flight = 1000;
+        static constexpr std::uint32_t default_max_errors = 1000;
+
+        explicit job_tracker(std::uint32_t _max_jobs_in_flight = default_max_jobs_in_flight,
+                             std::uint32_t _max_errors = default_max_errors)
+            : max_jobs_in_flight_{std::max<std::uint32_t>(_max_jobs_in_flight, 1)}
+            , max_errors_{_max_errors}
+        {
+        }
+
+        job_tracker(const job_tracker&) = delete;
+        auto operator=(const job_tracker&) -> job_tracker& = delete;
+
+        /// Blocks until another job may be started and then counts it as in flight.
+        auto acquire() -> void
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return in_flight_ < max_jobs_in_flight_; });
+            ++in_flight_;
+            ++submitted_;
+        }
+
+        /// Invokes \p _func and records its outcome. Exceptions do not propagate.
+        ///
+        /// Must be called exactly once for every call to acquire().
+        template <typename Function>
+        auto run(Function&& _func) noexcept -> void
+        {
+            try {
+                _func();
+                complete({0, ""});
+            }
+            catch (const irods::exception& e) {
+                complete({e.code(), e.what()});
+            }
+            catch (const std::exception& e) {
+                complete({SYS_UNKNOWN_ERROR, e.what()});
+            }
+            catch (...) {
+                complete({SYS_UNKNOWN_ERROR, "Unknown error occurred while processing job."});
+            }
+        }
+
+        /// Blocks until every job that was started has finished.
+        ///
+        /// \param[in] _stop If not null, waiting ends early once the flag is set.
+        ///
+        /// \return The errors of the jobs which failed. If more jobs failed than errors are
+        ///         kept, the last entry describes how many errors were dropped.
+        auto wait(const std::atomic_bool* _stop = nullptr) const -> errors_type
+        {
+            std::unique_lock lock{mutex_};
+
+            const auto done = [this, _stop] { return 0 == in_flight_ || (_stop && _stop->load()); };
+
+            // The stop flag is not tied to the condition variable, so it is polled.
+            while (!done()) {
+                cv_.wait_for(lock, std::chrono::milliseconds{100}, done);
+            }
+
+            auto errors = errors_;
+
+            if (dropped_errors_ > 0) {
+                errors.emplace_back(last_dropped_error_code_,
+                                    std::to_string(dropped_errors_) + " additional jobs failed. Their errors were not recorded.");
+            }
+
+            return errors;
+        }
+
+        /// The number of jobs started so far.
+        auto submitted() const -> std::uint64_t
+        {
+            std::lock_guard lock{mutex_};
+            return submitted_;
+        }
+
+        /// The number of jobs started but not yet finished.
+        auto in_flight() const -> std::uint32_t
+        {
+            std::lock_guard lock{mutex_};
+            return in_flight_;
+        }
+
+    private:
+        auto complete(error_type&& _error) noexcept -> void
+        {
+            {
+                std::lock_guard lock{mutex_};
+
+                if (std::get<0>(_error) < 0) {
+                    try {
+                        if (errors_.size() < max_errors_) {
+                            errors_.push_back(std::move(_error));
+                        }
+                        else {
+                            ++dropped_errors_;
+                            last_dropped_error_code_ = std::get<0>(_error);
+                        }
+                    }
+                    catch (...) {
+                        ++dropped_errors_;
+                        last_dropped_error_code_ = std::get<0>(_error);
+                    }
+                }
+
+                --in_flight_;
+            }
+
+            cv_.notify_all();
+        }
+
+        const std::uint32_t max_jobs_in_flight_;
+        const std::uint32_t max_errors_;
+
+        mutable std::mutex mutex_;
+        mutable std::condition_variable cv_;
+        std::uint32_t in_flight_ = 0;
+        std::uint64_t submitted_ = 0;
+        errors_type errors_;
+        std::uint64_t dropped_errors_ = 0;
+        int last_dropped_error_code_ = 0;
+    }; // class job_tracker
+} // namespace irods
+
+#endif // IRODS_JOB_TRACKER_HPP
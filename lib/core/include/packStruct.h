@@ -9,6 +9,7 @@
 #define SUB_STRUCT_ALLOC_SZ             1024            // initial alloc size for unpacking sub struct
 #define MAX_PACKED_OUT_ALLOC_SZ         (1024 * 1024)
 #define NULL_PTR_PACK_STR               "%@#ANULLSTR$%"
+#define UNPACK_ARENA_BLOCK_SZ           (64 * 1024)     // default block size for unpack arenas
 
 // definition for the flag in packXmlTag()
 #define START_TAG_FL                    0
@@ -95,6 +96,9 @@ typedef struct PackedOutput {
     bytesBufArray_t nopackBufArray;     // bBuf for non packed buffer
 } packedOutput_t;
 
+// Opaque handle to a set of memory blocks that unpacked structs can be placed in.
+typedef struct UnpackArena unpackArena_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -129,6 +133,30 @@ int unpack_struct(const void *inPackStr,
                   irodsProt_t irodsProt,
                   const char* peer_version);
 
+// Creates an arena for unpack_struct_with_arena(). A blockSize of 0 selects
+// UNPACK_ARENA_BLOCK_SZ. Returns NULL if memory could not be allocated.
+unpackArena_t* create_unpack_arena(size_t blockSize);
+
+// Makes the memory held by the arena available to the next unpack. Every struct
+// previously unpacked into the arena becomes invalid.
+void reset_unpack_arena(unpackArena_t* arena);
+
+// Releases the arena and every struct unpacked into it.
+void free_unpack_arena(unpackArena_t* arena);
+
+// Same as unpack_struct(), except that the struct and everything it points to is
+// placed in the arena. The result must be treated as read-only: it must not be
+// passed to clearKeyVal(), freeGenQueryOut(), free() or any other function that
+// frees or reallocates its members. It is released by reset_unpack_arena() or
+// free_unpack_arena().
+int unpack_struct_with_arena(const void *inPackStr,
+                             void **outStruct,
+                             const char *packInstName,
+                             const packInstruct_t *myPackTable,
+                             irodsProt_t irodsProt,
+                             const char* peer_version,
+                             unpackArena_t* arena);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,42 @@
+#ifndef IRODS_PACK_INSTRUCTION_CACHE_HPP
+#define IRODS_PACK_INSTRUCTION_CACHE_HPP
+
+/// \file
+
+#include <cstddef>
+
+/// The pack instruction cache holds the tokenized form of every pack instruction seen by
+/// pack_struct() and unpack_struct(). Each instruction is parsed once per process and then
+/// reused by all later pack and unpack operations.
+///
+/// The cache is enabled by default. All functions are thread-safe.
+namespace irods::experimental::pack_instruction_cache
+{
+    /// Enables or disables the cache.
+    ///
+    /// While disabled, every pack and unpack operation tokenizes its pack instructions
+    /// from scratch. Existing entries are kept and are used again once the cache is
+    /// re-enabled.
+    ///
+    /// \param[in] _value A boolean indicating whether the cache should be used.
+    ///
+    /// \since 4.3.0
+    auto enable(bool _value) noexcept -> void;
+
+    /// Returns whether the cache is enabled.
+    ///
+    /// \since 4.3.0
+    auto enabled() noexcept -> bool;
+
+    /// Removes all entries from the cache.
+    ///
+    /// \since 4.3.0
+    auto clear() -> void;
+
+    /// Returns the number of pack instructions held by the cache.
+    ///
+    /// \since 4.3.0
+    auto size() -> std::size_t;
+} // namespace irods::experimental::pack_instruction_cache
+
+#endif // IRODS_PACK_INSTRUCTION_CACHE_HPP
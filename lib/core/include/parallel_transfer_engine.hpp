@@ -31,6 +31,7 @@
 #include <functional>
 #include <memory>
 #include <atomic>
+#include <cstdint>
 
 namespace irods::experimental::io
 {
@@ -72,6 +73,13 @@ namespace irods::experimental::io
 
     /// A class that enables parallel transfer of objects across multiple streams.
     ///
+    /// The bytes to transfer are initially divided evenly between the channels. A channel that
+    /// finishes its range takes over the second half of the largest range that another channel has
+    /// not reached yet, so a slow channel does not hold up the transfer.
+    ///
+    /// Progress is recorded in a memory-mapped restart journal which holds the unfinished byte range
+    /// of each channel. The journal remains valid if the process crashes in the middle of a transfer.
+    ///
     /// Instances of this class are not copyable or moveable.
     ///
     /// \tparam SourceStream The stream type of the streams that will be read from.
@@ -93,6 +101,28 @@ namespace irods::experimental::io
         using sink_stream_close_handler_type = std::function<void (sink_stream_type&, bool)>;
         // clang-format on
 
+        /// Holds throughput information about a single channel.
+        ///
+        /// \since 4.3.0
+        struct channel_statistics
+        {
+            /// The number of bytes the channel has written to its sink stream.
+            std::int64_t bytes_transferred;
+
+            /// The number of times the channel took over part of another channel's range.
+            std::int64_t ranges_stolen;
+
+            /// The time the channel has spent transferring data.
+            std::chrono::steady_clock::duration elapsed;
+
+            /// Returns the average throughput of the channel in bytes per second.
+            auto bytes_per_second() const noexcept -> double
+            {
+                const auto seconds = std::chrono::duration<double>{elapsed}.count();
+                return seconds > 0 ? bytes_transferred / seconds : 0;
+            }
+        }; // struct channel_statistics
+
         /// Constructs an instance of the parallel_transfer_engine and starts transferring data.
         ///
         /// \throws parallel_transfer_engine_error
@@ -118,7 +148,8 @@ namespace irods::experimental::io
             , stop_{}
             , file_mapping_{}
             , mapped_region_{}
-            , progress_(_number_of_channels)
+            , channels_{std::make_unique<channel[]>(_number_of_channels)}
+            , work_mutex_{}
             , tasks_running_(_number_of_channels)
             , errors_{}
             , errors_mutex_{}
@@ -157,7 +188,8 @@ namespace irods::experimental::io
             , stop_{}
             , file_mapping_{}
             , mapped_region_{}
-            , progress_{}
+            , channels_{}
+            , work_mutex_{}
             , tasks_running_{}
             , errors_{}
             , errors_mutex_{}
@@ -231,12 +263,25 @@ namespace irods::experimental::io
         /// \retval false Otherwise.
         auto success() -> bool
         {
-            return errors_.empty() && std::all_of(std::cbegin(progress_), std::cend(progress_), [](auto& _p) {
-                using namespace std::chrono_literals;
-                return _p.running->valid() &&
-                       _p.running->wait_for(0s) == std::future_status::ready &&
-                       _p.progress->sent == _p.progress->chunk_size;
+            using namespace std::chrono_literals;
+
+            const auto tasks_finished = std::all_of(std::cbegin(tasks_running_), std::cend(tasks_running_), [](auto& _f) {
+                return _f.valid() && _f.wait_for(0s) == std::future_status::ready;
             });
+
+            if (!errors_.empty() || !tasks_finished) {
+                return false;
+            }
+
+            for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
+                const auto* slot = channels_[i].slot;
+
+                if (slot->begin.load() < slot->end.load()) {
+                    return false;
+                }
+            }
+
+            return true;
         }
 
         /// Returns information about errors encountered during the transfer.
@@ -250,6 +295,39 @@ namespace irods::experimental::io
             return errors_;
         }
 
+        /// Returns throughput information for each channel.
+        ///
+        /// This function may be called while the transfer is in progress.
+        ///
+        /// \return A vector containing one element per channel, ordered by channel.
+        ///
+        /// \since 4.3.0
+        auto statistics() const -> std::vector<channel_statistics>
+        {
+            using clock_type = std::chrono::steady_clock;
+
+            const auto now = clock_type::now().time_since_epoch().count();
+
+            std::vector<channel_statistics> stats;
+            stats.reserve(number_of_channels_);
+
+            for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
+                const auto& c = channels_[i];
+                const auto start_time = c.start_time.load();
+                const auto stop_time = c.stop_time.load();
+
+                auto elapsed = clock_type::duration::zero();
+
+                if (start_time > 0) {
+                    elapsed = clock_type::duration{(stop_time > 0 ? stop_time : now) - start_time};
+                }
+
+                stats.push_back({c.bytes_transferred.load(), c.ranges_stolen.load(), elapsed});
+            }
+
+            return stats;
+        }
+
         /// Returns the restart handle.
         auto restart_handle() const noexcept -> const restart_handle_type&
         {
@@ -298,32 +376,62 @@ namespace irods::experimental::io
             std::condition_variable cond_var_;
         }; // class latch
 
-        struct restart_header
-        {
+        // The restart journal is a journal_header followed by one journal_slot per channel. A slot
+        // holds the range of bytes, relative to the transfer offset, that its channel has not written
+        // yet. Bytes not covered by any slot have been written to the sink.
+        //
+        // Slots are only updated through single lock-free 64-bit stores, a channel only shrinks its
+        // slot after the bytes have been flushed to the sink, and a stolen range is added to the
+        // thief's slot before it is removed from the victim's slot. A crash at any point therefore
+        // leaves every unwritten byte covered by at least one slot.
+        static constexpr std::int64_t journal_magic = 0x6972647370746a31; // "irdsptj1"
+        static constexpr std::int64_t journal_version = 1;
+
+        struct journal_header
+        {
+            std::int64_t magic;
+            std::int64_t version;
             std::int64_t total_bytes_to_transfer;
             std::int64_t number_of_streams;
             std::int64_t offset;
             std::int64_t transfer_buffer_size;
         };
 
-        struct progress
+        struct journal_slot
         {
-            std::int64_t chunk_size;
-            std::int64_t sent;
+            std::atomic<std::int64_t> begin;
+            std::atomic<std::int64_t> end;
         };
 
-        struct transfer_progress
+        static_assert(std::atomic<std::int64_t>::is_always_lock_free,
+                      "Journal slots live in a memory-mapped file and must not require a lock.");
+
+        struct channel
         {
-            std::future<void>* running;
-            progress* progress;
+            // Guarded by work_mutex_. The owning task claims bytes from the front of [next, end)
+            // and other tasks steal from the back of it.
+            std::int64_t next = 0;
+            std::int64_t end = 0;
+            bool stealable = false;
+
+            journal_slot* slot = nullptr;
+
+            std::atomic<std::int64_t> bytes_transferred{0};
+            std::atomic<std::int64_t> ranges_stolen{0};
+            std::atomic<std::chrono::steady_clock::rep> start_time{0};
+            std::atomic<std::chrono::steady_clock::rep> stop_time{0};
         };
 
+        auto journal_size() const noexcept -> std::size_t
+        {
+            return sizeof(journal_header) + number_of_channels_ * sizeof(journal_slot);
+        }
+
         auto init_memory_mapped_progress_file(const std::string& _filename, bool _create_file) -> std::byte*
         {
             if (_create_file) {
                 if (std::ofstream out{_filename}; out) {
-                    const std::size_t storage_size = sizeof(restart_header) + number_of_channels_ * sizeof(progress) - 1;
-                    out.seekp(storage_size, std::ios_base::beg);
+                    out.seekp(journal_size() - 1, std::ios_base::beg);
                     out.put(0);
                 }
                 else {
@@ -341,10 +449,11 @@ namespace irods::experimental::io
             return base;
         }
 
-        auto construct_progress_header(std::byte* _storage) -> restart_header*
+        auto construct_journal_header(std::byte* _storage) -> journal_header*
         {
-            auto* header = new (_storage) restart_header{};
+            auto* header = new (_storage) journal_header{};
 
+            header->version = journal_version;
             header->total_bytes_to_transfer = total_bytes_to_transfer_;
             header->number_of_streams = number_of_channels_;
             header->offset = offset_;
@@ -380,41 +489,66 @@ namespace irods::experimental::io
 
                 constexpr auto create_new_file = false;
                 auto* storage = init_memory_mapped_progress_file(restart_handle_, create_new_file);
-                auto* header = new (storage) restart_header;
+
+                if (mapped_region_->get_size() < sizeof(journal_header)) {
+                    throw parallel_transfer_engine_error{"Restart file is truncated"};
+                }
+
+                auto* header = new (storage) journal_header;
+
+                if (header->magic != journal_magic || header->version != journal_version) {
+                    throw parallel_transfer_engine_error{"Restart file does not contain a transfer journal"};
+                }
 
                 total_bytes_to_transfer_ = header->total_bytes_to_transfer;
                 number_of_channels_ = header->number_of_streams;
                 offset_ = header->offset;
                 transfer_buffer_size_ = header->transfer_buffer_size;
 
+                if (number_of_channels_ <= 0 || mapped_region_->get_size() < journal_size()) {
+                    throw parallel_transfer_engine_error{"Restart file is truncated"};
+                }
+
                 thread_pool_ = std::make_unique<irods::thread_pool>(number_of_channels_);
-                progress_.resize(number_of_channels_);
+                channels_ = std::make_unique<channel[]>(number_of_channels_);
                 tasks_running_.resize(number_of_channels_);
                 latch_ = std::make_unique<latch>(number_of_channels_ - 1);
 
-                auto* task_progress_storage = storage + sizeof(restart_header);
+                auto* slot_storage = storage + sizeof(journal_header);
 
                 for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
-                    progress_[i].running = &tasks_running_[i];
-                    progress_[i].progress = new (task_progress_storage + (i * sizeof(progress))) progress;
+                    auto& c = channels_[i];
+                    c.slot = new (slot_storage + i * sizeof(journal_slot)) journal_slot;
+                    c.next = c.slot->begin.load();
+                    c.end = std::max(c.next, c.slot->end.load());
+                    c.stealable = true;
                 }
             }
             else {
                 constexpr auto create_new_file = true;
                 auto* storage = init_memory_mapped_progress_file(restart_handle_, create_new_file);
-                construct_progress_header(storage);
+                auto* header = construct_journal_header(storage);
 
-                auto* task_progress_storage = storage + sizeof(restart_header);
+                auto* slot_storage = storage + sizeof(journal_header);
                 const auto chunk_size = total_bytes_to_transfer_ / number_of_channels_;
 
                 for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
-                    progress_[i].running = &tasks_running_[i];
-                    progress_[i].progress = new (task_progress_storage + i * sizeof(progress)) progress{};
-                    progress_[i].progress->chunk_size = chunk_size;
+                    auto& c = channels_[i];
+                    c.next = i * chunk_size;
+                    c.end = c.next + chunk_size;
+                    c.stealable = true;
+                    c.slot = new (slot_storage + i * sizeof(journal_slot)) journal_slot{};
+                    c.slot->begin.store(c.next);
+                    c.slot->end.store(c.end);
                 }
 
-                // Add any remaining bytes to the last stream's chunk size.
-                progress_.back().progress->chunk_size += (total_bytes_to_transfer_ % number_of_channels_);
+                // Add any remaining bytes to the last stream's range.
+                auto& last = channels_[number_of_channels_ - 1];
+                last.end = total_bytes_to_transfer_;
+                last.slot->end.store(last.end);
+
+                // The magic number is written last so that a partially initialized journal is rejected.
+                header->magic = journal_magic;
             }
         }
 
@@ -424,32 +558,28 @@ namespace irods::experimental::io
             // The parallel transfer engine makes no attempts to verify existence of any source.
             // That is the sole responsibility of the caller.
             const auto mode = std::ios_base::out | (restart_file_exists_ ? std::ios_base::in : 0);
-            const auto offset = offset_ + progress_[0].progress->sent;
+            const auto offset = offset_ + channels_[0].next;
             auto primary_in_stream = create_source_stream(offset);
             auto primary_out_stream = create_sink_stream(mode, offset);
 
-            const auto chunk_size = total_bytes_to_transfer_ / number_of_channels_;
-
             for (decltype(number_of_channels_) i = 1; i < number_of_channels_; ++i) {
                 constexpr auto wait_for_sibling_tasks_to_finish = false;
                 const auto mode = std::ios_base::in | std::ios_base::out;
-                const auto offset = i * chunk_size + offset_ + progress_[i].progress->sent;
+                const auto offset = offset_ + channels_[i].next;
 
                 auto secondary_in_stream = create_source_stream(offset, &primary_in_stream);
                 auto secondary_out_stream = create_sink_stream(mode, offset, &primary_out_stream);
 
                 schedule_transfer_task_on_thread_pool(secondary_in_stream,
                                                       secondary_out_stream,
-                                                      progress_[i],
-                                                      tasks_running_[i],
+                                                      i,
                                                       wait_for_sibling_tasks_to_finish);
             }
 
             constexpr auto wait_for_sibling_tasks_to_finish = true;
             schedule_transfer_task_on_thread_pool(primary_in_stream,
                                                   primary_out_stream,
-                                                  progress_[0],
-                                                  tasks_running_[0],
+                                                  0,
                                                   wait_for_sibling_tasks_to_finish);
         }
 
@@ -486,40 +616,144 @@ namespace irods::experimental::io
             return out;
         }
 
+        auto add_error(parallel_transfer_error _error, std::string _message) -> void
+        {
+            std::lock_guard lock{errors_mutex_};
+            errors_.emplace_back(_error, std::move(_message));
+        }
+
+        // Moves the back half of the largest range that another channel has not claimed yet to the
+        // channel at index _thief. Ranges shorter than two transfer buffers are left to their owner.
+        //
+        // Must be called while holding work_mutex_.
+        auto steal_work(std::int64_t _thief) -> bool
+        {
+            channel* victim = nullptr;
+            std::int64_t largest = 0;
+
+            for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
+                auto& c = channels_[i];
+
+                if (i != _thief && c.stealable && c.end - c.next > largest) {
+                    victim = &c;
+                    largest = c.end - c.next;
+                }
+            }
+
+            if (!victim || largest < 2 * transfer_buffer_size_) {
+                return false;
+            }
+
+            auto& thief = channels_[_thief];
+            const auto split = victim->next + (largest / 2 / transfer_buffer_size_) * transfer_buffer_size_;
+
+            // Record the range in the thief's slot before removing it from the victim's slot. See
+            // the description of the journal for details.
+            thief.slot->begin.store(split);
+            thief.slot->end.store(victim->end);
+            victim->slot->end.store(split);
+
+            thief.next = split;
+            thief.end = victim->end;
+            victim->end = split;
+
+            ++thief.ranges_stolen;
+
+            return true;
+        }
+
+        // Copies bytes for the channel at index _channel_index until there is nothing left to claim
+        // or steal, the transfer is stopped, or an error occurs.
+        auto transfer_data(source_stream_type& _in, sink_stream_type& _out, std::int64_t _channel_index) -> void
+        {
+            auto& c = channels_[_channel_index];
+            std::vector<typename source_stream_type::char_type> buf(transfer_buffer_size_);
+
+            c.start_time.store(std::chrono::steady_clock::now().time_since_epoch().count());
+
+            // The position of the streams relative to the transfer offset. Only the owning task
+            // modifies "next", so it can be read without the lock here.
+            auto position = c.next;
+
+            while (!stop_.load()) {
+                std::int64_t begin = 0;
+                std::int64_t count = 0;
+
+                {
+                    std::lock_guard lock{work_mutex_};
+
+                    if (c.next >= c.end && !steal_work(_channel_index)) {
+                        break;
+                    }
+
+                    begin = c.next;
+                    count = std::min(c.end - c.next, static_cast<std::int64_t>(buf.size()));
+                    c.next += count;
+                }
+
+                if (begin != position) {
+                    if (!_in.seekg(offset_ + begin)) {
+                        add_error(parallel_transfer_error::stream_seek, "Seek error on input stream");
+                        break;
+                    }
+
+                    if (!_out.seekp(offset_ + begin)) {
+                        add_error(parallel_transfer_error::stream_seek, "Seek error on output stream");
+                        break;
+                    }
+                }
+
+                if (!_in) {
+                    add_error(parallel_transfer_error::stream_read, "Source stream in bad state");
+                    break;
+                }
+
+                if (!_out) {
+                    add_error(parallel_transfer_error::stream_write, "Sink stream in bad state");
+                    break;
+                }
+
+                _in.read(buf.data(), count);
+                const std::int64_t bytes_read = _in.gcount();
+
+                // The bytes must reach the sink before the journal stops covering them.
+                if (!_out.write(buf.data(), bytes_read) || !_out.flush()) {
+                    add_error(parallel_transfer_error::stream_write, "Sink stream in bad state");
+                    break;
+                }
+
+                position = begin + bytes_read;
+                c.slot->begin.store(position);
+                c.bytes_transferred.fetch_add(bytes_read);
+
+                if (bytes_read < count) {
+                    add_error(parallel_transfer_error::stream_read, "Source stream ended before the transfer completed");
+                    break;
+                }
+            }
+
+            {
+                // Whatever is left of the range stays in the journal for a restart.
+                std::lock_guard lock{work_mutex_};
+                c.stealable = false;
+            }
+
+            c.stop_time.store(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+
         auto schedule_transfer_task_on_thread_pool(source_stream_type& _source_stream,
                                                    sink_stream_type& _sink_stream,
-                                                   transfer_progress& _progress,
-                                                   std::future<void>& _result,
+                                                   std::int64_t _channel_index,
                                                    bool _wait_for_sibling_tasks_to_finish) -> void
         {
             std::packaged_task<void()> task{[this,
                                              in = std::move(_source_stream),
                                              out = std::move(_sink_stream),
-                                             &_progress,
+                                             _channel_index,
                                              _wait_for_sibling_tasks_to_finish]() mutable
             {
                 try {
-                    std::vector<typename source_stream_type::char_type> buf(transfer_buffer_size_);
-
-                    while (!stop_.load() && _progress.progress->sent < _progress.progress->chunk_size) {
-                        if (!in) {
-                            std::lock_guard lock{errors_mutex_};
-                            errors_.emplace_back(parallel_transfer_error::stream_read, "Source stream in bad state");
-                            break;
-                        }
-
-                        if (!out) {
-                            std::lock_guard lock{errors_mutex_};
-                            errors_.emplace_back(parallel_transfer_error::stream_write, "Sink stream in bad state");
-                            break;
-                        }
-
-                        in.read(buf.data(), std::min({_progress.progress->chunk_size - _progress.progress->sent,
-                                                      static_cast<std::int64_t>(buf.size()),
-                                                      _progress.progress->chunk_size}));
-                        out.write(buf.data(), in.gcount());
-                        _progress.progress->sent += in.gcount();
-                    }
+                    transfer_data(in, out, _channel_index);
 
                     if (_wait_for_sibling_tasks_to_finish) {
                         latch_->wait();
@@ -533,20 +767,17 @@ namespace irods::experimental::io
                     }
                 }
                 catch (const stream_error& e) {
-                    std::lock_guard lock{errors_mutex_};
-                    errors_.emplace_back(parallel_transfer_error::stream_create, e.what());
+                    add_error(parallel_transfer_error::stream_create, e.what());
                 }
                 catch (const std::exception& e) {
-                    std::lock_guard lock{errors_mutex_};
-                    errors_.emplace_back(parallel_transfer_error::generic_exception, e.what());
+                    add_error(parallel_transfer_error::generic_exception, e.what());
                 }
                 catch (...) {
-                    std::lock_guard lock{errors_mutex_};
-                    errors_.emplace_back(parallel_transfer_error::unknown, "Unknown error occurred during transfer.");
+                    add_error(parallel_transfer_error::unknown, "Unknown error occurred during transfer.");
                 }
             }};
 
-            _result = task.get_future();
+            tasks_running_[_channel_index] = task.get_future();
 
             // Cannot move a std::packaged_task directly into the thread pool due to the implementation
             // of boost::asio::thread_pool. Attempts to move the task into the thread pool will not
@@ -563,7 +794,8 @@ namespace irods::experimental::io
         std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;
         std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;
 
-        std::vector<transfer_progress> progress_;
+        std::unique_ptr<channel[]> channels_;
+        std::mutex work_mutex_;
         std::vector<std::future<void>> tasks_running_;
         error_type errors_;
         std::mutex errors_mutex_;
@@ -41,6 +41,16 @@ namespace irods::experimental
             return *this;
         }
 
+        // The number of rows fetched per round trip by a general query. A page size larger
+        // than MAX_SQL_ROWS opts into the columnar result format, which servers of release
+        // 4.3.0 or later serve up to their maximum_number_of_rows_per_genquery_page. Older
+        // servers and smaller page sizes use MAX_SQL_ROWS rows per page.
+        auto page_size(int _v) noexcept -> query_builder&
+        {
+            page_size_ = _v;
+            return *this;
+        }
+
         auto bind_arguments(const std::vector<std::string>& _args) -> query_builder&
         {
             args_ = &_args;
@@ -59,6 +69,7 @@ namespace irods::experimental
             zone_hint_.clear();
             limit_ = 0;
             offset_ = 0;
+            page_size_ = MAX_SQL_ROWS;
             type_ = query_type::general;
 
             return *this;
@@ -79,7 +90,8 @@ namespace irods::experimental
                     zone_hint_,
                     limit_,
                     offset_,
-                    type_ == query_type::general ? T::GENERAL : T::SPECIFIC};
+                    type_ == query_type::general ? T::GENERAL : T::SPECIFIC,
+                    page_size_};
         }
 
     private:
@@ -87,6 +99,7 @@ namespace irods::experimental
         std::string zone_hint_;
         std::uintmax_t limit_ = 0;
         std::uintmax_t offset_ = 0;
+        int page_size_ = MAX_SQL_ROWS;
         query_type type_ = query_type::general;
     }; // class query_builder
 } // namespace irods::experimental
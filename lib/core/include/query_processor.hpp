@@ -4,10 +4,12 @@
 #include "thread_pool.hpp"
 #include "irods_query.hpp"
 #include "irods_exception.hpp"
+#include "job_tracker.hpp"
 
+#include <cstdint>
 #include <string>
 #include <functional>
-#include <future>
+#include <memory>
 #include <vector>
 #include <tuple>
 #include <exception>
@@ -29,79 +31,63 @@ namespace irods
         class future
         {
         public:
+            // Blocks until every job has finished and returns the errors of the jobs
+            // which failed.
             auto get() -> errors
             {
-                errors errs;
-                errs.reserve(promises.size());
-
-                for (auto&& p : promises) {
-                    auto&& e = p->get_future().get();
-                    if (std::get<0>(e) < 0) {
-                        errs.push_back(std::move(e));
-                    }
-                }
-
-                return errs;
+                return tracker_->wait();
             }
 
+            // Returns the number of jobs posted to the thread pool.
             auto size() const noexcept -> std::uint32_t
             {
-                return promises.size();
+                return tracker_->submitted();
             }
 
             friend query_processor;
 
         private:
-            auto push_back(std::shared_ptr<std::promise<error>> p) -> void
+            explicit future(std::shared_ptr<job_tracker> _tracker)
+                : tracker_{std::move(_tracker)}
             {
-                promises.push_back(p);
             }
 
-            std::vector<std::shared_ptr<std::promise<error>>> promises;
+            std::shared_ptr<job_tracker> tracker_;
         }; // class future
 
         query_processor(const std::string& _query,
                         job _job,
                         uint32_t _limit = 0,
-                        query_type _type = query_type::GENERAL)
+                        query_type _type = query_type::GENERAL,
+                        uint32_t _max_jobs_in_flight = job_tracker::default_max_jobs_in_flight)
             : query_{_query}
             , job_{_job}
             , limit_{_limit}
             , type_{_type}
+            , max_jobs_in_flight_{_max_jobs_in_flight}
         {
         }
 
         query_processor(const query_processor&) = delete;
         query_processor& operator=(const query_processor&) = delete;
 
+        // Posts one job per row to the thread pool. No more than the maximum number of
+        // jobs are in flight at once. Once that many are in flight, this function stops
+        // fetching rows until a job finishes.
         auto execute(thread_pool& _thread_pool, ConnectionType& _conn) -> future
         {
-            future f;
+            auto tracker = std::make_shared<job_tracker>(max_jobs_in_flight_);
             query<ConnectionType> q{&_conn, query_, limit_, 0, type_};
 
             for (auto&& r : q) {
-               auto p = std::make_shared<std::promise<error>>();
-               f.push_back(p);
-
-               thread_pool::post(_thread_pool, [this, p, r]() mutable noexcept {
-                    try {
-                        job_(r);
-                        p->set_value({0, ""});
-                    }
-                    catch (const irods::exception& e) {
-                        p->set_value({e.code(), e.what()});
-                    }
-                    catch (const std::exception& e) {
-                        p->set_value({SYS_UNKNOWN_ERROR, e.what()});
-                    }
-                    catch (...) {
-                        p->set_value({SYS_UNKNOWN_ERROR, "Unknown error occurred while processing job."});
-                    }
-                });
+                tracker->acquire();
 
+                thread_pool::post(_thread_pool, [this, tracker, r]() mutable noexcept {
+                    tracker->run([this, &r] { job_(r); });
+                });
             } // for row
 
-            return f;
+            return future{tracker};
         }
 
     private:
@@ -109,6 +95,7 @@ namespace irods
         job job_;
         uint32_t limit_;
         query_type type_;
+        uint32_t max_jobs_in_flight_;
     }; // class query_processor
 } // namespace irods
 
@@ -126,6 +126,16 @@ sqlResult_t* getSqlResultByInx(genQueryOut_t* genQueryOut, int attriInx);
 
 void clearGenQueryOut(void* );
 
+int freeGenQueryColumnarOut(genQueryColumnarOut_t** genQueryColumnarOut);
+
+void clearGenQueryColumnarOut(void* voidInp);
+
+genQueryColumn_t* getGenQueryColumnByInx(genQueryColumnarOut_t* genQueryColumnarOut, int attriInx);
+
+const char* getGenQueryColumnValue(const genQueryColumn_t* column, int row);
+
+int validateGenQueryColumnarOut(const genQueryColumnarOut_t* genQueryColumnarOut);
+
 int catGenQueryOut(genQueryOut_t* targGenQueryOut,
                    genQueryOut_t* genQueryOut,
                    int maxRowCnt);
@@ -62,6 +62,36 @@ typedef struct GenQueryOut {
     sqlResult_t sqlResult[MAX_SQL_ATTR];
 } genQueryOut_t;
 
+/* The columnar result format returned by rcGenQueryColumnar.  Instead of a
+ * [rowCnt][len] array sized to the widest value, each column stores its
+ * values back to back, each one null terminated, and the offset at which
+ * every value starts.  A column holding few distinct values (resource names,
+ * owners, zones) is dictionary encoded: bytes and offsets hold each distinct
+ * value once and codes holds, for every row, the index of its value.
+ */
+#define GEN_QUERY_COLUMN_PLAIN 0 /* value of row i is bytes + offsets[i] */
+#define GEN_QUERY_COLUMN_DICT  1 /* value of row i is bytes + offsets[codes[i]] */
+
+typedef struct GenQueryColumn {
+    int attriInx;        /* attribute index */
+    int encoding;        /* GEN_QUERY_COLUMN_PLAIN or GEN_QUERY_COLUMN_DICT */
+    int offsetCnt;       /* number of values in bytes: rowCnt for PLAIN,
+                            the number of distinct values for DICT */
+    int *offsets;        /* start of each value in bytes */
+    int byteCnt;
+    char *bytes;         /* the null terminated values */
+    int codeCnt;         /* rowCnt for DICT, 0 for PLAIN */
+    int *codes;          /* index into offsets of the value of each row */
+} genQueryColumn_t;
+
+typedef struct GenQueryColumnarOut {
+    int rowCnt;
+    int attriCnt;
+    int continueInx;
+    int totalRowCount;
+    genQueryColumn_t *columns; /* attriCnt columns */
+} genQueryColumnarOut_t;
+
 /*
 Bits to set in the value array (genQueryInp.selectInp.value[i]) to
 order the results by that column, either ascending or descending.  This
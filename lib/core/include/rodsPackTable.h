@@ -87,6 +87,8 @@ const packInstruct_t RodsPackTable[] = {
     {"GenQueryInp_PI", GenQueryInp_PI, NULL},
     {"SqlResult_PI", SqlResult_PI, NULL},
     {"GenQueryOut_PI", GenQueryOut_PI, NULL},
+    {"GenQueryColumn_PI", GenQueryColumn_PI, NULL},
+    {"GenQueryColumnarOut_PI", GenQueryColumnarOut_PI, NULL},
     {"DataObjInfo_PI", DataObjInfo_PI, NULL},
     {"TransStat_PI", TransStat_PI, NULL},
     {"TransferStat_PI", TransferStat_PI, NULL},
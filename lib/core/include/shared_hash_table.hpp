@@ -0,0 +1,625 @@
+#ifndef IRODS_SHARED_HASH_TABLE_HPP
+#define IRODS_SHARED_HASH_TABLE_HPP
+
+/// \file
+
+#include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace irods::experimental::interprocess
+{
+    /// A fixed-capacity hash table which lives in a block of shared memory.
+    ///
+    /// The table uses open addressing with linear probing. Keys and values are stored inline,
+    /// so the table holds no pointers and may be mapped at any address. The slots are divided
+    /// into partitions, each protected by its own sharable mutex, so that processes working
+    /// on different keys rarely contend for the same lock.
+    ///
+    /// Every entry carries an expiration time. Expired entries are invisible to lookups and
+    /// their slots are reused by later insertions, so caches do not need to erase them eagerly.
+    ///
+    /// \tparam Value   The mapped type. Must be trivially copyable.
+    /// \tparam KeySize The size of the buffer holding a key, including the null terminator.
+    ///
+    /// \since 4.3.0
+    template <typename Value, std::size_t KeySize = 256>
+    class shared_hash_table
+    {
+        static_assert(std::is_trivially_copyable_v<Value>, "Value must be trivially copyable.");
+        static_assert(KeySize > 1 && KeySize <= 65536, "KeySize must be in the range (1, 65536].");
+
+    public:
+        // clang-format off
+        using value_type    = Value;
+        using key_view_type = std::string_view;
+        using clock_type    = std::chrono::system_clock;
+        // clang-format on
+
+        /// The longest key the table can hold.
+        static constexpr std::size_t max_key_size = KeySize - 1;
+
+        /// The maximum number of partitions (i.e. locks) a table is divided into.
+        static constexpr std::size_t max_partitions = 64;
+
+        /// Expiration value for entries which never expire.
+        static constexpr std::int64_t never_expires = 0;
+
+    private:
+        enum class slot_state : std::uint8_t
+        {
+            empty,
+            occupied,
+            erased
+        }; // enum class slot_state
+
+        struct slot
+        {
+            std::uint64_t hash;
+            std::int64_t expiration;
+            slot_state state;
+            std::uint16_t key_size;
+            char key[KeySize];
+            Value value;
+        }; // struct slot
+
+        struct partition
+        {
+            mutable boost::interprocess::interprocess_sharable_mutex mutex;
+            std::size_t size = 0;   // The number of occupied slots, including expired entries.
+            std::size_t erased = 0; // The number of erased slots.
+        }; // struct partition
+
+        // The slots follow the table in memory.
+        static constexpr auto slots_offset() noexcept -> std::size_t
+        {
+            return (sizeof(shared_hash_table) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+        }
+
+    public:
+        /// The number of bytes each entry occupies.
+        static constexpr std::size_t slot_size = sizeof(slot);
+
+        /// Returns the number of bytes needed for a table holding \p _capacity entries.
+        ///
+        /// \since 4.3.0
+        static constexpr auto required_size(std::size_t _capacity) noexcept -> std::size_t
+        {
+            return slots_offset() + _capacity * sizeof(slot);
+        }
+
+        /// Returns the number of entries a table constructed in \p _size bytes can hold.
+        ///
+        /// \since 4.3.0
+        static constexpr auto capacity_for(std::size_t _size) noexcept -> std::size_t
+        {
+            return _size > slots_offset() ? (_size - slots_offset()) / sizeof(slot) : 0;
+        }
+
+        /// Constructs an empty table in the memory pointed to by \p _memory.
+        ///
+        /// \param[in] _memory Memory suitably aligned for the table. Usually the start of a
+        ///                    mapped region of shared memory.
+        /// \param[in] _size   The number of bytes available at \p _memory.
+        ///
+        /// \throws std::bad_alloc If \p _size is too small to hold a single entry.
+        ///
+        /// \since 4.3.0
+        static auto construct(void* _memory, std::size_t _size) -> shared_hash_table*
+        {
+            const auto capacity = capacity_for(_size);
+
+            if (0 == capacity) {
+                throw std::bad_alloc{};
+            }
+
+            return new (_memory) shared_hash_table{capacity};
+        }
+
+        shared_hash_table(const shared_hash_table&) = delete;
+        auto operator=(const shared_hash_table&) -> shared_hash_table& = delete;
+
+        /// Returns the current time in the unit used for expiration times.
+        ///
+        /// \since 4.3.0
+        static auto now() noexcept -> std::int64_t
+        {
+            using std::chrono::duration_cast;
+            using std::chrono::seconds;
+
+            return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+        }
+
+        /// Inserts a new entry or replaces the value of an existing entry.
+        ///
+        /// \param[in] _key        The key.
+        /// \param[in] _value      The value.
+        /// \param[in] _expiration Seconds since the epoch at which the entry expires.
+        ///
+        /// \return An optional boolean.
+        /// \retval true         If a new entry was inserted.
+        /// \retval false        If an existing entry, expired or not, was updated.
+        /// \retval std::nullopt If the key is too long or the table is full.
+        ///
+        /// \since 4.3.0
+        auto insert_or_assign(key_view_type _key, const Value& _value, std::int64_t _expiration = never_expires)
+            -> std::optional<bool>
+        {
+            return insert_impl(_key, _value, _expiration, true);
+        }
+
+        /// Inserts a new entry if no unexpired entry exists for the key.
+        ///
+        /// \return An optional boolean.
+        /// \retval true         If the entry was inserted.
+        /// \retval false        If an unexpired entry already exists. It is left unchanged.
+        /// \retval std::nullopt If the key is too long or the table is full.
+        ///
+        /// \since 4.3.0
+        auto try_insert(key_view_type _key, const Value& _value, std::int64_t _expiration = never_expires)
+            -> std::optional<bool>
+        {
+            return insert_impl(_key, _value, _expiration, false);
+        }
+
+        /// Returns a copy of the value mapped to \p _key if an unexpired entry exists.
+        ///
+        /// \since 4.3.0
+        auto find(key_view_type _key) const -> std::optional<Value>
+        {
+            if (_key.size() > max_key_size) {
+                return std::nullopt;
+            }
+
+            const auto hash = hash_key(_key);
+            const auto& p = partition_for(hash);
+
+            boost::interprocess::sharable_lock lk{p.mutex};
+
+            if (const auto* s = find_slot(hash, _key); s && !is_expired(*s, now())) {
+                return s->value;
+            }
+
+            return std::nullopt;
+        }
+
+        /// Returns whether an unexpired entry exists for \p _key.
+        ///
+        /// \since 4.3.0
+        auto contains(key_view_type _key) const -> bool
+        {
+            return find(_key).has_value();
+        }
+
+        /// Invokes \p _func on the value of the unexpired entry mapped to \p _key while holding
+        /// the lock of its partition exclusively.
+        ///
+        /// \param[in] _key  The key.
+        /// \param[in] _func A callable with the signature bool(Value&). Returning false erases
+        ///                  the entry.
+        ///
+        /// \return Whether an entry was found.
+        ///
+        /// \since 4.3.0
+        template <typename Function>
+        auto modify(key_view_type _key, Function _func) -> bool
+        {
+            if (_key.size() > max_key_size) {
+                return false;
+            }
+
+            const auto hash = hash_key(_key);
+            auto& p = partition_for(hash);
+
+            boost::interprocess::scoped_lock lk{p.mutex};
+
+            auto* s = find_slot(hash, _key);
+
+            if (!s || is_expired(*s, now())) {
+                return false;
+            }
+
+            if (!_func(s->value)) {
+                erase_slot(p, *s);
+            }
+
+            return true;
+        }
+
+        /// Erases the entry mapped to \p _key.
+        ///
+        /// \return Whether an entry, expired or not, was erased.
+        ///
+        /// \since 4.3.0
+        auto erase(key_view_type _key) -> bool
+        {
+            if (_key.size() > max_key_size) {
+                return false;
+            }
+
+            const auto hash = hash_key(_key);
+            auto& p = partition_for(hash);
+
+            boost::interprocess::scoped_lock lk{p.mutex};
+
+            if (auto* s = find_slot(hash, _key); s) {
+                erase_slot(p, *s);
+                return true;
+            }
+
+            return false;
+        }
+
+        /// Erases every entry for which \p _pred returns true.
+        ///
+        /// Each partition is locked exclusively while it is visited. Expired entries are visited
+        /// as well.
+        ///
+        /// \param[in] _pred A callable with the signature bool(std::string_view, Value&). The
+        ///                  value may be modified.
+        ///
+        /// \return The number of entries erased.
+        ///
+        /// \since 4.3.0
+        template <typename Predicate>
+        auto erase_if(Predicate _pred) -> std::size_t
+        {
+            std::size_t count = 0;
+
+            for (std::size_t i = 0; i < partition_count_; ++i) {
+                auto& p = partitions_[i];
+
+                boost::interprocess::scoped_lock lk{p.mutex};
+
+                for (auto* s = first_slot(i), *end = s + slots_per_partition_; s != end; ++s) {
+                    if (slot_state::occupied == s->state && _pred(key_view_type{s->key, s->key_size}, s->value)) {
+                        erase_slot(p, *s);
+                        ++count;
+                    }
+                }
+
+                compact_if_needed(i);
+            }
+
+            return count;
+        }
+
+        /// Invokes \p _func on every unexpired entry.
+        ///
+        /// Each partition is locked for reading while it is visited.
+        ///
+        /// \param[in] _func A callable with the signature void(std::string_view, const Value&).
+        ///
+        /// \since 4.3.0
+        template <typename Function>
+        auto for_each(Function _func) const -> void
+        {
+            const auto current_time = now();
+
+            for (std::size_t i = 0; i < partition_count_; ++i) {
+                boost::interprocess::sharable_lock lk{partitions_[i].mutex};
+
+                for (const auto* s = first_slot(i), *end = s + slots_per_partition_; s != end; ++s) {
+                    if (slot_state::occupied == s->state && !is_expired(*s, current_time)) {
+                        _func(key_view_type{s->key, s->key_size}, s->value);
+                    }
+                }
+            }
+        }
+
+        /// Erases all expired entries.
+        ///
+        /// \return The number of entries erased.
+        ///
+        /// \since 4.3.0
+        auto erase_expired() -> std::size_t
+        {
+            const auto current_time = now();
+
+            std::size_t count = 0;
+
+            for (std::size_t i = 0; i < partition_count_; ++i) {
+                auto& p = partitions_[i];
+
+                boost::interprocess::scoped_lock lk{p.mutex};
+
+                for (auto* s = first_slot(i), *end = s + slots_per_partition_; s != end; ++s) {
+                    if (slot_state::occupied == s->state && is_expired(*s, current_time)) {
+                        erase_slot(p, *s);
+                        ++count;
+                    }
+                }
+
+                compact_if_needed(i);
+            }
+
+            return count;
+        }
+
+        /// Erases all entries.
+        ///
+        /// \since 4.3.0
+        auto clear() -> void
+        {
+            for (std::size_t i = 0; i < partition_count_; ++i) {
+                auto& p = partitions_[i];
+
+                boost::interprocess::scoped_lock lk{p.mutex};
+
+                for (auto* s = first_slot(i), *end = s + slots_per_partition_; s != end; ++s) {
+                    s->state = slot_state::empty;
+                }
+
+                p.size = 0;
+                p.erased = 0;
+            }
+        }
+
+        /// Returns the number of entries, including expired entries which have not been erased.
+        ///
+        /// \since 4.3.0
+        auto size() const -> std::size_t
+        {
+            std::size_t size = 0;
+
+            for (std::size_t i = 0; i < partition_count_; ++i) {
+                boost::interprocess::sharable_lock lk{partitions_[i].mutex};
+                size += partitions_[i].size;
+            }
+
+            return size;
+        }
+
+        /// Returns the maximum number of entries.
+        ///
+        /// \since 4.3.0
+        auto capacity() const noexcept -> std::size_t
+        {
+            return partition_count_ * slots_per_partition_;
+        }
+
+    private:
+        explicit shared_hash_table(std::size_t _capacity)
+            : partition_count_{std::clamp<std::size_t>(_capacity / 32, 1, max_partitions)}
+            , slots_per_partition_{_capacity / partition_count_}
+            , partitions_{}
+        {
+            auto* slots = first_slot(0);
+
+            for (std::size_t i = 0, n = capacity(); i < n; ++i) {
+                new (slots + i) slot{};
+            }
+        }
+
+        // FNV-1a
+        static auto hash_key(key_view_type _key) noexcept -> std::uint64_t
+        {
+            std::uint64_t hash = 14695981039346656037ULL;
+
+            for (unsigned char c : _key) {
+                hash ^= c;
+                hash *= 1099511628211ULL;
+            }
+
+            return hash;
+        }
+
+        static auto is_expired(const slot& _slot, std::int64_t _now) noexcept -> bool
+        {
+            return never_expires != _slot.expiration && _now >= _slot.expiration;
+        }
+
+        static auto matches(const slot& _slot, std::uint64_t _hash, key_view_type _key) noexcept -> bool
+        {
+            return _slot.hash == _hash &&
+                   _slot.key_size == _key.size() &&
+                   std::memcmp(_slot.key, _key.data(), _key.size()) == 0;
+        }
+
+        auto partition_index(std::uint64_t _hash) const noexcept -> std::size_t
+        {
+            return _hash % partition_count_;
+        }
+
+        auto partition_for(std::uint64_t _hash) const noexcept -> partition&
+        {
+            return partitions_[partition_index(_hash)];
+        }
+
+        auto first_slot(std::size_t _partition_index) const noexcept -> slot*
+        {
+            auto* base = reinterpret_cast<char*>(const_cast<shared_hash_table*>(this)) + slots_offset();
+            return reinterpret_cast<slot*>(base) + _partition_index * slots_per_partition_;
+        }
+
+        // Returns the first slot of the probe sequence for _hash.
+        auto home_slot(std::uint64_t _hash) const noexcept -> std::size_t
+        {
+            return (_hash / partition_count_) % slots_per_partition_;
+        }
+
+        // Returns the slot holding _key, expired or not. The partition must be locked.
+        auto find_slot(std::uint64_t _hash, key_view_type _key) const noexcept -> slot*
+        {
+            auto* slots = first_slot(partition_index(_hash));
+            const auto home = home_slot(_hash);
+
+            for (std::size_t i = 0; i < slots_per_partition_; ++i) {
+                auto& s = slots[(home + i) % slots_per_partition_];
+
+                if (slot_state::empty == s.state) {
+                    break;
+                }
+
+                if (slot_state::occupied == s.state && matches(s, _hash, _key)) {
+                    return &s;
+                }
+            }
+
+            return nullptr;
+        }
+
+        static auto erase_slot(partition& _partition, slot& _slot) noexcept -> void
+        {
+            _slot.state = slot_state::erased;
+            --_partition.size;
+            ++_partition.erased;
+        }
+
+        static auto assign_slot(slot& _slot,
+                                std::uint64_t _hash,
+                                key_view_type _key,
+                                const Value& _value,
+                                std::int64_t _expiration) noexcept -> void
+        {
+            _slot.hash = _hash;
+            _slot.expiration = _expiration;
+            _slot.key_size = static_cast<std::uint16_t>(_key.size());
+            std::memcpy(_slot.key, _key.data(), _key.size());
+            _slot.key[_key.size()] = 0;
+            _slot.value = _value;
+            _slot.state = slot_state::occupied;
+        }
+
+        auto insert_impl(key_view_type _key, const Value& _value, std::int64_t _expiration, bool _assign)
+            -> std::optional<bool>
+        {
+            if (_key.size() > max_key_size) {
+                return std::nullopt;
+            }
+
+            const auto hash = hash_key(_key);
+            const auto index = partition_index(hash);
+            auto& p = partitions_[index];
+
+            boost::interprocess::scoped_lock lk{p.mutex};
+
+            // Long runs of erased slots make probing slow. Rebuild the partition before they
+            // fill it up.
+            if (p.erased > 0 && p.size + p.erased >= slots_per_partition_ - slots_per_partition_ / 8) {
+                compact(index);
+            }
+
+            const auto current_time = now();
+
+            for (int attempt = 0; attempt < 2; ++attempt) {
+                auto* slots = first_slot(index);
+                const auto home = home_slot(hash);
+
+                slot* reusable = nullptr;
+
+                for (std::size_t i = 0; i < slots_per_partition_; ++i) {
+                    auto& s = slots[(home + i) % slots_per_partition_];
+
+                    if (slot_state::empty == s.state) {
+                        if (!reusable) {
+                            reusable = &s;
+                        }
+
+                        break;
+                    }
+
+                    if (slot_state::erased == s.state) {
+                        if (!reusable) {
+                            reusable = &s;
+                        }
+
+                        continue;
+                    }
+
+                    if (matches(s, hash, _key)) {
+                        const auto expired = is_expired(s, current_time);
+
+                        if (!_assign && !expired) {
+                            return false;
+                        }
+
+                        assign_slot(s, hash, _key, _value, _expiration);
+
+                        return _assign ? false : expired;
+                    }
+
+                    // The slots of expired entries belonging to other keys are reclaimed.
+                    if (!reusable && is_expired(s, current_time)) {
+                        reusable = &s;
+                    }
+                }
+
+                if (reusable) {
+                    if (slot_state::erased == reusable->state) {
+                        --p.erased;
+                        ++p.size;
+                    }
+                    else if (slot_state::empty == reusable->state) {
+                        ++p.size;
+                    }
+
+                    assign_slot(*reusable, hash, _key, _value, _expiration);
+
+                    return true;
+                }
+
+                // The partition is full. Drop expired entries and try again.
+                compact(index);
+            }
+
+            return std::nullopt;
+        }
+
+        auto compact_if_needed(std::size_t _partition_index) -> void
+        {
+            if (partitions_[_partition_index].erased > 0) {
+                compact(_partition_index);
+            }
+        }
+
+        // Rebuilds a partition without erased and expired slots. The partition must be locked
+        // exclusively.
+        auto compact(std::size_t _partition_index) -> void
+        {
+            auto& p = partitions_[_partition_index];
+            auto* slots = first_slot(_partition_index);
+            const auto current_time = now();
+
+            std::vector<slot> live;
+            live.reserve(p.size);
+
+            for (auto* s = slots, *end = slots + slots_per_partition_; s != end; ++s) {
+                if (slot_state::occupied == s->state && !is_expired(*s, current_time)) {
+                    live.push_back(*s);
+                }
+
+                s->state = slot_state::empty;
+            }
+
+            for (const auto& e : live) {
+                for (auto i = home_slot(e.hash);; i = (i + 1) % slots_per_partition_) {
+                    if (slot_state::empty == slots[i].state) {
+                        slots[i] = e;
+                        break;
+                    }
+                }
+            }
+
+            p.size = live.size();
+            p.erased = 0;
+        }
+
+        const std::size_t partition_count_;
+        const std::size_t slots_per_partition_;
+        mutable partition partitions_[max_partitions];
+    }; // class shared_hash_table
+} // namespace irods::experimental::interprocess
+
+#endif // IRODS_SHARED_HASH_TABLE_HPP
@@ -22,6 +22,11 @@ irods::error readMsgBody(
 irods::error writeMsgHeader(
     irods::network_object_ptr, // network object
     const msgHeader_t* );           // header structure
+// packs a header for the wire. the caller frees the buffer
+// with freeBBuf. since 4.3.0
+irods::error packMsgHeader(
+    const msgHeader_t*,             // header structure
+    bytesBuf_t** );                 // packed header
 irods::error sendRodsMsg(
     irods::network_object_ptr, // network object,
     const char*,                    // message type
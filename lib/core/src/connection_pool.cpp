@@ -3,11 +3,27 @@
 #include "irods_query.hpp"
 #include "thread_pool.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <thread>
 
 namespace irods
 {
+    namespace
+    {
+        // The options which reproduce a fixed-size pool: no growth and no background
+        // maintenance, so every checkout verifies its connection.
+        auto fixed_size_options(int _size) -> connection_pool_options
+        {
+            connection_pool_options options;
+            options.min_size = _size;
+            options.max_size = _size;
+            options.maintenance_interval = std::chrono::seconds{0};
+            return options;
+        }
+    } // anonymous namespace
+
     connection_pool::connection_proxy::connection_proxy()
         : pool_{}
         , conn_{}
@@ -27,6 +43,15 @@ namespace irods
 
     connection_pool::connection_proxy& connection_pool::connection_proxy::operator=(connection_proxy&& _other)
     {
+        if (this == &_other) {
+            return *this;
+        }
+
+        // Give back the connection currently held so that its slot is not lost.
+        if (pool_ && uninitialized_index != index_) {
+            pool_->return_connection(index_);
+        }
+
         pool_ = _other.pool_;
         conn_ = _other.conn_;
         index_ = _other.index_;
@@ -87,17 +112,30 @@ namespace irods
                                      const std::string& _username,
                                      const std::string& _zone,
                                      const int _refresh_time)
+        : connection_pool{fixed_size_options(_size), _host, _port, _username, _zone, _refresh_time}
+    {
+    }
+
+    connection_pool::connection_pool(const connection_pool_options& _options,
+                                     const std::string& _host,
+                                     const int _port,
+                                     const std::string& _username,
+                                     const std::string& _zone,
+                                     const int _refresh_time)
         : host_{_host}
         , port_{_port}
         , username_{_username}
         , zone_{_zone}
         , refresh_time_(_refresh_time)
-        , conn_ctxs_(_size)
+        , options_{_options}
+        , conn_ctxs_(std::max(_options.max_size, 0))
     {
-        if (_size < 1) {
+        if (_options.min_size < 1 || _options.max_size < _options.min_size) {
             throw std::runtime_error{"invalid connection pool size"};
         }
 
+        const int size = _options.min_size;
+
         // Always initialize the first connection to guarantee that the
         // network plugin is loaded. This guarantees that asynchronous calls
         // to rcConnect do not cause a segfault.
@@ -105,38 +143,66 @@ namespace irods
                           [] { throw std::runtime_error{"connect error"}; },
                           [] { throw std::runtime_error{"client login error"}; });
 
-        // If the size of the pool is one, then return immediately.
-        if (_size == 1) {
-            return;
-        }
-
         // Initialize the rest of the connection pool asynchronously.
+        if (size > 1) {
+            irods::thread_pool thread_pool{std::min<int>(size, std::thread::hardware_concurrency())};
+
+            std::atomic<bool> connect_error{};
+            std::atomic<bool> login_error{};
+
+            for (int i = 1; i < size; ++i) {
+                irods::thread_pool::post(thread_pool, [this, i, &connect_error, &login_error] {
+                    if (connect_error.load() || login_error.load()) {
+                        return;
+                    }
+
+                    create_connection(i,
+                                      [&connect_error] { connect_error.store(true); },
+                                      [&login_error] { login_error.store(true); });
+                });
+            }
 
-        irods::thread_pool thread_pool{std::min<int>(_size, std::thread::hardware_concurrency())};
+            thread_pool.join();
 
-        std::atomic<bool> connect_error{};
-        std::atomic<bool> login_error{};
+            if (connect_error.load()) {
+                throw std::runtime_error{"connect error"};
+            }
 
-        for (int i = 1; i < _size; ++i) {
-            irods::thread_pool::post(thread_pool, [this, i, &connect_error, &login_error] {
-                if (connect_error.load() || login_error.load()) {
-                    return;
-                }
+            if (login_error.load()) {
+                throw std::runtime_error{"client login error"};
+            }
+        }
 
-                create_connection(i,
-                                  [&connect_error] { connect_error.store(true); },
-                                  [&login_error] { login_error.store(true); });
-            });
+        // Slots are taken from the back of each list, so the lowest slots are used first.
+        for (int i = _options.max_size - 1; i >= 0; --i) {
+            if (i < size) {
+                conn_ctxs_[i].counted_open = true;
+                idle_.push_back(i);
+            }
+            else {
+                empty_.push_back(i);
+            }
         }
 
-        thread_pool.join();
+        open_ = size;
+        stats_.max_size = _options.max_size;
 
-        if (connect_error.load()) {
-            throw std::runtime_error{"connect error"};
+        if (_options.maintenance_interval.count() > 0) {
+            maintenance_thread_ = std::thread{[this] { maintain(); }};
         }
+    }
 
-        if (login_error.load()) {
-            throw std::runtime_error{"client login error"};
+    connection_pool::~connection_pool()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+
+        stop_cv_.notify_all();
+
+        if (maintenance_thread_.joinable()) {
+            maintenance_thread_.join();
         }
     }
 
@@ -159,6 +225,8 @@ namespace irods
         }
 
         if (clientLogin(ctx.conn.get()) != 0) {
+            // Never hand out a connection which is not logged in.
+            ctx.conn.reset();
             _on_login_error();
         }
     }
@@ -173,9 +241,6 @@ namespace irods
 
         try {
             query<rcComm_t>{ctx.conn.get(), "select ZONE_NAME where ZONE_TYPE = 'local'"};
-            if (std::time(nullptr) - ctx.creation_time > refresh_time_) {
-                return false;
-            }
         }
         catch (const std::exception&) {
             return false;
@@ -189,12 +254,17 @@ namespace irods
         auto& ctx = conn_ctxs_[_index];
         ctx.error = {};
 
-        if (ctx.refresh) {
-            ctx.refresh = false;
-            ctx.conn.release();
+        // When the maintenance thread verifies idle connections, only the age of the
+        // connection is checked here so that checkouts stay cheap. Without it, every
+        // checkout verifies the connection.
+        if (ctx.conn && std::time(nullptr) - ctx.creation_time > refresh_time_) {
+            ctx.conn.reset();
+        }
+        else if (ctx.conn && options_.maintenance_interval.count() <= 0 && !verify_connection(_index)) {
+            ctx.conn.reset();
         }
 
-        if (!verify_connection(_index)) {
+        if (!ctx.conn) {
             create_connection(_index,
                               [] { throw std::runtime_error{"connect error"}; },
                               [] { throw std::runtime_error{"client login error"}; });
@@ -203,37 +273,206 @@ namespace irods
         return ctx.conn.get();
     }
 
-    connection_pool::connection_proxy connection_pool::get_connection()
+    int connection_pool::acquire(const clock_type::time_point* _deadline)
     {
-        for (int i = 0;; i = ++i % conn_ctxs_.size()) {
-            std::unique_lock<std::mutex> lock{conn_ctxs_[i].mutex, std::defer_lock};
-
-            if (lock.try_lock()) {
-                if (!conn_ctxs_[i].in_use.load()) {
-                    conn_ctxs_[i].in_use.store(true);
-                    return {*this, *refresh_connection(i), i};
+        std::unique_lock lock{mutex_};
+
+        // Threads which are already waiting are served first.
+        if (waiters_.empty()) {
+            // Prefer open connections. Open a new one only when none are idle.
+            for (auto* slots : {&idle_, &empty_}) {
+                if (!slots->empty()) {
+                    const int index = slots->back();
+                    slots->pop_back();
+                    ++in_use_;
+                    ++stats_.checkouts;
+                    return index;
                 }
             }
         }
+
+        const auto start = clock_type::now();
+
+        waiter w;
+        waiters_.push_back(&w);
+        ++stats_.waits;
+
+        const auto handed_off = [&w] { return w.index >= 0; };
+
+        if (_deadline) {
+            w.cv.wait_until(lock, *_deadline, handed_off);
+        }
+        else {
+            w.cv.wait(lock, handed_off);
+        }
+
+        const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start);
+        stats_.total_wait_time += waited;
+        stats_.max_wait_time = std::max(stats_.max_wait_time, waited);
+
+        if (!handed_off()) {
+            waiters_.erase(std::find(std::begin(waiters_), std::end(waiters_), &w));
+            ++stats_.timeouts;
+            return -1;
+        }
+
+        ++stats_.checkouts;
+
+        return w.index;
+    }
+
+    connection_pool::connection_proxy connection_pool::make_proxy(int _index)
+    {
+        try {
+            auto* conn = refresh_connection(_index);
+
+            std::lock_guard lock{mutex_};
+            update_open_count(_index);
+
+            return {*this, *conn, _index};
+        }
+        catch (...) {
+            std::lock_guard lock{mutex_};
+            make_available(_index);
+            throw;
+        }
+    }
+
+    // Requires mutex_ to be locked.
+    void connection_pool::make_available(int _index)
+    {
+        update_open_count(_index);
+
+        // Hand the slot directly to the longest waiting thread.
+        if (!waiters_.empty()) {
+            auto* w = waiters_.front();
+            waiters_.pop_front();
+            w->index = _index;
+            w->cv.notify_one();
+            return;
+        }
+
+        --in_use_;
+
+        if (conn_ctxs_[_index].conn) {
+            idle_.push_back(_index);
+        }
+        else {
+            empty_.push_back(_index);
+        }
+    }
+
+    // Requires mutex_ to be locked.
+    void connection_pool::update_open_count(int _index)
+    {
+        auto& ctx = conn_ctxs_[_index];
+        const bool open = static_cast<bool>(ctx.conn);
+
+        if (open != ctx.counted_open) {
+            open_ += open ? 1 : -1;
+            ctx.counted_open = open;
+        }
+    }
+
+    connection_pool::connection_proxy connection_pool::get_connection()
+    {
+        return make_proxy(acquire(nullptr));
+    }
+
+    connection_pool::connection_proxy connection_pool::try_get_connection(std::chrono::milliseconds _timeout)
+    {
+        const auto deadline = clock_type::now() + _timeout;
+
+        if (const int index = acquire(&deadline); index >= 0) {
+            return make_proxy(index);
+        }
+
+        return {};
+    }
+
+    connection_pool::statistics connection_pool::get_statistics() const
+    {
+        std::lock_guard lock{mutex_};
+
+        auto stats = stats_;
+        stats.open = open_;
+        stats.in_use = in_use_;
+        stats.waiting = static_cast<int>(waiters_.size());
+
+        return stats;
     }
 
     void connection_pool::return_connection(int _index)
     {
-        conn_ctxs_[_index].in_use.store(false);
+        conn_ctxs_[_index].last_used = clock_type::now();
+
+        std::lock_guard lock{mutex_};
+        make_available(_index);
     }
 
     void connection_pool::release_connection(int _index)
     {
-        conn_ctxs_[_index].refresh = true;
         conn_ctxs_[_index].conn.release();
     }
 
+    void connection_pool::maintain()
+    {
+        std::unique_lock lock{mutex_};
+
+        while (!stop_cv_.wait_for(lock, options_.maintenance_interval, [this] { return stop_; })) {
+            // Visit every connection that is idle right now. Each one is checked out while it
+            // is being verified so that it is never used by two threads at once.
+            const auto slots = idle_;
+
+            for (const int index : slots) {
+                if (stop_) {
+                    return;
+                }
+
+                // Never hold back a connection from a waiting thread.
+                auto iter = std::find(std::begin(idle_), std::end(idle_), index);
+                if (!waiters_.empty() || std::end(idle_) == iter) {
+                    continue;
+                }
+
+                idle_.erase(iter);
+                ++in_use_;
+
+                auto& ctx = conn_ctxs_[index];
+                const bool shrink = open_ > options_.min_size &&
+                                    clock_type::now() - ctx.last_used > options_.idle_timeout;
+
+                lock.unlock();
+
+                if (shrink) {
+                    ctx.conn.reset();
+                }
+                else if (!verify_connection(index)) {
+                    ctx.conn.reset();
+                    create_connection(index, [] {}, [] {});
+
+                    lock.lock();
+                    ++stats_.health_check_failures;
+                    lock.unlock();
+                }
+
+                lock.lock();
+                make_available(index);
+            }
+        }
+    }
+
     std::shared_ptr<connection_pool> make_connection_pool(int size)
+    {
+        return make_connection_pool(fixed_size_options(size));
+    }
+
+    std::shared_ptr<connection_pool> make_connection_pool(const connection_pool_options& _options)
     {
         rodsEnv env{};
         _getRodsEnv(env);
         return std::make_shared<irods::connection_pool>(
-            size,
+            _options,
             env.rodsHost,
             env.rodsPort,
             env.rodsUserName,
@@ -1,153 +1,151 @@
 #include "dns_cache.hpp"
 
-#include <boost/interprocess/managed_shared_memory.hpp>
+#include "shared_hash_table.hpp"
+
 #include <boost/interprocess/shared_memory_object.hpp>
-#include <boost/interprocess/containers/map.hpp>
-#include <boost/interprocess/containers/string.hpp>
-#include <boost/interprocess/containers/list.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-#include <boost/interprocess/sync/named_sharable_mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/sharable_lock.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
+#include <cstdlib>
 #include <cstring>
 #include <utility>
 #include <algorithm>
 
 #include <sys/types.h>
 #include <unistd.h>
+#include <netinet/in.h>
 
 namespace
 {
     namespace bi = boost::interprocess;
+    namespace ipc = irods::experimental::interprocess;
 
     using std::chrono::duration_cast;
     using std::chrono::seconds;
 
-    struct address_info;
-
-    // clang-format off
-    using segment_manager_type         = bi::managed_shared_memory::segment_manager;
-    using void_allocator_type          = bi::allocator<void, segment_manager_type>;
-    using char_allocator_type          = bi::allocator<char, segment_manager_type>;
-    using address_info_allocator_type  = bi::allocator<address_info, segment_manager_type>;
-    using key_type                     = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
-    using mapped_type                  = bi::list<address_info, address_info_allocator_type>;
-    using value_type                   = std::pair<const key_type, mapped_type>;
-    using value_allocator_type         = bi::allocator<value_type, segment_manager_type>;
-    using map_type                     = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
-    using clock_type                   = std::chrono::system_clock;
-    // clang-format on
+    // The shared memory type of a single addrinfo.
+    struct address_info
+    {
+        int flags;
+        int family;
+        int socktype;
+        int protocol;
+        socklen_t addrlen;
+        bool has_addr;
+        char addr[sizeof(sockaddr_in6)]; // Large enough for IPv4 and IPv6 addresses.
+    }; // struct address_info
 
+    // The shared memory type of an addrinfo list.
     //
-    // Global Variables
-    //
-
-    // The following variables define the names of shared memory objects and other properties.
-    std::string g_segment_name;
-    std::size_t g_segment_size;
-    std::string g_mutex_name;
-
-    // On initialization, holds the PID of the process that initialized the hostname cache.
-    // This ensures that only the process that initialized the system can deinitialize it.
-    pid_t g_owner_pid;
+    // Only the first max_addresses nodes of a list are kept. getaddrinfo() returns one node per
+    // address and socket type, so this is enough for several addresses of a host.
+    struct address_info_list
+    {
+        static constexpr std::size_t max_addresses = 16;
 
-    // The following are pointers to the shared memory objects and allocator.
-    // Allocating on the heap allows us to know when the hostname cache is constructed/destructed.
-    std::unique_ptr<bi::managed_shared_memory> g_segment;
-    std::unique_ptr<void_allocator_type> g_allocator;
-    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
-    map_type* g_map;
+        address_info_list() = default;
 
-    // The shared memory type of addrinfo.
-    struct address_info
-    {
-        address_info(const addrinfo& _info, seconds _expires_after)
-            : flags{_info.ai_flags}
-            , family{_info.ai_family}
-            , socktype{_info.ai_socktype}
-            , protocol{_info.ai_protocol}
-            , addrlen{_info.ai_addrlen}
-            , addr{}
+        explicit address_info_list(const addrinfo& _info)
+            : count{}
+            , canonname_index{-1}
             , canonname{}
-            , expiration{}
-            , expires_after{_expires_after.count()}
+            , nodes{}
         {
-            if (_info.ai_addr) {
-                addr = static_cast<sockaddr*>(g_segment->allocate(sizeof(sockaddr)));
-                std::memcpy(addr.get(), _info.ai_addr, sizeof(sockaddr));
-            }
+            for (const auto* p = &_info; p && count < max_addresses; p = p->ai_next, ++count) {
+                auto& node = nodes[count];
 
-            if (_info.ai_canonname) {
-                const auto size = std::strlen(_info.ai_canonname);
-                canonname = static_cast<char*>(g_segment->allocate(sizeof(char) * size + 1));
-                std::strncpy(canonname.get(), _info.ai_canonname, size);
-                canonname[size] = 0;
-            }
+                // clang-format off
+                node.flags    = p->ai_flags;
+                node.family   = p->ai_family;
+                node.socktype = p->ai_socktype;
+                node.protocol = p->ai_protocol;
+                node.addrlen  = std::min<socklen_t>(p->ai_addrlen, sizeof(node.addr));
+                node.has_addr = (p->ai_addr != nullptr);
+                // clang-format on
+
+                if (p->ai_addr) {
+                    std::memcpy(node.addr, p->ai_addr, node.addrlen);
+                }
 
-            const auto tp = clock_type::now() + _expires_after;
-            expiration = duration_cast<seconds>(tp.time_since_epoch()).count();
+                // getaddrinfo() only sets the canonical name on the first node.
+                if (p->ai_canonname && canonname_index < 0) {
+                    canonname_index = static_cast<int>(count);
+                    std::strncpy(canonname, p->ai_canonname, sizeof(canonname) - 1);
+                }
+            }
         }
 
-        address_info(const address_info&) = default;
-        auto operator=(const address_info&) -> address_info& = default;
+        auto to_addrinfo() const -> addrinfo*
+        {
+            addrinfo* first{};
+            addrinfo* prev{};
 
-        address_info(address_info&&) = default;
-        auto operator=(address_info&&) -> address_info& = default;
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto& node = nodes[i];
 
-        ~address_info()
-        {
-            if (!g_segment) {
-                return;
-            }
+                auto* p = static_cast<addrinfo*>(std::malloc(sizeof(addrinfo)));
+                std::memset(p, 0, sizeof(addrinfo));
 
-            try {
                 // clang-format off
-                if (addr)      { g_segment->deallocate(addr.get()); }
-                if (canonname) { g_segment->deallocate(canonname.get()); }
+                p->ai_flags     = node.flags;
+                p->ai_family    = node.family;
+                p->ai_socktype  = node.socktype;
+                p->ai_protocol  = node.protocol;
+                p->ai_addrlen   = node.addrlen;
                 // clang-format on
-            }
-            catch (...) {}
-        }
 
-        auto to_addrinfo() const -> addrinfo*
-        {
-            auto* p = static_cast<addrinfo*>(std::malloc(sizeof(addrinfo)));
-            std::memset(p, 0, sizeof(addrinfo));
+                if (node.has_addr) {
+                    // Never allocate less than a sockaddr. Callers may read that many bytes
+                    // regardless of the address length.
+                    const auto size = std::max<std::size_t>(node.addrlen, sizeof(sockaddr));
+                    p->ai_addr = static_cast<sockaddr*>(std::calloc(1, size));
+                    std::memcpy(p->ai_addr, node.addr, node.addrlen);
+                }
 
-            // clang-format off
-            p->ai_flags     = flags;
-            p->ai_family    = family;
-            p->ai_socktype  = socktype;
-            p->ai_protocol  = protocol;
-            p->ai_addrlen   = addrlen;
-            // clang-format on
+                if (static_cast<int>(i) == canonname_index) {
+                    p->ai_canonname = strdup(canonname);
+                }
 
-            if (addr) {
-                p->ai_addr = static_cast<sockaddr*>(std::malloc(sizeof(sockaddr)));
-                std::memcpy(p->ai_addr, addr.get(), sizeof(sockaddr));
-            }
+                if (!prev) {
+                    first = p;
+                }
+                else {
+                    prev->ai_next = p;
+                }
 
-            if (canonname) {
-                const auto size = std::strlen(canonname.get());
-                p->ai_canonname = static_cast<char*>(std::malloc(sizeof(char) * size + 1));
-                std::strncpy(p->ai_canonname, canonname.get(), size);
-                p->ai_canonname[size] = 0;
+                prev = p;
             }
 
-            return p;
+            return first;
         }
 
-        int flags;
-        int family;
-        int socktype;
-        int protocol;
-        socklen_t addrlen;
-        bi::offset_ptr<sockaddr> addr;
-        bi::offset_ptr<char> canonname;
-        std::int64_t expiration;
-        std::int64_t expires_after;
-    }; // struct address_info
+        std::size_t count;
+        int canonname_index;
+        char canonname[256];
+        address_info nodes[max_addresses];
+    }; // struct address_info_list
+
+    // clang-format off
+    using map_type   = ipc::shared_hash_table<address_info_list, 256>;
+    using clock_type = map_type::clock_type;
+    // clang-format on
+
+    //
+    // Global Variables
+    //
+
+    // The following variables define the names of shared memory objects and other properties.
+    std::string g_segment_name;
+    std::size_t g_segment_size;
+
+    // On initialization, holds the PID of the process that initialized the hostname cache.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    // The following are pointers to the shared memory objects.
+    // Allocating on the heap allows us to know when the hostname cache is constructed/destructed.
+    std::unique_ptr<bi::shared_memory_object> g_segment;
+    std::unique_ptr<bi::mapped_region> g_region;
+    map_type* g_map;
 
     auto free_address_info(addrinfo* _p) -> void
     {
@@ -161,11 +159,6 @@ namespace
             std::free(prev);
         }
     }
-
-    auto current_timestamp_in_seconds() noexcept -> std::int64_t
-    {
-        return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
-    }
 } // anonymous namespace
 
 namespace irods::experimental::net::dns_cache
@@ -178,16 +171,14 @@ namespace irods::experimental::net::dns_cache
 
         g_segment_name = _shm_name.data();
         g_segment_size = _shm_size;
-        g_mutex_name = g_segment_name + "_mutex";
 
-        bi::named_sharable_mutex::remove(g_mutex_name.data());
         bi::shared_memory_object::remove(g_segment_name.data());
 
         g_owner_pid = getpid();
-        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
-        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
-        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
-        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+        g_segment = std::make_unique<bi::shared_memory_object>(bi::create_only, g_segment_name.data(), bi::read_write);
+        g_segment->truncate(g_segment_size);
+        g_region = std::make_unique<bi::mapped_region>(*g_segment, bi::read_write);
+        g_map = map_type::construct(g_region->get_address(), g_region->get_size());
     } // init
 
     auto deinit() noexcept -> void
@@ -199,18 +190,13 @@ namespace irods::experimental::net::dns_cache
         try {
             g_owner_pid = 0;
 
-            if (g_segment && g_map) {
-                g_segment->destroy_ptr(g_map);
-                g_map = nullptr;
-            }
+            g_map = nullptr;
 
             // clang-format off
-            if (g_mutex)     { g_mutex.reset(); }
-            if (g_allocator) { g_allocator.reset(); }
-            if (g_segment)   { g_segment.reset(); }
+            if (g_region)  { g_region.reset(); }
+            if (g_segment) { g_segment.reset(); }
             // clang-format on
 
-            bi::named_sharable_mutex::remove(g_mutex_name.data());
             bi::shared_memory_object::remove(g_segment_name.data());
         }
         catch (...) {}
@@ -220,47 +206,18 @@ namespace irods::experimental::net::dns_cache
                           const addrinfo& _info,
                           seconds _expires_after) -> bool
     {
-        void_allocator_type alloc{g_segment->get_segment_manager()};
+        const auto tp = clock_type::now() + _expires_after;
+        const auto expiration = duration_cast<seconds>(tp.time_since_epoch()).count();
 
-        bi::scoped_lock lk{*g_mutex};
-
-        auto [iter, inserted] = g_map->insert_or_assign(key_type{_key.data(), *g_allocator}, mapped_type{alloc});
-
-        for (const auto* p = &_info; p; p = p->ai_next) {
-            iter->second.emplace_back(*p, _expires_after);
-        }
-
-        return inserted;
+        return g_map->insert_or_assign(_key, address_info_list{_info}, expiration).value_or(false);
     } // insert_or_assign
 
     auto lookup(const std::string_view _key) -> std::unique_ptr<addrinfo, addrinfo_deleter_type>
     {
-        bi::sharable_lock lk{*g_mutex};
-
-        if (auto iter = g_map->find(key_type{_key.data(), *g_allocator}); iter != g_map->end()) {
-            if (auto& list = iter->second; current_timestamp_in_seconds() < list.front().expiration) {
-                addrinfo* first{};
-                addrinfo* prev{};
-                addrinfo* current{};
-
-                for (auto& node : list) {
-                    current = node.to_addrinfo();
-
-                    if (!prev) {
-                        first = current;
-                    }
-                    else {
-                        prev->ai_next = current;
-                    }
-
-                    prev = current;
-                }
-
-                // Not bumping the expiration timestamp here means the entry will eventually expire
-                // and cause a cache miss which is totally fine.
-
-                return {first, free_address_info};
-            }
+        // Not bumping the expiration timestamp here means the entry will eventually expire
+        // and cause a cache miss which is totally fine.
+        if (const auto list = g_map->find(_key); list && list->count > 0) {
+            return {list->to_addrinfo(), free_address_info};
         }
 
         return {nullptr, nullptr};
@@ -268,42 +225,26 @@ namespace irods::experimental::net::dns_cache
 
     auto erase(const std::string_view _key) -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-        g_map->erase(key_type{_key.data(), *g_allocator});
+        g_map->erase(_key);
     } // erase
 
     auto erase_expired_entries() -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-
-        const auto now = current_timestamp_in_seconds();
-
-        for (auto iter = g_map->begin(), end = g_map->end(); iter != end;) {
-            if (now >= iter->second.front().expiration) {
-                iter = g_map->erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
+        g_map->erase_expired();
     } // erase_expired_entries
 
     auto clear() -> void
     {
-        bi::scoped_lock lk{*g_mutex};
         g_map->clear();
     } // clear
 
     auto size() -> std::size_t
     {
-        bi::sharable_lock lk{*g_mutex};
         return g_map->size();
     } // size
 
     auto available_memory() -> std::size_t
     {
-        bi::sharable_lock lk{*g_mutex};
-        return g_segment->get_free_memory();
+        return (g_map->capacity() - g_map->size()) * map_type::slot_size;
     } // available_memory
 } // namespace irods::experimental::net::dns_cache
-
@@ -0,0 +1,210 @@
+#include "genquery_columnar.hpp"
+
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+
+#include <climits>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace
+{
+    // Copies _count elements of _src into a new malloc'd buffer. Returns false if the
+    // allocation fails. Leaves _dst null when there is nothing to copy.
+    template <typename T>
+    auto copy_to_malloc(const T* _src, std::size_t _count, T*& _dst) -> bool
+    {
+        _dst = nullptr;
+
+        if (0 == _count) {
+            return true;
+        }
+
+        _dst = static_cast<T*>(std::malloc(_count * sizeof(T)));
+
+        if (!_dst) {
+            return false;
+        }
+
+        std::memcpy(_dst, _src, _count * sizeof(T));
+
+        return true;
+    }
+
+    // Fills in _out with the dictionary encoding of the values in _bytes if the column has
+    // no more than half as many distinct values as rows and the encoding is smaller.
+    // Returns 1 if the column was encoded, 0 if it should be stored as is, and
+    // SYS_MALLOC_ERR on allocation failure.
+    auto encode_dictionary(const std::string& _bytes,
+                           const std::vector<int>& _offsets,
+                           genQueryColumn_t& _out) -> int
+    {
+        const auto rows = _offsets.size();
+
+        if (rows < 2) {
+            return 0;
+        }
+
+        const auto max_distinct = rows / 2;
+
+        std::unordered_map<std::string_view, int> codes_by_value;
+        codes_by_value.reserve(max_distinct + 1);
+
+        std::vector<std::string_view> distinct;
+        std::vector<int> codes(rows);
+        std::size_t distinct_bytes = 0;
+
+        for (std::size_t i = 0; i < rows; ++i) {
+            const auto end = i + 1 < rows ? _offsets[i + 1] : static_cast<int>(_bytes.size());
+            const std::string_view value{_bytes.data() + _offsets[i], static_cast<std::size_t>(end - _offsets[i])};
+
+            const auto [iter, inserted] = codes_by_value.try_emplace(value, static_cast<int>(distinct.size()));
+
+            if (inserted) {
+                if (distinct.size() == max_distinct) {
+                    return 0;
+                }
+
+                distinct.push_back(value);
+                distinct_bytes += value.size();
+            }
+
+            codes[i] = iter->second;
+        }
+
+        // Both encodings store one int per row, as an offset or as a code.
+        if (distinct_bytes + distinct.size() * sizeof(int) >= _bytes.size()) {
+            return 0;
+        }
+
+        std::string bytes;
+        bytes.reserve(distinct_bytes);
+
+        std::vector<int> offsets;
+        offsets.reserve(distinct.size());
+
+        for (auto value : distinct) {
+            offsets.push_back(static_cast<int>(bytes.size()));
+            bytes.append(value);
+        }
+
+        _out.encoding = GEN_QUERY_COLUMN_DICT;
+        _out.offsetCnt = static_cast<int>(offsets.size());
+        _out.byteCnt = static_cast<int>(bytes.size());
+        _out.codeCnt = static_cast<int>(codes.size());
+
+        if (!copy_to_malloc(offsets.data(), offsets.size(), _out.offsets) ||
+            !copy_to_malloc(bytes.data(), bytes.size(), _out.bytes) ||
+            !copy_to_malloc(codes.data(), codes.size(), _out.codes))
+        {
+            return SYS_MALLOC_ERR;
+        }
+
+        return 1;
+    }
+} // anonymous namespace
+
+namespace irods::experimental::genquery
+{
+    auto columnar_page_builder::append(const genQueryOut_t& _page) -> int
+    {
+        if (_page.attriCnt < 0 || _page.attriCnt > MAX_SQL_ATTR) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        if (columns_.empty()) {
+            columns_.resize(_page.attriCnt);
+
+            for (int i = 0; i < _page.attriCnt; ++i) {
+                columns_[i].attribute_index = _page.sqlResult[i].attriInx;
+            }
+        }
+        else if (static_cast<std::size_t>(_page.attriCnt) != columns_.size()) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        for (int i = 0; i < _page.attriCnt; ++i) {
+            const auto& result = _page.sqlResult[i];
+            auto& column = columns_[i];
+
+            if (result.attriInx != column.attribute_index) {
+                return SYS_INVALID_INPUT_PARAM;
+            }
+
+            column.offsets.reserve(column.offsets.size() + _page.rowCnt);
+
+            for (int row = 0; row < _page.rowCnt; ++row) {
+                const char* value = result.value + static_cast<std::size_t>(result.len) * row;
+                const auto length = ::strnlen(value, result.len);
+
+                if (column.bytes.size() + length + 1 > INT_MAX) {
+                    return SYS_INVALID_INPUT_PARAM;
+                }
+
+                column.offsets.push_back(static_cast<int>(column.bytes.size()));
+                column.bytes.append(value, length);
+                column.bytes.push_back('\0');
+
+                bytes_ += length + 1;
+            }
+        }
+
+        rows_ += _page.rowCnt;
+
+        return 0;
+    } // append
+
+    auto columnar_page_builder::release(genQueryColumnarOut_t& _out) -> int
+    {
+        _out.rowCnt = rows_;
+        _out.attriCnt = static_cast<int>(columns_.size());
+        _out.columns = nullptr;
+
+        int ec = 0;
+
+        if (!columns_.empty()) {
+            _out.columns = static_cast<genQueryColumn_t*>(std::calloc(columns_.size(), sizeof(genQueryColumn_t)));
+
+            if (!_out.columns) {
+                _out.attriCnt = 0;
+                ec = SYS_MALLOC_ERR;
+            }
+        }
+
+        for (std::size_t i = 0; 0 == ec && i < columns_.size(); ++i) {
+            const auto& column = columns_[i];
+            auto& out = _out.columns[i];
+
+            out.attriInx = column.attribute_index;
+
+            ec = encode_dictionary(column.bytes, column.offsets, out);
+
+            if (0 == ec) {
+                out.encoding = GEN_QUERY_COLUMN_PLAIN;
+                out.offsetCnt = static_cast<int>(column.offsets.size());
+                out.byteCnt = static_cast<int>(column.bytes.size());
+
+                if (!copy_to_malloc(column.offsets.data(), column.offsets.size(), out.offsets) ||
+                    !copy_to_malloc(column.bytes.data(), column.bytes.size(), out.bytes))
+                {
+                    ec = SYS_MALLOC_ERR;
+                }
+            }
+            else if (ec > 0) {
+                ec = 0;
+            }
+        }
+
+        columns_.clear();
+        rows_ = 0;
+        bytes_ = 0;
+
+        if (ec < 0) {
+            clearGenQueryColumnarOut(&_out);
+            _out.rowCnt = 0;
+            _out.attriCnt = 0;
+        }
+
+        return ec;
+    } // release
+} // namespace irods::experimental::genquery
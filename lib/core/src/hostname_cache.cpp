@@ -1,13 +1,9 @@
 #include "hostname_cache.hpp"
 
-#include <boost/interprocess/managed_shared_memory.hpp>
+#include "shared_hash_table.hpp"
+
 #include <boost/interprocess/shared_memory_object.hpp>
-#include <boost/interprocess/containers/map.hpp>
-#include <boost/interprocess/containers/string.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-#include <boost/interprocess/sync/named_sharable_mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/sharable_lock.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include <cstring>
 #include <utility>
@@ -19,42 +15,30 @@
 namespace
 {
     namespace bi = boost::interprocess;
+    namespace ipc = irods::experimental::interprocess;
 
     using std::chrono::duration_cast;
     using std::chrono::seconds;
 
-    struct alias;
-
-    // clang-format off
-    using segment_manager_type = bi::managed_shared_memory::segment_manager;
-    using void_allocator_type  = bi::allocator<void, segment_manager_type>;
-    using char_allocator_type  = bi::allocator<char, segment_manager_type>;
-    using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
-    using mapped_type          = alias;
-    using value_type           = std::pair<const key_type, mapped_type>;
-    using value_allocator_type = bi::allocator<value_type, segment_manager_type>;
-    using map_type             = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
-    using clock_type           = std::chrono::system_clock;
-    // clang-format on
-
     // The value type mapped to a specific hostname key.
     struct alias
     {
-        alias(const std::string_view _key,
-              std::int64_t _expiration,
-              std::int64_t _expires_after)
+        alias() = default;
+
+        explicit alias(const std::string_view _alias)
             : hostname{}
-            , expiration{_expiration}
-            , expires_after{_expires_after}
         {
-            std::strncpy(hostname, _key.data(), _key.size());
+            std::memcpy(hostname, _alias.data(), std::min(_alias.size(), sizeof(hostname) - 1));
         }
 
-        char hostname[256];         // FQDN are 253 characters long.
-        std::int64_t expiration;    // The seconds since epoch representing when this alias expires.
-        std::int64_t expires_after; // The number of seconds to apply to expiration after successful lookup.
+        char hostname[256]; // FQDN are 253 characters long.
     }; // struct alias
 
+    // clang-format off
+    using map_type   = ipc::shared_hash_table<alias, 256>;
+    using clock_type = map_type::clock_type;
+    // clang-format on
+
     //
     // Global Variables
     //
@@ -62,23 +46,16 @@ namespace
     // The following variables define the names of shared memory objects and other properties.
     std::string g_segment_name;
     std::size_t g_segment_size;
-    std::string g_mutex_name;
 
     // On initialization, holds the PID of the process that initialized the hostname cache.
     // This ensures that only the process that initialized the system can deinitialize it.
     pid_t g_owner_pid;
 
-    // The following are pointers to the shared memory objects and allocator.
+    // The following are pointers to the shared memory objects.
     // Allocating on the heap allows us to know when the hostname cache is constructed/destructed.
-    std::unique_ptr<bi::managed_shared_memory> g_segment;
-    std::unique_ptr<void_allocator_type> g_allocator;
-    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+    std::unique_ptr<bi::shared_memory_object> g_segment;
+    std::unique_ptr<bi::mapped_region> g_region;
     map_type* g_map;
-
-    auto current_timestamp_in_seconds() noexcept -> std::int64_t
-    {
-        return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
-    }
 } // anonymous namespace
 
 namespace irods::experimental::net::hostname_cache
@@ -91,16 +68,14 @@ namespace irods::experimental::net::hostname_cache
 
         g_segment_name = _shm_name.data();
         g_segment_size = _shm_size;
-        g_mutex_name = g_segment_name + "_mutex";
 
-        bi::named_sharable_mutex::remove(g_mutex_name.data());
         bi::shared_memory_object::remove(g_segment_name.data());
 
         g_owner_pid = getpid();
-        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
-        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
-        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
-        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+        g_segment = std::make_unique<bi::shared_memory_object>(bi::create_only, g_segment_name.data(), bi::read_write);
+        g_segment->truncate(g_segment_size);
+        g_region = std::make_unique<bi::mapped_region>(*g_segment, bi::read_write);
+        g_map = map_type::construct(g_region->get_address(), g_region->get_size());
     } // init
 
     auto deinit() noexcept -> void
@@ -112,18 +87,13 @@ namespace irods::experimental::net::hostname_cache
         try {
             g_owner_pid = 0;
 
-            if (g_segment && g_map) {
-                g_segment->destroy_ptr(g_map);
-                g_map = nullptr;
-            }
+            g_map = nullptr;
 
             // clang-format off
-            if (g_mutex)     { g_mutex.reset(); }
-            if (g_allocator) { g_allocator.reset(); }
-            if (g_segment)   { g_segment.reset(); }
+            if (g_region)  { g_region.reset(); }
+            if (g_segment) { g_segment.reset(); }
             // clang-format on
 
-            bi::named_sharable_mutex::remove(g_mutex_name.data());
             bi::shared_memory_object::remove(g_segment_name.data());
         }
         catch (...) {}
@@ -133,26 +103,16 @@ namespace irods::experimental::net::hostname_cache
                           const std::string_view _alias,
                           std::chrono::seconds _expires_after) -> bool
     {
-        bi::scoped_lock lk{*g_mutex};
-
         const auto tp = clock_type::now() + _expires_after;
         const auto expiration = duration_cast<seconds>(tp.time_since_epoch()).count();
 
-        const auto [iter, inserted] = g_map->insert_or_assign(
-            key_type{_key.data(), *g_allocator},
-            mapped_type{_alias, expiration, _expires_after.count()});
-
-        return inserted;
+        return g_map->insert_or_assign(_key, alias{_alias}, expiration).value_or(false);
     } // insert_or_assign
 
     auto lookup(const std::string_view _key) -> std::optional<std::string>
     {
-        bi::sharable_lock lk{*g_mutex};
-
-        if (auto iter = g_map->find(key_type{_key.data(), *g_allocator}); iter != g_map->end()) {
-            if (current_timestamp_in_seconds() < iter->second.expiration) {
-                return iter->second.hostname;
-            }
+        if (const auto value = g_map->find(_key); value) {
+            return value->hostname;
         }
 
         return std::nullopt;
@@ -160,42 +120,26 @@ namespace irods::experimental::net::hostname_cache
 
     auto erase(const std::string_view _key) -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-        g_map->erase(key_type{_key.data(), *g_allocator});
+        g_map->erase(_key);
     } // erase
 
     auto erase_expired_entries() -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-
-        const auto now = current_timestamp_in_seconds();
-
-        for (auto iter = g_map->begin(), end = g_map->end(); iter != end;) {
-            if (now >= iter->second.expiration) {
-                iter = g_map->erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
+        g_map->erase_expired();
     } // erase_expired_entries
 
     auto clear() -> void
     {
-        bi::scoped_lock lk{*g_mutex};
         g_map->clear();
     } // clear
 
     auto size() -> std::size_t
     {
-        bi::sharable_lock lk{*g_mutex};
         return g_map->size();
     } // size
 
     auto available_memory() -> std::size_t
     {
-        bi::sharable_lock lk{*g_mutex};
-        return g_segment->get_free_memory();
+        return (g_map->capacity() - g_map->size()) * map_type::slot_size;
     } // available_memory
 } // namespace irods::experimental::net::hostname_cache
-
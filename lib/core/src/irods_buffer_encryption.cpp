@@ -170,10 +170,41 @@ namespace irods {
         const array_t& _iv,
         const array_t& _in_buf,
         array_t&       _out_buf ) {
+        // =-=-=-=-=-=-=-
+        // max ciphertext len for a n bytes of plaintext is n + AES_BLOCK_SIZE -1 bytes
+        _out_buf.resize( _in_buf.size() + EVP_MAX_BLOCK_LENGTH );
+
+        int out_size = 0;
+        irods::error ret = encrypt(
+                               _key,
+                               _iv,
+                               _in_buf.data(),
+                               _in_buf.size(),
+                               _out_buf.data(),
+                               out_size );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        _out_buf.resize( out_size );
+
+        return SUCCESS();
+
+    } // encrypt
+
+// =-=-=-=-=-=-=-
+// public - encryptor for caller owned memory
+    irods::error buffer_crypt::encrypt(
+        const array_t&       _key,
+        const array_t&       _iv,
+        const unsigned char* _in_buf,
+        int                  _in_size,
+        unsigned char*       _out_buf,
+        int&                 _out_size ) {
 
         // =-=-=-=-=-=-=-
         // create an encryption context
-        auto* context = EVP_CIPHER_CTX_new();
+        std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> context{EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free};
 
         auto* algo = EVP_get_cipherbyname( algorithm_.c_str() );
         if ( !algo ) {
@@ -186,7 +217,7 @@ namespace irods {
         }
 
         int ret = EVP_EncryptInit_ex(
-                      context,
+                      context.get(),
                       algo,
                       NULL,
                       &_key[0],
@@ -199,21 +230,16 @@ namespace irods {
             return ERROR( ERR_get_error(), msg );
         }
 
-
-        // =-=-=-=-=-=-=-
-        // max ciphertext len for a n bytes of plaintext is n + AES_BLOCK_SIZE -1 bytes
-        int            cipher_len  = _in_buf.size() + AES_BLOCK_SIZE;
-        unsigned char* cipher_text = new unsigned char[ cipher_len ] ;
         // =-=-=-=-=-=-=-
         // update ciphertext, cipher_len is filled with the length of ciphertext generated,
+        int cipher_len = 0;
         ret = EVP_EncryptUpdate(
-                  context,
-                  cipher_text,
+                  context.get(),
+                  _out_buf,
                   &cipher_len,
-                  &_in_buf[0],
-                  _in_buf.size() );
+                  _in_buf,
+                  _in_size );
         if ( 0 == ret ) {
-            delete [] cipher_text;
             char err[ 256 ];
             ERR_error_string_n( ERR_get_error(), err, 256 );
             std::string msg( "failed in EVP_EncryptUpdate - " );
@@ -225,11 +251,10 @@ namespace irods {
         // update ciphertext with the final remaining bytes
         int final_len = 0;
         ret = EVP_EncryptFinal_ex(
-                  context,
-                  cipher_text + cipher_len,
+                  context.get(),
+                  _out_buf + cipher_len,
                   &final_len );
         if ( 0 == ret ) {
-            delete [] cipher_text;
             char err[ 256 ];
             ERR_error_string_n( ERR_get_error(), err, 256 );
             std::string msg( "failed in EVP_EncryptFinal_ex - " );
@@ -237,19 +262,7 @@ namespace irods {
             return ERROR( ERR_get_error(), msg );
         }
 
-        // =-=-=-=-=-=-=-
-        // clean up and assign out variables before exit
-        _out_buf.resize( cipher_len + final_len );
-
-        // =-=-=-=-=-=-=-
-        // copy the iv to the out variable
-        _out_buf.assign(
-            &cipher_text[0],
-            &cipher_text[ cipher_len + final_len ] );
-
-        delete [] cipher_text;
-
-        EVP_CIPHER_CTX_free( context );
+        _out_size = cipher_len + final_len;
 
         return SUCCESS();
 
@@ -263,8 +276,39 @@ namespace irods {
         const array_t& _in_buf,
         array_t&       _out_buf ) {
         // =-=-=-=-=-=-=-
+        // because we have padding ON, we must allocate an extra cipher block size of memory
+        _out_buf.resize( _in_buf.size() + EVP_MAX_BLOCK_LENGTH );
+
+        int out_size = 0;
+        irods::error ret = decrypt(
+                               _key,
+                               _iv,
+                               _in_buf.data(),
+                               _in_buf.size(),
+                               _out_buf.data(),
+                               out_size );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        _out_buf.resize( out_size );
+
+        return SUCCESS();
+
+    } // decrypt
+
+// =-=-=-=-=-=-=-
+// public - decryptor for caller owned memory
+    irods::error buffer_crypt::decrypt(
+        const array_t&       _key,
+        const array_t&       _iv,
+        const unsigned char* _in_buf,
+        int                  _in_size,
+        unsigned char*       _out_buf,
+        int&                 _out_size ) {
+        // =-=-=-=-=-=-=-
         // create an decryption context
-        auto* context = EVP_CIPHER_CTX_new();
+        std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> context{EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free};
 
         auto* algo = EVP_get_cipherbyname( algorithm_.c_str() );
         if ( !algo ) {
@@ -277,7 +321,7 @@ namespace irods {
         }
 
         int ret = EVP_DecryptInit_ex(
-                      context,
+                      context.get(),
                       algo,
                       NULL,
                       &_key[0],
@@ -290,20 +334,15 @@ namespace irods {
             return ERROR( ERR_get_error(), msg );
         }
 
-        // =-=-=-=-=-=-=-
-        // allocate a plain text buffer
-        // because we have padding ON, we must allocate an extra cipher block size of memory
-        int            plain_len  = 0;
-        auto plain_text = std::make_unique<unsigned char[]>(_in_buf.size() + AES_BLOCK_SIZE);
-
         // =-=-=-=-=-=-=-
         // update the plain text, plain_len is filled with the length of the plain text
+        int plain_len = 0;
         ret = EVP_DecryptUpdate(
-                  context,
-                  plain_text.get(),
+                  context.get(),
+                  _out_buf,
                   &plain_len,
-                  &_in_buf[0],
-                  _in_buf.size() );
+                  _in_buf,
+                  _in_size );
         if ( 0 == ret ) {
             char err[ 256 ];
             ERR_error_string_n( ERR_get_error(), err, 256 );
@@ -316,8 +355,8 @@ namespace irods {
         // finalize the plain text, final_len is filled with the resulting length of the plain text
         int final_len = 0;
         ret = EVP_DecryptFinal_ex(
-                  context,
-                  plain_text.get() + plain_len,
+                  context.get(),
+                  _out_buf + plain_len,
                   &final_len );
         if ( 0 == ret ) {
             char err[ 256 ];
@@ -327,17 +366,7 @@ namespace irods {
             return ERROR( ERR_get_error(), msg );
         }
 
-        // =-=-=-=-=-=-=-
-        // assign the plain text to the outvariable and clean up
-        _out_buf.resize( plain_len + final_len );
-
-        // =-=-=-=-=-=-=-
-        // copy the iv to the out variable
-        _out_buf.assign(
-            plain_text.get(),
-            plain_text.get() + plain_len + final_len );
-
-        EVP_CIPHER_CTX_free( context );
+        _out_size = plain_len + final_len;
 
         return SUCCESS();
 
@@ -104,7 +104,7 @@ namespace irods
         // hash the encrypted sid
         Hasher hasher;
         err = getHasher( MD5_NAME, hasher );
-        hasher.update( std::string( reinterpret_cast<char*>( out_buf.data() ), out_buf.size() ) );
+        hasher.update( reinterpret_cast<char*>( out_buf.data() ), out_buf.size() );
         hasher.digest( _signed_sid );
 
         return SUCCESS();
@@ -61,6 +61,12 @@ namespace irods
     const std::string CFG_MAX_TEMP_PASSWORD_LIFETIME( "maximum_temporary_password_lifetime_in_seconds" );
     const std::string CFG_MAX_NUMBER_OF_CONCURRENT_RE_PROCS( "maximum_number_of_concurrent_rule_engine_server_processes" );
     const std::string DEFAULT_LOG_ROTATION_IN_DAYS("default_log_rotation_in_days");
+    const std::string CFG_DB_PREPARED_STATEMENT_CACHE_SIZE_KW("database_prepared_statement_cache_size");
+    const std::string CFG_AGENT_FACTORY_POOL_SIZE_KW("agent_factory_pool_size");
+    const std::string CFG_AGENT_FACTORY_POOL_MAX_IDLE_TIME_IN_SECONDS_KW("agent_factory_pool_max_idle_time_in_seconds");
+    const std::string CFG_CHECKSUM_READ_BUFFER_SIZE_IN_BYTES_KW("checksum_read_buffer_size_in_bytes");
+    const std::string CFG_NUMBER_OF_TRANSFER_BUFFERS_FOR_PARA_TRANS_KW("number_of_transfer_buffers_for_parallel_transfer");
+    const std::string CFG_MAX_NUMBER_OF_ROWS_PER_GENQUERY_PAGE_KW("maximum_number_of_rows_per_genquery_page");
 
     const std::string CFG_RE_CACHE_SALT_KW("reCacheSalt");
     const std::string CFG_RE_SERVER_SLEEP_TIME( "rule_engine_server_sleep_time_in_seconds");
@@ -68,6 +74,7 @@ namespace irods
 
     const std::string CFG_DNS_CACHE_KW("dns_cache");
     const std::string CFG_HOSTNAME_CACHE_KW("hostname_cache");
+    const std::string CFG_RESOURCE_SNAPSHOT_KW("resource_snapshot");
 
     const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW("shared_memory_size_in_bytes");
     const std::string CFG_EVICTION_AGE_IN_SECONDS_KW("eviction_age_in_seconds");
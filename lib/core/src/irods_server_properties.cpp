@@ -158,6 +158,29 @@ namespace irods
         return 3600;
     } // get_hostname_cache_eviction_age
 
+    auto get_resource_snapshot_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_SNAPSHOT_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto bytes = boost::any_cast<int>(wrapped);
+
+            if (bytes > 0) {
+                return bytes;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for resource snapshot [size=%d].", bytes);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_SNAPSHOT_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for resource snapshot [default=2500000].");
+
+        return 2'500'000;
+    } // get_resource_snapshot_shared_memory_size
+
     void parse_and_store_hosts_configuration_file_as_json() noexcept
     {
         try {
@@ -7,12 +7,47 @@
 #include "rcMisc.h"
 #include "version.hpp"
 #include "irods_pack_table.hpp"
+#include "pack_instruction_cache.hpp"
 
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <regex>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+// An unpack arena is a chain of large blocks. Every buffer produced while unpacking
+// into the arena is bump-allocated from the current block, so the whole decoded message
+// is released by freeing the chain rather than by walking the structure.
+struct UnpackArena
+{
+    struct block
+    {
+        block* next;
+        std::size_t size;
+        std::size_t used;
+
+        auto data() noexcept -> char* { return reinterpret_cast<char*>(this) + header_size(); }
+
+        static constexpr auto header_size() noexcept -> std::size_t
+        {
+            return (sizeof(block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        }
+    };
+
+    std::size_t block_size;
+    block* head;
+    block* current;
+    void* last_allocation;
+};
 
 namespace
 {
@@ -264,7 +299,104 @@ namespace
         return _peer_version && *_peer_version >= irods::version{4, 2, 9};
     } // use_correct_xml_encoding
 
-    int parsePackInstruct( const char *packInstruct, packItem_t &packItemHead )
+    // Pack items and their names are recycled through a per-thread pool so that
+    // instantiating a cached plan does not go to the heap for every item. Items
+    // and names the pool cannot hold fall back to malloc()/strdup() and are told
+    // apart by address when released.
+    class pack_item_pool
+    {
+    public:
+        static constexpr int capacity = 512;
+
+        pack_item_pool()
+        {
+            for ( int i = 0; i < capacity; ++i ) {
+                free_items_[i] = capacity - 1 - i;
+                free_names_[i] = capacity - 1 - i;
+            }
+        }
+
+        auto allocate_item() -> packItem_t*
+        {
+            packItem_t* item = free_item_count_ > 0
+                ? &items_[free_items_[--free_item_count_]]
+                : static_cast<packItem_t*>( malloc( sizeof( packItem_t ) ) );
+            memset( item, 0, sizeof( packItem_t ) );
+            return item;
+        }
+
+        void release_item( packItem_t* _item )
+        {
+            if ( _item >= items_ && _item < items_ + capacity ) {
+                free_items_[free_item_count_++] = static_cast<int>( _item - items_ );
+            }
+            else {
+                free( _item );
+            }
+        }
+
+        auto copy_name( const char* _name ) -> char*
+        {
+            const std::size_t len = strlen( _name );
+            if ( len >= NAME_LEN || free_name_count_ == 0 ) {
+                return strdup( _name );
+            }
+            char* name = names_[free_names_[--free_name_count_]];
+            memcpy( name, _name, len + 1 );
+            return name;
+        }
+
+        void release_name( char* _name )
+        {
+            if ( _name >= names_[0] && _name < names_[capacity] ) {
+                free_names_[free_name_count_++] = static_cast<int>( ( _name - names_[0] ) / NAME_LEN );
+            }
+            else {
+                free( _name );
+            }
+        }
+
+    private:
+        packItem_t items_[capacity];
+        char names_[capacity][NAME_LEN];
+        int free_items_[capacity];
+        int free_names_[capacity];
+        int free_item_count_ = capacity;
+        int free_name_count_ = capacity;
+    }; // class pack_item_pool
+
+    auto get_pack_item_pool() -> pack_item_pool&
+    {
+        thread_local auto pool = std::make_unique<pack_item_pool>();
+        return *pool;
+    } // get_pack_item_pool
+
+    auto allocPackItem() -> packItem_t*
+    {
+        return get_pack_item_pool().allocate_item();
+    }
+
+    void freePackItem( packItem_t* _item )
+    {
+        get_pack_item_pool().release_item( _item );
+    }
+
+    auto copyPackItemName( const char* _name ) -> char*
+    {
+        return get_pack_item_pool().copy_name( _name );
+    }
+
+    void freePackItemName( char* _name )
+    {
+        if ( _name ) {
+            get_pack_item_pool().release_name( _name );
+        }
+    }
+
+    // Tokenizes a pack instruction into a linked list of items. This is the
+    // original interpreter. It is only reached on a plan cache miss or when the
+    // plan cache has been disabled.
+    int tokenizePackInstruct( const char *packInstruct, packItem_t &packItemHead )
     {
         char buf[MAX_PI_LEN];
         packItem_t *myPackItem = &packItemHead;
@@ -275,8 +407,7 @@ namespace
 
         while ( copyStrFromPiBuf( inptr, buf, 0 ) > 0 ) {
             if ( !myPackItem ) {
-                myPackItem = ( packItem_t* )malloc( sizeof( packItem_t ) );
-                memset( myPackItem, 0, sizeof( packItem_t ) );
+                myPackItem = allocPackItem();
             }
 
             if ( strcmp( buf,  ";" ) == 0 ) { /* delimiter */
@@ -288,7 +419,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: No varName for %s", packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -309,7 +441,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: % position error for %s", packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -318,7 +451,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: packTypeLookup failed for %s", buf );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -329,11 +463,12 @@ namespace
                              "parsePackInstruct: ? No variable following ? for %s",
                              packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
-                myPackItem->name = strdup( buf );
+                myPackItem->name = copyPackItemName( buf );
                 gotItemName = 1;
                 continue;
             }
@@ -343,7 +478,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: ? position error for %s", packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -352,7 +488,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: packTypeLookup failed for %s", buf );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -363,7 +500,8 @@ namespace
                              "parsePackInstruct: ? No variable following ? for %s",
                              packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -376,7 +514,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: * position error for %s", packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -388,7 +527,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: # position error for %s", packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -400,7 +540,8 @@ namespace
                     rodsLog( LOG_ERROR,
                              "parsePackInstruct: $ position error for %s", packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -413,7 +554,8 @@ namespace
                              "parsePackInstruct: packTypeLookup failed for %s in %s",
                              buf, packInstruct );
                     if ( myPackItem != &packItemHead ) {
-                        free( myPackItem );
+                        freePackItemName( myPackItem->name );
+                        freePackItem( myPackItem );
                     }
                     return SYS_PACK_INSTRUCT_FORMAT_ERR;
                 }
@@ -421,7 +563,7 @@ namespace
                 continue;
             }
             else if ( gotTypeCast == 1 && gotItemName == 0 ) {    /* item name */
-                myPackItem->name = strdup( buf );
+                myPackItem->name = copyPackItemName( buf );
                 gotItemName = 1;
                 continue;
             }
@@ -430,7 +572,8 @@ namespace
                          "parsePackInstruct: too many string around %s in %s",
                          buf, packInstruct );
                 if ( myPackItem != &packItemHead ) {
-                    free( myPackItem );
+                    freePackItemName( myPackItem->name );
+                    freePackItem( myPackItem );
                 }
                 return SYS_PACK_INSTRUCT_FORMAT_ERR;
             }
@@ -440,13 +583,121 @@ namespace
                      "parsePackInstruct: Pack Instruction %s not properly terminated",
                      packInstruct );
             if ( myPackItem != &packItemHead ) {
-                free( myPackItem );
+                freePackItemName( myPackItem->name );
+                freePackItem( myPackItem );
             }
             return SYS_PACK_INSTRUCT_FORMAT_ERR;
         }
         return 0;
     }
 
+    // A pack plan is the immutable result of tokenizing a pack instruction. It holds
+    // only the fields tokenizePackInstruct() fills in. Everything else in a packItem_t
+    // is per-call state (resolved dimensions, int values, pointers, etc.), which is
+    // why the plan is copied into a fresh linked list for each pack/unpack operation.
+    struct pack_plan_item
+    {
+        packTypeInx_t type_index;
+        int pointer_type;
+        std::optional<std::string> name;
+        std::string str_value;
+    };
+
+    using pack_plan = std::vector<pack_plan_item>;
+
+    struct pack_plan_cache
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const pack_plan>> plans;
+        std::atomic<bool> enabled{true};
+    };
+
+    auto get_pack_plan_cache() -> pack_plan_cache&
+    {
+        static pack_plan_cache cache;
+        return cache;
+    } // get_pack_plan_cache
+
+    auto make_pack_plan(const packItem_t& _packItemHead) -> pack_plan
+    {
+        pack_plan plan;
+
+        for (const auto* item = &_packItemHead; item; item = item->next) {
+            auto& plan_item = plan.emplace_back();
+            plan_item.type_index = item->typeInx;
+            plan_item.pointer_type = item->pointerType;
+            plan_item.str_value = item->strValue;
+
+            if (item->name) {
+                plan_item.name = item->name;
+            }
+        }
+
+        return plan;
+    } // make_pack_plan
+
+    void instantiatePackPlan( const pack_plan& plan, packItem_t &packItemHead )
+    {
+        packItem_t *prevPackItem = NULL;
+
+        for ( const auto& plan_item : plan ) {
+            packItem_t *myPackItem = &packItemHead;
+
+            if ( prevPackItem != NULL ) {
+                myPackItem = allocPackItem();
+                prevPackItem->next = myPackItem;
+                myPackItem->prev = prevPackItem;
+            }
+
+            myPackItem->typeInx = plan_item.type_index;
+            myPackItem->pointerType = plan_item.pointer_type;
+            myPackItem->name = plan_item.name ? copyPackItemName( plan_item.name->c_str() ) : NULL;
+            rstrcpy( myPackItem->strValue, plan_item.str_value.c_str(), NAME_LEN );
+
+            prevPackItem = myPackItem;
+        }
+    }
+
+    // Produces the linked list of items for a pack instruction. The instruction is
+    // tokenized only the first time it is seen. Later calls copy the cached plan.
+    int parsePackInstruct( const char *packInstruct, packItem_t &packItemHead )
+    {
+        auto& cache = get_pack_plan_cache();
+
+        if ( !cache.enabled.load( std::memory_order_relaxed ) ) {
+            return tokenizePackInstruct( packInstruct, packItemHead );
+        }
+
+        std::shared_ptr<const pack_plan> plan;
+
+        {
+            std::shared_lock lk{cache.mutex};
+            if ( auto iter = cache.plans.find( packInstruct ); iter != std::end( cache.plans ) ) {
+                plan = iter->second;
+            }
+        }
+
+        if ( !plan ) {
+            const int status = tokenizePackInstruct( packInstruct, packItemHead );
+            if ( status < 0 ) {
+                return status;
+            }
+
+            // The freshly tokenized list is handed back to the caller as is. It has
+            // not been touched by resolvePackedItem() yet, so it is a valid template.
+            auto new_plan = std::make_shared<const pack_plan>( make_pack_plan( packItemHead ) );
+
+            std::unique_lock lk{cache.mutex};
+            cache.plans.try_emplace( packInstruct, std::move( new_plan ) );
+
+            return 0;
+        }
+
+        instantiatePackPlan( *plan, packItemHead );
+
+        return 0;
+    }
+
     /* copy the next string from the inBuf to putBuf and advance the inBuf pointer.
      * special char '*', ';' and '?' will be returned as a string.
      */
@@ -520,12 +771,95 @@ namespace
         return -1;
     }
 
+    // The arena used by the unpack_struct_with_arena() call running on this thread, if any.
+    thread_local UnpackArena* current_unpack_arena = nullptr;
+
+    constexpr auto align_arena_size(std::size_t len) noexcept -> std::size_t
+    {
+        constexpr auto alignment = alignof(std::max_align_t);
+        return (len + alignment - 1) & ~(alignment - 1);
+    }
+
+    auto arena_allocate(UnpackArena& arena, std::size_t len) -> void*
+    {
+        len = align_arena_size(len);
+
+        auto* blk = arena.current;
+
+        // Move to the next block kept from a previous reset_unpack_arena(), or add one.
+        while (!blk || blk->used + len > blk->size) {
+            if (blk && blk->next) {
+                blk = blk->next;
+                blk->used = 0;
+                continue;
+            }
+
+            const auto size = std::max(arena.block_size, len);
+            auto* new_blk = static_cast<UnpackArena::block*>(malloc(UnpackArena::block::header_size() + size));
+            if (!new_blk) {
+                return nullptr;
+            }
+
+            *new_blk = {nullptr, size, 0};
+
+            if (blk) {
+                blk->next = new_blk;
+            }
+            else {
+                arena.head = new_blk;
+            }
+
+            blk = new_blk;
+        }
+
+        arena.current = blk;
+
+        void* p = blk->data() + blk->used;
+        blk->used += len;
+        arena.last_allocation = p;
+
+        return p;
+    }
+
+    // Equivalent to malloc() unless an unpack arena is active on this thread.
+    void* unpackAlloc( int len ) {
+        if ( current_unpack_arena ) {
+            return arena_allocate( *current_unpack_arena, len );
+        }
+        return malloc( len );
+    }
+
+    // Equivalent to realloc() unless an unpack arena is active on this thread. The most
+    // recent arena allocation is grown in place when its block has room for it.
+    void* unpackRealloc( void *ptr, int oldLen, int newLen ) {
+        if ( !current_unpack_arena ) {
+            return realloc( ptr, newLen );
+        }
+
+        auto& arena = *current_unpack_arena;
+
+        if ( ptr && ptr == arena.last_allocation ) {
+            auto* blk = arena.current;
+            const auto offset = static_cast<std::size_t>( static_cast<char*>( ptr ) - blk->data() );
+            if ( offset + align_arena_size( newLen ) <= blk->size ) {
+                blk->used = offset + align_arena_size( newLen );
+                return ptr;
+            }
+        }
+
+        void* newPtr = arena_allocate( arena, newLen );
+        if ( newPtr && ptr ) {
+            memcpy( newPtr, ptr, std::min( oldLen, newLen ) );
+        }
+        return newPtr;
+    }
+
     packedOutput_t
     initPackedOutput( const int len ) {
         return {
             .bBuf={
                 .len=0,   // The amount of memory used in the buffer.
-                .buf=malloc(len)
+                .buf=unpackAlloc(len)
             },
             .bufSize=len, // Capacity
             .nopackBufArray={}
@@ -586,8 +920,8 @@ namespace
             }
 
             /* NULL pointer of unknown type: pack it as a string pointer */
-            free( myPackedItem.name );
-            myPackedItem.name = strdup( "STR_PTR_PI" );
+            freePackItemName( myPackedItem.name );
+            myPackedItem.name = copyPackItemName( "STR_PTR_PI" );
         }
         inPtr = ptr;
 
@@ -738,7 +1072,7 @@ namespace
         }
 
         /* reset the link and switch myPackedItem<->newPackedItem */
-        free( myPackedItem.name );
+        freePackItemName( myPackedItem.name );
 
         packItem_t *lastPackedItem = &newPackedItem;
         while (lastPackedItem->next) {
@@ -761,8 +1095,6 @@ namespace
 
     int
     resolveIntInItem( const char *name, const packItem_t &myPackedItem ) {
-        int i;
-
         if ( isAllDigit( name ) ) {
             return atoi( name );
         }
@@ -786,13 +1118,16 @@ namespace
 
         /* Try the Rods Global table */
 
-        i = 0;
-        while ( strcmp( PackConstantTable[i].name, PACK_TABLE_END_PI ) != 0 ) {
-            /* not the end */
-            if ( strcmp( PackConstantTable[i].name, name ) == 0 ) {
-                return PackConstantTable[i].value;
+        static const auto pack_constant_table_index = [] {
+            std::unordered_map<std::string_view, int> index;
+            for (int i = 0; strcmp( PackConstantTable[i].name, PACK_TABLE_END_PI ) != 0; ++i) {
+                index.try_emplace( PackConstantTable[i].name, PackConstantTable[i].value );
             }
-            i++;
+            return index;
+        }();
+
+        if ( auto iter = pack_constant_table_index.find( name ); iter != std::end( pack_constant_table_index ) ) {
+            return iter->second;
         }
 
         return SYS_PACK_INSTRUCT_FORMAT_ERR;
@@ -826,8 +1161,8 @@ namespace
         }
 
         myPackedItem.typeInx = PACK_STRUCT_TYPE;
-        free( myPackedItem.name );
-        myPackedItem.name = strdup( tmpPackedItem->strValue );
+        freePackItemName( myPackedItem.name );
+        myPackedItem.name = copyPackItemName( tmpPackedItem->strValue );
 
         return 0;
     }
@@ -845,10 +1180,17 @@ namespace
 
         /* Try the Rods Global table */
 
-        for(int i = 0; strcmp( RodsPackTable[i].name, PACK_TABLE_END_PI ) != 0; ++i ) {
-            if ( strcmp( RodsPackTable[i].name, name ) == 0 ) {
-                return RodsPackTable[i].packInstruct;
+        static const auto rods_pack_table_index = [] {
+            std::unordered_map<std::string_view, const char*> index;
+            for (int i = 0; strcmp( RodsPackTable[i].name, PACK_TABLE_END_PI ) != 0; ++i) {
+                // Keep the first occurrence so that lookups agree with a linear scan.
+                index.try_emplace( RodsPackTable[i].name, RodsPackTable[i].packInstruct );
             }
+            return index;
+        }();
+
+        if ( auto iter = rods_pack_table_index.find( name ); iter != std::end( rods_pack_table_index ) ) {
+            return iter->second;
         }
 
         /* Try the API table */
@@ -1289,7 +1631,7 @@ namespace
             newBufSize = newOutLen + PACKED_OUT_ALLOC_SZ;
         }
 
-        if (auto* tmp = realloc( packedOutput.bBuf.buf, newBufSize ); tmp) {
+        if (auto* tmp = unpackRealloc( packedOutput.bBuf.buf, packedOutput.bufSize, newBufSize ); tmp) {
             packedOutput.bBuf.buf = tmp;
             packedOutput.bufSize = newBufSize;
         }
@@ -1867,12 +2209,12 @@ namespace
 
     int
     freePackedItem( packItem_t &packItemHead ) {
-        free( packItemHead.name );
+        freePackItemName( packItemHead.name );
         packItem_t *tmpItem = packItemHead.next;
         while ( tmpItem ) {
             packItem_t* nextItem = tmpItem->next;
-            free( tmpItem->name );
-            free( tmpItem );
+            freePackItemName( tmpItem->name );
+            freePackItem( tmpItem );
             tmpItem = nextItem;
         }
 
@@ -2851,7 +3193,7 @@ namespace
                 /* pointer to an array of pointers */
                 for ( i = 0; i < numPointer; i++ ) {
                     if ( myPackedItem.pointerType != NO_PACK_POINTER ) {
-                        outPtr = pointerArray[i] = malloc( numElement * elementSz );
+                        outPtr = pointerArray[i] = unpackAlloc( numElement * elementSz );
                         status = unpackCharToOutPtr( inPtr, outPtr, numElement * elementSz, myPackedItem.name, myPackedItem.typeInx, irodsProt );
                     }
                     if ( status < 0 ) {
@@ -2906,7 +3248,7 @@ namespace
                     if ( myLen < 0 ) {
                         return myLen;
                     }
-                    outPtr = pointerArray[j] = malloc( myLen );
+                    outPtr = pointerArray[j] = unpackAlloc( myLen );
                     for ( i = 0; i < numStr; i++ ) {
                         status = unpackStringToOutPtr( inPtr, outPtr, maxStrLen, myPackedItem.name, irodsProt, peer_version );
                         if ( status < 0 ) {
@@ -2926,7 +3268,7 @@ namespace
             else {
                 /* pointer to an array of pointers */
                 for ( i = 0; i < numPointer; i++ ) {
-                    outPtr = pointerArray[i] = malloc( numElement * elementSz );
+                    outPtr = pointerArray[i] = unpackAlloc( numElement * elementSz );
                     status = unpackIntToOutPtr( inPtr, outPtr, numElement * elementSz, myPackedItem.name, irodsProt );
                     if ( status < 0 ) {
                         return status;
@@ -2943,7 +3285,7 @@ namespace
             else {
                 /* pointer to an array of pointers */
                 for ( i = 0; i < numPointer; i++ ) {
-                    outPtr = pointerArray[i] = malloc( numElement * elementSz );
+                    outPtr = pointerArray[i] = unpackAlloc( numElement * elementSz );
                     status = unpackInt16ToOutPtr( inPtr, outPtr, numElement * elementSz, myPackedItem.name, irodsProt );
                     if ( status < 0 ) {
                         return status;
@@ -2960,7 +3302,7 @@ namespace
             else {
                 /* pointer to an array of pointers */
                 for ( i = 0; i < numPointer; i++ ) {
-                    outPtr = pointerArray[i] = malloc( numElement * elementSz );
+                    outPtr = pointerArray[i] = unpackAlloc( numElement * elementSz );
                     status = unpackDoubleToOutPtr( inPtr, outPtr, numElement * elementSz, myPackedItem.name, irodsProt );
                     if ( status < 0 ) {
                         return status;
@@ -2977,7 +3319,7 @@ namespace
                 /* we really don't know the size of each struct. */
                 /* outPtr = addPointerToPackedOut (unpackedOutput,
                    numElement * SUB_STRUCT_ALLOC_SZ); */
-                outPtr = malloc( numElement * SUB_STRUCT_ALLOC_SZ );
+                outPtr = unpackAlloc( numElement * SUB_STRUCT_ALLOC_SZ );
                 packedOutput_t subPackedOutput = initPackedOutputWithBuf( outPtr, numElement * SUB_STRUCT_ALLOC_SZ );
                 status = unpackChildStruct( inPtr, subPackedOutput, myPackedItem, myPackTable, numElement, irodsProt, nullptr, peer_version );
                 addPointerToPackedOut( unpackedOutput, numElement * SUB_STRUCT_ALLOC_SZ, subPackedOutput.bBuf.buf );
@@ -2989,8 +3331,8 @@ namespace
             else {
                 /* pointer to an array of pointers */
                 for ( i = 0; i < numPointer; i++ ) {
-                    /* outPtr = pointerArray[i] = malloc ( */
-                    outPtr = malloc( numElement * SUB_STRUCT_ALLOC_SZ );
+                    /* outPtr = pointerArray[i] = unpackAlloc ( */
+                    outPtr = unpackAlloc( numElement * SUB_STRUCT_ALLOC_SZ );
                     packedOutput_t subPackedOutput = initPackedOutputWithBuf( outPtr, numElement * SUB_STRUCT_ALLOC_SZ );
                     status = unpackChildStruct( inPtr, subPackedOutput, myPackedItem, myPackTable, numElement, irodsProt, nullptr, peer_version );
                     pointerArray[i] = subPackedOutput.bBuf.buf;
@@ -3023,7 +3365,7 @@ namespace
             *tmpPtr = pointer;
         }
         else if ( len > 0 ) {
-            *tmpPtr = malloc( len );
+            *tmpPtr = unpackAlloc( len );
             memset(*tmpPtr, 0, len);
         }
         else {
@@ -3087,6 +3429,7 @@ namespace
 
         /* maxStrLen = -1 means null terminated */
         if ( maxStrLen >= 0 && myStrlen >= maxStrLen ) {
+            free( myStrPtr );
             return USER_PACKSTRUCT_INPUT_ERR;
         }
 
@@ -3096,6 +3439,7 @@ namespace
         else {
             strncpy( static_cast<char*>(outPtr), myStrPtr, myStrlen + 1 );
         }
+        free( myStrPtr );
 
         inPtr = static_cast<const char*>(inPtr) + ( origStrLen + endTagLen );
 
@@ -3323,22 +3667,22 @@ namespace
         int newNumBuf;
         int curNumBuf;
         bytesBuf_t *newBBufArray;
-        int i;
         int status;
 
         curNumBuf = packedOutput.nopackBufArray.numBuf;
-        if ( ( curNumBuf % PTR_ARRAY_MALLOC_LEN ) == 0 ) {
-            newNumBuf = curNumBuf + PTR_ARRAY_MALLOC_LEN;
 
-            newBBufArray = ( bytesBuf_t * ) malloc( newNumBuf * sizeof( bytesBuf_t ) );
-            memset( newBBufArray, 0, newNumBuf * sizeof( bytesBuf_t ) );
-            for ( i = 0; i < curNumBuf; i++ ) {
-                newBBufArray[i].len = packedOutput.nopackBufArray.bBufArray[i].len;
-                newBBufArray[i].buf = packedOutput.nopackBufArray.bBufArray[i].buf;
-            }
-            if ( packedOutput.nopackBufArray.bBufArray != NULL ) {
-                free( packedOutput.nopackBufArray.bBufArray );
+        /* the capacity doubles, starting at PTR_ARRAY_MALLOC_LEN. the array is full
+         * when curNumBuf is zero or PTR_ARRAY_MALLOC_LEN times a power of two. */
+        const int numBlocks = curNumBuf / PTR_ARRAY_MALLOC_LEN;
+        if ( ( curNumBuf % PTR_ARRAY_MALLOC_LEN ) == 0 && ( numBlocks & ( numBlocks - 1 ) ) == 0 ) {
+            newNumBuf = ( curNumBuf == 0 ) ? PTR_ARRAY_MALLOC_LEN : curNumBuf * 2;
+
+            newBBufArray = ( bytesBuf_t * ) realloc( packedOutput.nopackBufArray.bBufArray,
+                                                     newNumBuf * sizeof( bytesBuf_t ) );
+            if ( newBBufArray == NULL ) {
+                return SYS_MALLOC_ERR;
             }
+            memset( newBBufArray + curNumBuf, 0, ( newNumBuf - curNumBuf ) * sizeof( bytesBuf_t ) );
             packedOutput.nopackBufArray.bBufArray = newBBufArray;
         }
         packedOutput.nopackBufArray.bBufArray[curNumBuf].len = len;
@@ -3372,10 +3716,10 @@ int packStruct(const void *inStruct,
     packedOutput_t packedOutput = initPackedOutput(MAX_PACKED_OUT_ALLOC_SZ);
 
     packItem_t rootPackedItem{};
-    rootPackedItem.name = strdup( packInstName );
+    rootPackedItem.name = copyPackItemName( packInstName );
     int status = packChildStruct(inStruct, packedOutput, rootPackedItem,
                                  myPackTable, 1, packFlag, irodsProt, nullptr, std::nullopt);
-    free( rootPackedItem.name );
+    freePackItemName( rootPackedItem.name );
 
     if ( status < 0 ) {
         free( packedOutput.bBuf.buf );
@@ -3417,10 +3761,10 @@ int unpackStruct(const void *inPackedStr,
     packedOutput_t unpackedOutput = initPackedOutput(PACKED_OUT_ALLOC_SZ);
 
     packItem_t rootPackedItem{};
-    rootPackedItem.name = strdup( packInstName );
+    rootPackedItem.name = copyPackItemName( packInstName );
     int status = unpackChildStruct(inPackedStr, unpackedOutput, rootPackedItem,
                                    myPackTable, 1, irodsProt, nullptr, std::nullopt);
-    free( rootPackedItem.name );
+    freePackItemName( rootPackedItem.name );
 
     if ( status < 0 ) {
         free( unpackedOutput.bBuf.buf );
@@ -3454,10 +3798,10 @@ int pack_struct(const void *inStruct,
     packedOutput_t packedOutput = initPackedOutput(MAX_PACKED_OUT_ALLOC_SZ);
 
     packItem_t rootPackedItem{};
-    rootPackedItem.name = strdup(packInstName);
+    rootPackedItem.name = copyPackItemName(packInstName);
     int status = packChildStruct(inStruct, packedOutput, rootPackedItem, myPackTable,
                                  1, packFlag, irodsProt, nullptr, peer_vers);
-    free(rootPackedItem.name);
+    freePackItemName(rootPackedItem.name);
 
     if (status < 0) {
         free(packedOutput.bBuf.buf);
@@ -3505,13 +3849,15 @@ int unpack_struct(const void *inPackedStr,
     packedOutput_t unpackedOutput = initPackedOutput(PACKED_OUT_ALLOC_SZ);
 
     packItem_t rootPackedItem{};
-    rootPackedItem.name = strdup(packInstName);
+    rootPackedItem.name = copyPackItemName(packInstName);
     int status = unpackChildStruct(inPackedStr, unpackedOutput, rootPackedItem, myPackTable,
                                    1, irodsProt, nullptr, peer_vers);
-    free(rootPackedItem.name);
+    freePackItemName(rootPackedItem.name);
 
     if (status < 0) {
-        free(unpackedOutput.bBuf.buf);
+        if (!current_unpack_arena) {
+            free(unpackedOutput.bBuf.buf);
+        }
         return status;
     }
 
@@ -3520,3 +3866,92 @@ int unpack_struct(const void *inPackedStr,
     return 0;
 }
 
+unpackArena_t* create_unpack_arena(size_t blockSize)
+{
+    auto* arena = static_cast<unpackArena_t*>(malloc(sizeof(unpackArena_t)));
+    if (!arena) {
+        return nullptr;
+    }
+
+    *arena = {blockSize > 0 ? blockSize : UNPACK_ARENA_BLOCK_SZ, nullptr, nullptr, nullptr};
+
+    return arena;
+}
+
+void reset_unpack_arena(unpackArena_t* arena)
+{
+    if (!arena) {
+        return;
+    }
+
+    // The blocks are kept so that the next message reuses them.
+    arena->current = arena->head;
+    arena->last_allocation = nullptr;
+
+    if (arena->head) {
+        arena->head->used = 0;
+    }
+}
+
+void free_unpack_arena(unpackArena_t* arena)
+{
+    if (!arena) {
+        return;
+    }
+
+    for (auto* blk = arena->head; blk;) {
+        auto* next = blk->next;
+        free(blk);
+        blk = next;
+    }
+
+    free(arena);
+}
+
+int unpack_struct_with_arena(const void *inPackedStr,
+                             void **outStruct,
+                             const char *packInstName,
+                             const packInstruct_t *myPackTable,
+                             irodsProt_t irodsProt,
+                             const char* peer_version,
+                             unpackArena_t* arena)
+{
+    if (!arena) {
+        rodsLog(LOG_ERROR, "unpack_struct_with_arena: Input error. The arena is null.");
+        return USER_PACKSTRUCT_INPUT_ERR;
+    }
+
+    UnpackArena* previous_arena = current_unpack_arena;
+    current_unpack_arena = arena;
+    const int status = unpack_struct(inPackedStr, outStruct, packInstName, myPackTable, irodsProt, peer_version);
+    current_unpack_arena = previous_arena;
+
+    return status;
+}
+
+namespace irods::experimental::pack_instruction_cache
+{
+    auto enable(bool _value) noexcept -> void
+    {
+        get_pack_plan_cache().enabled.store(_value);
+    } // enable
+
+    auto enabled() noexcept -> bool
+    {
+        return get_pack_plan_cache().enabled.load();
+    } // enabled
+
+    auto clear() -> void
+    {
+        auto& cache = get_pack_plan_cache();
+        std::unique_lock lk{cache.mutex};
+        cache.plans.clear();
+    } // clear
+
+    auto size() -> std::size_t
+    {
+        auto& cache = get_pack_plan_cache();
+        std::shared_lock lk{cache.mutex};
+        return cache.plans.size();
+    } // size
+} // namespace irods::experimental::pack_instruction_cache
@@ -1077,6 +1077,157 @@ clearGenQueryOut( void* voidInp ) {
     return;
 }
 
+int
+freeGenQueryColumnarOut( genQueryColumnarOut_t **genQueryColumnarOut ) {
+    if ( genQueryColumnarOut == NULL ) {
+        return 0;
+    }
+
+    if ( *genQueryColumnarOut == NULL ) {
+        return 0;
+    }
+
+    clearGenQueryColumnarOut( *genQueryColumnarOut );
+    free( *genQueryColumnarOut );
+    *genQueryColumnarOut = NULL;
+
+    return 0;
+}
+
+void
+clearGenQueryColumnarOut( void* voidInp ) {
+    genQueryColumnarOut_t *genQueryColumnarOut = ( genQueryColumnarOut_t* ) voidInp;
+    int i;
+
+    if ( genQueryColumnarOut == NULL || genQueryColumnarOut->columns == NULL ) {
+        return;
+    }
+
+    for ( i = 0; i < genQueryColumnarOut->attriCnt; i++ ) {
+        free( genQueryColumnarOut->columns[i].offsets );
+        free( genQueryColumnarOut->columns[i].bytes );
+        free( genQueryColumnarOut->columns[i].codes );
+    }
+    free( genQueryColumnarOut->columns );
+    genQueryColumnarOut->columns = NULL;
+    return;
+}
+
+genQueryColumn_t *
+getGenQueryColumnByInx( genQueryColumnarOut_t *genQueryColumnarOut, int attriInx ) {
+    int i;
+
+    if ( genQueryColumnarOut == NULL || genQueryColumnarOut->columns == NULL ) {
+        return NULL;
+    }
+
+    for ( i = 0; i < genQueryColumnarOut->attriCnt; i++ ) {
+        if ( genQueryColumnarOut->columns[i].attriInx == attriInx ) {
+            return &genQueryColumnarOut->columns[i];
+        }
+    }
+    return NULL;
+}
+
+/* getGenQueryColumnValue - returns the null terminated value of the given row
+ * of a column of a genQueryColumnarOut_t, or NULL if the row is out of range.
+ */
+const char *
+getGenQueryColumnValue( const genQueryColumn_t *column, int row ) {
+    int inx;
+
+    if ( column == NULL || row < 0 ) {
+        return NULL;
+    }
+
+    if ( column->encoding == GEN_QUERY_COLUMN_DICT ) {
+        if ( row >= column->codeCnt ) {
+            return NULL;
+        }
+        inx = column->codes[row];
+    }
+    else {
+        inx = row;
+    }
+
+    if ( inx < 0 || inx >= column->offsetCnt ||
+            column->offsets[inx] < 0 || column->offsets[inx] >= column->byteCnt ) {
+        return NULL;
+    }
+    return column->bytes + column->offsets[inx];
+}
+
+/* validateGenQueryColumnarOut - checks that every offset and code of a
+ * genQueryColumnarOut_t received from a peer stays within its column, so that
+ * the values can be read without further bounds checks.  Returns 0 if the page
+ * is well formed and SYS_INVALID_INPUT_PARAM otherwise.
+ */
+int
+validateGenQueryColumnarOut( const genQueryColumnarOut_t *genQueryColumnarOut ) {
+    int i, j;
+
+    if ( genQueryColumnarOut == NULL ) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    if ( genQueryColumnarOut->rowCnt < 0 || genQueryColumnarOut->attriCnt < 0 ||
+            genQueryColumnarOut->attriCnt > MAX_SQL_ATTR ) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    if ( genQueryColumnarOut->attriCnt > 0 && genQueryColumnarOut->columns == NULL ) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    for ( i = 0; i < genQueryColumnarOut->attriCnt; i++ ) {
+        const genQueryColumn_t *column = &genQueryColumnarOut->columns[i];
+
+        if ( column->encoding == GEN_QUERY_COLUMN_DICT ) {
+            if ( column->codeCnt != genQueryColumnarOut->rowCnt ||
+                    ( column->codeCnt > 0 && column->codes == NULL ) ) {
+                return SYS_INVALID_INPUT_PARAM;
+            }
+            for ( j = 0; j < column->codeCnt; j++ ) {
+                if ( column->codes[j] < 0 || column->codes[j] >= column->offsetCnt ) {
+                    return SYS_INVALID_INPUT_PARAM;
+                }
+            }
+        }
+        else if ( column->encoding != GEN_QUERY_COLUMN_PLAIN ||
+                  column->offsetCnt != genQueryColumnarOut->rowCnt ) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        if ( column->offsetCnt < 0 || column->byteCnt < 0 ) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        if ( column->offsetCnt == 0 ) {
+            continue;
+        }
+
+        if ( column->offsets == NULL || column->bytes == NULL || column->byteCnt == 0 ||
+                column->bytes[column->byteCnt - 1] != '\0' ) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        /* Every value holds at least its null terminator, so the offsets
+         * strictly increase and the byte before each one ends a value. */
+        for ( j = 0; j < column->offsetCnt; j++ ) {
+            if ( column->offsets[j] < 0 || column->offsets[j] >= column->byteCnt ) {
+                return SYS_INVALID_INPUT_PARAM;
+            }
+            if ( j == 0 ? column->offsets[j] != 0
+                        : column->offsets[j] <= column->offsets[j - 1] ||
+                          column->bytes[column->offsets[j] - 1] != '\0' ) {
+                return SYS_INVALID_INPUT_PARAM;
+            }
+        }
+    }
+
+    return 0;
+}
+
 /* catGenQueryOut - Concatenate genQueryOut to targGenQueryOut up to maxRowCnt.
  * It is assumed that the two genQueryOut have the same attriInx and
  * len for each attri.
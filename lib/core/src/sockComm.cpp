@@ -458,24 +458,39 @@ rsAcceptConn( rsComm_t *svrComm ) {
     return newSock;
 }
 
+// =-=-=-=-=-=-=-
+//
+irods::error packMsgHeader(
+    const msgHeader_t* _header,
+    bytesBuf_t**       _header_buf ) {
+    // =-=-=-=-=-=-=-
+    // always use XML_PROT for the Header
+    *_header_buf = 0;
+    int status = pack_struct(_header, _header_buf, "MsgHeader_PI", RodsPackTable, 0, XML_PROT, nullptr);
+    if ( status < 0 || 0 == *_header_buf ) {
+        return ERROR( status, "packstruct error" );
+    }
+
+    return SUCCESS();
+
+} // packMsgHeader
+
 // =-=-=-=-=-=-=-
 //
 irods::error writeMsgHeader(
     irods::network_object_ptr _ptr,
     const msgHeader_t*        _header ) {
-    // =-=-=-=-=-=-=-
-    // always use XML_PROT for the Header
     bytesBuf_t* header_buf = 0;
-    int status = pack_struct(_header, &header_buf, "MsgHeader_PI", RodsPackTable, 0, XML_PROT, nullptr);
-    if ( status < 0 || 0 == header_buf ) {
-        return ERROR( status, "packstruct error" );
+    irods::error ret = packMsgHeader( _header, &header_buf );
+    if ( !ret.ok() ) {
+        return PASS( ret );
     }
 
     // =-=-=-=-=-=-=-
     // resolve a network interface plugin from the
     // network object
     irods::plugin_ptr p_ptr;
-    irods::error ret = _ptr->resolve( irods::NETWORK_INTERFACE, p_ptr );
+    ret = _ptr->resolve( irods::NETWORK_INTERFACE, p_ptr );
     if ( !ret.ok() ) {
         freeBBuf( header_buf );
         return PASSMSG( "failed to resolve network interface", ret );
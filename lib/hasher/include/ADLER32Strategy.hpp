@@ -13,9 +13,9 @@ namespace irods {
             std::string name() const override {
                 return ADLER32_NAME;
             }
-            error init( boost::any& context ) const override;
-            error update( const std::string& data, boost::any& context ) const override;
-            error digest( std::string& messageDigest, boost::any& context ) const override;
+            error init( hash_context& context ) const override;
+            error update( const unsigned char* data, std::size_t size, hash_context& context ) const override;
+            error digest( std::string& messageDigest, hash_context& context ) const override;
             bool isChecksum( const std::string& ) const override;
 
     };
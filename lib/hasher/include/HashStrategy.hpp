@@ -2,22 +2,61 @@
 #define _HASH_STRATEGY_HPP_
 
 #include <irods_error.hpp>
+
+#include <openssl/evp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <boost/any.hpp>
 
 namespace irods {
 
+    // Holds the state of a single hash computation.
+    //
+    // The members used depend on the strategy which initialized the context.
+    // Strategies backed by OpenSSL use the EVP digest context. All other members
+    // are used by strategies which are implemented directly.
+    struct hash_context {
+        struct evp_md_ctx_deleter {
+            void operator()( EVP_MD_CTX* _ctx ) const noexcept {
+                EVP_MD_CTX_free( _ctx );
+            }
+        };
+
+        std::unique_ptr<EVP_MD_CTX, evp_md_ctx_deleter> evp;
+        std::uint32_t checksum_a{};
+        std::uint32_t checksum_b{};
+    };
+
     class HashStrategy {
         public:
 
             virtual ~HashStrategy() {};
 
             virtual std::string name() const = 0;
-            virtual error init( boost::any& context ) const = 0;
-            virtual error update( const std::string&, boost::any& context ) const = 0;
-            virtual error digest( std::string& messageDigest, boost::any& context ) const = 0;
+            virtual error init( hash_context& context ) const = 0;
+            virtual error update( const unsigned char* data, std::size_t size, hash_context& context ) const = 0;
+            virtual error digest( std::string& messageDigest, hash_context& context ) const = 0;
             virtual bool isChecksum( const std::string& ) const = 0;
     };
+
+    // Base class for strategies whose digest is computed by an OpenSSL EVP message digest.
+    class EVPHashStrategy : public HashStrategy {
+        public:
+
+            error init( hash_context& context ) const override;
+            error update( const unsigned char* data, std::size_t size, hash_context& context ) const override;
+
+        protected:
+
+            // Returns the OpenSSL message digest implementing the strategy.
+            virtual const EVP_MD* message_digest() const = 0;
+
+            // Writes the raw digest into _buffer (at least EVP_MAX_MD_SIZE bytes) and
+            // stores the number of bytes written in _size.
+            error finalize( unsigned char* _buffer, unsigned int& _size, hash_context& context ) const;
+    };
 } // namespace irods
 
 #endif // _HASH_STRATEGY_HPP_
@@ -4,8 +4,9 @@
 #include "HashStrategy.hpp"
 #include "irods_error.hpp"
 
+#include <cstddef>
 #include <string>
-#include <boost/any.hpp>
+#include <string_view>
 
 namespace irods {
 
@@ -17,12 +18,19 @@ namespace irods {
             Hasher() : _strategy( NULL ) {}
 
             error init( const HashStrategy* );
-            error update( const std::string& );
+
+            // Hashes _size bytes starting at _data. The bytes are not copied.
+            error update( const char* _data, std::size_t _size );
+
+            error update( std::string_view _data ) {
+                return update( _data.data(), _data.size() );
+            }
+
             error digest( std::string& messageDigest );
 
         private:
             const HashStrategy* _strategy;
-            boost::any          _context;
+            hash_context        _context;
             error               _stored_error;
             std::string         _stored_digest;
     };
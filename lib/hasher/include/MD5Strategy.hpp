@@ -5,7 +5,7 @@
 
 namespace irods {
     extern const std::string MD5_NAME;
-    class MD5Strategy : public HashStrategy {
+    class MD5Strategy : public EVPHashStrategy {
         public:
             MD5Strategy() {};
             virtual ~MD5Strategy() {};
@@ -13,11 +13,12 @@ namespace irods {
             std::string name() const override {
                 return MD5_NAME;
             }
-            error init( boost::any& context ) const override;
-            error update( const std::string&, boost::any& context ) const override;
-            error digest( std::string& messageDigest, boost::any& context ) const override;
+            error digest( std::string& messageDigest, hash_context& context ) const override;
             bool isChecksum( const std::string& ) const override;
 
+        protected:
+            const EVP_MD* message_digest() const override;
+
     };
 } // namespace irods
 
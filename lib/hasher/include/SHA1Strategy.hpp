@@ -5,7 +5,7 @@
 
 namespace irods {
     extern const std::string SHA1_NAME;
-    class SHA1Strategy : public HashStrategy {
+    class SHA1Strategy : public EVPHashStrategy {
         public:
             SHA1Strategy() {};
             virtual ~SHA1Strategy() {};
@@ -13,11 +13,12 @@ namespace irods {
             std::string name() const override {
                 return SHA1_NAME;
             }
-            error init( boost::any& context ) const override;
-            error update( const std::string& data, boost::any& context ) const override;
-            error digest( std::string& messageDigest, boost::any& context ) const override;
+            error digest( std::string& messageDigest, hash_context& context ) const override;
             bool isChecksum( const std::string& ) const override;
 
+        protected:
+            const EVP_MD* message_digest() const override;
+
     };
 } // namespace irods
 
@@ -5,7 +5,7 @@
 
 namespace irods {
     extern const std::string SHA256_NAME;
-    class SHA256Strategy : public HashStrategy {
+    class SHA256Strategy : public EVPHashStrategy {
         public:
             SHA256Strategy() {};
             virtual ~SHA256Strategy() {};
@@ -13,11 +13,12 @@ namespace irods {
             virtual std::string name() const override {
                 return SHA256_NAME;
             }
-            error init( boost::any& context ) const override;
-            error update( const std::string& data, boost::any& context ) const override;
-            error digest( std::string& messageDigest, boost::any& context ) const override;
+            error digest( std::string& messageDigest, hash_context& context ) const override;
             bool isChecksum( const std::string& ) const override;
 
+        protected:
+            const EVP_MD* message_digest() const override;
+
     };
 } // namespace irods
 
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include <cstring>
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -26,13 +27,28 @@ namespace irods {
 
         const uint32_t MOD_ADLER = 65521;
 
+        // The largest number of bytes which can be summed before b can overflow
+        // 32 bits. Deferring the modulo to the end of each block keeps the inner
+        // loop free of divisions.
+        const size_t MAX_BLOCK_SIZE = 5552;
+
         uint32_t a = parts.a, b = parts.b;
 
-        // Process each byte of the data in order
-        for (size_t index = 0; index < len; ++index)
-        {
-            a = (a + data[index]) % MOD_ADLER;
-            b = (b + a) % MOD_ADLER;
+        while (len > 0) {
+            const size_t block_size = std::min(len, MAX_BLOCK_SIZE);
+
+            // Process each byte of the block in order
+            for (size_t index = 0; index < block_size; ++index)
+            {
+                a += data[index];
+                b += a;
+            }
+
+            a %= MOD_ADLER;
+            b %= MOD_ADLER;
+
+            data += block_size;
+            len -= block_size;
         }
 
         return adler32_parts{a, b};
@@ -44,24 +60,28 @@ namespace irods {
 
 
     error
-    ADLER32Strategy::init( boost::any& _context ) const {
-        _context = adler32_init();
+    ADLER32Strategy::init( hash_context& _context ) const {
+        const auto parts = adler32_init();
+        _context.checksum_a = parts.a;
+        _context.checksum_b = parts.b;
         return SUCCESS();
     }
 
     error
-    ADLER32Strategy::update( const std::string& data, boost::any& _context ) const {
+    ADLER32Strategy::update( const unsigned char* data, std::size_t size, hash_context& _context ) const {
 
-        _context = adler32_update(boost::any_cast<adler32_parts>(_context), reinterpret_cast<const unsigned char*>(data.c_str()), data.size());
+        const auto parts = adler32_update(adler32_parts{_context.checksum_a, _context.checksum_b}, data, size);
+        _context.checksum_a = parts.a;
+        _context.checksum_b = parts.b;
         return SUCCESS();
     }
 
     error
-    ADLER32Strategy::digest( std::string& _messageDigest, boost::any& _context ) const {
+    ADLER32Strategy::digest( std::string& _messageDigest, hash_context& _context ) const {
 
         const unsigned int ADLER32_DIGEST_LENGTH = 4;
 
-        uint32_t result = adler32_final(boost::any_cast<adler32_parts>(_context));
+        uint32_t result = adler32_final(adler32_parts{_context.checksum_a, _context.checksum_b});
 
         std::stringstream ss;
         ss << std::setfill('0') << std::hex << std::setw(ADLER32_DIGEST_LENGTH * 2) << result;
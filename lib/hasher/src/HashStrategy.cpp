@@ -0,0 +1,41 @@
+#include "HashStrategy.hpp"
+
+#include "rodsErrorTable.h"
+
+namespace irods {
+
+    error
+    EVPHashStrategy::init( hash_context& _context ) const {
+        if ( !_context.evp ) {
+            _context.evp.reset( EVP_MD_CTX_new() );
+
+            if ( !_context.evp ) {
+                return ERROR( SYS_MALLOC_ERR, "Could not allocate digest context" );
+            }
+        }
+
+        if ( !EVP_DigestInit_ex( _context.evp.get(), message_digest(), nullptr ) ) {
+            return ERROR( SYS_INTERNAL_ERR, "Could not initialize digest context for [" + name() + "]" );
+        }
+
+        return SUCCESS();
+    }
+
+    error
+    EVPHashStrategy::update( const unsigned char* _data, std::size_t _size, hash_context& _context ) const {
+        if ( !EVP_DigestUpdate( _context.evp.get(), _data, _size ) ) {
+            return ERROR( SYS_INTERNAL_ERR, "Could not update digest for [" + name() + "]" );
+        }
+
+        return SUCCESS();
+    }
+
+    error
+    EVPHashStrategy::finalize( unsigned char* _buffer, unsigned int& _size, hash_context& _context ) const {
+        if ( !EVP_DigestFinal_ex( _context.evp.get(), _buffer, &_size ) ) {
+            return ERROR( SYS_INTERNAL_ERR, "Could not finalize digest for [" + name() + "]" );
+        }
+
+        return SUCCESS();
+    }
+}; // namespace irods
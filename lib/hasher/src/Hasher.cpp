@@ -19,14 +19,14 @@ namespace irods {
     }
 
     error
-    Hasher::update( const std::string& _data ) {
+    Hasher::update( const char* _data, std::size_t _size ) {
         if ( NULL == _strategy ) {
             return ERROR( SYS_UNINITIALIZED, "Update called on a hasher that has not been initialized" );
         }
         if ( !_stored_digest.empty() ) {
             return ERROR( SYS_HASH_IMMUTABLE, "Update called on a hasher that has already generated a digest" );
         }
-        error ret = _strategy->update( _data, _context );
+        error ret = _strategy->update( reinterpret_cast<const unsigned char*>( _data ), _size, _context );
 
         return PASS( ret );
     }
@@ -5,32 +5,27 @@
 #include <iomanip>
 
 #include <cstring>
-#include <openssl/md5.h>
+#include <openssl/evp.h>
 #include "irods_stacktrace.hpp"
 
 namespace irods {
 
     const std::string MD5_NAME( "md5" );
 
-    error
-    MD5Strategy::init( boost::any& _context ) const {
-        _context = MD5_CTX();
-        MD5_Init( boost::any_cast<MD5_CTX>( &_context ) );
-        return SUCCESS();
+    const EVP_MD*
+    MD5Strategy::message_digest() const {
+        return EVP_md5();
     }
 
     error
-    MD5Strategy::update( const std::string& data, boost::any& _context ) const {
-        MD5_Update( boost::any_cast<MD5_CTX>( &_context ), ( const unsigned char * )data.c_str(), data.size() );
-        return SUCCESS();
-    }
-
-    error
-    MD5Strategy::digest( std::string& messageDigest, boost::any& _context ) const {
-        unsigned char buffer[17];
-        MD5_Final( buffer, boost::any_cast<MD5_CTX>( &_context ) );
+    MD5Strategy::digest( std::string& messageDigest, hash_context& _context ) const {
+        unsigned char buffer[EVP_MAX_MD_SIZE];
+        unsigned int size = 0;
+        if ( error ret = finalize( buffer, size, _context ); !ret.ok() ) {
+            return PASS( ret );
+        }
         std::stringstream ins;
-        for ( int i = 0; i < 16; ++i ) {
+        for ( unsigned int i = 0; i < size; ++i ) {
             ins << std::setfill( '0' ) << std::setw( 2 ) << std::hex << ( int )buffer[i];
         }
         messageDigest = ins.str();
@@ -6,7 +6,7 @@
 #include <iomanip>
 #include <cstring>
 #include <boost/algorithm/string/predicate.hpp>
-#include <openssl/sha.h>
+#include <openssl/evp.h>
 
 #include "base64.h"
 
@@ -14,28 +14,23 @@ namespace irods {
 
     const std::string SHA1_NAME( "sha1" );
 
-    error
-    SHA1Strategy::init( boost::any& _context ) const {
-        _context = SHA_CTX();
-        SHA1_Init( boost::any_cast<SHA_CTX>( &_context ) );
-        return SUCCESS();
-    }
-
-    error
-    SHA1Strategy::update( const std::string& data, boost::any& _context ) const {
-        SHA1_Update( boost::any_cast<SHA_CTX>( &_context ), data.c_str(), data.size() );
-        return SUCCESS();
+    const EVP_MD*
+    SHA1Strategy::message_digest() const {
+        return EVP_sha1();
     }
 
     error
-    SHA1Strategy::digest( std::string& _messageDigest, boost::any& _context ) const {
-        unsigned char final_buffer[SHA_DIGEST_LENGTH];
-        SHA1_Final( final_buffer, boost::any_cast<SHA_CTX>( &_context ) );
+    SHA1Strategy::digest( std::string& _messageDigest, hash_context& _context ) const {
+        unsigned char final_buffer[EVP_MAX_MD_SIZE];
+        unsigned int final_size = 0;
+        if ( error ret = finalize( final_buffer, final_size, _context ); !ret.ok() ) {
+            return PASS( ret );
+        }
         int len = strlen( SHA1_CHKSUM_PREFIX );
         unsigned long out_len = CHKSUM_LEN - len;
 
         unsigned char out_buffer[CHKSUM_LEN];
-        base64_encode( final_buffer, SHA_DIGEST_LENGTH, out_buffer, &out_len );
+        base64_encode( final_buffer, final_size, out_buffer, &out_len );
 
         _messageDigest = SHA1_CHKSUM_PREFIX;
         _messageDigest += std::string( ( char* )out_buffer, out_len );
@@ -6,7 +6,7 @@
 #include <iomanip>
 #include <cstring>
 #include <boost/algorithm/string/predicate.hpp>
-#include <openssl/sha.h>
+#include <openssl/evp.h>
 
 #include "base64.h"
 
@@ -14,28 +14,23 @@ namespace irods {
 
     const std::string SHA512_NAME( "sha512" );
 
-    error
-    SHA512Strategy::init( boost::any& _context ) const {
-        _context = SHA512_CTX();
-        SHA512_Init( boost::any_cast<SHA512_CTX>( &_context ) );
-        return SUCCESS();
-    }
-
-    error
-    SHA512Strategy::update( const std::string& data, boost::any& _context ) const {
-        SHA512_Update( boost::any_cast<SHA512_CTX>( &_context ), data.c_str(), data.size() );
-        return SUCCESS();
+    const EVP_MD*
+    SHA512Strategy::message_digest() const {
+        return EVP_sha512();
     }
 
     error
-    SHA512Strategy::digest( std::string& _messageDigest, boost::any& _context ) const {
-        unsigned char final_buffer[SHA512_DIGEST_LENGTH];
-        SHA512_Final( final_buffer, boost::any_cast<SHA512_CTX>( &_context ) );
+    SHA512Strategy::digest( std::string& _messageDigest, hash_context& _context ) const {
+        unsigned char final_buffer[EVP_MAX_MD_SIZE];
+        unsigned int final_size = 0;
+        if ( error ret = finalize( final_buffer, final_size, _context ); !ret.ok() ) {
+            return PASS( ret );
+        }
         int len = strlen( SHA512_CHKSUM_PREFIX );
         unsigned long out_len = CHKSUM_LEN * 2 - len;
 
         unsigned char out_buffer[CHKSUM_LEN * 2];
-        base64_encode( final_buffer, SHA512_DIGEST_LENGTH, out_buffer, &out_len );
+        base64_encode( final_buffer, final_size, out_buffer, &out_len );
 
         _messageDigest = SHA512_CHKSUM_PREFIX;
         _messageDigest += std::string( ( char* )out_buffer, out_len );
@@ -149,8 +149,7 @@ int chksumLocFile(
 
     if ( in_file.eof() ) {
         if ( in_file.gcount() > 0 ) {
-            buffer_read.resize( in_file.gcount() );
-            hasher.update( buffer_read );
+            hasher.update( buffer_read.data(), in_file.gcount() );
         }
     } else {
         status = UNIX_FILE_READ_ERR - errno;
@@ -323,7 +323,7 @@ namespace
             return ec;
         }
 
-        if (l1desc_index < 3 || l1desc_index >= NUM_L1_DESC) {
+        if (!L1desc.in_range(l1desc_index)) {
             log::api::error("L1 descriptor index is out of range [error_code={}, fd={}].", BAD_INPUT_DESC_INDEX, l1desc_index);
             return BAD_INPUT_DESC_INDEX;
         }
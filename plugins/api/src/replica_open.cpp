@@ -18,6 +18,7 @@
 //
 
 #include "objDesc.hpp"
+#include "rsGlobalExtern.hpp"
 #include "irods_stacktrace.hpp"
 #include "irods_server_api_call.hpp"
 #include "irods_re_serialization.hpp"
@@ -34,8 +35,6 @@
 
 #include <string>
 
-extern l1desc_t L1desc[NUM_L1_DESC];
-
 namespace
 {
     using log = irods::experimental::log;
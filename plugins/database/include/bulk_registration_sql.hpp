@@ -0,0 +1,162 @@
+#ifndef IRODS_BULK_REGISTRATION_SQL_HPP
+#define IRODS_BULK_REGISTRATION_SQL_HPP
+
+/// \file
+///
+/// SQL used by the database plugin to register a batch of data objects with multi-row
+/// statements (chlBulkRegDataObj).
+
+#include "rodsType.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace irods::experimental::bulk_registration
+{
+#ifdef ORA_ICAT
+    /// Oracle does not support multi-row VALUES lists.
+    inline constexpr int rows_per_statement = 1;
+#else
+    inline constexpr int rows_per_statement = 100;
+#endif
+
+    /// Calls \p _func with the offset and size of each consecutive chunk of at most
+    /// \p _chunk_size rows out of \p _count.
+    ///
+    /// \return The first non-zero value returned by \p _func, or zero.
+    template <typename Function>
+    auto for_each_chunk(int _count, int _chunk_size, Function _func) -> int
+    {
+        for (int offset = 0; offset < _count; offset += _chunk_size) {
+            if (const int ec = _func(offset, std::min(_chunk_size, _count - offset)); ec != 0) {
+                return ec;
+            }
+        }
+
+        return 0;
+    }
+
+    /// Returns \p _rows comma-separated groups of \p _columns placeholders, e.g. "(?, ?), (?, ?)".
+    inline auto values_list(int _rows, int _columns) -> std::string
+    {
+        std::string row = "(";
+        for (int i = 0; i < _columns; ++i) {
+            row += (i == 0) ? "?" : ", ?";
+        }
+        row += ")";
+
+        std::string sql;
+        for (int i = 0; i < _rows; ++i) {
+            if (i > 0) {
+                sql += ", ";
+            }
+            sql += row;
+        }
+
+        return sql;
+    }
+
+    /// Returns a comma-separated list of \p _count placeholders, e.g. "?, ?, ?".
+    inline auto placeholder_list(int _count) -> std::string
+    {
+        std::string sql;
+        for (int i = 0; i < _count; ++i) {
+            sql += (i == 0) ? "?" : ", ?";
+        }
+
+        return sql;
+    }
+
+    /// Returns the query which reserves \p _count values of a sequence.
+    ///
+    /// \param[in] _next_value The expression which yields the next value of the sequence
+    ///                        (see cllNextValueString).
+    inline auto reserve_sequence_values_sql(const std::string& _next_value, int _count) -> std::string
+    {
+#ifdef ORA_ICAT
+        return "select " + _next_value + " from DUAL connect by level <= " + std::to_string(_count);
+#else
+        return "select " + _next_value + " from generate_series(1, " + std::to_string(_count) + ")";
+#endif
+    }
+
+    /// Converts the values returned by reserve_sequence_values_sql() into ids.
+    ///
+    /// \param[in]  _strings The values, each in a slot of \p _width characters.
+    /// \param[in]  _width   The size of each slot.
+    /// \param[in]  _count   The number of values which were reserved.
+    /// \param[out] _values  Receives one id per value.
+    ///
+    /// \return false if a value is not a positive integer or is returned more than once.
+    inline auto parse_sequence_values(const char* _strings,
+                                      int _width,
+                                      int _count,
+                                      std::vector<rodsLong_t>& _values) -> bool
+    {
+        _values.clear();
+        _values.reserve(_count);
+
+        std::set<rodsLong_t> seen;
+
+        for (int i = 0; i < _count; ++i) {
+            const char* str = &_strings[i * _width];
+            char* end{};
+            const rodsLong_t value = std::strtoll(str, &end, 10);
+
+            if (end == str || *end != '\0' || value <= 0 || !seen.insert(value).second) {
+                _values.clear();
+                return false;
+            }
+
+            _values.push_back(value);
+        }
+
+        return true;
+    }
+
+    /// Returns the query which finds collections named like any of \p _rows logical paths.
+    inline auto find_collections_sql(int _rows) -> std::string
+    {
+        return "select coll_name from R_COLL_MAIN where coll_name in (" + placeholder_list(_rows) + ")";
+    }
+
+    /// The number of values bound per row by insert_data_objects_sql().
+    inline constexpr int data_object_columns = 20;
+
+    /// Returns the statement which inserts \p _rows rows into R_DATA_MAIN.
+    inline auto insert_data_objects_sql(int _rows) -> std::string
+    {
+        return "insert into R_DATA_MAIN (data_id, coll_id, data_name, data_repl_num, data_version, "
+               "data_type_name, data_size, resc_id, data_path, data_owner_name, data_owner_zone, "
+               "data_is_dirty, data_checksum, data_mode, create_ts, modify_ts, data_expiry_ts, "
+               "resc_name, resc_hier, resc_group_name) values " +
+               values_list(_rows, data_object_columns);
+    }
+
+    /// The number of values bound per row by insert_owner_access_sql().
+    inline constexpr int access_columns = 5;
+
+    /// Returns the statement which inserts \p _rows rows into R_OBJT_ACCESS.
+    inline auto insert_owner_access_sql(int _rows) -> std::string
+    {
+        return "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts) values " +
+               values_list(_rows, access_columns);
+    }
+
+    /// Returns the statement which copies the access rows of the parent collection of each of
+    /// \p _rows data objects to the data object.
+    ///
+    /// The create and modify times are bound first, followed by the \p _rows data ids.
+    inline auto insert_inherited_access_sql(int _rows) -> std::string
+    {
+        return "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts) "
+               "(select d.data_id, a.user_id, a.access_type_id, ?, ? from R_DATA_MAIN d, R_OBJT_ACCESS a "
+               "where a.object_id = d.coll_id and d.data_id in (" +
+               placeholder_list(_rows) + "))";
+    }
+} // namespace irods::experimental::bulk_registration
+
+#endif // IRODS_BULK_REGISTRATION_SQL_HPP
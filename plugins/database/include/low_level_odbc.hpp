@@ -16,6 +16,8 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstddef>
 
 #define MAX_BIND_VARS 32000
 
@@ -38,4 +40,17 @@ int cllGetRowCount( icatSessionStruct *icss, int statementNumber );
 int cllCheckPending( const char *sql, int option, int dbType );
 int cllGetLastErrorMessage( char *msg, int maxChars );
 
+/*
+  Counters for the per-connection cache of prepared statements.
+*/
+typedef struct {
+    std::uint64_t hits;       /* statements executed from an existing prepared handle */
+    std::uint64_t misses;     /* statements that had to be prepared or executed directly */
+    std::uint64_t evictions;  /* prepared handles freed to make room for others */
+    std::size_t   size;       /* prepared handles currently held */
+    std::size_t   capacity;   /* maximum number of prepared handles held */
+} cllStatementCacheStats;
+
+int cllGetStatementCacheStats( icatSessionStruct *icss, cllStatementCacheStats *stats );
+
 #endif	/* CLL_ODBC_HPP */
@@ -143,6 +143,8 @@ int cmlGetOneRowFromSql( const char *sql,
 
 rodsLong_t cmlGetNextSeqVal( icatSessionStruct *icss );
 
+int cmlGetNextSeqVals( int count, std::vector<rodsLong_t>& values, icatSessionStruct *icss );
+
 rodsLong_t cmlGetCurrentSeqVal( icatSessionStruct *icss );
 
 int cmlGetNextSeqStr( char *seqStr, int maxSeqStrLen, icatSessionStruct *icss );
@@ -0,0 +1,228 @@
+#ifndef IRODS_PREPARED_STATEMENT_CACHE_HPP
+#define IRODS_PREPARED_STATEMENT_CACHE_HPP
+
+/// \file
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace irods::experimental
+{
+    /// Caches prepared statement handles for a single database connection, keyed on the SQL text.
+    ///
+    /// A statement is only prepared the second time its SQL text is seen, so SQL which carries
+    /// literal values and runs once does not displace statements that are reused. The least
+    /// recently used handle that is not being executed is evicted first.
+    ///
+    /// The cache lives as long as the connection. clear() must be called before the connection
+    /// is closed, because the handles cannot outlive it.
+    ///
+    /// \tparam Statements Performs the database operations. It provides the types
+    ///                    \p connection_type and \p handle_type, and the functions:
+    ///                    - prepare(connection, sql): returns a prepared handle, or a
+    ///                      value-initialized handle on failure.
+    ///                    - reset(handle): readies a handle for its next execution.
+    ///                    - free(handle): releases a handle.
+    ///
+    /// \since 4.3.0
+    template <typename Statements>
+    class prepared_statement_cache
+    {
+    public:
+        using connection_type = typename Statements::connection_type;
+        using handle_type = typename Statements::handle_type;
+
+        struct stats_type
+        {
+            std::uint64_t hits;      ///< Executions which reused a prepared handle.
+            std::uint64_t misses;    ///< Executions which had to prepare or execute directly.
+            std::uint64_t evictions; ///< Prepared handles freed to make room for others.
+            std::size_t size;        ///< Prepared handles currently held.
+            std::size_t capacity;    ///< Maximum number of prepared handles held.
+        }; // struct stats_type
+
+        explicit prepared_statement_cache(std::size_t _capacity, Statements _statements = {})
+            : capacity_{_capacity}
+            , statements_{std::move(_statements)}
+        {
+        }
+
+        prepared_statement_cache(const prepared_statement_cache&) = delete;
+        auto operator=(const prepared_statement_cache&) -> prepared_statement_cache& = delete;
+
+        /// Returns a prepared handle for \p _sql.
+        ///
+        /// \return A handle owned by the cache, or a value-initialized handle if the caller
+        ///         must allocate its own handle and execute \p _sql directly.
+        auto acquire(connection_type _connection, const char* _sql) -> handle_type
+        {
+            if (0 == capacity_) {
+                ++stats_.misses;
+                return {};
+            }
+
+            if (auto iter = by_sql_.find(_sql); iter != std::end(by_sql_)) {
+                auto& e = *iter->second;
+
+                // The same SQL text can be open twice (e.g. nested queries). Only one
+                // of them gets the cached handle.
+                if (e.in_use) {
+                    ++stats_.misses;
+                    return {};
+                }
+
+                ++stats_.hits;
+                e.in_use = true;
+                entries_.splice(std::begin(entries_), entries_, iter->second);
+
+                return e.handle;
+            }
+
+            ++stats_.misses;
+
+            if (!forget_seen(_sql)) {
+                remember_seen(_sql);
+                return {};
+            }
+
+            const handle_type handle = statements_.prepare(_connection, _sql);
+            if (handle == handle_type{}) {
+                return {};
+            }
+
+            evict(capacity_ - 1);
+
+            entries_.push_front(entry{_sql, handle, true, false});
+            by_sql_.emplace(entries_.front().sql, std::begin(entries_));
+            by_handle_.emplace(handle, std::begin(entries_));
+
+            return handle;
+        }
+
+        /// Hands back a handle returned by acquire().
+        ///
+        /// \return true if \p _handle is owned by the cache, in which case the cache resets or
+        ///         frees it. Otherwise, the caller remains responsible for it.
+        auto release(handle_type _handle) -> bool
+        {
+            auto iter = by_handle_.find(_handle);
+            if (iter == std::end(by_handle_)) {
+                return false;
+            }
+
+            auto& e = *iter->second;
+            e.in_use = false;
+
+            if (e.discard) {
+                erase(iter->second);
+                return true;
+            }
+
+            statements_.reset(_handle);
+
+            return true;
+        }
+
+        /// Makes sure a handle whose execution failed is not reused.
+        auto discard(handle_type _handle) -> void
+        {
+            if (auto iter = by_handle_.find(_handle); iter != std::end(by_handle_)) {
+                iter->second->discard = true;
+            }
+        }
+
+        /// Frees every handle, including those being executed, and forgets every SQL text.
+        auto clear() -> void
+        {
+            while (!entries_.empty()) {
+                erase(std::begin(entries_));
+            }
+
+            seen_by_sql_.clear();
+            seen_.clear();
+        }
+
+        auto stats() const -> stats_type
+        {
+            auto s = stats_;
+            s.size = entries_.size();
+            s.capacity = capacity_;
+            return s;
+        }
+
+    private:
+        struct entry
+        {
+            std::string sql;
+            handle_type handle;
+            bool in_use;
+            bool discard;
+        }; // struct entry
+
+        auto evict(std::size_t _max_size) -> void
+        {
+            for (auto iter = std::rbegin(entries_); entries_.size() > _max_size && iter != std::rend(entries_);) {
+                if (iter->in_use) {
+                    ++iter;
+                    continue;
+                }
+
+                ++stats_.evictions;
+                iter = std::make_reverse_iterator(erase(std::prev(iter.base())));
+            }
+        }
+
+        auto erase(typename std::list<entry>::iterator _iter) -> typename std::list<entry>::iterator
+        {
+            by_sql_.erase(_iter->sql);
+            by_handle_.erase(_iter->handle);
+            statements_.free(_iter->handle);
+
+            return entries_.erase(_iter);
+        }
+
+        // Records SQL text which has been executed once. Holds at most as many texts as the
+        // cache holds handles, dropping the oldest first.
+        auto remember_seen(const char* _sql) -> void
+        {
+            if (seen_.size() == capacity_) {
+                seen_by_sql_.erase(seen_.back());
+                seen_.pop_back();
+            }
+
+            seen_.emplace_front(_sql);
+            seen_by_sql_.emplace(seen_.front(), std::begin(seen_));
+        }
+
+        // Returns whether _sql had been executed once before.
+        auto forget_seen(const char* _sql) -> bool
+        {
+            auto iter = seen_by_sql_.find(_sql);
+            if (iter == std::end(seen_by_sql_)) {
+                return false;
+            }
+
+            seen_.erase(iter->second);
+            seen_by_sql_.erase(iter);
+
+            return true;
+        }
+
+        std::size_t capacity_;
+        Statements statements_;
+        std::list<entry> entries_;
+        std::unordered_map<std::string_view, typename std::list<entry>::iterator> by_sql_;
+        std::unordered_map<handle_type, typename std::list<entry>::iterator> by_handle_;
+        std::list<std::string> seen_;
+        std::unordered_map<std::string_view, std::list<std::string>::iterator> seen_by_sql_;
+        stats_type stats_{};
+    }; // class prepared_statement_cache
+} // namespace irods::experimental
+
+#endif // IRODS_PREPARED_STATEMENT_CACHE_HPP
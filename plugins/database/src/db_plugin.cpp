@@ -33,6 +33,7 @@
 #include "modAccessControl.h"
 #include "checksum.h"
 #include "key_value_proxy.hpp"
+#include "bulk_registration_sql.hpp"
 
 // =-=-=-=-=-=-=-
 // irods includes
@@ -49,6 +50,9 @@
 #include <string_view>
 #include <iostream>
 #include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
 #include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -2803,6 +2807,312 @@ irods::error db_reg_data_obj_op(
 
 } // db_reg_data_obj_op
 
+// =-=-=-=-=-=-=-
+// register a batch of new data objects into the catalog within one transaction.
+// object ids are reserved in a single query and the rows of R_DATA_MAIN and
+// R_OBJT_ACCESS are written with multi-row inserts.
+irods::error db_bulk_reg_data_obj_op(
+    irods::plugin_context& _ctx,
+    dataObjInfo_t*         _data_obj_infos,
+    int                    _count ) {
+    // =-=-=-=-=-=-=-
+    // check the context
+    irods::error ret = _ctx.valid();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
+    // =-=-=-=-=-=-=-
+    // check the params
+    if ( !_data_obj_infos || _count < 0 ) {
+        return ERROR(
+                   CAT_INVALID_ARGUMENT,
+                   "null parameter" );
+    }
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlBulkRegDataObj" );
+    }
+    if ( !icss.status ) {
+        return ERROR( CATALOG_NOT_CONNECTED, "catalog not connected" );
+    }
+
+    if ( 0 == _count ) {
+        return SUCCESS();
+    }
+
+    namespace bulk = irods::experimental::bulk_registration;
+
+    struct data_obj_row {
+        std::string data_id;
+        std::string coll_id;
+        std::string data_name;
+        std::string repl_num;
+        std::string data_size;
+        std::string repl_status;
+        std::string resc_id;
+        bool inherit;
+    };
+
+    const char* user_name = _ctx.comm()->clientUser.userName;
+    const char* user_zone = _ctx.comm()->clientUser.rodsZone;
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 1 " );
+    }
+    std::vector<rodsLong_t> seqNums;
+    int status = cmlGetNextSeqVals( _count, seqNums, &icss );
+    if ( status < 0 ) {
+        rodsLog( LOG_NOTICE, "chlBulkRegDataObj cmlGetNextSeqVals failure %d",
+                 status );
+        _rollback( "chlBulkRegDataObj" );
+        return ERROR( status, "chlBulkRegDataObj cmlGetNextSeqVals failure" );
+    }
+
+    char myTime[50];
+    getNowStr( myTime );
+
+    // parent collections and data types are usually shared by the whole batch,
+    // so each one is only checked once.
+    std::map<std::string, std::pair<rodsLong_t, int>> checked_colls;
+    std::set<std::string> checked_data_types;
+    std::vector<data_obj_row> rows( _count );
+    bool commit = true;
+
+    for ( int i = 0; i < _count; i++ ) {
+        dataObjInfo_t& info = _data_obj_infos[i];
+        data_obj_row& row = rows[i];
+
+        char logicalFileName[MAX_NAME_LEN];
+        char logicalDirName[MAX_NAME_LEN];
+        splitPathByKey( info.objPath, logicalDirName, MAX_NAME_LEN, logicalFileName, MAX_NAME_LEN, '/' );
+
+        auto coll = checked_colls.find( logicalDirName );
+        if ( coll == checked_colls.end() ) {
+            int inheritFlag = 0;
+            const rodsLong_t iVal = cmlCheckDirAndGetInheritFlag( logicalDirName,
+                                    user_name,
+                                    user_zone,
+                                    ACCESS_MODIFY_OBJECT,
+                                    &inheritFlag,
+                                    mySessionTicket,
+                                    mySessionClientAddr,
+                                    &icss );
+            if ( iVal < 0 ) {
+                if ( iVal == CAT_UNKNOWN_COLLECTION ) {
+                    std::stringstream errMsg;
+                    errMsg << "collection '" << logicalDirName << "' is unknown";
+                    addRErrorMsg( &_ctx.comm()->rError, 0, errMsg.str().c_str() );
+                }
+                else if ( iVal == CAT_NO_ACCESS_PERMISSION ) {
+                    std::stringstream errMsg;
+                    errMsg << "no permission to update collection '" << logicalDirName << "'";
+                    addRErrorMsg( &_ctx.comm()->rError, 0, errMsg.str().c_str() );
+                }
+                return ERROR( iVal, "" );
+            }
+            coll = checked_colls.emplace( logicalDirName, std::make_pair( iVal, inheritFlag ) ).first;
+        }
+
+        if ( checked_data_types.count( info.dataType ) == 0 ) {
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 2" );
+            }
+            if ( cmlCheckNameToken( "data_type", info.dataType, &icss ) != 0 ) {
+                return ERROR( CAT_INVALID_DATA_TYPE, "invalid data type" );
+            }
+            checked_data_types.insert( info.dataType );
+        }
+
+        info.dataId = seqNums[i];
+        info.collId = coll->second.first;
+
+        if ( 0 == strcmp( info.dataModify, "" ) ) {
+            strcpy( info.dataModify, myTime );
+        }
+        if ( 0 == strcmp( info.dataCreate, "" ) ) {
+            strcpy( info.dataCreate, myTime );
+        }
+        strcpy( info.dataExpiry, "00000000000" );
+
+        std::snprintf( info.dataOwnerName, sizeof( info.dataOwnerName ), "%s", user_name );
+        std::snprintf( info.dataOwnerZone, sizeof( info.dataOwnerZone ), "%s", user_zone );
+
+        row.data_id = std::to_string( info.dataId );
+        row.coll_id = std::to_string( info.collId );
+        row.data_name = logicalFileName;
+        row.repl_num = std::to_string( info.replNum );
+        row.data_size = std::to_string( info.dataSize );
+        row.repl_status = std::to_string( info.replStatus );
+        row.resc_id = std::to_string( info.rescId );
+        row.inherit = coll->second.second != 0;
+
+        if ( info.flags & NO_COMMIT_FLAG ) {
+            commit = false;
+        }
+    }
+
+    // make sure no collection already exists by any of these names
+    status = bulk::for_each_chunk( _count, bulk::rows_per_statement, [&]( int offset, int n ) {
+        std::vector<std::string> bindVars;
+        for ( int i = 0; i < n; i++ ) {
+            bindVars.push_back( _data_obj_infos[offset + i].objPath );
+        }
+
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 3" );
+        }
+        char collName[MAX_NAME_LEN];
+        const int ec = cmlGetMultiRowStringValuesFromSql( bulk::find_collections_sql( n ).c_str(),
+                       collName, MAX_NAME_LEN, 1, bindVars, &icss );
+        return ec > 0 ? CAT_NAME_EXISTS_AS_COLLECTION : 0;
+    } );
+    if ( status != 0 ) {
+        return ERROR( status, "collection exists" );
+    }
+
+    status = bulk::for_each_chunk( _count, bulk::rows_per_statement, [&]( int offset, int n ) {
+        cllBindVarCount = 0;
+        for ( int i = 0; i < n; i++ ) {
+            const dataObjInfo_t& info = _data_obj_infos[offset + i];
+            const data_obj_row& row = rows[offset + i];
+
+            cllBindVars[cllBindVarCount++] = row.data_id.c_str();
+            cllBindVars[cllBindVarCount++] = row.coll_id.c_str();
+            cllBindVars[cllBindVarCount++] = row.data_name.c_str();
+            cllBindVars[cllBindVarCount++] = row.repl_num.c_str();
+            cllBindVars[cllBindVarCount++] = info.version;
+            cllBindVars[cllBindVarCount++] = info.dataType;
+            cllBindVars[cllBindVarCount++] = row.data_size.c_str();
+            cllBindVars[cllBindVarCount++] = row.resc_id.c_str();
+            cllBindVars[cllBindVarCount++] = info.filePath;
+            cllBindVars[cllBindVarCount++] = info.dataOwnerName;
+            cllBindVars[cllBindVarCount++] = info.dataOwnerZone;
+            cllBindVars[cllBindVarCount++] = row.repl_status.c_str();
+            cllBindVars[cllBindVarCount++] = info.chksum;
+            cllBindVars[cllBindVarCount++] = info.dataMode;
+            cllBindVars[cllBindVarCount++] = info.dataCreate;
+            cllBindVars[cllBindVarCount++] = info.dataModify;
+            cllBindVars[cllBindVarCount++] = info.dataExpiry;
+            cllBindVars[cllBindVarCount++] = "EMPTY_RESC_NAME";
+            cllBindVars[cllBindVarCount++] = "EMPTY_RESC_HIER";
+            cllBindVars[cllBindVarCount++] = "EMPTY_RESC_GROUP_NAME";
+        }
+
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 4" );
+        }
+        return cmlExecuteNoAnswerSql( bulk::insert_data_objects_sql( n ).c_str(), &icss );
+    } );
+    if ( status != 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "chlBulkRegDataObj cmlExecuteNoAnswerSql failure %d", status );
+        _rollback( "chlBulkRegDataObj" );
+        return ERROR( status, "chlBulkRegDataObj cmlExecuteNoAnswerSql failure" );
+    }
+
+    // objects in collections with the inherit (sticky) bit get copies of the
+    // access rows of their parent collection, the others are owned by the client.
+    std::vector<const data_obj_row*> inheriting;
+    std::vector<const data_obj_row*> owned;
+    for ( const auto& row : rows ) {
+        ( row.inherit ? inheriting : owned ).push_back( &row );
+    }
+
+    status = bulk::for_each_chunk( static_cast<int>( inheriting.size() ), bulk::rows_per_statement, [&]( int offset, int n ) {
+        cllBindVars[0] = myTime;
+        cllBindVars[1] = myTime;
+        cllBindVarCount = 2;
+        for ( int i = 0; i < n; i++ ) {
+            cllBindVars[cllBindVarCount++] = inheriting[offset + i]->data_id.c_str();
+        }
+
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 5" );
+        }
+        return cmlExecuteNoAnswerSql( bulk::insert_inherited_access_sql( n ).c_str(), &icss );
+    } );
+    if ( status != 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "chlBulkRegDataObj cmlExecuteNoAnswerSql insert access failure %d",
+                 status );
+        _rollback( "chlBulkRegDataObj" );
+        return ERROR( status, "cmlExecuteNoAnswerSql insert access failure" );
+    }
+
+    if ( !owned.empty() ) {
+        rodsLong_t userId;
+        rodsLong_t accessTypeId;
+        {
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 6" );
+            }
+            std::vector<std::string> bindVars;
+            bindVars.push_back( user_name );
+            bindVars.push_back( user_zone );
+            status = cmlGetIntegerValueFromSql(
+                         "select user_id from R_USER_MAIN where user_name=? and zone_name=?",
+                         &userId, bindVars, &icss );
+        }
+        if ( status == 0 ) {
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 7" );
+            }
+            std::vector<std::string> bindVars;
+            bindVars.push_back( ACCESS_OWN );
+            status = cmlGetIntegerValueFromSql(
+                         "select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?",
+                         &accessTypeId, bindVars, &icss );
+        }
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlBulkRegDataObj cmlGetIntegerValueFromSql owner lookup failure %d",
+                     status );
+            _rollback( "chlBulkRegDataObj" );
+            return ERROR( status, "owner lookup failure" );
+        }
+
+        const std::string userIdNum = std::to_string( userId );
+        const std::string accessTypeIdNum = std::to_string( accessTypeId );
+
+        status = bulk::for_each_chunk( static_cast<int>( owned.size() ), bulk::rows_per_statement, [&]( int offset, int n ) {
+            cllBindVarCount = 0;
+            for ( int i = 0; i < n; i++ ) {
+                cllBindVars[cllBindVarCount++] = owned[offset + i]->data_id.c_str();
+                cllBindVars[cllBindVarCount++] = userIdNum.c_str();
+                cllBindVars[cllBindVarCount++] = accessTypeIdNum.c_str();
+                cllBindVars[cllBindVarCount++] = myTime;
+                cllBindVars[cllBindVarCount++] = myTime;
+            }
+
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlBulkRegDataObj SQL 8" );
+            }
+            return cmlExecuteNoAnswerSql( bulk::insert_owner_access_sql( n ).c_str(), &icss );
+        } );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlBulkRegDataObj cmlExecuteNoAnswerSql insert access failure %d",
+                     status );
+            _rollback( "chlBulkRegDataObj" );
+            return ERROR( status, "cmlExecuteNoAnswerSql insert access failure" );
+        }
+    }
+
+    if ( commit ) {
+        status =  cmlExecuteNoAnswerSql( "commit", &icss );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlBulkRegDataObj cmlExecuteNoAnswerSql commit failure %d",
+                     status );
+            return ERROR( status, "cmlExecuteNoAnswerSql commit failure" );
+        }
+    }
+
+    return SUCCESS();
+
+} // db_bulk_reg_data_obj_op
+
 
 // =-=-=-=-=-=-=-
 // register a data object into the catalog
@@ -13637,6 +13947,7 @@ irods::error db_get_repl_list_for_leaf_bundles_op(
     size_t                      _child_index,
     const std::vector<leaf_bundle_t>* _bundles,
     const std::string*          _invocation_timestamp,
+    rodsLong_t                  _after_data_id,
     dist_child_result_t*        _results ) {
 
     // =-=-=-=-=-=-=-
@@ -13686,8 +13997,10 @@ irods::error db_get_repl_list_for_leaf_bundles_op(
     }
     not_child_array.pop_back(); // trim last ','
 
+    // Results are ordered by data id and start after _after_data_id so that callers can page
+    // through them without visiting the same data objects again.
 #ifdef ORA_ICAT
-    const std::string query = (boost::format("select data_id from (select distinct data_id from R_DATA_MAIN where data_id in (select data_id from R_DATA_MAIN where resc_id in (%s)) and data_id not in (select data_id from R_DATA_MAIN where resc_id in (%s)) and modify_ts <= '%s') where rownum <= %d") % not_child_array % child_array % _invocation_timestamp->c_str() % _count).str();
+    const std::string query = (boost::format("select data_id from (select distinct data_id from R_DATA_MAIN where data_id in (select data_id from R_DATA_MAIN where resc_id in (%s)) and data_id not in (select data_id from R_DATA_MAIN where resc_id in (%s)) and modify_ts <= '%s' and data_id > %lld order by data_id) where rownum <= %d") % not_child_array % child_array % _invocation_timestamp->c_str() % _after_data_id % _count).str();
 #elif MY_ICAT
     /* MySQL (MariaDB doesn't get 'except' until v10.3)*/
     const std::string query = (boost::format(
@@ -13695,16 +14008,17 @@ irods::error db_get_repl_list_for_leaf_bundles_op(
         "  where resc_id in (%s) and data_id not in ( "
         "    select data_id from R_DATA_MAIN "
         "      where resc_id in (%s) "
-        "  ) and modify_ts <= '%s' limit %d") % not_child_array % child_array % _invocation_timestamp->c_str() % _count).str();
+        "  ) and modify_ts <= '%s' and data_id > %lld "
+        "order by data_id limit %d") % not_child_array % child_array % _invocation_timestamp->c_str() % _after_data_id % _count).str();
 #else
     /* Postgres */
     const std::string query = (boost::format(
         "select distinct data_id from R_DATA_MAIN "
-        "  where resc_id in (%s) and modify_ts <= '%s' "
+        "  where resc_id in (%s) and modify_ts <= '%s' and data_id > %lld "
         "except "
         "  select data_id from R_DATA_MAIN "
         "    where resc_id in (%s) "
-        "limit %d") % not_child_array % _invocation_timestamp->c_str() % child_array % _count).str();
+        "order by data_id limit %d") % not_child_array % _invocation_timestamp->c_str() % _after_data_id % child_array % _count).str();
 #endif
 
     _results->reserve(_count);
@@ -14860,6 +15174,10 @@ irods::database* plugin_factory(
         DATABASE_OP_REG_DATA_OBJ,
         function<error(plugin_context&,dataObjInfo_t*)>(
             db_reg_data_obj_op ) );
+    pg->add_operation<dataObjInfo_t*,int>(
+        DATABASE_OP_BULK_REG_DATA_OBJ,
+        function<error(plugin_context&,dataObjInfo_t*,int)>(
+            db_bulk_reg_data_obj_op ) );
     pg->add_operation<dataObjInfo_t*,dataObjInfo_t*,keyValPair_t*>(
         DATABASE_OP_REG_REPLICA,
         function<error(plugin_context&,dataObjInfo_t*,dataObjInfo_t*,keyValPair_t*)>(
@@ -15156,9 +15474,9 @@ irods::database* plugin_factory(
         DATABASE_OP_GET_DISTINCT_DATA_OBJS_MISSING_FROM_CHILD_GIVEN_PARENT,
         function<error(plugin_context&,const string*, const string*, int, dist_child_result_t*)>(
             db_get_distinct_data_objs_missing_from_child_given_parent_op ) );
-    pg->add_operation<rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,dist_child_result_t*>(
+    pg->add_operation<rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,rodsLong_t,dist_child_result_t*>(
         DATABASE_OP_GET_REPL_LIST_FOR_LEAF_BUNDLES,
-        function<error(plugin_context&,rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,dist_child_result_t*)>(
+        function<error(plugin_context&,rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,rodsLong_t,dist_child_result_t*)>(
             db_get_repl_list_for_leaf_bundles_op));
     pg->add_operation<const rodsLong_t>(
         DATABASE_OP_CHECK_PERMISSION_TO_MODIFY_DATA_OBJECT,
@@ -34,9 +34,11 @@
 #include "irods_error.hpp"
 #include "irods_stacktrace.hpp"
 #include "irods_server_properties.hpp"
+#include "prepared_statement_cache.hpp"
 
 #include <cctype>
 #include <string>
+#include <unordered_map>
 
 int _cllFreeStatementColumns( icatSessionStruct *icss, int statementNumber );
 
@@ -70,6 +72,7 @@ SQLINTEGER columnLength[MAX_TOKEN];  /* change me ! */
 #include <stdio.h>
 #include <pwd.h>
 #include <ctype.h>
+#include <strings.h>
 
 #include <vector>
 #include <string>
@@ -86,6 +89,134 @@ static int noResultRowCount = 0;
 static const short MAX_NUMBER_ICAT_COLUMS = 32;
 static SQLLEN resultDataSizeArray[ MAX_NUMBER_ICAT_COLUMS ];
 
+namespace
+{
+    const int default_prepared_statement_cache_size = 64;
+
+    // The ODBC operations behind the prepared statement cache.
+    struct odbc_statements
+    {
+        using connection_type = HDBC;
+        using handle_type = HSTMT;
+
+        HSTMT prepare( HDBC _hdbc, const char* _sql ) const
+        {
+            HSTMT hstmt;
+            if ( SQLAllocHandle( SQL_HANDLE_STMT, _hdbc, &hstmt ) != SQL_SUCCESS ) {
+                return nullptr;
+            }
+
+            if ( SQLPrepare( hstmt, ( unsigned char * )_sql, strlen( _sql ) ) != SQL_SUCCESS ) {
+                rodsLog( LOG_DEBUG, "prepared_statement_cache: SQLPrepare failed, executing directly. sql:%s", _sql );
+                SQLFreeHandle( SQL_HANDLE_STMT, hstmt );
+                return nullptr;
+            }
+
+            return hstmt;
+        }
+
+        void reset( HSTMT _hstmt ) const
+        {
+            SQLFreeStmt( _hstmt, SQL_CLOSE );
+            SQLFreeStmt( _hstmt, SQL_UNBIND );
+            SQLFreeStmt( _hstmt, SQL_RESET_PARAMS );
+        }
+
+        void free( HSTMT _hstmt ) const
+        {
+            if ( SQLFreeHandle( SQL_HANDLE_STMT, _hstmt ) != SQL_SUCCESS ) {
+                rodsLog( LOG_ERROR, "prepared_statement_cache: SQLFreeHandle for statement error" );
+            }
+        }
+    }; // struct odbc_statements
+
+    using prepared_statement_cache = irods::experimental::prepared_statement_cache<odbc_statements>;
+
+    std::unordered_map<HDBC, prepared_statement_cache> statement_caches;
+
+    int get_prepared_statement_cache_size()
+    {
+        try {
+            const int size = irods::get_advanced_setting<const int>( irods::CFG_DB_PREPARED_STATEMENT_CACHE_SIZE_KW );
+            if ( size >= 0 ) {
+                return size;
+            }
+            rodsLog( LOG_ERROR, "Invalid prepared statement cache size [size=%d].", size );
+        }
+        catch ( ... ) {
+            rodsLog( LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                     irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_DB_PREPARED_STATEMENT_CACHE_SIZE_KW.data() );
+        }
+
+        return default_prepared_statement_cache_size;
+    }
+
+    // Only plain DML/queries are prepared. Transaction control and session
+    // settings are always executed directly.
+    bool is_cacheable_statement( const char* _sql )
+    {
+        while ( isspace( *_sql ) ) {
+            ++_sql;
+        }
+
+        for ( const char* keyword : {"select", "insert", "update", "delete"} ) {
+            if ( strncasecmp( _sql, keyword, strlen( keyword ) ) == 0 ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Returns a statement handle for _sql. On return, _prepared indicates whether the
+    // handle came from the statement cache (execute with SQLExecute) or was freshly
+    // allocated (execute with SQLExecDirect).
+    SQLRETURN acquire_statement( HDBC _hdbc, const char* _sql, HSTMT& _hstmt, bool& _prepared )
+    {
+        _prepared = false;
+
+        if ( is_cacheable_statement( _sql ) ) {
+            if ( auto iter = statement_caches.find( _hdbc ); iter != std::end( statement_caches ) ) {
+                if ( HSTMT hstmt = iter->second.acquire( _hdbc, _sql ); hstmt ) {
+                    _hstmt = hstmt;
+                    _prepared = true;
+                    return SQL_SUCCESS;
+                }
+            }
+        }
+
+        return SQLAllocHandle( SQL_HANDLE_STMT, _hdbc, &_hstmt );
+    }
+
+    SQLRETURN execute_statement( HSTMT _hstmt, const char* _sql, bool _prepared )
+    {
+        if ( _prepared ) {
+            return SQLExecute( _hstmt );
+        }
+
+        return SQLExecDirect( _hstmt, ( unsigned char * )_sql, strlen( _sql ) );
+    }
+
+    // Hands a statement handle back to the cache, or frees it if the cache does not own it.
+    SQLRETURN release_statement( HDBC _hdbc, HSTMT _hstmt )
+    {
+        if ( auto iter = statement_caches.find( _hdbc ); iter != std::end( statement_caches ) ) {
+            if ( iter->second.release( _hstmt ) ) {
+                return SQL_SUCCESS;
+            }
+        }
+
+        return SQLFreeHandle( SQL_HANDLE_STMT, _hstmt );
+    }
+
+    void discard_statement( HDBC _hdbc, HSTMT _hstmt )
+    {
+        if ( auto iter = statement_caches.find( _hdbc ); iter != std::end( statement_caches ) ) {
+            iter->second.discard( _hstmt );
+        }
+    }
+} // anonymous namespace
+
 
 /*
   call SQLError to get error information and log it
@@ -218,6 +349,12 @@ cllConnect( icatSessionStruct *icss ) {
 
     icss->connectPtr = myHdbc;
 
+    // The prepared statement cache lives as long as the connection and is cleared
+    // by cllDisconnect. Anything left under a reused handle address belonged to a
+    // connection that no longer exists, so it is dropped without being freed.
+    statement_caches.erase( myHdbc );
+    statement_caches.try_emplace( myHdbc, get_prepared_statement_cache_size() );
+
     if ( icss->databaseType == DB_TYPE_MYSQL ) {
         /* MySQL must be running in ANSI mode (or at least in
            PIPES_AS_CONCAT mode) to be able to understand Postgres
@@ -328,6 +465,16 @@ cllDisconnect( icatSessionStruct *icss ) {
         cllExecSqlNoResult( icss, "commit" ); 
     }
 
+    // The cached statement handles must be freed before the connection is.
+    if ( auto iter = statement_caches.find( icss->connectPtr ); iter != std::end( statement_caches ) ) {
+        const auto stats = iter->second.stats();
+        rodsLog( LOG_DEBUG, "cllDisconnect: prepared statement cache hits: %ju, misses: %ju, evictions: %ju",
+                 static_cast<uintmax_t>( stats.hits ), static_cast<uintmax_t>( stats.misses ),
+                 static_cast<uintmax_t>( stats.evictions ) );
+        iter->second.clear();
+        statement_caches.erase( iter );
+    }
+
     SQLRETURN stat = SQLDisconnect( icss->connectPtr );
     if ( stat != SQL_SUCCESS ) {
         rodsLog( LOG_ERROR, "cllDisconnect: SQLDisconnect failed: %d", stat );
@@ -450,19 +597,22 @@ _cllExecSqlNoResult(
 
     HDBC myHdbc = icss->connectPtr;
     HSTMT myHstmt;
-    SQLRETURN stat = SQLAllocHandle( SQL_HANDLE_STMT, myHdbc, &myHstmt );
+    bool prepared;
+    SQLRETURN stat = acquire_statement( myHdbc, sql, myHstmt, prepared );
     if ( stat != SQL_SUCCESS ) {
         rodsLog( LOG_ERROR, "_cllExecSqlNoResult: SQLAllocHandle failed for statement: %d", stat );
         return -1;
     }
 
     if ( option == 0 && bindTheVariables( myHstmt, sql ) != 0 ) {
+        discard_statement( myHdbc, myHstmt );
+        release_statement( myHdbc, myHstmt );
         return -1;
     }
 
     rodsLogSql( sql );
 
-    stat = SQLExecDirect( myHstmt, ( unsigned char * )sql, strlen( sql ) );
+    stat = execute_statement( myHstmt, sql, prepared );
     SQL_INT_OR_LEN rowCount = 0;
     SQLRowCount( myHstmt, ( SQL_INT_OR_LEN * )&rowCount );
     switch ( stat ) {
@@ -520,9 +670,10 @@ _cllExecSqlNoResult(
                  stat, sql );
         result = logPsgError( LOG_NOTICE, icss->environPtr, myHdbc, myHstmt,
                               icss->databaseType );
+        discard_statement( myHdbc, myHstmt );
     }
 
-    stat = SQLFreeHandle( SQL_HANDLE_STMT, myHstmt );
+    stat = release_statement( myHdbc, myHstmt );
     if ( stat != SQL_SUCCESS ) {
         rodsLog( LOG_ERROR, "_cllExecSqlNoResult: SQLFreeHandle for statement error: %d", stat );
     }
@@ -551,7 +702,8 @@ cllExecSqlWithResult( icatSessionStruct *icss, int *stmtNum, const char *sql ) {
 
     HDBC myHdbc = icss->connectPtr;
     HSTMT hstmt;
-    SQLRETURN stat = SQLAllocHandle( SQL_HANDLE_STMT, myHdbc, &hstmt );
+    bool prepared;
+    SQLRETURN stat = acquire_statement( myHdbc, sql, hstmt, prepared );
     if ( stat != SQL_SUCCESS ) {
         rodsLog( LOG_ERROR, "cllExecSqlWithResult: SQLAllocHandle failed for statement: %d",
                  stat );
@@ -570,6 +722,7 @@ cllExecSqlWithResult( icatSessionStruct *icss, int *stmtNum, const char *sql ) {
     if ( statementNumber < 0 ) {
         rodsLog( LOG_ERROR,
                  "cllExecSqlWithResult: too many concurrent statements" );
+        release_statement( myHdbc, hstmt );
         return CAT_STATEMENT_TABLE_FULL;
     }
 
@@ -582,11 +735,12 @@ cllExecSqlWithResult( icatSessionStruct *icss, int *stmtNum, const char *sql ) {
     myStatement->stmtPtr = hstmt;
 
     if ( bindTheVariables( hstmt, sql ) != 0 ) {
+        discard_statement( myHdbc, hstmt );
         return -1;
     }
 
     rodsLogSql( sql );
-    stat = SQLExecDirect( hstmt, ( unsigned char * )sql, strlen( sql ) );
+    stat = execute_statement( hstmt, sql, prepared );
 
     switch ( stat ) {
     case SQL_SUCCESS:
@@ -617,6 +771,7 @@ cllExecSqlWithResult( icatSessionStruct *icss, int *stmtNum, const char *sql ) {
                  stat, sql );
         logPsgError( LOG_NOTICE, icss->environPtr, myHdbc, hstmt,
                      icss->databaseType );
+        discard_statement( myHdbc, hstmt );
         return -1;
     }
 
@@ -725,7 +880,8 @@ cllExecSqlWithResultBV(
 
     HDBC myHdbc = icss->connectPtr;
     HSTMT hstmt;
-    SQLRETURN stat = SQLAllocHandle( SQL_HANDLE_STMT, myHdbc, &hstmt );
+    bool prepared;
+    SQLRETURN stat = acquire_statement( myHdbc, sql, hstmt, prepared );
     if ( stat != SQL_SUCCESS ) {
         rodsLog( LOG_ERROR, "cllExecSqlWithResultBV: SQLAllocHandle failed for statement: %d",
                  stat );
@@ -744,6 +900,7 @@ cllExecSqlWithResultBV(
     if ( statementNumber < 0 ) {
         rodsLog( LOG_ERROR,
                  "cllExecSqlWithResultBV: too many concurrent statements" );
+        release_statement( myHdbc, hstmt );
         return CAT_STATEMENT_TABLE_FULL;
     }
 
@@ -766,12 +923,13 @@ cllExecSqlWithResultBV(
             if ( stat != SQL_SUCCESS ) {
                 rodsLog( LOG_ERROR,
                          "cllExecSqlWithResultBV: SQLBindParameter failed: %d", stat );
+                discard_statement( myHdbc, hstmt );
                 return -1;
             }
         }
     }
     rodsLogSql( sql );
-    stat = SQLExecDirect( hstmt, ( unsigned char * )sql, strlen( sql ) );
+    stat = execute_statement( hstmt, sql, prepared );
 
     switch ( stat ) {
     case SQL_SUCCESS:
@@ -802,6 +960,7 @@ cllExecSqlWithResultBV(
                  stat, sql );
         logPsgError( LOG_NOTICE, icss->environPtr, myHdbc, hstmt,
                      icss->databaseType );
+        discard_statement( myHdbc, hstmt );
         return -1;
     }
 
@@ -971,7 +1130,7 @@ cllFreeStatement( icatSessionStruct *icss, int& statementNumber ) {
 
     _cllFreeStatementColumns( icss, statementNumber );
 
-    SQLRETURN stat = SQLFreeHandle( SQL_HANDLE_STMT, myStatement->stmtPtr );
+    SQLRETURN stat = release_statement( icss->connectPtr, myStatement->stmtPtr );
     if ( stat != SQL_SUCCESS ) {
         statementNumber = UNINITIALIZED_STATEMENT_NUMBER;
         rodsLog( LOG_ERROR, "cllFreeStatement SQLFreeHandle for statement error: %d", stat );
@@ -1001,3 +1160,26 @@ _cllFreeStatementColumns( icatSessionStruct *icss, int statementNumber ) {
     }
     return 0;
 }
+
+/*
+   Report the counters of the prepared statement cache for this connection.
+*/
+int
+cllGetStatementCacheStats( icatSessionStruct *icss, cllStatementCacheStats *stats ) {
+    if ( stats == NULL ) {
+        return SYS_INTERNAL_NULL_INPUT_ERR;
+    }
+
+    memset( stats, 0, sizeof( *stats ) );
+
+    if ( auto iter = statement_caches.find( icss->connectPtr ); iter != std::end( statement_caches ) ) {
+        const auto s = iter->second.stats();
+        stats->hits = s.hits;
+        stats->misses = s.misses;
+        stats->evictions = s.evictions;
+        stats->size = s.size;
+        stats->capacity = s.capacity;
+    }
+
+    return 0;
+}
@@ -19,6 +19,7 @@
 #include "irods_stacktrace.hpp"
 #include "irods_log.hpp"
 #include "irods_virtual_path.hpp"
+#include "bulk_registration_sql.hpp"
 
 #include "rcMisc.h"
 
@@ -681,6 +682,67 @@ cmlGetNextSeqVal( icatSessionStruct *icss ) {
     return iVal;
 }
 
+/*
+   Reserve _count values of the object sequence with a single query.
+   The values are not necessarily contiguous.
+*/
+int
+cmlGetNextSeqVals( int _count, std::vector<rodsLong_t>& _values, icatSessionStruct *icss ) {
+    if ( logSQL_CML != 0 ) {
+        rodsLog( LOG_SQL, "cmlGetNextSeqVals SQL 1 " );
+    }
+
+    _values.clear();
+    if ( _count <= 0 ) {
+        return 0;
+    }
+    _values.reserve( _count );
+
+#ifdef MY_ICAT
+    /* R_ObjectID_nextval() cannot be applied to a generated row set,
+       so fall back to one query per value */
+    for ( int i = 0; i < _count; i++ ) {
+        const rodsLong_t seqNum = cmlGetNextSeqVal( icss );
+        if ( seqNum < 0 ) {
+            return seqNum;
+        }
+        _values.push_back( seqNum );
+    }
+#else
+    namespace bulk = irods::experimental::bulk_registration;
+
+    char nextStr[STR_LEN];
+
+    nextStr[0] = '\0';
+    cllNextValueString( "R_ObjectID", nextStr, STR_LEN );
+
+    const std::string sql = bulk::reserve_sequence_values_sql( nextStr, _count );
+
+    std::vector<char> strings( static_cast<std::size_t>( _count ) * MAX_INTEGER_SIZE );
+    std::vector<std::string> emptyBindVars;
+    const int status = cmlGetMultiRowStringValuesFromSql( sql.c_str(), strings.data(), MAX_INTEGER_SIZE,
+                       _count, emptyBindVars, icss );
+    if ( status < 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "cmlGetNextSeqVals cmlGetMultiRowStringValuesFromSql failure %d", status );
+        return status;
+    }
+    if ( status != _count ) {
+        rodsLog( LOG_NOTICE,
+                 "cmlGetNextSeqVals expected %d values, got %d", _count, status );
+        return CAT_SQL_ERR;
+    }
+
+    if ( !bulk::parse_sequence_values( strings.data(), MAX_INTEGER_SIZE, _count, _values ) ) {
+        rodsLog( LOG_NOTICE,
+                 "cmlGetNextSeqVals received an invalid or repeated value" );
+        return CAT_SQL_ERR;
+    }
+#endif
+
+    return 0;
+}
+
 rodsLong_t
 cmlGetCurrentSeqVal( icatSessionStruct *icss ) {
     char nextStr[STR_LEN];
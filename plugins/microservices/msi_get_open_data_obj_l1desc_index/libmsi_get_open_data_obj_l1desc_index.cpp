@@ -8,14 +8,12 @@
 #include "irods_log.hpp"
 #include "objDesc.hpp"
 #include "fileOpr.hpp"
+#include "rsGlobalExtern.hpp"
 
 #include <exception>
 #include <functional>
 #include <string>
 
-// persistent L1 object descriptor table
-extern l1desc_t L1desc[NUM_L1_DESC];
-
 namespace
 {
     int msi_impl(msParam_t* _in, msParam_t* _out, ruleExecInfo_t* _rei)
@@ -34,11 +32,12 @@ namespace
 
         int l1descInx = -1;
 
-        for (const l1desc_t &l1 : L1desc)
+        for (int i = 0; i < static_cast<int>(L1desc.size()); ++i)
         {
             // for a valid descriptor, if the path matches...
+            const l1desc_t& l1 = L1desc[i];
             if (l1.inuseFlag == FD_INUSE && !strcmp(l1.dataObjInp->objPath, objPath)) {
-                l1descInx = &l1 - L1desc;
+                l1descInx = i;
                 break;
             }
         }
@@ -18,6 +18,8 @@
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 // =-=-=-=-=-=-=-
 // ssl includes
@@ -43,6 +45,11 @@
 // key for ssl shared secret property
 const std::string SHARED_KEY( "ssl_network_plugin_shared_key" );
 
+// =-=-=-=-=-=-=-
+// byte streams up to this size are copied into the message
+// buffer so that the whole message is sent with one SSL_write
+const int MAX_COALESCED_STREAM_SIZE = 64 * 1024;
+
 // =-=-=-=-=-=-=-
 //
 static void ssl_log_error(
@@ -1049,56 +1056,82 @@ irods::error ssl_send_rods_msg(
             }
 
             // =-=-=-=-=-=-=-
-            // send the header
-            irods::network_object_ptr net_obj = boost::dynamic_pointer_cast< irods::network_object >( _ctx.fco() );
-            ret = writeMsgHeader( net_obj, &msg_header );
-            if ( ( result = ASSERT_PASS( ret, "Write message header failed." ) ).ok() ) {
+            // pack the header
+            bytesBuf_t* header_buf = 0;
+            ret = packMsgHeader( &msg_header, &header_buf );
+            if ( ( result = ASSERT_PASS( ret, "Pack message header failed." ) ).ok() ) {
+                std::unique_ptr<bytesBuf_t, decltype(&freeBBuf)> header_buf_ptr{header_buf, freeBBuf};
+
+                if ( getRodsLogLevel() >= LOG_DEBUG8 ) {
+                    printf( "sending header: len = %d\n%.*s\n", header_buf->len, header_buf->len, ( const char * ) header_buf->buf );
+                }
 
                 // =-=-=-=-=-=-=-
-                // send the message buffer
-                int bytes_written = 0;
-                if ( NULL != _msg_buf &&
-                        msg_header.msgLen > 0 ) {
+                // the header length, the header, the message and the error are
+                // coalesced so that they are sent as a single SSL record. a small
+                // byte stream is included, a large one is sent on its own rather
+                // than copied.
+                const bool coalesce_stream = NULL != _stream_bbuf && msg_header.bsLen <= MAX_COALESCED_STREAM_SIZE;
+
+                std::vector<char> message;
+                message.reserve( sizeof( int ) + header_buf->len + msg_header.msgLen + msg_header.errorLen +
+                                 ( coalesce_stream ? msg_header.bsLen : 0 ) );
+
+                const auto append = [&message]( const void* _buf, int _len ) {
+                    const char* p = static_cast<const char*>( _buf );
+                    message.insert( message.end(), p, p + _len );
+                };
+
+                const int header_length = htonl( header_buf->len );
+                append( &header_length, sizeof( header_length ) );
+                append( header_buf->buf, header_buf->len );
+
+                if ( NULL != _msg_buf && msg_header.msgLen > 0 ) {
                     if ( XML_PROT == _protocol &&
                             getRodsLogLevel() >= LOG_DEBUG8 ) {
-                        printf( "sending msg: \n%s\n", ( const char* ) _msg_buf->buf );
+                        printf( "sending msg: \n%.*s\n", _msg_buf->len, ( const char* ) _msg_buf->buf );
                     }
-                    ret = ssl_socket_write( _msg_buf->buf, _msg_buf->len, bytes_written, ssl_obj->ssl() );
-                    result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
-                } // if msgLen > 0
+                    append( _msg_buf->buf, _msg_buf->len );
+                }
 
-                if ( result.ok() ) {
+                if ( NULL != _error_buf && msg_header.errorLen > 0 ) {
+                    if ( XML_PROT == _protocol &&
+                            getRodsLogLevel() >= LOG_DEBUG8 ) {
+                        printf( "sending msg: \n%.*s\n", _error_buf->len, ( const char* ) _error_buf->buf );
+                    }
+                    append( _error_buf->buf, _error_buf->len );
+                }
 
-                    // =-=-=-=-=-=-=-
-                    // send the error buffer
-                    if ( NULL != _error_buf &&
-                            msg_header.errorLen > 0 ) {
-                        if ( XML_PROT == _protocol &&
-                                getRodsLogLevel() >= LOG_DEBUG8 ) {
-                            printf( "sending msg: \n%s\n", ( const char* ) _error_buf->buf );
+                if ( NULL != _stream_bbuf && msg_header.bsLen > 0 ) {
+                    if ( XML_PROT == _protocol &&
+                            getRodsLogLevel() >= LOG_DEBUG8 ) {
+                        printf( "sending msg: \n%.*s\n", _stream_bbuf->len, ( const char* ) _stream_bbuf->buf );
+                    }
+                    if ( coalesce_stream ) {
+                        append( _stream_bbuf->buf, _stream_bbuf->len );
+                    }
+                }
 
-                        }
+                // =-=-=-=-=-=-=-
+                // send the message
+                const int header_size = sizeof( header_length ) + header_buf->len;
+                int bytes_written = 0;
+                ret = ssl_socket_write( message.data(), message.size(), bytes_written, ssl_obj->ssl() );
+                if ( bytes_written < header_size ) {
+                    const int status = SYS_HEADER_WRITE_LEN_ERR - errno;
+                    result = ASSERT_ERROR( false, status, "Wrote %d expected %d.", bytes_written, header_size );
+                }
+                else if ( ( result = ASSERT_PASS( ret, "Failed writing SSL message to socket." ) ).ok() ) {
 
-                        ret = ssl_socket_write( _error_buf->buf, _error_buf->len, bytes_written, ssl_obj->ssl() );
+                    // =-=-=-=-=-=-=-
+                    // send a large stream buffer
+                    if ( NULL != _stream_bbuf &&
+                            msg_header.bsLen > 0 &&
+                            !coalesce_stream ) {
+                        ret = ssl_socket_write( _stream_bbuf->buf, _stream_bbuf->len, bytes_written, ssl_obj->ssl() );
                         result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
-                    } // if errorLen > 0
 
-                    if ( result.ok() ) {
-
-                        // =-=-=-=-=-=-=-
-                        // send the stream buffer
-                        if ( NULL != _stream_bbuf &&
-                                msg_header.bsLen > 0 ) {
-                            if ( XML_PROT == _protocol &&
-                                    getRodsLogLevel() >= LOG_DEBUG8 ) {
-                                printf( "sending msg: \n%s\n", ( const char* ) _stream_bbuf->buf );
-                            }
-
-                            ret = ssl_socket_write( _stream_bbuf->buf, _stream_bbuf->len, bytes_written, ssl_obj->ssl() );
-                            result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
-
-                        } // if bsLen > 0
-                    }
+                    } // if bsLen > 0
                 }
             }
         }
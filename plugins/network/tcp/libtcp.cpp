@@ -17,6 +17,12 @@
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+#include <sys/uio.h>
+#include <climits>
 
 // =-=-=-=-=-=-=-
 // local function to read a buffer from a socket
@@ -134,6 +140,125 @@ irods::error tcp_socket_write(
 
 } // tcp_socket_write
 
+// =-=-=-=-=-=-=-
+// local function to write several buffers to a socket. the buffers
+// are handed to the kernel together so that small messages leave in
+// as few segments as possible. the iovecs are updated as data is sent.
+irods::error tcp_socket_writev(
+    int           _socket,
+    struct iovec* _iov,
+    int           _iov_count,
+    int&          _bytes_written ) {
+    // =-=-=-=-=-=-=-
+    // reset bytes written
+    _bytes_written = 0;
+
+    while ( _iov_count > 0 ) {
+        const ssize_t num_bytes = writev( _socket, _iov, std::min( _iov_count, IOV_MAX ) );
+
+        if ( num_bytes < 0 ) {
+            // =-=-=-=-=-=-=-
+            // gracefully handle an interrupt
+            if ( EINTR == errno ) {
+                errno = 0;
+                continue;
+            }
+
+            return ERROR( SYS_SOCK_WRITE_ERR - errno, boost::format("error writing to socket after [%d] bytes written") % _bytes_written );
+        }
+
+        _bytes_written += num_bytes;
+
+        // =-=-=-=-=-=-=-
+        // skip the buffers which were sent completely and
+        // advance into the one which was sent partially
+        std::size_t remaining = num_bytes;
+        while ( _iov_count > 0 && remaining >= _iov->iov_len ) {
+            remaining -= _iov->iov_len;
+            ++_iov;
+            --_iov_count;
+        }
+
+        if ( _iov_count > 0 ) {
+            _iov->iov_base = static_cast<char*>( _iov->iov_base ) + remaining;
+            _iov->iov_len -= remaining;
+        }
+    }
+
+    return SUCCESS();
+
+} // tcp_socket_writev
+
+// =-=-=-=-=-=-=-
+// local function to read from a socket into several buffers. the
+// iovecs are updated as data is received.
+irods::error tcp_socket_readv(
+    int             _socket,
+    struct iovec*   _iov,
+    int             _iov_count,
+    int&            _bytes_read,
+    struct timeval* _time_value ) {
+    // =-=-=-=-=-=-=-
+    // local copy of time value?
+    struct timeval timeout;
+    if ( _time_value != NULL ) {
+        timeout = ( *_time_value );
+    }
+
+    // =-=-=-=-=-=-=-
+    // reset bytes read
+    _bytes_read = 0;
+
+    while ( _iov_count > 0 ) {
+        if ( nullptr != _time_value ) {
+            fd_set set;
+            FD_ZERO( &set );
+            FD_SET( _socket, &set );
+
+            const int status = select( _socket + 1, &set, NULL, NULL, &timeout );
+            if ( status == 0 ) { // the select has timed out
+                return ERROR( SYS_SOCK_READ_TIMEDOUT, boost::format("socket timeout with [%d] bytes read") % _bytes_read);
+            } else if ( status < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                } else {
+                    return ERROR( SYS_SOCK_READ_ERR - errno, boost::format("error on select after [%d] bytes read") % _bytes_read);
+                }
+            } // else
+        } // if tv
+
+        const ssize_t num_bytes = readv( _socket, _iov, std::min( _iov_count, IOV_MAX ) );
+        if ( num_bytes < 0 ) {
+            if ( EINTR == errno ) {
+                errno = 0;
+                continue;
+            }
+
+            return ERROR(SYS_SOCK_READ_ERR - errno, boost::format("error reading from socket after [%d] bytes read") % _bytes_read);
+        }
+        else if ( num_bytes == 0 ) {
+            break;
+        }
+
+        _bytes_read += num_bytes;
+
+        std::size_t remaining = num_bytes;
+        while ( _iov_count > 0 && remaining >= _iov->iov_len ) {
+            remaining -= _iov->iov_len;
+            ++_iov;
+            --_iov_count;
+        }
+
+        if ( _iov_count > 0 ) {
+            _iov->iov_base = static_cast<char*>( _iov->iov_base ) + remaining;
+            _iov->iov_len -= remaining;
+        }
+    } // while
+
+    return SUCCESS();
+
+} // tcp_socket_readv
+
 // =-=-=-=-=-=-=-
 //
 irods::error tcp_start(
@@ -347,120 +472,72 @@ irods::error tcp_send_rods_msg(
     }
 
     // =-=-=-=-=-=-=-
-    // send the header
-    ret = writeMsgHeader(
-              tcp,
-              &msg_header );
+    // pack the header
+    bytesBuf_t* header_buf = 0;
+    ret = packMsgHeader( &msg_header, &header_buf );
     if ( !ret.ok() ) {
-        return PASSMSG( "writeMsgHeader failed", ret );
+        return PASSMSG( "packMsgHeader failed", ret );
     }
 
-    // =-=-=-=-=-=-=-
-    // send the message buffer
-    int bytes_written = 0;
-    if ( _msg_buf && _msg_buf->len > 0 ) {
-        if ( XML_PROT == _protocol &&
-                getRodsLogLevel() >= LOG_DEBUG8 ) {
-            printf( "sending msg: \n%.*s\n", _msg_buf->len, ( const char* ) _msg_buf->buf );
-        }
-        ret = tcp_socket_write(
-                  socket_handle,
-                  _msg_buf->buf,
-                  _msg_buf->len,
-                  bytes_written );
-        if ( !ret.ok() ) {
-            return PASS( ret );
-        }
+    std::unique_ptr<bytesBuf_t, decltype(&freeBBuf)> header_buf_ptr{header_buf, freeBBuf};
 
-    } // if msgLen > 0
+    if ( getRodsLogLevel() >= LOG_DEBUG8 ) {
+        printf( "sending header: len = %d\n%.*s\n",
+                header_buf->len,
+                header_buf->len,
+                ( const char * ) header_buf->buf );
+    }
 
     // =-=-=-=-=-=-=-
-    // send the error buffer
-    if ( _error_buf && _error_buf->len > 0 ) {
-        if ( XML_PROT == _protocol &&
-                getRodsLogLevel() >= LOG_DEBUG8 ) {
-            printf( "sending msg: \n%.*s\n", _error_buf->len, ( const char* ) _error_buf->buf );
+    // the header length, the header, the message, the error and the
+    // byte stream are sent with a single call
+    int header_length = htonl( header_buf->len );
 
-        }
+    struct iovec iov[ 5 ];
+    int iov_count = 0;
 
-        ret = tcp_socket_write(
-                  socket_handle,
-                  _error_buf->buf,
-                  _error_buf->len,
-                  bytes_written );
-        if ( !ret.ok() ) {
-            return PASS( ret );
-        }
-
-    } // if errorLen > 0
+    iov[ iov_count++ ] = { &header_length, sizeof( header_length ) };
+    iov[ iov_count++ ] = { header_buf->buf, static_cast<std::size_t>( header_buf->len ) };
 
-    // =-=-=-=-=-=-=-
-    // send the stream buffer
-    if ( _stream_bbuf && _stream_bbuf->len > 0 ) {
-        if ( XML_PROT == _protocol &&
-                getRodsLogLevel() >= LOG_DEBUG8 ) {
-            printf( "sending msg: \n%.*s\n", _stream_bbuf->len, ( const char* ) _stream_bbuf->buf );
-        }
+    const bytesBuf_t* bodies[] = { _msg_buf, _error_buf, _stream_bbuf };
+    for ( const bytesBuf_t* body : bodies ) {
+        if ( body && body->len > 0 ) {
+            if ( XML_PROT == _protocol &&
+                    getRodsLogLevel() >= LOG_DEBUG8 ) {
+                printf( "sending msg: \n%.*s\n", body->len, ( const char* ) body->buf );
+            }
 
-        ret = tcp_socket_write(
-                  socket_handle,
-                  _stream_bbuf->buf,
-                  _stream_bbuf->len,
-                  bytes_written );
-        if ( !ret.ok() ) {
-            return PASS( ret );
+            iov[ iov_count++ ] = { body->buf, static_cast<std::size_t>( body->len ) };
         }
-
-    } // if bsLen > 0
-
-    return SUCCESS();
-
-} // tcp_send_rods_msg
-
-// =-=-=-=-=-=-=-
-// helper fcn to read a bytes buf
-irods::error read_bytes_buf(
-    int             _socket_handle,
-    int             _length,
-    bytesBuf_t*     _buffer,
-    irodsProt_t     _protocol,
-    struct timeval* _time_val ) {
-    // =-=-=-=-=-=-=-
-    // trap input buffer ptr
-    if ( !_buffer || !_buffer->buf ) {
-        return ERROR( SYS_READ_MSG_BODY_INPUT_ERR,
-                      "null buffer ptr" );
     }
 
-    int bytes_read = 0;
+    const int header_size = sizeof( header_length ) + header_buf->len;
 
-    // read buffer
-    irods::error ret = tcp_socket_read(
-                           _socket_handle,
-                           _buffer->buf,
-                           _length,
-                           bytes_read,
-                           _time_val );
-    _buffer->len = bytes_read;
-
-    // log transaction if requested
-    if ( _protocol == XML_PROT ) {
-        rodsLog(LOG_DEBUG8, "received msg: \n%.*s\n", _buffer->len, ( char* )_buffer->buf );
-    }
-
-    if (!ret.ok()) {
-        free(_buffer->buf);
-        return PASS(ret);
-    }
+    int bytes_written = 0;
+    ret = tcp_socket_writev(
+              socket_handle,
+              iov,
+              iov_count,
+              bytes_written );
+    if ( !ret.ok() ) {
+        // =-=-=-=-=-=-=-
+        // report a header which was not sent the way
+        // tcp_write_msg_header does
+        if ( bytes_written < header_size ) {
+            std::stringstream msg;
+            msg << "wrote "
+                << bytes_written
+                << " expected " << header_size;
+            return ERROR( SYS_HEADER_WRITE_LEN_ERR - errno,
+                          msg.str() );
+        }
 
-    if (bytes_read != _length) {
-        free(_buffer->buf);
-        return ERROR(SYS_READ_MSG_BODY_LEN_ERR, boost::format("only read [%d] of [%d]") % bytes_read % _length);
+        return PASS( ret );
     }
 
     return SUCCESS();
 
-} // read_bytes_buf
+} // tcp_send_rods_msg
 
 // =-=-=-=-=-=-=-
 // read a message body off of the socket
@@ -501,28 +578,29 @@ irods::error tcp_read_msg_body(
     }
 
     // =-=-=-=-=-=-=-
-    // reset error buf
-    // NOTE :: do not reset bs buf as it can be reused
-    //         on the client side
-    if ( _error_buf ) {
-    }
+    // the message, error and bs buffers are read with as few
+    // system calls as possible. each buffer is owned by the caller.
+    struct body_part {
+        bytesBuf_t* buffer;
+        int         length;
+    };
+
+    body_part parts[ 3 ];
+    struct iovec iov[ 3 ];
+    int part_count = 0;
+
+    const auto add_part = [&]( bytesBuf_t* _buffer, int _length ) {
+        parts[ part_count ] = { _buffer, _length };
+        iov[ part_count ] = { _buffer->buf, static_cast<std::size_t>( _length ) };
+        ++part_count;
+    };
 
     // =-=-=-=-=-=-=-
     // read input buffer
     if ( 0 != _input_struct_buf ) {
         if ( _header->msgLen > 0 ) {
             _input_struct_buf->buf = malloc( _header->msgLen + 1 );
-
-            ret = read_bytes_buf(
-                      socket_handle,
-                      _header->msgLen,
-                      _input_struct_buf,
-                      _protocol,
-                      _time_val );
-            if ( !ret.ok() ) {
-                return PASS( ret );
-            }
-
+            add_part( _input_struct_buf, _header->msgLen );
         }
         else {
             // =-=-=-=-=-=-=-
@@ -539,15 +617,7 @@ irods::error tcp_read_msg_body(
     if ( 0 != _error_buf ) {
         if ( _header->errorLen > 0 ) {
             _error_buf->buf = malloc( _header->errorLen + 1 );
-            ret = read_bytes_buf(
-                      socket_handle,
-                      _header->errorLen,
-                      _error_buf,
-                      _protocol,
-                      _time_val );
-            if ( !ret.ok() ) {
-                return PASS( ret );
-            }
+            add_part( _error_buf, _header->errorLen );
         }
         else {
             _error_buf->len = 0;
@@ -572,15 +642,7 @@ irods::error tcp_read_msg_body(
 
             }
 
-            ret = read_bytes_buf(
-                      socket_handle,
-                      _header->bsLen,
-                      _bs_buf,
-                      _protocol,
-                      _time_val );
-            if ( !ret.ok() ) {
-                return PASS( ret );
-            }
+            add_part( _bs_buf, _header->bsLen );
         }
         else {
             _bs_buf->len = 0;
@@ -589,6 +651,55 @@ irods::error tcp_read_msg_body(
 
     } // bs buffer
 
+    if ( 0 == part_count ) {
+        return SUCCESS();
+    }
+
+    for ( int i = 0; i < part_count; ++i ) {
+        if ( !parts[ i ].buffer->buf ) {
+            return ERROR( SYS_READ_MSG_BODY_INPUT_ERR,
+                          "null buffer ptr" );
+        }
+    }
+
+    int bytes_read = 0;
+    ret = tcp_socket_readv(
+              socket_handle,
+              iov,
+              part_count,
+              bytes_read,
+              _time_val );
+
+    // =-=-=-=-=-=-=-
+    // distribute the bytes read over the buffers
+    int bytes_left = bytes_read;
+    for ( int i = 0; i < part_count; ++i ) {
+        parts[ i ].buffer->len = std::min( bytes_left, parts[ i ].length );
+        bytes_left -= parts[ i ].buffer->len;
+
+        // log transaction if requested
+        if ( _protocol == XML_PROT ) {
+            rodsLog(LOG_DEBUG8, "received msg: \n%.*s\n", parts[ i ].buffer->len, ( char* )parts[ i ].buffer->buf );
+        }
+    }
+
+    const int expected = std::accumulate( parts, parts + part_count, 0, []( int _sum, const body_part& _part ) {
+        return _sum + _part.length;
+    } );
+
+    if ( !ret.ok() || bytes_read != expected ) {
+        for ( int i = 0; i < part_count; ++i ) {
+            free( parts[ i ].buffer->buf );
+            parts[ i ].buffer->buf = NULL;
+        }
+
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        return ERROR(SYS_READ_MSG_BODY_LEN_ERR, boost::format("only read [%d] of [%d]") % bytes_read % expected);
+    }
+
     return SUCCESS();
 
 } // tcp_read_msg_body
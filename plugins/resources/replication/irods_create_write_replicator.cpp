@@ -2,7 +2,24 @@
 
 #include "dataObjRepl.h"
 #include "irods_repl_retry.hpp"
+#include "irods_repl_workers.hpp"
 #include "irods_stacktrace.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace {
+
+    // A replication to a single sibling and its outcome.
+    // An empty status means the replication raised an exception.
+    struct replication_job {
+        std::string hierarchy;
+        dataObjInp_t input;
+        std::optional<int> status;
+    };
+
+} // anonymous namespace
 
 namespace irods {
 
@@ -36,13 +53,23 @@ namespace irods {
             child_parser.str( sub_hier, current_resource_ );
 
             file_object object = _object_oper.object();
+            std::vector<replication_job> jobs;
+            irods::at_scope_exit free_inputs{[&jobs] {
+                for ( auto& job : jobs ) {
+                    clearKeyVal( &job.input.condInput );
+                }
+            }};
+
             child_list_t::const_iterator it;
             for ( it = _siblings.begin(); it != _siblings.end(); ++it ) {
                 hierarchy_parser sibling = *it;
                 std::string hierarchy_string;
                 error ret = sibling.str( hierarchy_string );
                 if ( ( result = ASSERT_PASS( ret, "Failed to get the hierarchy string from the sibling hierarchy parser." ) ).ok() ) {
-                    dataObjInp_t dataObjInp;
+                    auto& job = jobs.emplace_back();
+                    job.hierarchy = hierarchy_string;
+
+                    dataObjInp_t& dataObjInp = job.input;
                     bzero( &dataObjInp, sizeof( dataObjInp ) );
                     rstrcpy( dataObjInp.objPath, object.logical_path().c_str(), MAX_NAME_LEN );
                     dataObjInp.createMode = object.mode();
@@ -54,41 +81,46 @@ namespace irods {
                     addKeyVal( &dataObjInp.condInput, DEST_RESC_NAME_KW, root_resource_.c_str() );
                     addKeyVal( &dataObjInp.condInput, IN_PDMO_KW, sub_hier.c_str() );
 
-                    try {
-                        const auto status = data_obj_repl_with_retry( _ctx, dataObjInp );
-                        if (status < 0) {
-                            // Replications which failed simply because they were not allowed need not be reported.
-                            // Such failures should be fixed with a rebalance or some tree surgery.
-                            if (SYS_NOT_ALLOWED == status) {
-                                continue;
-                            }
-
-                            char* sys_error = NULL;
-                            auto rods_error = rodsErrorName( status, &sys_error );
-                            result = ERROR(status, fmt::format(
-                                "Failed to replicate the data object: \"{}\" from resource: \"{}\" to sibling: \"{}\" - {} {}.",
-                                object.logical_path(), child_, hierarchy_string, rods_error, sys_error));
-                            free( sys_error );
-
-                            // cache last error to return, log it and add it to the
-                            // client side error stack
-                            last_error = result;
-                            irods::log( result );
-                            addRErrorMsg(
-                                &_ctx.comm()->rError,
-                                result.code(),
-                                result.result().c_str() );
-                            result = SUCCESS();
-                        }
-                    }
-                    catch ( const irods::exception& e ) {
-                        irods::log( irods::error( e ) );
-                    }
-
                 } // if hier str
 
             } // for it
 
+            // Siblings are independent of each other, so they form a single group
+            irods::run_replications( _ctx, { jobs.size() }, irods::get_replication_concurrency( _ctx ),
+                [&_ctx, &jobs]( rcComm_t* _conn, std::size_t, std::size_t _index ) {
+                    auto& job = jobs[_index];
+                    job.status = _conn
+                        ? irods::data_obj_repl_with_retry( _ctx, *_conn, job.input )
+                        : irods::data_obj_repl_with_retry( _ctx, job.input );
+                } );
+
+            // Report the outcome of each sibling in order, regardless of the order in which they finished
+            for ( const auto& job : jobs ) {
+                // Replications which failed simply because they were not allowed need not be reported.
+                // Such failures should be fixed with a rebalance or some tree surgery.
+                if ( !job.status || *job.status >= 0 || SYS_NOT_ALLOWED == *job.status ) {
+                    continue;
+                }
+
+                const auto status = *job.status;
+                char* sys_error = NULL;
+                auto rods_error = rodsErrorName( status, &sys_error );
+                result = ERROR(status, fmt::format(
+                    "Failed to replicate the data object: \"{}\" from resource: \"{}\" to sibling: \"{}\" - {} {}.",
+                    object.logical_path(), child_, job.hierarchy, rods_error, sys_error));
+                free( sys_error );
+
+                // cache last error to return, log it and add it to the
+                // client side error stack
+                last_error = result;
+                irods::log( result );
+                addRErrorMsg(
+                    &_ctx.comm()->rError,
+                    result.code(),
+                    result.result().c_str() );
+                result = SUCCESS();
+            }
+
         } // if ok
 
         if ( !last_error.ok() ) {
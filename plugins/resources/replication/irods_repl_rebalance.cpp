@@ -5,6 +5,7 @@
 #include "irods_virtual_path.hpp"
 #include "irods_repl_retry.hpp"
 #include "irods_repl_types.hpp"
+#include "irods_repl_workers.hpp"
 #include "icatHighLevelRoutines.hpp"
 #include "dataObjRepl.h"
 #include "genQuery.h"
@@ -13,10 +14,15 @@
 #include "boost/lexical_cast.hpp"
 #include "rodsError.h"
 
+#include <chrono>
+#include <map>
+#include <optional>
 
 namespace {
+    // _conn is the connection to replicate through, or null to replicate within this agent
     irods::error repl_for_rebalance(
         irods::plugin_context& _ctx,
+        rcComm_t*          _conn,
         const std::string& _obj_path,
         const std::string& _current_resc,
         const std::string& _src_hier,
@@ -44,7 +50,10 @@ namespace {
         try {
             // =-=-=-=-=-=-=-
             // process the actual call for replication
-            const auto status = data_obj_repl_with_retry( _ctx, data_obj_inp );
+            const auto status = _conn
+                ? data_obj_repl_with_retry( _ctx, *_conn, data_obj_inp )
+                : data_obj_repl_with_retry( _ctx, data_obj_inp );
+            clearKeyVal( &data_obj_inp.condInput );
             if ( status < 0 ) {
                 return ERROR( status,
                               boost::format( "Failed to replicate the data object [%s]" ) %
@@ -52,6 +61,7 @@ namespace {
             }
         }
         catch( const irods::exception& e ) {
+            clearKeyVal( &data_obj_inp.condInput );
             irods::log(e);
             return irods::error( e );
         }
@@ -59,6 +69,76 @@ namespace {
         return SUCCESS();
     }
 
+    // A replication prepared by the rebalance and its outcome
+    struct rebalance_job {
+        rodsLong_t  data_id;
+        std::string object_path;
+        std::string source_hierarchy;
+        std::string destination_hierarchy;
+        std::string root_resource;
+        int         data_mode;
+        irods::error result = SUCCESS();
+    };
+
+    // Counts the replications performed by a rebalance and reports them to the log
+    class rebalance_progress {
+    public:
+        rebalance_progress(const std::string& _resource_name, const std::string& _operation)
+            : resource_name_{_resource_name}
+            , operation_{_operation}
+            , start_{std::chrono::steady_clock::now()}
+        {
+        }
+
+        void add(const std::vector<rebalance_job>& _jobs) {
+            for (const auto& job : _jobs) {
+                ++(job.result.ok() ? succeeded_ : failed_);
+            }
+        }
+
+        void log(const char* _stage) const {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+            const auto total = succeeded_ + failed_;
+            rodsLog(LOG_NOTICE, "rebalance: %s for resource [%s] %s. replicas [%zu] failed [%zu] elapsed [%.1f] seconds rate [%.1f] replicas per second",
+                    operation_.c_str(), resource_name_.c_str(), _stage, total, failed_, elapsed.count(),
+                    elapsed.count() > 0 ? total / elapsed.count() : 0.0);
+        }
+
+    private:
+        std::string resource_name_;
+        std::string operation_;
+        std::chrono::steady_clock::time_point start_;
+        std::size_t succeeded_ = 0;
+        std::size_t failed_ = 0;
+    };
+
+    // Runs the jobs of every group, with up to the resource's replication_concurrency
+    // jobs of a group at the same time. The outcome of each job is stored in the job.
+    void run_rebalance_jobs(
+        irods::plugin_context& _ctx,
+        const std::string& _current_resc,
+        std::vector<std::vector<rebalance_job>>& _groups) {
+        std::vector<std::size_t> group_sizes;
+        for (const auto& group : _groups) {
+            group_sizes.push_back(group.size());
+        }
+
+        irods::run_replications(_ctx, group_sizes, irods::get_replication_concurrency(_ctx),
+            [&_ctx, &_current_resc, &_groups](rcComm_t* _conn, std::size_t _group, std::size_t _index) {
+                auto& job = _groups[_group][_index];
+                job.result = repl_for_rebalance(
+                    _ctx,
+                    _conn,
+                    job.object_path,
+                    _current_resc,
+                    job.source_hierarchy,
+                    job.destination_hierarchy,
+                    job.root_resource,
+                    job.root_resource,
+                    job.data_mode);
+            });
+    }
+
     // throws irods::exception
     sqlResult_t* extract_sql_result(const genQueryInp_t& genquery_inp, genQueryOut_t* genquery_out_ptr, const int column_number) {
         if (sqlResult_t *sql_result = getSqlResultByInx(genquery_out_ptr, column_number)) {
@@ -171,12 +251,17 @@ namespace {
         rodsLong_t resource_id;
     };
 
+    // Returns up to _batch_size out-of-date replicas with a data id greater than _after_data_id,
+    // ordered by data id. The replicas of a data object are not split across batches, unless a
+    // data object has more out-of-date replicas than fit in a batch. The excess replicas of such
+    // a data object are left for the next rebalance.
     // throws irods::exception
     std::vector<ReplicaAndRescId> get_out_of_date_replicas_batch(
         rsComm_t* _comm,
         const std::vector<leaf_bundle_t>& _bundles,
         const std::string& _invocation_timestamp,
-        const int _batch_size) {
+        const int _batch_size,
+        const rodsLong_t _after_data_id) {
         if (!_comm) {
             THROW(SYS_INTERNAL_NULL_INPUT_ERR, "null rsComm");
         }
@@ -204,8 +289,9 @@ namespace {
         addInxVal(&genquery_inp_wrapped.get().sqlCondInp, COL_D_REPL_STATUS, (boost::format("= '%d'") % STALE_REPLICA).str().c_str());
         const std::string timestamp_str = "<= '" + _invocation_timestamp + "'";
         addInxVal(&genquery_inp_wrapped.get().sqlCondInp, COL_D_MODIFY_TIME, timestamp_str.c_str());
-        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_D_DATA_ID, 1);
-        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_DATA_REPL_NUM, 1);
+        addInxVal(&genquery_inp_wrapped.get().sqlCondInp, COL_D_DATA_ID, (boost::format("> '%lld'") % _after_data_id).str().c_str());
+        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_D_DATA_ID, ORDER_BY);
+        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_DATA_REPL_NUM, ORDER_BY);
         addInxIval(&genquery_inp_wrapped.get().selectInp, COL_D_RESC_ID, 1);
 
         irods::GenQueryOutPtrWrapper genquery_out_ptr_wrapped;
@@ -253,6 +339,25 @@ namespace {
             repl_and_resc.resource_id    = cast_genquery_result(i, &data_resc_id_results ->value[data_resc_id_results ->len * i]);
             ret.push_back(repl_and_resc);
         }
+
+        // Only the first page is needed. Close the statement rather than leaving it open.
+        if (genquery_out_ptr_wrapped.get()->continueInx > 0) {
+            genquery_inp_wrapped.get().continueInx = genquery_out_ptr_wrapped.get()->continueInx;
+            genquery_inp_wrapped.get().maxRows = 0;
+            genQueryOut_t* close_out{};
+            rsGenQuery(_comm, &genquery_inp_wrapped.get(), &close_out);
+            freeGenQueryOut(&close_out);
+
+            // The replicas of the last data object may continue in the next page. They are
+            // left for the next batch, which starts after the previous data object.
+            if (ret.front().data_id != ret.back().data_id) {
+                const auto last_data_id = ret.back().data_id;
+                while (ret.back().data_id == last_data_id) {
+                    ret.pop_back();
+                }
+            }
+        }
+
         return ret;
     }
 
@@ -294,7 +399,9 @@ namespace {
     }
 
     // throws irods::exception
-    void proc_results_for_rebalance(
+    // Replicates each data object to the child resource. Returns the outcome of every replication.
+    // throws irods::exception
+    std::vector<rebalance_job> proc_results_for_rebalance(
         irods::plugin_context&           _ctx,
         const std::string&               _parent_resc_name,
         const std::string&               _child_resc_name,
@@ -319,9 +426,10 @@ namespace {
                   leaf_bundles_to_string(_bundles));
         }
 
-        //irods::file_object_ptr file_obj{boost::dynamic_pointer_cast<irods::file_object>(_ctx.fco())};
-
-        irods::error first_rebalance_error = SUCCESS();
+        // Resolving the destinations queries the catalog through this agent, so it is done up front.
+        // Only the replications themselves run concurrently.
+        std::vector<std::vector<rebalance_job>> jobs(1);
+        jobs[0].reserve(_data_ids_to_replicate.size());
         for (auto data_id_to_replicate : _data_ids_to_replicate) {
             const ReplicationSourceInfo source_info = get_source_data_object_attributes(_ctx.comm(), data_id_to_replicate, _bundles);
 
@@ -378,36 +486,24 @@ namespace {
             const std::string dst_hier = parser.str();
             rodsLog(LOG_NOTICE, "%s: creating new replica for data id [%lld] from [%s] on [%s]", __FUNCTION__, data_id_to_replicate, source_info.resource_hierarchy.c_str(), dst_hier.c_str());
 
-            const irods::error err_rebalance = repl_for_rebalance(
-                _ctx,
-                source_info.object_path,
-                _parent_resc_name,
-                source_info.resource_hierarchy,
-                dst_hier,
-                root_resc,
-                root_resc,
-                source_info.data_mode);
-            if (!err_rebalance.ok()) {
-                if (first_rebalance_error.ok()) {
-                    first_rebalance_error = err_rebalance;
-                }
+            jobs[0].push_back({data_id_to_replicate, source_info.object_path, source_info.resource_hierarchy, dst_hier, root_resc, source_info.data_mode});
+        }
+
+        // The data objects are distinct, so up to replication_concurrency of them are replicated to the child at once.
+        run_rebalance_jobs(_ctx, _parent_resc_name, jobs);
+
+        for (const auto& job : jobs[0]) {
+            if (!job.result.ok()) {
                 rodsLog(LOG_ERROR, "%s: repl_for_rebalance failed. object path [%s] parent resc [%s] source hier [%s] dest hier [%s] root resc [%s] data mode [%d]",
-                        __FUNCTION__, source_info.object_path.c_str(), _parent_resc_name.c_str(), source_info.resource_hierarchy.c_str(), dst_hier.c_str(), root_resc.c_str(), source_info.data_mode);
-                irods::log(PASS(err_rebalance));
+                        __FUNCTION__, job.object_path.c_str(), _parent_resc_name.c_str(), job.source_hierarchy.c_str(), job.destination_hierarchy.c_str(), job.root_resource.c_str(), job.data_mode);
+                irods::log(PASS(job.result));
                 if (_ctx.comm()->rError.len < MAX_ERROR_MESSAGES) {
-                    addRErrorMsg(&_ctx.comm()->rError, err_rebalance.code(), err_rebalance.result().c_str());
+                    addRErrorMsg(&_ctx.comm()->rError, job.result.code(), job.result.result().c_str());
                 }
             }
         }
 
-        if (!first_rebalance_error.ok()) {
-            THROW(first_rebalance_error.code(),
-                  boost::format("%s: repl_for_rebalance failed. child_resc [%s] parent resc [%s]. rebalance message [%s]") %
-                  __FUNCTION__ %
-                  _child_resc_name %
-                  _parent_resc_name %
-                  first_rebalance_error.result());
-        }
+        return std::move(jobs[0]);
     }
 }
 
@@ -420,13 +516,25 @@ namespace irods {
         const std::string& _invocation_timestamp,
         const std::string& _resource_name) {
 
+        rebalance_progress progress{_resource_name, "updating out-of-date replicas"};
+        error first_error = SUCCESS();
+
+        // Batches are paged by data id, so replicas which fail to update are not fetched again.
+        rodsLong_t last_data_id = 0;
         while (true) {
-            const std::vector<ReplicaAndRescId> replicas_to_update = get_out_of_date_replicas_batch(_ctx.comm(), _leaf_bundles, _invocation_timestamp, _batch_size);
+            const std::vector<ReplicaAndRescId> replicas_to_update = get_out_of_date_replicas_batch(_ctx.comm(), _leaf_bundles, _invocation_timestamp, _batch_size, last_data_id);
             if (replicas_to_update.empty()) {
                 break;
             }
+            last_data_id = replicas_to_update.back().data_id;
+
+            // Replicas are grouped by the child they are in, which bounds the replications
+            // running against each child. Replicas of the same data object are updated one
+            // after another, so each pass holds at most one replica per data object.
+            std::vector<std::vector<std::vector<rebalance_job>>> passes;
+            std::map<std::string, std::size_t> child_to_group;
+            std::map<rodsLong_t, std::size_t> replicas_of_data_object;
 
-            error first_error = SUCCESS();
             for (const auto& replica_to_update : replicas_to_update) {
                 std::string destination_hierarchy;
                 const error err_dst_hier = resc_mgr.leaf_id_to_hier(replica_to_update.resource_id, destination_hierarchy);
@@ -458,37 +566,55 @@ namespace irods {
                         source_info.object_path);
                 }
 
+                std::string child_name;
+                irods::hierarchy_parser{destination_hierarchy}.next(_resource_name, child_name);
+                const auto group = child_to_group.emplace(child_name, child_to_group.size()).first->second;
+
+                const auto pass = replicas_of_data_object[replica_to_update.data_id]++;
+                if (pass == passes.size()) {
+                    passes.emplace_back();
+                }
+                if (group >= passes[pass].size()) {
+                    passes[pass].resize(group + 1);
+                }
+
                 rodsLog(LOG_NOTICE, "update_out_of_date_replicas: updating out-of-date replica for data id [%ji] from [%s] to [%s]",
                         static_cast<intmax_t>(replica_to_update.data_id),
                         source_info.resource_hierarchy.c_str(),
                         destination_hierarchy.c_str());
-                const error err_repl = repl_for_rebalance(
-                    _ctx,
-                    source_info.object_path,
-                    _resource_name,
-                    source_info.resource_hierarchy,
-                    destination_hierarchy,
-                    root_resc,
-                    root_resc,
-                    source_info.data_mode);
-
-                if (!err_repl.ok()) {
-                    if (first_error.ok()) {
-                        first_error = err_repl;
-                    }
-                    const error error_to_log = PASS(err_repl);
-                    if (_ctx.comm()->rError.len < MAX_ERROR_MESSAGES) {
-                        addRErrorMsg(&_ctx.comm()->rError, error_to_log.code(), error_to_log.result().c_str());
+                passes[pass][group].push_back({replica_to_update.data_id, source_info.object_path, source_info.resource_hierarchy, destination_hierarchy, root_resc, source_info.data_mode});
+            }
+
+            for (auto& groups : passes) {
+                run_rebalance_jobs(_ctx, _resource_name, groups);
+
+                for (const auto& jobs : groups) {
+                    for (const auto& job : jobs) {
+                        if (!job.result.ok()) {
+                            if (first_error.ok()) {
+                                first_error = job.result;
+                            }
+                            const error error_to_log = PASS(job.result);
+                            if (_ctx.comm()->rError.len < MAX_ERROR_MESSAGES) {
+                                addRErrorMsg(&_ctx.comm()->rError, error_to_log.code(), error_to_log.result().c_str());
+                            }
+                            rodsLog(LOG_ERROR,
+                                    "update_out_of_date_replicas: repl_for_rebalance failed with code [%ji] and message [%s]. object [%s] source hierarchy [%s] data id [%ji] destination hierarchy [%s]",
+                                    static_cast<intmax_t>(job.result.code()), job.result.result().c_str(), job.object_path.c_str(), job.source_hierarchy.c_str(),
+                                    static_cast<intmax_t>(job.data_id), job.destination_hierarchy.c_str());
+                        }
                     }
-                    rodsLog(LOG_ERROR,
-                            "update_out_of_date_replicas: repl_for_rebalance failed with code [%ji] and message [%s]. object [%s] source hierarchy [%s] data id [%ji] destination repl num [%ji] destination hierarchy [%s]",
-                            static_cast<intmax_t>(err_repl.code()), err_repl.result().c_str(), source_info.object_path.c_str(), source_info.resource_hierarchy.c_str(),
-                            static_cast<intmax_t>(replica_to_update.data_id), static_cast<intmax_t>(replica_to_update.replica_number), destination_hierarchy.c_str());
+                    progress.add(jobs);
                 }
             }
-            if (!first_error.ok()) {
-                THROW(first_error.code(), first_error.result());
-            }
+
+            progress.log("in progress");
+        }
+
+        progress.log("finished");
+
+        if (!first_error.ok()) {
+            THROW(first_error.code(), first_error.result());
         }
     }
 
@@ -499,11 +625,18 @@ namespace irods {
         const int _batch_size,
         const std::string& _invocation_timestamp,
         const std::string& _resource_name) {
+        rebalance_progress progress{_resource_name, "creating missing replicas"};
+        error first_rebalance_error = SUCCESS();
+        std::string first_failed_child;
+
         for (size_t i=0; i<_leaf_bundles.size(); ++i) {
             const std::string child_name = get_child_name_that_is_ancestor_of_bundle(_resource_name, _leaf_bundles[i]);
+
+            // Batches are paged by data id, so data objects which fail to replicate are not fetched again.
+            rodsLong_t last_data_id = 0;
             while (true) {
                 dist_child_result_t data_ids_needing_new_replicas;
-                const int status_chlGetReplListForLeafBundles = chlGetReplListForLeafBundles(_batch_size, i, &_leaf_bundles, &_invocation_timestamp, &data_ids_needing_new_replicas);
+                const int status_chlGetReplListForLeafBundles = chlGetReplListForLeafBundles(_batch_size, i, &_leaf_bundles, &_invocation_timestamp, last_data_id, &data_ids_needing_new_replicas);
                 if (status_chlGetReplListForLeafBundles != 0) {
                     THROW(status_chlGetReplListForLeafBundles,
                           boost::format("failed to get data objects needing new replicas for resource [%s] bundle index [%d] bundles [%s]")
@@ -514,9 +647,29 @@ namespace irods {
                 if (data_ids_needing_new_replicas.empty()) {
                     break;
                 }
+                last_data_id = data_ids_needing_new_replicas.back();
 
-                proc_results_for_rebalance(_ctx, _resource_name, child_name, i, _leaf_bundles, data_ids_needing_new_replicas);
+                const auto jobs = proc_results_for_rebalance(_ctx, _resource_name, child_name, i, _leaf_bundles, data_ids_needing_new_replicas);
+                for (const auto& job : jobs) {
+                    if (!job.result.ok() && first_rebalance_error.ok()) {
+                        first_rebalance_error = job.result;
+                        first_failed_child = child_name;
+                    }
+                }
+                progress.add(jobs);
+                progress.log("in progress");
             }
         }
+
+        progress.log("finished");
+
+        if (!first_rebalance_error.ok()) {
+            THROW(first_rebalance_error.code(),
+                  boost::format("%s: repl_for_rebalance failed. child_resc [%s] parent resc [%s]. rebalance message [%s]") %
+                  __FUNCTION__ %
+                  first_failed_child %
+                  _resource_name %
+                  first_rebalance_error.result());
+        }
     }
 } // namespace irods
@@ -1,28 +1,36 @@
 #include "irods_repl_retry.hpp"
 #include "irods_repl_types.hpp"
 #include "rsDataObjRepl.hpp"
+#include "dataObjRepl.h"
 
 #include <boost/numeric/conversion/cast.hpp>
 #include <chrono>
 #include <string>
 #include <thread>
 
+namespace {
+
 // Replicates a data object and verifies that the bits are correct
 // Retry mechanism triggers based on config in repl context string
-int irods::data_obj_repl_with_retry(
+// _replicate performs a single replication attempt and _pop_error returns
+// the message it reported
+template <typename Replicate, typename PopError>
+int repl_with_retry(
         irods::plugin_context& _ctx,
-        dataObjInp_t& dataObjInp ) {
+        dataObjInp_t& dataObjInp,
+        Replicate _replicate,
+        PopError _pop_error ) {
 
     transferStat_t* trans_stat{ nullptr };
     rmKeyVal(&dataObjInp.condInput, ALL_KW);
-    auto status{ rsDataObjRepl( _ctx.comm(), &dataObjInp, &trans_stat ) };
+    auto status{ _replicate( &dataObjInp, &trans_stat ) };
     if ( 0 == status ) {
         irods::log(LOG_DEBUG8, fmt::format("[{}:{}] - replication succeeded", __FUNCTION__, __LINE__));
         free( trans_stat );
         return status;
     }
     else if (SYS_NOT_ALLOWED == status) {
-        const auto error = irods::pop_error_message(_ctx.comm()->rError);
+        const auto error = _pop_error();
         irods::log(LOG_NOTICE, fmt::format("[{}:{}] - [{}]",
             __FUNCTION__, __LINE__, error));
         return status;
@@ -57,7 +65,7 @@ int irods::data_obj_repl_with_retry(
         while ( status < 0 && retry_attempts-- > 0 ) {
             irods::log(LOG_DEBUG, fmt::format("[{}:{}] - retries remaining:[{}]", __FUNCTION__, __LINE__, retry_attempts));
             std::this_thread::sleep_for( std::chrono::seconds( delay_in_seconds ) );
-            status = rsDataObjRepl( _ctx.comm(), &dataObjInp, &trans_stat );
+            status = _replicate( &dataObjInp, &trans_stat );
             if ( status < 0 && retry_attempts > 0 ) {
                 delay_in_seconds = boost::numeric_cast< decltype( delay_in_seconds ) >
                                     ( delay_in_seconds * backoff_multiplier );
@@ -74,3 +82,32 @@ int irods::data_obj_repl_with_retry(
     free( trans_stat );
     return status;
 }
+
+} // anonymous namespace
+
+int irods::data_obj_repl_with_retry(
+        irods::plugin_context& _ctx,
+        dataObjInp_t& dataObjInp ) {
+    rsComm_t* comm = _ctx.comm();
+    return repl_with_retry( _ctx, dataObjInp,
+        [comm]( dataObjInp_t* _inp, transferStat_t** _stat ) {
+            return rsDataObjRepl( comm, _inp, _stat );
+        },
+        [comm] {
+            return irods::pop_error_message( comm->rError );
+        } );
+}
+
+int irods::data_obj_repl_with_retry(
+        irods::plugin_context& _ctx,
+        rcComm_t& _conn,
+        dataObjInp_t& dataObjInp ) {
+    return repl_with_retry( _ctx, dataObjInp,
+        [&_conn]( dataObjInp_t* _inp, transferStat_t** _stat ) {
+            return _rcDataObjRepl( &_conn, _inp, _stat );
+        },
+        [&_conn] {
+            // The client library replaces the error stack on every request.
+            return _conn.rError ? irods::pop_error_message( *_conn.rError ) : std::string{};
+        } );
+}
@@ -3,6 +3,7 @@
 
 #include "dataObjInpOut.h"
 #include "irods_plugin_context.hpp"
+#include "rcConnect.h"
 #include <string>
 
 namespace irods {
@@ -11,13 +12,23 @@ namespace irods {
         irods::plugin_context& _ctx,
         dataObjInp_t& dataObjInp );
 
+    // Same as above, but the replication is executed by the server on
+    // the other end of _conn rather than by this agent.
+    // throws irods::exception
+    int data_obj_repl_with_retry(
+        irods::plugin_context& _ctx,
+        rcComm_t& _conn,
+        dataObjInp_t& dataObjInp );
+
     const std::string RETRY_ATTEMPTS_KW{ "retry_attempts" };
     const std::string RETRY_FIRST_DELAY_IN_SECONDS_KW{ "first_retry_delay_in_seconds" };
     const std::string RETRY_BACKOFF_MULTIPLIER_KW{ "backoff_multiplier" };
+    const std::string REPLICATION_CONCURRENCY_KW{ "replication_concurrency" };
 
     const uint32_t DEFAULT_RETRY_ATTEMPTS{ 1 };
     const uint32_t DEFAULT_RETRY_FIRST_DELAY_IN_SECONDS{ 1 };
     const double DEFAULT_RETRY_BACKOFF_MULTIPLIER{ 1.0f };
+    const uint32_t DEFAULT_REPLICATION_CONCURRENCY{ 1 };
 }
 
 #endif // _IRODS_REPL_RETRY_HPP_
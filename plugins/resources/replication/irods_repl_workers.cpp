@@ -0,0 +1,111 @@
+#include "irods_repl_workers.hpp"
+#include "irods_repl_retry.hpp"
+
+#include "client_connection.hpp"
+#include "irods_exception.hpp"
+#include "irods_log.hpp"
+#include "rodsConnect.h"
+#include "rsGlobalExtern.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+    // Connects to the local server as the client, the same way svrToSvrConnect does,
+    // so that replications issued through the connection are carried out by another agent.
+    // throws irods::exception
+    irods::experimental::client_connection connect_to_local_server( rsComm_t& _comm ) {
+        rErrMsg_t err_msg{};
+        auto* conn = _rcConnect(
+            LocalServerHost->hostName->name,
+            static_cast<zoneInfo_t*>( LocalServerHost->zoneInfo )->portNum,
+            _comm.myEnv.rodsUserName, _comm.myEnv.rodsZone,
+            _comm.clientUser.userName, _comm.clientUser.rodsZone,
+            &err_msg, 0, NO_RECONN );
+        if ( !conn ) {
+            THROW( err_msg.status < 0 ? err_msg.status : SYS_SVR_TO_SVR_CONNECT_FAILED,
+                   "Failed to connect to the local server for replication." );
+        }
+
+        irods::experimental::client_connection client_conn{ *conn };
+        if ( const int ec = clientLogin( conn ); ec < 0 ) {
+            THROW( ec, "Failed to log in to the local server for replication." );
+        }
+
+        return client_conn;
+    }
+
+    struct worker {
+        irods::experimental::client_connection conn;
+        std::size_t group;
+    };
+} // anonymous namespace
+
+namespace irods {
+    void run_replications(
+        irods::plugin_context& _ctx,
+        const std::vector<std::size_t>& _group_sizes,
+        std::size_t _concurrency_per_group,
+        const replication_function_t& _replicate ) {
+
+        std::vector<std::unique_ptr<std::atomic<std::size_t>>> next_index;
+        std::vector<worker> workers;
+
+        // Connections are established up front because logging in is not thread safe.
+        if ( _concurrency_per_group > 1 ) {
+            try {
+                for ( std::size_t group = 0; group < _group_sizes.size(); ++group ) {
+                    const auto count = std::min( _concurrency_per_group, _group_sizes[group] );
+                    for ( std::size_t i = 0; i < count; ++i ) {
+                        workers.push_back( { connect_to_local_server( *_ctx.comm() ), group } );
+                    }
+                }
+            }
+            catch ( const irods::exception& e ) {
+                irods::log( e );
+            }
+        }
+
+        for ( std::size_t group = 0; group < _group_sizes.size(); ++group ) {
+            next_index.push_back( std::make_unique<std::atomic<std::size_t>>( 0 ) );
+        }
+
+        // Takes the next replication of _group until none are left.
+        const auto drain = [&]( rcComm_t* _conn, std::size_t _group ) {
+            auto& next = *next_index[_group];
+            for ( auto i = next++; i < _group_sizes[_group]; i = next++ ) {
+                try {
+                    _replicate( _conn, _group, i );
+                }
+                catch ( const irods::exception& e ) {
+                    irods::log( e );
+                }
+            }
+        };
+
+        if ( !workers.empty() ) {
+            irods::thread_pool pool{ static_cast<int>( workers.size() ) };
+            for ( auto& w : workers ) {
+                irods::thread_pool::post( pool, [&drain, &w] {
+                    drain( static_cast<rcComm_t*>( w.conn ), w.group );
+                } );
+            }
+            pool.join();
+        }
+
+        // Replications of groups which did not get a worker are carried out by this agent.
+        for ( std::size_t group = 0; group < _group_sizes.size(); ++group ) {
+            drain( nullptr, group );
+        }
+    }
+
+    std::size_t get_replication_concurrency( irods::plugin_context& _ctx ) {
+        auto concurrency{ irods::DEFAULT_REPLICATION_CONCURRENCY };
+        if ( !_ctx.prop_map().get< decltype( concurrency ) >( irods::REPLICATION_CONCURRENCY_KW, concurrency ).ok() ) {
+            return irods::DEFAULT_REPLICATION_CONCURRENCY;
+        }
+        return std::max< std::size_t >( concurrency, 1 );
+    }
+} // namespace irods
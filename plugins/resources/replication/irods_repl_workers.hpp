@@ -0,0 +1,31 @@
+#ifndef _IRODS_REPL_WORKERS_HPP_
+#define _IRODS_REPL_WORKERS_HPP_
+
+#include "irods_plugin_context.hpp"
+#include "rcConnect.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace irods {
+    // Performs replication _index of group _group. _conn is the connection of the
+    // worker performing it, or null if the replication is to be carried out by this agent.
+    using replication_function_t = std::function<void(rcComm_t* _conn, std::size_t _group, std::size_t _index)>;
+
+    // Calls _replicate once for every replication in every group, running up to
+    // _concurrency_per_group replications of each group at the same time.
+    // rsDataObjRepl cannot run on several threads of one agent, so every worker
+    // drives its own connection to the local server, opened on behalf of the client.
+    // Everything runs serially on the calling thread when _concurrency_per_group is 1.
+    void run_replications(
+        irods::plugin_context& _ctx,
+        const std::vector<std::size_t>& _group_sizes,
+        std::size_t _concurrency_per_group,
+        const replication_function_t& _replicate );
+
+    // Returns the replication_concurrency property of the resource in _ctx
+    std::size_t get_replication_concurrency( irods::plugin_context& _ctx );
+}
+
+#endif // _IRODS_REPL_WORKERS_HPP_
@@ -1607,6 +1607,7 @@ class repl_resource : public irods::resource {
                     properties_.set< decltype( irods::DEFAULT_RETRY_ATTEMPTS ) >( irods::RETRY_ATTEMPTS_KW, irods::DEFAULT_RETRY_ATTEMPTS );
                     properties_.set< decltype( irods::DEFAULT_RETRY_FIRST_DELAY_IN_SECONDS ) >( irods::RETRY_FIRST_DELAY_IN_SECONDS_KW, irods::DEFAULT_RETRY_FIRST_DELAY_IN_SECONDS );
                     properties_.set< decltype( irods::DEFAULT_RETRY_BACKOFF_MULTIPLIER ) >( irods::RETRY_BACKOFF_MULTIPLIER_KW, irods::DEFAULT_RETRY_BACKOFF_MULTIPLIER );
+                    properties_.set< decltype( irods::DEFAULT_REPLICATION_CONCURRENCY ) >( irods::REPLICATION_CONCURRENCY_KW, irods::DEFAULT_REPLICATION_CONCURRENCY );
                     return;
                 }
 
@@ -1706,6 +1707,38 @@ class repl_resource : public irods::resource {
                 }
                 properties_.set< decltype( backoff_multiplier ) >( irods::RETRY_BACKOFF_MULTIPLIER_KW, backoff_multiplier );
 
+                // The number of siblings replicated to at the same time after a create or write
+                auto replication_concurrency = irods::DEFAULT_REPLICATION_CONCURRENCY;
+                if ( kvp_map.find( irods::REPLICATION_CONCURRENCY_KW ) != kvp_map.end() ) {
+                    try {
+                        // boost::lexical_cast does not raise errors on negatives when casting to unsigned
+                        const int int_replication_concurrency = boost::lexical_cast< int >( kvp_map[ irods::REPLICATION_CONCURRENCY_KW ] );
+                        if ( int_replication_concurrency <= 0 ) {
+                            irods::log( ERROR( SYS_INVALID_INPUT_PARAM,
+                                           boost::format(
+                                           "[%s] - [%s] for resource [%s] is <= 0; using default value [%d]" ) %
+                                           __FUNCTION__ %
+                                           irods::REPLICATION_CONCURRENCY_KW.c_str() %
+                                           _inst_name %
+                                           irods::DEFAULT_REPLICATION_CONCURRENCY ) );
+                        }
+                        else {
+                            replication_concurrency = static_cast< decltype( replication_concurrency ) >( int_replication_concurrency );
+                        }
+                    }
+                    catch ( const boost::bad_lexical_cast& ) {
+                        irods::log( ERROR( SYS_INVALID_INPUT_PARAM,
+                                        boost::format(
+                                        "[%s] - failed to cast [%s] for resource [%s] to value [%s]; using default value [%d]") %
+                                        __FUNCTION__ %
+                                        irods::REPLICATION_CONCURRENCY_KW.c_str() %
+                                        _inst_name %
+                                        kvp_map[ irods::REPLICATION_CONCURRENCY_KW ] %
+                                        irods::DEFAULT_REPLICATION_CONCURRENCY ) );
+                    }
+                }
+                properties_.set< decltype( replication_concurrency ) >( irods::REPLICATION_CONCURRENCY_KW, replication_concurrency );
+
                 if ( kvp_map.find( READ_KW ) != kvp_map.end() ) {
                     properties_.set< std::string >( READ_KW, kvp_map[ READ_KW ] );
                 }
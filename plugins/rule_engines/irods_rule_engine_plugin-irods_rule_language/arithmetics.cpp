@@ -915,12 +915,14 @@ Res* getSessionVar( char *action,  Node *node, char *varName,  ruleExecInfo_t *r
     /* Maps varName to the standard name and make varMap point to it. */
     /* It seems that for each pair of varName and standard name there is a list of actions that are supported. */
     /* vinx stores the index of the current pair so that we can start for the next pair if the current pair fails. */
-    char *varMap = NULL;
-    for ( int vinx = getVarMap( action, varName, &varMap, 0 ); vinx >= 0;
-            vinx = getVarMap( action, varName, &varMap, vinx + 1 ) ) {
+    /* The mappings are looked up in an index, and most variable maps are read by a typed getter instead of the generated getters. */
+    const char *varMap = NULL;
+    VarMapGetter getter = NULL;
+    for ( int vinx = getVarMapAndGetter( action, varName, &varMap, &getter, 0 ); vinx >= 0;
+            vinx = getVarMapAndGetter( action, varName, &varMap, &getter, vinx + 1 ) ) {
         /* Get the value of session variable referenced by varMap. */
         Res *varValue = NULL;
-        int i = getVarValue( varMap, rei, &varValue, r ); /* reVariableMap.c */
+        int i = getVarValueWithGetter( varMap, getter, rei, &varValue, r ); /* reVariableMap.c */
         if ( i >= 0 ) {
 
             FunctionDesc *fd = ( FunctionDesc * ) lookupFromEnv( ruleEngineConfig.extFuncDescIndex, varMap );
@@ -929,18 +931,13 @@ Res* getSessionVar( char *action,  Node *node, char *varName,  ruleExecInfo_t *r
                 Hashtable *tvarEnv = newHashTable2( 10, r );
                 varValue = processCoercion( node, varValue, type, tvarEnv, errmsg, r );
             }
-            free( varMap );
             return varValue;
         }
         else if ( i != NULL_VALUE_ERR ) {  /* On error, return 0. */
-            free( varMap );
             return NULL;
         }
-        free( varMap );
-        varMap = NULL;
         /* Try next varMap */
     }
-    free( varMap );
     return NULL;
 }
 
@@ -1269,16 +1266,20 @@ Res *execRule( char *ruleNameInp, Res** args, unsigned int argc, int applyAllRul
     int systemSpaceRuleFlag = ( reiSaveFlag & SYSTEM_SPACE_RULE ) != 0 || lookupFromHashTable( ruleEngineConfig.coreFuncDescIndex->current, ruleName ) != NULL ? SYSTEM_SPACE_RULE : 0;
     int _reiSaveFlag = reiSaveFlag & SAVE_REI;
 
+    /* ruleInx counts the rules tried, the cursor remembers where the next rule is */
+    RuleIndexCursor cursor;
+    if ( systemSpaceRuleFlag != 0 ) {
+        initRuleIndexCursor( &cursor, ruleEngineConfig.coreFuncDescIndex );
+    }
+    else {
+        initRuleIndexCursor( &cursor, isComponentInitialized( ruleEngineConfig.extFuncDescIndexStatus ) ? ruleEngineConfig.extFuncDescIndex : NULL );
+    }
+
     RuleIndexListNode *ruleIndexListNode;
     int success = 0;
     int first = 1;
     while ( 1 ) {
-        if ( systemSpaceRuleFlag != 0 ) {
-            statusI = findNextRuleFromIndex( ruleEngineConfig.coreFuncDescIndex, ruleName, ruleInx, &ruleIndexListNode );
-        }
-        else {
-            statusI = findNextRule2( ruleName, ruleInx, &ruleIndexListNode );
-        }
+        statusI = findNextRuleFromCursor( &cursor, ruleName, &ruleIndexListNode );
 
         if ( statusI != 0 ) {
             if ( applyAllRule == 0 ) {
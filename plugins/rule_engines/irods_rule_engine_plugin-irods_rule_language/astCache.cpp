@@ -0,0 +1,118 @@
+/* For copyright information please refer to files in the COPYRIGHT directory
+ */
+#include "astCache.hpp"
+
+#include <cstring>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    typedef std::list<std::pair<std::string, AstCacheEntry *> > LruList;
+
+    /* most recently used first */
+    LruList lru;
+    std::unordered_map<std::string, LruList::iterator> entries;
+
+    std::string astCacheKey( AstCacheKind kind, const char *text, const std::string &signature ) {
+        std::string key;
+        key.reserve( signature.size() + strlen( text ) + 2 );
+        key += static_cast<char>( '0' + kind );
+        key += signature;
+        key += '\0';
+        key += text;
+        return key;
+    }
+
+    void freeAstCacheEntry( AstCacheEntry *entry ) {
+        /* the entry itself lives in its region */
+        region_free( entry->r );
+    }
+
+    void dropAstCacheEntry( AstCacheEntry *entry ) {
+        entry->stale = 1;
+        if ( entry->refCount == 0 ) {
+            freeAstCacheEntry( entry );
+        }
+    }
+}
+
+std::string msParamArraySignature( msParamArray_t *msParamArray ) {
+    std::string signature;
+    if ( msParamArray == NULL ) {
+        return signature;
+    }
+    int i;
+    for ( i = 0; i < msParamArray->len; i++ ) {
+        msParam_t *p = msParamArray->msParam[i];
+        signature += p->label == NULL ? "" : p->label;
+        signature += ':';
+        signature += p->type == NULL ? "" : p->type;
+        signature += ';';
+    }
+    return signature;
+}
+
+AstCacheEntry *lookupAstCache( AstCacheKind kind, const char *text, const std::string &signature ) {
+    auto it = entries.find( astCacheKey( kind, text, signature ) );
+    if ( it == entries.end() ) {
+        return NULL;
+    }
+    /* move to the front of the lru list */
+    lru.splice( lru.begin(), lru, it->second );
+    AstCacheEntry *entry = it->second->second;
+    entry->refCount++;
+    return entry;
+}
+
+AstCacheEntry *newAstCacheEntry() {
+    Region *r = make_region( 0, NULL );
+    AstCacheEntry *entry = ( AstCacheEntry * )region_alloc( r, sizeof( AstCacheEntry ) );
+    memset( entry, 0, sizeof( AstCacheEntry ) );
+    entry->r = r;
+    entry->refCount = 1;
+    /* not in the cache yet */
+    entry->stale = 1;
+    return entry;
+}
+
+void insertIntoAstCache( AstCacheKind kind, const char *text, const std::string &signature, AstCacheEntry *entry ) {
+    std::string key = astCacheKey( kind, text, signature );
+    auto it = entries.find( key );
+    if ( it != entries.end() ) {
+        AstCacheEntry *old = it->second->second;
+        lru.erase( it->second );
+        entries.erase( it );
+        dropAstCacheEntry( old );
+    }
+
+    lru.emplace_front( key, entry );
+    entries.emplace( std::move( key ), lru.begin() );
+    entry->stale = 0;
+
+    while ( lru.size() > AST_CACHE_SIZE ) {
+        AstCacheEntry *victim = lru.back().second;
+        entries.erase( lru.back().first );
+        lru.pop_back();
+        dropAstCacheEntry( victim );
+    }
+}
+
+void releaseAstCacheEntry( AstCacheEntry *entry ) {
+    entry->refCount--;
+    if ( entry->refCount == 0 && entry->stale ) {
+        freeAstCacheEntry( entry );
+    }
+}
+
+void invalidateAstCache() {
+    for ( auto &p : lru ) {
+        dropAstCacheEntry( p.second );
+    }
+    lru.clear();
+    entries.clear();
+}
+
+int astCacheSize() {
+    return static_cast<int>( lru.size() );
+}
@@ -84,16 +84,37 @@ Cache *copyCache( unsigned char **p, size_t size, Cache *ptr ) {
 }
 
 /*
- * Restore a Cache struct from buf into a malloc'd buffer.
- * This function returns NULL if failed to acquire or release the mutex.
+ * Restore a Cache struct from shared memory.
+ * The shared cache is laid out for SHM_BASE_ADDR by updateCache. If the shared memory can be mapped at that address,
+ * it is mapped copy-on-write and used in place: no data is copied and no pointer is relocated, the pages are shared with
+ * the other agents until an agent writes to them.
+ * Otherwise, the cache is restored into a malloc'd buffer.
  * It first create a local copy of buf's data section and pointer pointers section. This part needs synchronization.
  * Then it works on its local copy, which does not need synchronization.
+ * This function returns NULL if failed to acquire or release the mutex.
+ * The address of the restored cache must be released with freeCacheAddress.
  */
 Cache *restoreCache( const char* _inst_name ) {
     mutex_type *mutex;
     lockReadMutex(_inst_name, &mutex);
-    unsigned char *buf = prepareNonServerSharedMemory( _inst_name );
+    unsigned char *buf = mapSharedMemoryAt( _inst_name, SHM_BASE_ADDR );
+    if ( buf != NULL ) {
+        Cache *cache = ( Cache * ) buf;
+        /* a cache laid out for another address, for example by an older server, is restored by copying */
+        if ( cache->address == buf ) {
+            unlockReadMutex(_inst_name, &mutex);
+#ifdef RE_CACHE_CHECK
+            Hashtable *objectMap = newHashTable( 100 );
+            cacheChkEnv( cache->coreFuncDescIndex, cache, ( CacheChkFuncType * ) cacheChkNode, objectMap );
+            cacheChkRuleSet( cache->coreRuleSet, cache, objectMap );
+#endif
+            return cache;
+        }
+        unmapSharedMemory( buf );
+    }
+    buf = prepareNonServerSharedMemory( _inst_name );
     if (buf == NULL) {
+        unlockReadMutex(_inst_name, &mutex);
         return NULL;
     }
     Cache *cache = ( Cache * ) buf;
@@ -153,6 +174,12 @@ Cache *restoreCache( const char* _inst_name ) {
 #endif
     return cacheCopy;
 }
+void freeCacheAddress( unsigned char *address ) {
+    if ( address != NULL && !unmapSharedMemory( address ) ) {
+        free( address );
+    }
+}
+
 void applyDiff( unsigned char *pointers, long pointersSize, long diff, long pointerDiff ) {
     unsigned char *p;
 #ifdef DEBUG_VERBOSE
@@ -197,6 +224,9 @@ void applyDiffToPointers( unsigned char *pointers, long pointersSize, long point
  * 		   or when the processType is RULE_ENGINE_REFRESH_CACHE, which means that we want to refresh the cache with the new cache.
  * It prepares the data in the new cache for copying into the shared cache.
  * It checks the timestamp again and does the actually copying.
+ * The pointers are relocated to SHM_BASE_ADDR, where restoreCache maps the shared cache to use it in place.
+ * Agents may be using the current shared cache in place, so it is replaced by new shared memory instead of being
+ * overwritten. Their mappings keep the old shared memory until they release it.
  */
 int updateCache( const char* _inst_name, size_t size, Cache *cache ) {
         unsigned char *buf = ( unsigned char * ) malloc( size );
@@ -209,13 +239,15 @@ int updateCache( const char* _inst_name, size_t size, Cache *cache ) {
                 printf( "Buffer usage: %fM\n", ( ( double )( cacheCopy->dataSize ) ) / ( 1024 * 1024 ) );
 #endif
                 size_t pointersSize = ( cacheCopy->address + cacheCopy->cacheSize ) - cacheCopy->pointers;
+                long pointersOffset = cacheCopy->pointers - cacheCopy->address;
                 mutex_type *mutex;
                 lockWriteMutex(_inst_name, &mutex);
+                removeSharedMemory( _inst_name );
                 unsigned char *shared = prepareServerSharedMemory( _inst_name );
                 if (shared == NULL) {
                     ret = -1;
                 } else {
-                    long diff = shared - cacheCopy->address;
+                    long diff = ( unsigned char * ) SHM_BASE_ADDR - cacheCopy->address;
                     unsigned char *pointers = cacheCopy->pointers;
 
                     applyDiff( pointers, pointersSize, diff, 0 );
@@ -225,7 +257,7 @@ int updateCache( const char* _inst_name, size_t size, Cache *cache ) {
                     /* copy data */
                     memcpy( shared, buf, cacheCopy->dataSize );
                     /* copy pointers */
-                    memcpy( cacheCopy->pointers, pointers, pointersSize );
+                    memcpy( shared + pointersOffset, pointers, pointersSize );
                     ret = 0;
                     detachSharedMemory( _inst_name );
                 }
@@ -7,6 +7,7 @@
 #include "rules.hpp"
 #include "index.hpp"
 #include "cache.hpp"
+#include "astCache.hpp"
 #include "locks.hpp"
 #include "region.h"
 #include "functions.hpp"
@@ -24,6 +25,7 @@
 
 #include "irods_get_full_path_for_config_file.hpp"
 #include "irods_log.hpp"
+#include "irods_re_ruleexistshelper.hpp"
 #include <boost/filesystem.hpp>
 
 #ifdef DEBUG
@@ -69,11 +71,13 @@ Cache ruleEngineConfig;
 
 void clearRuleEngineConfig() {
   int resources = 0xf00;
+  /* cached asts were typed against the rule base being cleared */
+  invalidateAstCache();
   clearRegion (APP, app);
   clearRegion (CORE, core);
   clearRegion (SYS, sys);
   clearRegion (EXT, ext);
-  free(ruleEngineConfig.address);
+  freeCacheAddress(ruleEngineConfig.address);
   memset (&ruleEngineConfig, 0, sizeof(Cache));
 }
 
@@ -129,6 +133,8 @@ void prependRuleIntoAppIndex( RuleDesc *rule, int i, Region *r ) {
 }
 int checkPointExtRuleSet( Region *r ) {
     ruleEngineConfig.extFuncDescIndex = newEnv( newHashTable2( 100, r ), ruleEngineConfig.extFuncDescIndex, NULL, r );
+    /* rules defined by the rule text are visible until popExtRuleSet */
+    RuleExistsHelper::Instance()->invalidateCache();
     return ruleEngineConfig.extRuleSet->len;
 }
 /*void appendAppRule(RuleDesc *rd, Region *r) {
@@ -140,6 +146,8 @@ void prependAppRule( RuleDesc *rd, Region *r ) {
     int i = ruleEngineConfig.appRuleSet->len++;
     ruleEngineConfig.appRuleSet->rules[i] = rd;
     prependRuleIntoAppIndex( rd, i, r );
+    RuleExistsHelper::Instance()->invalidateCache();
+    invalidateAstCache();
 }
 void popExtRuleSet( int checkPoint ) {
     /*int i;
@@ -150,6 +158,7 @@ void popExtRuleSet( int checkPoint ) {
     ruleEngineConfig.extFuncDescIndex = temp->previous;
     /* deleteEnv(temp, 1); */
     ruleEngineConfig.extRuleSet->len = checkPoint;
+    RuleExistsHelper::Instance()->invalidateCache();
 }
 RuleEngineStatus getRuleEngineStatus() {
     return ruleEngineConfig.ruleEngineStatus;
@@ -167,6 +176,8 @@ void setRuleEngineMemStatus(RuleEngineStatus s) {
 	_ruleEngineMemStatus = s;
 } */
 int clearResources( int resources ) {
+    /* cached asts were typed against the rule base being cleared */
+    invalidateAstCache();
     clearFuncDescIndex( APP, app );
     clearFuncDescIndex( SYS, sys );
     clearFuncDescIndex( CORE, core );
@@ -180,7 +191,7 @@ int clearResources( int resources ) {
     clearRuleSet( EXT, ext );
 
     if ( ( resources & RESC_CACHE ) && isComponentAllocated( ruleEngineConfig.cacheStatus ) ) {
-        free( ruleEngineConfig.address );
+        freeCacheAddress( ruleEngineConfig.address );
         ruleEngineConfig.address = NULL;
         ruleEngineConfig.cacheStatus = UNINITIALIZED;
     }
@@ -239,7 +250,7 @@ void clearDelayed() {
     }
     n = memoryToFree.head;
     while ( n != NULL ) {
-        free( n->value );
+        freeCacheAddress( ( unsigned char * ) n->value );
         listRemoveNoRegion( &memoryToFree, n );
         n = memoryToFree.head;
     }
@@ -322,10 +333,12 @@ int clearAppRuleIndex( ) {
 int createCoreRuleIndex( ) {
         createRuleNodeIndex( ruleEngineConfig.coreRuleSet, ruleEngineConfig.coreFuncDescIndex->current, CORE_RULE_INDEX_OFF, ruleEngineConfig.coreRegion );
         createCondIndex( ruleEngineConfig.coreRegion );
+        compileRuleIndex( ruleEngineConfig.coreFuncDescIndex->current, ruleEngineConfig.coreRegion );
     return 0;
     }
 int createAppRuleIndex( ) {
         createRuleNodeIndex( ruleEngineConfig.appRuleSet, ruleEngineConfig.appFuncDescIndex->current, APP_RULE_INDEX_OFF, ruleEngineConfig.appRegion );
+        compileRuleIndex( ruleEngineConfig.appFuncDescIndex->current, ruleEngineConfig.appRegion );
     return 0;
 
 }
@@ -539,7 +552,7 @@ int loadRuleFromCacheOrFile( const char* inst_name, const char *irbSet ) {
 
                     if ( diffIrbSet || time_type_gt( timestamp, cache->timestamp ) || diffHash ) {
                         update = 1;
-                        free( cache->address );
+                        freeCacheAddress( cache->address );
                         rodsLog( LOG_DEBUG, "Rule base set or rule files modified, force refresh." );
                     } else {
                         cache->cacheStatus = INITIALIZED;
@@ -0,0 +1,61 @@
+#ifndef IRODS_NREP_AST_CACHE_HPP
+#define IRODS_NREP_AST_CACHE_HPP
+
+#include "restructs.hpp"
+#include "region.h"
+#include "msParam.h"
+
+#include <string>
+
+/* The parsed and typed ASTs of rule texts and expressions submitted through
+ * exec_rule_text and exec_rule_expression, so that running the same text again
+ * skips the parser and the type checker.
+ * Entries are keyed by the text and the signature of its parameters, evicted in
+ * least recently used order, and dropped when the rule base changes. */
+
+/* the maximum number of cached texts */
+#define AST_CACHE_SIZE 256
+
+typedef enum astCacheKind {
+    AST_CACHE_RULE_TEXT,
+    AST_CACHE_EXPRESSION
+} AstCacheKind;
+
+typedef struct astCacheEntry {
+    Region *r;                  /* the long-lived region holding the ASTs, owned by the cache */
+    /* AST_CACHE_RULE_TEXT */
+    RuleDesc **rules;           /* the typed rules in the order they appear in the text */
+    int len;
+    char **fdNames;             /* constructors and external functions declared by the text */
+    FunctionDesc **fds;
+    int fdLen;
+    /* AST_CACHE_EXPRESSION */
+    Node *node;                 /* the typed expression or actions */
+    /* bookkeeping */
+    int refCount;               /* the number of callers using the entry */
+    int stale;                  /* the entry has been evicted or invalidated, freed when refCount drops to 0 */
+} AstCacheEntry;
+
+/* the labels and types of the parameters, "" if msParamArray is NULL */
+std::string msParamArraySignature( msParamArray_t *msParamArray );
+
+/* returns the entry for the text or NULL
+ * the entry must be released with releaseAstCacheEntry */
+AstCacheEntry *lookupAstCache( AstCacheKind kind, const char *text, const std::string &signature );
+
+/* returns an empty entry owning a new region, to be filled in by the caller and passed to insertIntoAstCache */
+AstCacheEntry *newAstCacheEntry();
+
+/* adds a filled in entry to the cache, evicting the least recently used entries if the cache is full
+ * the entry must be released with releaseAstCacheEntry */
+void insertIntoAstCache( AstCacheKind kind, const char *text, const std::string &signature, AstCacheEntry *entry );
+
+/* releases an entry returned by lookupAstCache, passed to insertIntoAstCache, or never inserted */
+void releaseAstCacheEntry( AstCacheEntry *entry );
+
+/* drops every entry, must be called whenever the rule base changes */
+void invalidateAstCache();
+
+int astCacheSize();
+
+#endif // IRODS_NREP_AST_CACHE_HPP
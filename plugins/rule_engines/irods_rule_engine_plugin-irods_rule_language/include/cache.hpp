@@ -16,6 +16,9 @@ Cache *copyCache( unsigned char **buf, size_t size, Cache *c );
 
 Cache *restoreCache( const char* );
 
+/* releases the address of a cache returned by restoreCache, whether it is mapped or malloc'd */
+void freeCacheAddress( unsigned char *address );
+
 void applyDiff( unsigned char *pointers, long pointersSize, long diff, long pointerDiff );
 
 void applyDiffToPointers( unsigned char *pointers, long pointersSize, long pointerDiff );
@@ -154,6 +154,8 @@ void prependAppRule( RuleDesc *rd, Region *r );
 void popExtRuleSet( int checkPoint );
 void clearDelayed();
 int generateFunctionDescriptionTables();
+void generateRegions();
+void generateRuleSets();
 int readICatUserInfo( char *userName, char *attr, char userInfo[MAX_NAME_LEN], rsComm_t *rsComm );
 int writeICatUserInfo( char *userName, char *attr, char *userInfo, rsComm_t *rsComm );
 int readICatUserLogging( char *userName, int *logging, rsComm_t *rsComm );
@@ -13,6 +13,15 @@
 
 #define COND_INDEX_THRESHOLD 2
 
+/* iterates over the rules of an action in a chain of indices */
+/* each step takes constant time instead of walking the rule list from its head */
+typedef struct ruleIndexCursor {
+    Env *ruleIndex;             /* the index being searched, NULL when there are no more rules */
+    RuleIndexList *list;        /* the rules of the action in ruleIndex, NULL if not looked up yet */
+    int pos;                    /* the position of the next rule in list->nodes */
+    RuleIndexListNode *next;    /* the next rule if list has not been compiled */
+} RuleIndexCursor;
+
 char *convertRuleNameArityToKey( char *ruleName, int arity );
 RuleIndexList *newRuleIndexList( char *ruleName, int ruleIndex, Region *r );
 RuleIndexListNode *newRuleIndexListNode( int ruleIndex, RuleIndexListNode *prev, RuleIndexListNode *next, Region *r );
@@ -44,6 +53,10 @@ int createFuncMapDefIndex( rulefmapdef_t *inFuncStrct1, Hashtable **ruleIndex );
 int mapExternalFuncToInternalProc2( char *funcName );
 int findNextRuleFromIndex( Env *ruleIndex, const char *action, int i, RuleIndexListNode **node );
 int findNextRule2( const char *action,  int i, RuleIndexListNode **node );
+void initRuleIndexCursor( RuleIndexCursor *cursor, Env *ruleIndex );
+int findNextRuleFromCursor( RuleIndexCursor *cursor, const char *action, RuleIndexListNode **node );
+void compileRuleIndexList( RuleIndexList *list, Region *r );
+int compileRuleIndex( Hashtable *ruleIndex, Region *r );
 int actionTableLookUp2( char *action );
 void deleteCondIndexVal( CondIndexVal *h );
 void insertIntoRuleIndexList( RuleIndexList *rd, RuleIndexListNode *prev, CondIndexVal *civ, Region *r );
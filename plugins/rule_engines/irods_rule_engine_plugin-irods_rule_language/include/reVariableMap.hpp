@@ -20,9 +20,23 @@ int setStructPtrLeafValue( void **leafPtr, Res *newVarValue );
 int setBufferPtrLeafValue( bytesBuf_t **leafPtr, Res *newVarValue );
 int getVarMap( char *action, char *varName, char **varMap, int index );
 
+/* reads the variable of ruleExecInfo_t a variable map such as "rei->doi->objPath" refers to */
+typedef int ( *VarMapGetter )( ruleExecInfo_t *rei, Res **varValue, Region *r );
+
+/* returns the getter for a variable map, or NULL if the variable map is resolved by the generated getters */
+VarMapGetter lookupVarMapGetter( const char *varMap );
+
+/* like getVarMap, but looks up the mappings of the variable in an index and returns the
+ * variable map without copying it, together with its getter */
+int getVarMapAndGetter( const char *action, const char *varName, const char **varMap, VarMapGetter *getter, int index );
+
+/* must be called whenever appRuleVarDef or coreRuleVarDef changes */
+void clearVarDefIndex();
+
 ExprType *getVarType( char *varMap, Region *r );
 
 int getVarValue( char *varMap, ruleExecInfo_t *rei, Res **varValue, Region *r );
+int getVarValueWithGetter( const char *varMap, VarMapGetter getter, ruleExecInfo_t *rei, Res **varValue, Region *r );
 int getVarNameFromVarMap( char *varMap, char *varName, char **varMapCPtr );
 
 #define REVARIABLEMAP_HPP_
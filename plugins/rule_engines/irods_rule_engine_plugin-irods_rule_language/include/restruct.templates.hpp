@@ -62,6 +62,8 @@ RE_STRUCT_BEGIN( RuleIndexList )
 MK_PTR( RuleIndexListNode, head )
 MK_PTR( RuleIndexListNode, tail )
 MK_VAR_ARRAY( char, ruleName )
+MK_VAL( int, len )
+MK_PTR_ARRAY( RuleIndexListNode, len, nodes )
 RE_STRUCT_END( RuleIndexList )
 
 RE_STRUCT_GENERIC_BEGIN( Env, T )
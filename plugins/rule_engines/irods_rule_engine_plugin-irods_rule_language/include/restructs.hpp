@@ -217,9 +217,15 @@ typedef struct ruleIndexListNode {
     CondIndexVal *condIndex;
 } RuleIndexListNode;
 
+typedef RuleIndexListNode *RuleIndexListNodePtr;
+
 typedef struct ruleIndexList {
     char *ruleName;
     RuleIndexListNode *head, *tail;
+    /* the nodes from head to tail in a contiguous array, compiled when the rule base is loaded */
+    /* nodes is NULL if the list has been modified since it was compiled */
+    int len;
+    RuleIndexListNode **nodes;
 } RuleIndexList;
 
 typedef struct env Env;
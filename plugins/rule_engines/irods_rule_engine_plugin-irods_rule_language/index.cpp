@@ -166,7 +166,13 @@ int createCondIndex( Region *r ) {
     return 1;
 
 }
+/* the compiled array no longer matches the list */
+static void invalidateRuleIndexList( RuleIndexList *rd ) {
+    rd->len = 0;
+    rd->nodes = NULL;
+}
 void insertIntoRuleIndexList( RuleIndexList *rd, RuleIndexListNode *prev, CondIndexVal *civ, Region *r ) {
+    invalidateRuleIndexList( rd );
     if ( prev == NULL ) {
         RuleIndexListNode *n = newRuleIndexListNode2( civ, prev, rd->head, r );
         rd->head = n;
@@ -192,6 +198,7 @@ void removeNodeFromRuleIndexList2( RuleIndexList *rd, int i ) {
     }
 }
 void removeNodeFromRuleIndexList( RuleIndexList *rd, RuleIndexListNode *n ) {
+    invalidateRuleIndexList( rd );
     if ( n == rd->head ) {
         rd->head = n->next;
     }
@@ -206,12 +213,14 @@ void removeNodeFromRuleIndexList( RuleIndexList *rd, RuleIndexListNode *n ) {
     }
 }
 void appendRuleNodeToRuleIndexList( RuleIndexList *list, int i, Region *r ) {
+    invalidateRuleIndexList( list );
     RuleIndexListNode *listNode = newRuleIndexListNode( i, list->tail, NULL, r );
     list->tail ->next = listNode;
     list->tail = listNode;
 
 }
 void prependRuleNodeToRuleIndexList( RuleIndexList *list, int i, Region *r ) {
+    invalidateRuleIndexList( list );
     RuleIndexListNode *listNode = newRuleIndexListNode( i, NULL, list->head, r );
     listNode->next = list->head;
     list->head = listNode;
@@ -296,19 +305,28 @@ int findNextRuleFromIndex( Env *ruleIndex, const char *action, int i, RuleIndexL
                 return NO_MORE_RULES_ERR;
             }
             RuleIndexList *l = FD_RULE_INDEX_LIST( fd );
-            RuleIndexListNode *b = l->head;
-            while ( k != 0 ) {
-                if ( b != NULL ) {
-                    b = b->next;
-                    k--;
-                }
-                else {
-                    break;
+            if ( l->nodes != NULL ) {
+                if ( k < l->len ) {
+                    *node = l->nodes[k];
+                    return 0;
                 }
+                k -= l->len;
             }
-            if ( b != NULL ) {
-                *node = b;
-                return 0;
+            else {
+                RuleIndexListNode *b = l->head;
+                while ( k != 0 ) {
+                    if ( b != NULL ) {
+                        b = b->next;
+                        k--;
+                    }
+                    else {
+                        break;
+                    }
+                }
+                if ( b != NULL ) {
+                    *node = b;
+                    return 0;
+                }
             }
         }
         return findNextRuleFromIndex( ruleIndex->previous, action, k, node );
@@ -334,6 +352,90 @@ int findNextRule2( const char *action,  int i, RuleIndexListNode **node ) {
     }
 }
 
+void initRuleIndexCursor( RuleIndexCursor *cursor, Env *ruleIndex ) {
+    cursor->ruleIndex = ruleIndex;
+    cursor->list = NULL;
+    cursor->pos = 0;
+    cursor->next = NULL;
+}
+/**
+ * returns the same sequence of nodes as calling findNextRuleFromIndex with i = 0, 1, 2, ...
+ */
+int findNextRuleFromCursor( RuleIndexCursor *cursor, const char *action, RuleIndexListNode **node ) {
+    while ( cursor->ruleIndex != NULL ) {
+        if ( cursor->list == NULL ) {
+            FunctionDesc *fd = ( FunctionDesc * )lookupFromHashTable( cursor->ruleIndex->current, action );
+            if ( fd == NULL ) {
+                cursor->ruleIndex = cursor->ruleIndex->previous;
+                continue;
+            }
+            if ( getNodeType( fd ) != N_FD_RULE_INDEX_LIST ) {
+                cursor->ruleIndex = NULL;
+                return NO_MORE_RULES_ERR;
+            }
+            cursor->list = FD_RULE_INDEX_LIST( fd );
+            cursor->pos = 0;
+            cursor->next = cursor->list->head;
+        }
+
+        RuleIndexListNode *b = NULL;
+        if ( cursor->list->nodes != NULL ) {
+            if ( cursor->pos < cursor->list->len ) {
+                b = cursor->list->nodes[cursor->pos];
+            }
+        }
+        else {
+            b = cursor->next;
+        }
+
+        if ( b != NULL ) {
+            cursor->pos++;
+            cursor->next = b->next;
+            *node = b;
+            return 0;
+        }
+
+        cursor->list = NULL;
+        cursor->ruleIndex = cursor->ruleIndex->previous;
+    }
+
+    return NO_MORE_RULES_ERR;
+}
+void compileRuleIndexList( RuleIndexList *list, Region *r ) {
+    int len = 0;
+    RuleIndexListNode *n;
+    for ( n = list->head; n != NULL; n = n->next ) {
+        len++;
+    }
+
+    RuleIndexListNode **nodes = ( RuleIndexListNode ** )region_alloc( r, sizeof( RuleIndexListNode * ) * ( len > 0 ? len : 1 ) );
+    int i = 0;
+    for ( n = list->head; n != NULL; n = n->next ) {
+        nodes[i++] = n;
+    }
+
+    list->len = len;
+    list->nodes = nodes;
+}
+/**
+ * compiles every rule list in the index into an array
+ * must be called after createCondIndex, which changes the lists
+ */
+int compileRuleIndex( Hashtable *ruleIndex, Region *r ) {
+    int i;
+    for ( i = 0; i < ruleIndex->size; i++ ) {
+        struct bucket *b = ruleIndex->buckets[i];
+        while ( b != NULL ) {
+            FunctionDesc *fd = ( FunctionDesc * ) b->value;
+            if ( getNodeType( fd ) == N_FD_RULE_INDEX_LIST ) {
+                compileRuleIndexList( FD_RULE_INDEX_LIST( fd ), r );
+            }
+            b = b->next;
+        }
+    }
+    return 1;
+}
+
 int mapExternalFuncToInternalProc2( char *funcName ) {
     int *i;
 
@@ -371,6 +473,7 @@ RuleIndexList *newRuleIndexList( char *ruleName, int ruleIndex, Region *r ) {
     RuleIndexList *list = ( RuleIndexList * )region_alloc( r, sizeof( RuleIndexList ) );
     list->ruleName = cpStringExt( ruleName, r );
     list->head = list->tail = newRuleIndexListNode( ruleIndex, NULL, NULL, r );
+    invalidateRuleIndexList( list );
     return list;
 }
 
@@ -13,6 +13,7 @@
 #include "locks.hpp"
 #include "functions.hpp"
 #include "configuration.hpp"
+#include "reVariableMap.hpp"
 #include "rsGenQuery.hpp"
 #include "irods_log.hpp"
 #include "irods_get_full_path_for_config_file.hpp"
@@ -339,6 +340,7 @@ initRuleStruct( const char* inst_name, rsComm_t *svrComm, const char *irbSet, co
     snprintf( r2, sizeof( r2 ), "%s", dvmSet );
     coreRuleVarDef.MaxNumOfDVars = 0;
     appRuleVarDef.MaxNumOfDVars = 0;
+    clearVarDefIndex();
 
     while ( strlen( r2 ) > 0 ) {
         i = rSplitStr( r2, r1, NAME_LEN, r3, RULE_SET_DEF_LENGTH, ',' );
@@ -599,6 +601,7 @@ readDVMapStructFromDB( char *dvmBaseName, char *versionStr, rulevardef_t *inDvmS
 	freeGenQueryOut( &genQueryOut );
     clearGenQueryInp( &genQueryInp );
     inDvmStrct->MaxNumOfDVars = l;
+    clearVarDefIndex();
     return 0;
 }
 
@@ -770,6 +773,7 @@ int clearDVarStruct( rulevardef_t *inRuleVarDef ) {
         }
     }
     inRuleVarDef->MaxNumOfDVars =  0;
+    clearVarDefIndex();
     return 0;
 }
 
@@ -855,6 +859,7 @@ readDVarStructFromFile( char *dvarBaseName, rulevardef_t *inRuleVarDef ) {
     }
     fclose( file );
     inRuleVarDef->MaxNumOfDVars = ( long int )  i;
+    clearVarDefIndex();
     return 0;
 }
 
@@ -5,6 +5,7 @@
 #include "reGlobalsExtern.hpp"
 #include "conversion.hpp"
 #include "reVariableMap.gen.hpp"
+#include "reVariableMap.hpp"
 #include "reVariables.hpp"
 #include "rcMisc.h"
 #ifdef DEBUG
@@ -73,42 +74,92 @@ mapExternalFuncToInternalProc( char *funcName ) {
     return 0;
 }
 
-int
-getVarMap( char *action, char *inVarName, char **varMap, int index ) {
-    int i;
-    char *varName;
+/* the data variable mappings by variable name, app mappings before core mappings
+ * as getVarMap searches them, built when a variable is first looked up after the
+ * mappings change */
+typedef struct varDefIndexEntry {
+    int vinx;                   /* i for appRuleVarDef, i + 1000 for coreRuleVarDef */
+    char *action;
+    char *varMap;
+    VarMapGetter getter;
+} VarDefIndexEntry;
+
+static Hashtable *varDefIndex = NULL;
+static VarDefIndexEntry *varDefIndexEntries = NULL;
+
+void clearVarDefIndex() {
+    if ( varDefIndex != NULL ) {
+        deleteHashTable( varDefIndex, nop );
+        varDefIndex = NULL;
+    }
+    free( varDefIndexEntries );
+    varDefIndexEntries = NULL;
+}
 
-    if ( inVarName[0] == '$' ) {
-        varName = inVarName + 1;
+static int addVarDefsToIndex( rulevardef_t *inRuleVarDef, int offset, int k ) {
+    for ( int i = 0; i < inRuleVarDef->MaxNumOfDVars; i++ ) {
+        VarDefIndexEntry *entry = &varDefIndexEntries[k++];
+        entry->vinx = i + offset;
+        entry->action = inRuleVarDef->action[i];
+        entry->varMap = inRuleVarDef->var2CMap[i];
+        entry->getter = lookupVarMapGetter( inRuleVarDef->var2CMap[i] );
+        if ( 0 == insertIntoHashTable( varDefIndex, inRuleVarDef->varName[i], entry ) ) {
+            return -1;
+        }
     }
-    else {
-        varName = inVarName;
+    return k;
+}
+
+/**
+ * returns 0 if out of memory
+ */
+static int createVarDefIndex() {
+    clearVarDefIndex();
+    varDefIndex = newHashTable( MAX_NUM_OF_DVARS * 2 );
+    varDefIndexEntries = ( VarDefIndexEntry * )malloc( sizeof( VarDefIndexEntry ) *
+                         ( appRuleVarDef.MaxNumOfDVars + coreRuleVarDef.MaxNumOfDVars + 1 ) );
+    if ( varDefIndex == NULL || varDefIndexEntries == NULL ) {
+        clearVarDefIndex();
+        return 0;
     }
-    if ( index < 1000 ) {
-        for ( i = index; i < appRuleVarDef.MaxNumOfDVars; i++ ) {
-            if ( !strcmp( appRuleVarDef.varName[i], varName ) ) {
-                if ( strlen( appRuleVarDef.action[i] ) == 0 ||
-                        strstr( appRuleVarDef.action[i], action ) != NULL ) {
-                    *varMap = strdup( appRuleVarDef.var2CMap[i] );
-                    return i;
-                }
-            }
-        }
-        index = 1000;
+    int k = addVarDefsToIndex( &appRuleVarDef, 0, 0 );
+    if ( k < 0 || addVarDefsToIndex( &coreRuleVarDef, 1000, k ) < 0 ) {
+        clearVarDefIndex();
+        return 0;
     }
-    i = index - 1000;
-    for ( ; i < coreRuleVarDef.MaxNumOfDVars; i++ ) {
-        if ( !strcmp( coreRuleVarDef.varName[i], varName ) ) {
-            if ( strlen( coreRuleVarDef.action[i] ) == 0 ||
-                    strstr( coreRuleVarDef.action[i], action ) != NULL ) {
-                *varMap = strdup( coreRuleVarDef.var2CMap[i] );
-                return i + 1000;
-            }
+    return 1;
+}
+
+int
+getVarMapAndGetter( const char *action, const char *inVarName, const char **varMap, VarMapGetter *getter, int index ) {
+    const char *varName = inVarName[0] == '$' ? inVarName + 1 : inVarName;
+
+    if ( varDefIndex == NULL && createVarDefIndex() == 0 ) {
+        return UNKNOWN_VARIABLE_MAP_ERR;
+    }
+    for ( struct bucket *b = lookupBucketFromHashTable( varDefIndex, varName ); b != NULL; b = nextBucket( b, varName ) ) {
+        const VarDefIndexEntry *entry = ( const VarDefIndexEntry * )b->value;
+        if ( entry->vinx >= index &&
+                ( strlen( entry->action ) == 0 || strstr( entry->action, action ) != NULL ) ) {
+            *varMap = entry->varMap;
+            *getter = entry->getter;
+            return entry->vinx;
         }
     }
     return UNKNOWN_VARIABLE_MAP_ERR;
 }
 
+int
+getVarMap( char *action, char *inVarName, char **varMap, int index ) {
+    const char *map;
+    VarMapGetter getter;
+    int i = getVarMapAndGetter( action, inVarName, &map, &getter, index );
+    if ( i >= 0 ) {
+        *varMap = strdup( map );
+    }
+    return i;
+}
+
 
 
 int
@@ -172,6 +223,18 @@ getVarValue( char *varMap, ruleExecInfo_t *rei, Res **varValue, Region *r ) {
     }
 }
 
+int
+getVarValueWithGetter( const char *varMap, VarMapGetter getter, ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( getter != NULL ) {
+        return getter( rei, varValue, r );
+    }
+    /* getVarNameFromVarMap splits the variable map in place */
+    char *varMapCopy = strdup( varMap );
+    int i = getVarValue( varMapCopy, rei, varValue, r );
+    free( varMapCopy );
+    return i;
+}
+
 int
 setVarValue( char *varMap, ruleExecInfo_t *rei, Res *newVarValue ) {
     char varName[NAME_LEN];
@@ -405,13 +468,12 @@ int
 getSessionVarValue( char *action, char *varName, ruleExecInfo_t *rei,
                     char **varValue ) {
     Region *r = make_region( 0, NULL );
-    char *varMap = NULL;
-    int vinx = getVarMap( action, varName, &varMap, 0 );
+    const char *varMap = NULL;
+    VarMapGetter getter = NULL;
+    int vinx = getVarMapAndGetter( action, varName, &varMap, &getter, 0 );
     while ( vinx >= 0 ) {
         Res *res;
-        int i = getVarValue( varMap, rei, &res, r );
-        free( varMap );
-        varMap = NULL;
+        int i = getVarValueWithGetter( varMap, getter, rei, &res, r );
         if ( i != NULL_VALUE_ERR ) {
             if ( i >= 0 ) {
                 *varValue = convertResToString( res );
@@ -419,9 +481,8 @@ getSessionVarValue( char *action, char *varName, ruleExecInfo_t *rei,
             region_free( r );
             return i;
         }
-        vinx = getVarMap( action, varName, &varMap, vinx + 1 );
+        vinx = getVarMapAndGetter( action, varName, &varMap, &getter, vinx + 1 );
     }
-    free( varMap );
     region_free( r );
     return vinx;
 }
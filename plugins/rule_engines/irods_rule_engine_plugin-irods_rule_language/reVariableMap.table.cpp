@@ -0,0 +1,448 @@
+/* For copyright information please refer to files in the COPYRIGHT directory
+ */
+/* Typed getters for the variable maps of the data variable mappings shipped in
+ * core.dvm, so that reading a session variable such as $objPath does not walk
+ * the strcmp chains of reVariableMap.gen.cpp.
+ * Each getter returns exactly what the generated getters return for its
+ * variable map. Variable maps which are not in the table, or which the
+ * generated getters do not resolve, are still resolved by the generated getters.
+ * Keep the table sorted by variable map. */
+#include "reVariableMap.gen.hpp"
+#include "reVariableMap.hpp"
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    int getReiCoiCollAccess( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->coi->collAccess, r );
+    }
+
+    int getReiCoiCollAccessInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->coi->collAccessInx, r );
+    }
+
+    int getReiCoiCollComments( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->coi->collComments, r );
+    }
+
+    int getReiCoiCollInheritance( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->coi->collInheritance, r );
+    }
+
+    int getReiCoiCollName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->coi->collName, r );
+    }
+
+    int getReiCoiCollOwnerName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->coi->collOwnerName, r );
+    }
+
+    int getReiCoiCollParentName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->coi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->coi->collParentName, r );
+    }
+
+    int getReiCondInputData( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getPtrLeafValue( varValue, ( void * ) rei->condInputData, NULL, KeyValPair_MS_T, r );
+    }
+
+    int getReiDoiBackupRescName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->backupRescName, r );
+    }
+
+    int getReiDoiChksum( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->chksum, r );
+    }
+
+    int getReiDoiCollId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getLongLeafValue( varValue, rei->doi->collId, r );
+    }
+
+    int getReiDoiDataAccess( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->dataAccess, r );
+    }
+
+    int getReiDoiDataAccessInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->doi->dataAccessInx, r );
+    }
+
+    int getReiDoiDataComments( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->dataComments, r );
+    }
+
+    int getReiDoiDataId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getLongLeafValue( varValue, rei->doi->dataId, r );
+    }
+
+    int getReiDoiDataOwnerName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->dataOwnerName, r );
+    }
+
+    int getReiDoiDataOwnerZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->dataOwnerZone, r );
+    }
+
+    int getReiDoiDataSize( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getLongLeafValue( varValue, rei->doi->dataSize, r );
+    }
+
+    int getReiDoiDataType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->dataType, r );
+    }
+
+    int getReiDoiDestRescName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->destRescName, r );
+    }
+
+    int getReiDoiFilePath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->filePath, r );
+    }
+
+    int getReiDoiObjPath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->objPath, r );
+    }
+
+    int getReiDoiReplNum( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->doi->replNum, r );
+    }
+
+    int getReiDoiReplStatus( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->doi->replStatus, r );
+    }
+
+    int getReiDoiRescName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->rescName, r );
+    }
+
+    int getReiDoiStatusString( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->statusString, r );
+    }
+
+    int getReiDoiVersion( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doi->version, r );
+    }
+
+    int getReiDoiWriteFlag( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doi == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->doi->writeFlag, r );
+    }
+
+    int getReiDoinpDataSize( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doinp == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getLongLeafValue( varValue, rei->doinp->dataSize, r );
+    }
+
+    int getReiDoinpObjPath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->doinp == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->doinp->objPath, r );
+    }
+
+    int getReiPluginInstanceName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->pluginInstanceName, r );
+    }
+
+    int getReiRsCommApiInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->rsComm == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->rsComm->apiInx, r );
+    }
+
+    int getReiRsCommClientAddr( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->rsComm == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->rsComm->clientAddr, r );
+    }
+
+    int getReiRsCommConnectCnt( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->rsComm == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->rsComm->connectCnt, r );
+    }
+
+    int getReiRsCommOption( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->rsComm == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->rsComm->option, r );
+    }
+
+    int getReiRsCommSock( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->rsComm == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->rsComm->sock, r );
+    }
+
+    int getReiRsCommStatus( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->rsComm == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->rsComm->status, r );
+    }
+
+    int getReiStatus( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->status, r );
+    }
+
+    int getReiUoic( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getPtrLeafValue( varValue, ( void * ) rei->uoic, NULL, UserInfo_MS_T, r );
+    }
+
+    int getReiUoicRodsZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoic == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoic->rodsZone, r );
+    }
+
+    int getReiUoicSysUid( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoic == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getIntLeafValue( varValue, rei->uoic->sysUid, r );
+    }
+
+    int getReiUoicUserName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoic == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoic->userName, r );
+    }
+
+    int getReiUoio( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getPtrLeafValue( varValue, ( void * ) rei->uoio, NULL, UserInfo_MS_T, r );
+    }
+
+    int getReiUoioRodsZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoio == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoio->rodsZone, r );
+    }
+
+    int getReiUoioUserName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoio == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoio->userName, r );
+    }
+
+    int getReiUoioUserType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoio == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoio->userType, r );
+    }
+
+    int getReiUoip( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getPtrLeafValue( varValue, ( void * ) rei->uoip, NULL, UserInfo_MS_T, r );
+    }
+
+    int getReiUoipRodsZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoip == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoip->rodsZone, r );
+    }
+
+    int getReiUoipUserName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+        if ( rei == NULL || rei->uoip == NULL ) {
+            return NULL_VALUE_ERR;
+        }
+        return getStrLeafValue( varValue, rei->uoip->userName, r );
+    }
+
+    typedef struct varMapGetterDef {
+        const char *varMap;
+        VarMapGetter getter;
+    } VarMapGetterDef;
+
+    constexpr VarMapGetterDef varMapGetters[] = {
+        { "rei->coi->collAccess", getReiCoiCollAccess },
+        { "rei->coi->collAccessInx", getReiCoiCollAccessInx },
+        { "rei->coi->collComments", getReiCoiCollComments },
+        { "rei->coi->collInheritance", getReiCoiCollInheritance },
+        { "rei->coi->collName", getReiCoiCollName },
+        { "rei->coi->collOwnerName", getReiCoiCollOwnerName },
+        { "rei->coi->collParentName", getReiCoiCollParentName },
+        { "rei->condInputData", getReiCondInputData },
+        { "rei->doi->backupRescName", getReiDoiBackupRescName },
+        { "rei->doi->chksum", getReiDoiChksum },
+        { "rei->doi->collId", getReiDoiCollId },
+        { "rei->doi->dataAccess", getReiDoiDataAccess },
+        { "rei->doi->dataAccessInx", getReiDoiDataAccessInx },
+        { "rei->doi->dataComments", getReiDoiDataComments },
+        { "rei->doi->dataId", getReiDoiDataId },
+        { "rei->doi->dataOwnerName", getReiDoiDataOwnerName },
+        { "rei->doi->dataOwnerZone", getReiDoiDataOwnerZone },
+        { "rei->doi->dataSize", getReiDoiDataSize },
+        { "rei->doi->dataType", getReiDoiDataType },
+        { "rei->doi->destRescName", getReiDoiDestRescName },
+        { "rei->doi->filePath", getReiDoiFilePath },
+        { "rei->doi->objPath", getReiDoiObjPath },
+        { "rei->doi->replNum", getReiDoiReplNum },
+        { "rei->doi->replStatus", getReiDoiReplStatus },
+        { "rei->doi->rescName", getReiDoiRescName },
+        { "rei->doi->statusString", getReiDoiStatusString },
+        { "rei->doi->version", getReiDoiVersion },
+        { "rei->doi->writeFlag", getReiDoiWriteFlag },
+        { "rei->doinp->dataSize", getReiDoinpDataSize },
+        { "rei->doinp->objPath", getReiDoinpObjPath },
+        { "rei->pluginInstanceName", getReiPluginInstanceName },
+        { "rei->rsComm->apiInx", getReiRsCommApiInx },
+        { "rei->rsComm->clientAddr", getReiRsCommClientAddr },
+        { "rei->rsComm->connectCnt", getReiRsCommConnectCnt },
+        { "rei->rsComm->option", getReiRsCommOption },
+        { "rei->rsComm->sock", getReiRsCommSock },
+        { "rei->rsComm->status", getReiRsCommStatus },
+        { "rei->status", getReiStatus },
+        { "rei->uoic", getReiUoic },
+        { "rei->uoic->rodsZone", getReiUoicRodsZone },
+        { "rei->uoic->sysUid", getReiUoicSysUid },
+        { "rei->uoic->userName", getReiUoicUserName },
+        { "rei->uoio", getReiUoio },
+        { "rei->uoio->rodsZone", getReiUoioRodsZone },
+        { "rei->uoio->userName", getReiUoioUserName },
+        { "rei->uoio->userType", getReiUoioUserType },
+        { "rei->uoip", getReiUoip },
+        { "rei->uoip->rodsZone", getReiUoipRodsZone },
+        { "rei->uoip->userName", getReiUoipUserName },
+    };
+
+    constexpr int compareVarMaps( const char *a, const char *b ) {
+        while ( *a != '\0' && *a == *b ) {
+            a++;
+            b++;
+        }
+        return static_cast<unsigned char>( *a ) - static_cast<unsigned char>( *b );
+    }
+
+    constexpr bool varMapGettersSorted() {
+        for ( size_t i = 1; i < sizeof( varMapGetters ) / sizeof( varMapGetters[0] ); i++ ) {
+            if ( compareVarMaps( varMapGetters[i - 1].varMap, varMapGetters[i].varMap ) >= 0 ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert( varMapGettersSorted(), "varMapGetters must be sorted by variable map without duplicates" );
+}
+
+VarMapGetter lookupVarMapGetter( const char *varMap ) {
+    const VarMapGetterDef *begin = varMapGetters;
+    const VarMapGetterDef *end = varMapGetters + sizeof( varMapGetters ) / sizeof( varMapGetters[0] );
+    const VarMapGetterDef *def = std::lower_bound( begin, end, varMap, []( const VarMapGetterDef &a, const char *b ) {
+        return strcmp( a.varMap, b ) < 0;
+    } );
+    if ( def == end || strcmp( def->varMap, varMap ) != 0 ) {
+        return NULL;
+    }
+    return def->getter;
+}
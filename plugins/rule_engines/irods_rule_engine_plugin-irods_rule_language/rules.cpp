@@ -5,6 +5,7 @@
 #include "reHelpers1.hpp"
 #include "rules.hpp"
 #include "index.hpp"
+#include "astCache.hpp"
 #include "functions.hpp"
 #include "arithmetics.hpp"
 #include "configuration.hpp"
@@ -18,6 +19,9 @@
 
 extern int GlobalAllRuleExecFlag;
 
+static int parseAndComputeRuleWithSignature( char *rule, const std::string *signature, Env *env, ruleExecInfo_t *rei, int reiSaveFlag, rError_t *errmsg, Region *r );
+static Res *parseAndComputeExpressionWithSignature( char *expr, const std::string *signature, Env *env, ruleExecInfo_t *rei, int reiSaveFlag, rError_t *errmsg, Region *r );
+
 
 /**
  * Read a set of rules from files.
@@ -113,6 +117,8 @@ int parseAndComputeRuleAdapter( char *rule, msParamArray_t *msParamArray, ruleEx
 
     rei->status = 0;
 
+    std::string signature = msParamArraySignature( msParamArray );
+
     int rescode = 0;
     if ( msParamArray != NULL ) {
         if ( strncmp( rule, "@external\n", 10 ) == 0 ) {
@@ -130,7 +136,7 @@ int parseAndComputeRuleAdapter( char *rule, msParamArray_t *msParamArray, ruleEx
 
     rei->msParamArray = msParamArray;
 
-    rescode = parseAndComputeRule( rule, env, rei, reiSaveFlag, &errmsgBuf, r );
+    rescode = parseAndComputeRuleWithSignature( rule, &signature, env, rei, reiSaveFlag, &errmsgBuf, r );
     RE_ERROR( rescode < 0 );
 
     if ( NULL == rei->msParamArray ) {
@@ -185,6 +191,12 @@ error:
 
 /* parse and compute a rule */
 int parseAndComputeRule( char *rule, Env *env, ruleExecInfo_t *rei, int reiSaveFlag, rError_t *errmsg, Region *r ) {
+    return parseAndComputeRuleWithSignature( rule, NULL, env, rei, reiSaveFlag, errmsg, r );
+}
+
+/* parse and compute a rule
+ * if signature is not NULL, the parsed and typed rules are looked up in and added to the ast cache */
+static int parseAndComputeRuleWithSignature( char *rule, const std::string *signature, Env *env, ruleExecInfo_t *rei, int reiSaveFlag, rError_t *errmsg, Region *r ) {
     if ( overflow( rule, MAX_RULE_LEN ) ) {
         addRErrorMsg( errmsg, RE_BUFFER_OVERFLOW, "error: potential buffer overflow" );
         return RE_BUFFER_OVERFLOW;
@@ -207,29 +219,77 @@ int parseAndComputeRule( char *rule, Env *env, ruleExecInfo_t *rei, int reiSaveF
     RuleDesc *rd = NULL;
     Res *res = NULL;
 
-    /* add rules into ext rule set */
-    rescode = parseRuleSet( e, ruleEngineConfig.extRuleSet, ruleEngineConfig.extFuncDescIndex, &errloc, errmsg, r );
-    deletePointer( e );
-    if ( rescode != 0 ) {
-        rescode = RE_PARSER_ERROR;
-        RETURN;
+    int i;
+
+    /* rule texts computed inside another rule text are typed against its rules, so only top level rule texts are cached */
+    AstCacheEntry *cached = NULL;
+    AstCacheEntry *entry = NULL;
+    Region *astRegion = r;
+    if ( signature != NULL && tempLen == 0 ) {
+        cached = lookupAstCache( AST_CACHE_RULE_TEXT, rule, *signature );
+        if ( cached == NULL ) {
+            entry = newAstCacheEntry();
+            astRegion = entry->r;
+        }
+    }
+
+    if ( cached != NULL ) {
+        /* add cached rules into ext rule set */
+        deletePointer( e );
+        for ( i = 0; i < cached->fdLen; i++ ) {
+            insertIntoHashTable( ruleEngineConfig.extFuncDescIndex->current, cached->fdNames[i], cached->fds[i] );
+        }
+        for ( i = 0; i < cached->len; i++ ) {
+            pushRule( ruleEngineConfig.extRuleSet, cached->rules[i] );
+        }
+    }
+    else {
+        /* add rules into ext rule set */
+        rescode = parseRuleSet( e, ruleEngineConfig.extRuleSet, ruleEngineConfig.extFuncDescIndex, &errloc, errmsg, astRegion );
+        deletePointer( e );
+        if ( rescode != 0 ) {
+            rescode = RE_PARSER_ERROR;
+            RETURN;
+        }
+    }
+
+    if ( entry != NULL ) {
+        /* constructors and external functions declared by the rule text */
+        Hashtable *declared = ruleEngineConfig.extFuncDescIndex->current;
+        entry->fdNames = ( char ** )region_alloc( astRegion, sizeof( char * ) * ( declared->len > 0 ? declared->len : 1 ) );
+        entry->fds = ( FunctionDesc ** )region_alloc( astRegion, sizeof( FunctionDesc * ) * ( declared->len > 0 ? declared->len : 1 ) );
+        for ( i = 0; i < declared->size; i++ ) {
+            struct bucket *b;
+            for ( b = declared->buckets[i]; b != NULL; b = b->next ) {
+                entry->fdNames[entry->fdLen] = cpStringExt( b->key, astRegion );
+                entry->fds[entry->fdLen] = ( FunctionDesc * ) b->value;
+                entry->fdLen++;
+            }
+        }
+
+        entry->len = ruleEngineConfig.extRuleSet->len - tempLen;
+        entry->rules = ( RuleDesc ** )region_alloc( astRegion, sizeof( RuleDesc * ) * ( entry->len > 0 ? entry->len : 1 ) );
+        for ( i = 0; i < entry->len; i++ ) {
+            entry->rules[i] = ruleEngineConfig.extRuleSet->rules[tempLen + i];
+        }
     }
 
     /* add rules into rule index */
-    int i;
     for ( i = tempLen; i < ruleEngineConfig.extRuleSet->len; i++ ) {
         if ( ruleEngineConfig.extRuleSet->rules[i]->ruleType == RK_FUNC || ruleEngineConfig.extRuleSet->rules[i]->ruleType == RK_REL ) {
             appendRuleIntoExtIndex( ruleEngineConfig.extRuleSet->rules[i], i, r );
         }
     }
 
-    for ( i = tempLen; i < ruleEngineConfig.extRuleSet->len; i++ ) {
+    /* cached rules have been typed already */
+    for ( i = tempLen; cached == NULL && i < ruleEngineConfig.extRuleSet->len; i++ ) {
         if ( ruleEngineConfig.extRuleSet->rules[i]->ruleType == RK_FUNC || ruleEngineConfig.extRuleSet->rules[i]->ruleType == RK_REL ) {
-            Hashtable *varTypes = newHashTable2( 10, r );
+            /* the types are attached to the nodes, so they are allocated with the nodes */
+            Hashtable *varTypes = newHashTable2( 10, astRegion );
 
-            List *typingConstraints = newList( r );
+            List *typingConstraints = newList( astRegion );
             Node *errnode;
-            ExprType *type = typeRule( ruleEngineConfig.extRuleSet->rules[i], ruleEngineConfig.extFuncDescIndex, varTypes, typingConstraints, errmsg, &errnode, r );
+            ExprType *type = typeRule( ruleEngineConfig.extRuleSet->rules[i], ruleEngineConfig.extFuncDescIndex, varTypes, typingConstraints, errmsg, &errnode, astRegion );
 
             if ( getNodeType( type ) == T_ERROR ) {
                 /*				rescode = TYPE_ERROR;     #   TGR, since renamed to RE_TYPE_ERROR */
@@ -239,6 +299,10 @@ int parseAndComputeRule( char *rule, Env *env, ruleExecInfo_t *rei, int reiSaveF
         }
     }
 
+    if ( entry != NULL ) {
+        insertIntoAstCache( AST_CACHE_RULE_TEXT, rule, *signature, entry );
+    }
+
     /* exec the first rule */
     rd = ruleEngineConfig.extRuleSet->rules[tempLen];
     node = rd->node;
@@ -249,6 +313,14 @@ ret:
     /* remove rules from ext rule set */
     popExtRuleSet( checkPoint );
 
+    /* the ast cache frees entries which were not added to it */
+    if ( cached != NULL ) {
+        releaseAstCacheEntry( cached );
+    }
+    if ( entry != NULL ) {
+        releaseAstCacheEntry( entry );
+    }
+
     return rescode;
 }
 
@@ -495,10 +567,19 @@ ret:
  *
  */
 Res *parseAndComputeExpression( char *expr, Env *env, ruleExecInfo_t *rei, int reiSaveFlag, rError_t *errmsg, Region *r ) {
+    return parseAndComputeExpressionWithSignature( expr, NULL, env, rei, reiSaveFlag, errmsg, r );
+}
+
+/* parse and compute an expression
+ * if signature is not NULL, the parsed and typed expression is looked up in and added to the ast cache
+ */
+static Res *parseAndComputeExpressionWithSignature( char *expr, const std::string *signature, Env *env, ruleExecInfo_t *rei, int reiSaveFlag, rError_t *errmsg, Region *r ) {
     Res *res = NULL;
     char buf[ERR_MSG_LEN > 1024 ? ERR_MSG_LEN : 1024];
     int rulegen;
     Node *node = NULL, *recoNode = NULL;
+    AstCacheEntry *entry = NULL;
+    Region *astRegion = r;
 
 #ifdef DEBUG
     snprintf( buf, 1024, "parseAndComputeExpression: %s\n", expr );
@@ -508,8 +589,19 @@ Res *parseAndComputeExpression( char *expr, Env *env, ruleExecInfo_t *rei, int r
         addRErrorMsg( errmsg, RE_BUFFER_OVERFLOW, "error: potential buffer overflow" );
         return newErrorRes( r, RE_BUFFER_OVERFLOW );
     }
+    /* expressions computed inside a rule text are typed against its rules, so only top level expressions are cached */
+    if ( signature != NULL && ruleEngineConfig.extRuleSet->len == 0 ) {
+        AstCacheEntry *cached = lookupAstCache( AST_CACHE_EXPRESSION, expr, *signature );
+        if ( cached != NULL ) {
+            res = computeNode( cached->node, NULL, env, rei, reiSaveFlag, errmsg, r );
+            releaseAstCacheEntry( cached );
+            return res;
+        }
+        entry = newAstCacheEntry();
+        astRegion = entry->r;
+    }
     Pointer *e = newPointer2( expr );
-    ParserContext *pc = newParserContext( errmsg, r );
+    ParserContext *pc = newParserContext( errmsg, astRegion );
     if ( e == NULL ) {
         addRErrorMsg( errmsg, RE_POINTER_ERROR, "error: can not create pointer." );
         res = newErrorRes( r, RE_POINTER_ERROR );
@@ -561,10 +653,26 @@ Res *parseAndComputeExpression( char *expr, Env *env, ruleExecInfo_t *rei, int r
             RETURN;
         }
     }
+    if ( entry != NULL ) {
+        /* the types are attached to the nodes, so they are allocated with the nodes */
+        Hashtable *varTypes = newHashTable2( 10, astRegion );
+        Node *errnode;
+        int errorcode = typeNode( node, varTypes, errmsg, &errnode, astRegion );
+        if ( errorcode != 0 ) {
+            res = newErrorRes( r, errorcode );
+            RETURN;
+        }
+        entry->node = node;
+        insertIntoAstCache( AST_CACHE_EXPRESSION, expr, *signature, entry );
+    }
     res = computeNode( node, NULL, env, rei, reiSaveFlag, errmsg, r );
 ret:
     deleteParserContext( pc );
     deletePointer( e );
+    /* the ast cache frees entries which were not added to it */
+    if ( entry != NULL ) {
+        releaseAstCacheEntry( entry );
+    }
     return res;
 }
 
@@ -636,7 +744,8 @@ Res *parseAndComputeExpressionAdapter( char *inAction, msParamArray_t *inMsParam
         deleteFromHashTable(env->current, "ruleExecOut");
     }
 
-    res = parseAndComputeExpression( inAction, env, rei, reiSaveFlag, &errmsgBuf, r );
+    std::string signature = msParamArraySignature( inMsParamArray );
+    res = parseAndComputeExpressionWithSignature( inAction, &signature, env, rei, reiSaveFlag, &errmsgBuf, r );
     if ( retOutParams ) { // JMC - backport 4540
         if ( inMsParamArray != NULL ) {
             clearMsParamArray( inMsParamArray, 0 );
@@ -192,3 +192,27 @@ class Test_Dynamic_PEPs(session.make_sessions_mixin([('otherrods', 'rods')], [])
                     self.admin.assert_icommand(['irm', '-f', logical_path])
                     self.admin.assert_icommand(['iadmin', 'rum'])
 
+    @unittest.skipIf(plugin_name == 'irods_rule_engine_plugin-python' or test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_pep_database_reg_data_obj_is_invoked_for_each_data_object_of_a_bulk_upload(self):
+        config = IrodsConfig()
+        core_re_path = os.path.join(config.core_re_directory, 'core.re')
+
+        # Bulk uploads register new data objects in batches unless a policy is
+        # attached to the registration of a single data object.
+        with lib.file_backed_up(core_re_path):
+            prefix = 'bulk_reg_data_obj_post => '
+
+            with open(core_re_path, 'a') as core_re:
+                core_re.write('pep_database_reg_data_obj_post(*INSTANCE, *CONTEXT, *OUT, *DATA_OBJ_INFO) { writeLine("serverLog", "' + prefix + '" ++ *DATA_OBJ_INFO.logical_path); }\n')
+
+            file_count = 5
+            local_dir = os.path.join(self.admin.local_session_dir, 'bulk_reg_data_obj')
+            lib.create_directory_of_small_files(local_dir, file_count)
+            coll_path = os.path.join(self.admin.session_collection, 'bulk_reg_data_obj')
+
+            log_offset = lib.get_file_size_by_path(paths.server_log_path())
+            self.admin.assert_icommand(['iput', '-rb', local_dir, coll_path], 'STDOUT', [' '])
+
+            for i in range(file_count):
+                data_path = os.path.join(coll_path, str(i))
+                lib.delayAssert(lambda: lib.log_message_occurrences_equals_count(msg=prefix + data_path, start_index=log_offset))
@@ -274,6 +274,80 @@ class Test_iPut_Options(ResourceBase, unittest.TestCase):
         finally:
             shutil.rmtree(dir_name, ignore_errors=True)
 
+    def test_bulk_upload_registers_more_data_objects_than_fit_in_one_statement(self):
+        # The catalog inserts up to 100 rows per statement, so 250 files need three of them.
+        file_count = 250
+        dir_name = tempfile.mkdtemp(prefix='bulk_registration_')
+        lib.create_directory_of_small_files(dir_name, file_count)
+
+        try:
+            coll_name = os.path.join(self.admin.session_collection, 'bulk_registration')
+            self.admin.assert_icommand(['iput', '-rb', dir_name, coll_name], 'STDOUT', [' '])
+
+            # Every data object is registered with its own id.
+            out, _, _ = self.admin.run_icommand(['iquest', '%s', "select DATA_ID where COLL_NAME = '{0}'".format(coll_name)])
+            data_ids = out.split()
+            self.assertEqual(len(data_ids), file_count)
+            self.assertEqual(len(set(data_ids)), file_count)
+
+            for i in [0, 99, 100, 249]:
+                gql = "select DATA_SIZE where COLL_NAME = '{0}' and DATA_NAME = '{1}'".format(coll_name, i)
+                out, _, _ = self.admin.run_icommand(['iquest', '%s', gql])
+                self.assertEqual(int(out.strip()), os.path.getsize(os.path.join(dir_name, str(i))))
+
+            # Overwriting a mix of existing and new files updates the existing data objects
+            # and registers the new ones next to them.
+            for i in [5, 150]:
+                lib.make_file(os.path.join(dir_name, str(i)), 1000, 'arbitrary')
+            for i in range(file_count, file_count + 10):
+                lib.make_file(os.path.join(dir_name, str(i)), 10, 'arbitrary')
+
+            self.admin.assert_icommand(['iput', '-rbf', dir_name, coll_name], 'STDOUT', [' '])
+
+            out, _, _ = self.admin.run_icommand(['iquest', '%s', "select DATA_ID where COLL_NAME = '{0}'".format(coll_name)])
+            self.assertEqual(len(set(out.split())), file_count + 10)
+
+            for i in [5, 150, file_count + 9]:
+                gql = "select DATA_SIZE where COLL_NAME = '{0}' and DATA_NAME = '{1}'".format(coll_name, i)
+                out, _, _ = self.admin.run_icommand(['iquest', '%s', gql])
+                self.assertEqual(int(out.strip()), os.path.getsize(os.path.join(dir_name, str(i))))
+        finally:
+            shutil.rmtree(dir_name, ignore_errors=True)
+
+    def test_bulk_upload_inherits_the_acls_of_the_parent_collection(self):
+        file_count = 150
+        dir_name = tempfile.mkdtemp(prefix='bulk_registration_inheritance_')
+        lib.create_directory_of_small_files(dir_name, file_count)
+
+        def count_data_objects_accessible_to(user, coll_name):
+            out, _, _ = self.admin.run_icommand(['iquest', '%s', "select USER_ID where USER_NAME = '{0}'".format(user.username)])
+            gql = "select count(DATA_ID) where COLL_NAME = '{0}' and DATA_ACCESS_USER_ID = '{1}'".format(coll_name, out.strip())
+            out, _, _ = self.admin.run_icommand(['iquest', '%s', gql])
+            return int(out.strip())
+
+        try:
+            # Data objects in a collection with inheritance get copies of its ACLs.
+            parent = os.path.join(self.admin.session_collection, 'inheriting')
+            self.admin.assert_icommand(['imkdir', parent])
+            self.admin.assert_icommand(['ichmod', 'read', self.user1.username, parent])
+            self.admin.assert_icommand(['ichmod', 'inherit', parent])
+
+            coll_name = os.path.join(parent, 'bulk')
+            self.admin.assert_icommand(['iput', '-rb', dir_name, coll_name], 'STDOUT', [' '])
+
+            self.assertEqual(count_data_objects_accessible_to(self.user1, coll_name), file_count)
+            self.assertEqual(count_data_objects_accessible_to(self.admin, coll_name), file_count)
+            self.user1.assert_icommand(['iget', os.path.join(coll_name, str(file_count - 1)), '-'], 'STDOUT', [' '])
+
+            # The others are only accessible to their owner.
+            coll_name = os.path.join(self.admin.session_collection, 'not_inheriting')
+            self.admin.assert_icommand(['iput', '-rb', dir_name, coll_name], 'STDOUT', [' '])
+
+            self.assertEqual(count_data_objects_accessible_to(self.user1, coll_name), 0)
+            self.assertEqual(count_data_objects_accessible_to(self.admin, coll_name), file_count)
+        finally:
+            shutil.rmtree(dir_name, ignore_errors=True)
+
 class Test_iPut_Options_Issue_3883(ResourceBase, unittest.TestCase):
 
     def setUp(self):
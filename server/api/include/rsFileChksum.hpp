@@ -5,6 +5,8 @@
 
 #include "fileChksum.h"
 
+#include <string>
+
 struct RsComm;
 struct rodsServerHost;
 
@@ -25,6 +27,21 @@ int fileChksum(RsComm *rsComm,
                char* orig_chksum,
                char *chksumStr);
 
+/// Determines the hash scheme used to checksum a replica.
+///
+/// The scheme is the server's default hash scheme unless \p _original_checksum names a
+/// different scheme and the match hash policy allows it.
+///
+/// \param[in]  _original_checksum The existing checksum of the replica. May be null or empty.
+/// \param[out] _scheme            The hash scheme.
+///
+/// \return An integer.
+/// \retval 0                       On success.
+/// \retval USER_HASH_TYPE_MISMATCH If the strict hash policy rejects \p _original_checksum.
+///
+/// \since 4.3.0
+int get_checksum_scheme(const char* _original_checksum, std::string& _scheme);
+
 int file_checksum(RsComm* _comm,
                   const char* _logical_path,
                   const char* _filename,
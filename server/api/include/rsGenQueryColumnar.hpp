@@ -0,0 +1,9 @@
+#ifndef RS_GEN_QUERY_COLUMNAR_HPP
+#define RS_GEN_QUERY_COLUMNAR_HPP
+
+#include "rodsConnect.h"
+#include "rodsGenQuery.h"
+
+int rsGenQueryColumnar( rsComm_t *rsComm, genQueryInp_t *genQueryInp, genQueryColumnarOut_t **genQueryColumnarOut );
+
+#endif
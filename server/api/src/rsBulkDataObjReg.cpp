@@ -11,6 +11,51 @@
 #include "irods_stacktrace.hpp"
 #include "irods_file_object.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "irods_database_constants.hpp"
+#include "irods_re_plugin.hpp"
+#include "irods_re_namespaceshelper.hpp"
+#include "irods_re_ruleexistshelper.hpp"
+
+namespace
+{
+    // Returns whether a policy may be attached to the registration of a single
+    // data object (pep_database_reg_data_obj_*).  chlBulkRegDataObj does not
+    // invoke those PEPs, so when one exists every object has to be registered
+    // through svrRegDataObj.
+    bool reg_data_obj_policy_may_exist( rsComm_t* _comm )
+    {
+        ruleExecInfo_t rei{};
+        rei.rsComm = _comm;
+        rei.uoic   = &_comm->clientUser;
+        rei.uoip   = &_comm->proxyUser;
+
+        irods::rule_engine_context_manager<
+            irods::unit,
+            ruleExecInfo_t*,
+            irods::AUDIT_RULE> re_ctx_mgr(
+                                   irods::re_plugin_globals->global_re_mgr,
+                                   &rei);
+
+        auto* rule_exists_helper = RuleExistsHelper::Instance();
+
+        for ( const std::string pep_class : { "pre", "post", "except", "finally" } ) {
+            if ( !rule_exists_helper->pepMayExist( irods::DATABASE_OP_REG_DATA_OBJ, pep_class ) ) {
+                continue;
+            }
+
+            for ( const auto& ns : NamespacesHelper::Instance()->getNamespaces() ) {
+                const auto rule_name = ns + "pep_" + irods::DATABASE_OP_REG_DATA_OBJ + "_" + pep_class;
+
+                // a rule engine plugin which cannot answer may still define the PEP
+                if ( const auto exists = rule_exists_helper->ruleExists( rule_name, re_ctx_mgr ); !exists || *exists ) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    } // reg_data_obj_policy_may_exist
+} // anonymous namespace
 
 int
 rsBulkDataObjReg( rsComm_t *rsComm, genQueryOut_t *bulkDataObjRegInp,
@@ -84,7 +129,7 @@ int _rsBulkDataObjReg(
         char *tmpObjPath, *tmpDataType, *tmpDataSize, *tmpRescName, *tmpRescID, *tmpFilePath,
              *tmpDataMode, *tmpOprType, *tmpReplNum, *tmpChksum;
         char *tmpObjId;
-        int status;
+        int status = 0;
 
         if ( ( rescID =
                     getSqlResultByInx( bulkDataObjRegInp, COL_D_RESC_ID ) ) == NULL ) {
@@ -163,6 +208,50 @@ int _rsBulkDataObjReg(
 
         std::vector<std::pair<ir::replica_proxy_t, irods::experimental::lifetime_manager<DataObjInfo>>> result_info;
 
+        // Consecutive rows which register new data objects are collected and
+        // registered as one batch.  The batch is flushed before each row that
+        // updates an existing data object, so the rows are applied in order.
+        // If a policy is attached to single registrations, every object is
+        // registered on its own so that the policy still sees each of them.
+        const bool register_one_by_one = reg_data_obj_policy_may_exist( rsComm );
+        std::vector<dataObjInfo_t> reg_infos;
+        std::vector<int> reg_rows;
+
+        const auto flush_registrations = [&]() -> int {
+            if ( reg_infos.empty() ) {
+                return 0;
+            }
+
+            const int ec = chlBulkRegDataObj( rsComm, reg_infos.data(), static_cast<int>( reg_infos.size() ) );
+            if ( ec < 0 ) {
+                rodsLog( LOG_ERROR,
+                         "rsBulkDataObjReg: chlBulkRegDataObj failed for %d objects,stat=%d",
+                         static_cast<int>( reg_infos.size() ), ec );
+                return ec;
+            }
+
+            for ( std::size_t j = 0; j < reg_infos.size(); j++ ) {
+                auto& info = reg_infos[j];
+
+                irods::file_object_ptr file_obj(new irods::file_object(rsComm, &info));
+                if (auto ret = fileRegistered(rsComm, file_obj); !ret.ok()) {
+                    rodsLog( LOG_ERROR,
+                             "rsBulkDataObjReg: failed to signal resource that %s was registered,stat=%d",
+                             info.objPath, ret.code() );
+                    return ret.code();
+                }
+
+                snprintf( &objId->value[objId->len * reg_rows[j]], objId->len, "%lld", info.dataId );
+
+                result_info.push_back(ir::duplicate_replica(info));
+            }
+
+            reg_infos.clear();
+            reg_rows.clear();
+
+            return 0;
+        };
+
         ( *bulkDataObjRegOut )->rowCnt = bulkDataObjRegInp->rowCnt;
         for (int i = 0; i < bulkDataObjRegInp->rowCnt; i++ ) {
             tmpObjPath = &objPath->value[objPath->len * i];
@@ -203,11 +292,21 @@ int _rsBulkDataObjReg(
             }
 
             dataObjInfo.replStatus = GOOD_REPLICA;
-            if ( strcmp( tmpOprType, REGISTER_OPR ) == 0 ) {
-                status = svrRegDataObj( rsComm, &dataObjInfo );
+            const bool is_registration = strcmp( tmpOprType, REGISTER_OPR ) == 0;
+            if ( is_registration && !register_one_by_one ) {
+                reg_infos.push_back( dataObjInfo );
+                reg_rows.push_back( i );
+                continue;
             }
-            else {
-                status = modDataObjSizeMeta( rsComm, &dataObjInfo, tmpDataSize );
+
+            status = flush_registrations();
+            if ( status >= 0 ) {
+                if ( is_registration ) {
+                    status = svrRegDataObj( rsComm, &dataObjInfo );
+                }
+                else {
+                    status = modDataObjSizeMeta( rsComm, &dataObjInfo, tmpDataSize );
+                }
             }
 
             if ( status < 0 ) {
@@ -220,9 +319,20 @@ int _rsBulkDataObjReg(
                 return status;
             }
 
+            if ( is_registration ) {
+                snprintf( tmpObjId, objId->len, "%lld", dataObjInfo.dataId );
+            }
+
             result_info.push_back(ir::duplicate_replica(dataObjInfo));
         }
 
+        if ( ( status = flush_registrations() ) < 0 ) {
+            chlRollback( rsComm );
+            freeGenQueryOut( bulkDataObjRegOut );
+            *bulkDataObjRegOut = NULL;
+            return status;
+        }
+
         if (const auto ec = chlCommit(rsComm); ec < 0) {
             rodsLog(LOG_ERROR, "rsBulkDataObjReg: chlCommit failed, status = %d", ec );
             freeGenQueryOut(bulkDataObjRegOut);
@@ -110,7 +110,7 @@ apply_acPostProcForDataCopyReceived(rsComm_t *rsComm, dataOprInp_t *dataOprInp)
     }
 
     const int l3_index = dataOprInp->destL3descInx;
-    if (l3_index < 3 || l3_index >= NUM_FILE_DESC) {
+    if (!FileDesc.in_range(l3_index)) {
         rodsLog(LOG_ERROR, "apply_acPostProcForDataCopyReceived: bad l3 descriptor index %d", l3_index);
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
@@ -367,7 +367,7 @@ namespace
                 r.mtime(SET_TIME_TO_NOW_KW);
             }
             else {
-                r.replica_status(std::stoi(rst::get_property(r.data_id(), r.replica_number(), "data_is_dirty")));
+                r.replica_status(rst::get_replica_status(r.data_id(), r.replica_number()));
             }
         }
 
@@ -699,7 +699,7 @@ int rsDataObjClose(rsComm_t* rsComm, openedDataObjInp_t* dataObjCloseInp)
     }
 
     const auto fd = dataObjCloseInp->l1descInx;
-    if (fd < 3 || fd >= NUM_L1_DESC) {
+    if (!L1desc.in_range(fd)) {
         irods::log(LOG_NOTICE, fmt::format("{}: l1descInx {} out of range", __FUNCTION__, fd));
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
@@ -48,6 +48,8 @@
 #include "irods_server_properties.hpp"
 #include "scoped_privileged_client.hpp"
 #include "server_utilities.hpp"
+#include "inline_checksum.hpp"
+#include "rsFileChksum.hpp"
 
 #define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 #include "filesystem.hpp"
@@ -63,6 +65,7 @@
 #include <tuple>
 #include <algorithm>
 #include <exception>
+#include <memory>
 
 namespace
 {
@@ -91,6 +94,34 @@ namespace
         return {};
     } // calculate_checksum
 
+    // Hashes the buffer written to the replica so that the replica does not need to be
+    // read again when its checksum is calculated.
+    auto record_inline_checksum(const DataObjInfo& _info, const char* _original_checksum, const BytesBuf& _bbuf) -> void
+    {
+        namespace ix = irods::experimental;
+
+        // The checksum is calculated by the server hosting the replica.
+        int remote_flag = 0;
+        rodsServerHost* host = nullptr;
+        if (const auto err = irods::get_host_for_hier_string(_info.rescHier, remote_flag, host); !err.ok() || LOCAL_HOST != remote_flag) {
+            return;
+        }
+
+        std::string scheme;
+        if (get_checksum_scheme(_original_checksum, scheme) < 0 || !ix::inline_checksum::is_supported(scheme, 1)) {
+            return;
+        }
+
+        try {
+            auto checksum = std::make_shared<ix::inline_checksum>(scheme, 1);
+            checksum->update(0, 0, _bbuf.buf, _bbuf.len);
+            ix::inline_checksum_table::insert(_info.rescHier, _info.filePath, std::move(checksum));
+        }
+        catch (const irods::exception& e) {
+            irods::log(e);
+        }
+    } // record_inline_checksum
+
     auto finalize_on_failure(RsComm& _comm, DataObjInfo& _info, l1desc& _l1desc) -> int
     {
         const auto admin_op = irods::experimental::make_key_value_proxy(_l1desc.dataObjInp->condInput).contains(ADMIN_KW);
@@ -283,6 +314,9 @@ namespace
                 __FUNCTION__, __LINE__, bytes_written,
                 opened_replica.logical_path(), opened_replica.hierarchy()));
         }
+        else if (bytes_written == _bbuf.len && (REG_CHKSUM == l1desc.chksumFlag || VERIFY_CHKSUM == l1desc.chksumFlag)) {
+            record_inline_checksum(*l1desc.dataObjInfo, l1desc.chksum, _bbuf);
+        }
 
         if ( bytes_written == 0 && opened_replica.size() > 0 ) {
             /* overwrite with 0 len file */
@@ -68,7 +68,7 @@ rsDataObjRead(rsComm_t* rsComm,
 {
     const int l1descInx = dataObjReadInp->l1descInx;
 
-    if (l1descInx <= 2 || l1descInx >= NUM_L1_DESC) {
+    if (!L1desc.in_range(l1descInx)) {
         rodsLog(LOG_ERROR, "%s: l1descInx %d out of range", __func__, l1descInx);
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
@@ -20,6 +20,7 @@
 #include "irods_hierarchy_parser.hpp"
 #include "irods_file_object.hpp"
 #include "irods_resource_redirect.hpp"
+#include "inline_checksum.hpp"
 
 
 int
@@ -72,7 +73,7 @@ int rsDataObjWrite(
     int bytesWritten = 0;
     int l1descInx    = dataObjWriteInp->l1descInx;
 
-    if ( l1descInx < 2 || l1descInx >= NUM_L1_DESC ) {
+    if ( !L1desc.in_range( l1descInx ) ) {
         rodsLog(
             LOG_NOTICE,
             "rsDataObjWrite: l1descInx %d out of range",
@@ -154,6 +155,9 @@ l3Write( rsComm_t *rsComm, int l1descInx, int len,
         return -1;
     }
 
+    // Any checksum computed while the replica was being transferred no longer describes it.
+    irods::experimental::inline_checksum_table::erase( dataObjInfo->rescHier, dataObjInfo->filePath );
+
     if ( getStructFileType( dataObjInfo->specColl ) >= 0 ) {
         subStructFileFdOprInp_t subStructFileWriteInp;
         memset( &subStructFileWriteInp, 0, sizeof( subStructFileWriteInp ) );
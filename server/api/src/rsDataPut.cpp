@@ -25,6 +25,12 @@ rsDataPut( rsComm_t *rsComm, dataOprInp_t *dataOprInp,
 
     l3descInx = dataOprInp->destL3descInx;
 
+    if ( !FileDesc.in_range( l3descInx ) ) {
+        rodsLog( LOG_ERROR,
+                 "rsDataPut: l3descInx %d out of range", l3descInx );
+        return SYS_FILE_DESC_OUT_OF_RANGE;
+    }
+
     if ( getValByKey( &dataOprInp->condInput, EXEC_LOCALLY_KW ) != NULL ) {
         remoteFlag = LOCAL_HOST;
     }
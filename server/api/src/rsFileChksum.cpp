@@ -11,15 +11,63 @@
 #include "irods_hierarchy_parser.hpp"
 #include "MD5Strategy.hpp"
 #include "irods_at_scope_exit.hpp"
+#include "irods_resource_constants.hpp"
+#include "inline_checksum.hpp"
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <future>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
 
 #define SVR_MD5_BUF_SZ (1024*1024)
 
+namespace ix = irods::experimental;
+
+namespace
+{
+    // The default number of bytes read from a replica per call to fileRead when
+    // computing a checksum.
+    constexpr int default_checksum_read_buffer_size = 4 * 1024 * 1024;
+
+    auto get_checksum_read_buffer_size() noexcept -> int
+    {
+        try {
+            const int size = irods::get_advanced_setting<const int>(irods::CFG_CHECKSUM_READ_BUFFER_SIZE_IN_BYTES_KW);
+            if (size > 0) {
+                return size;
+            }
+            rodsLog(LOG_ERROR, "Invalid checksum read buffer size [size=%d].", size);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_CHECKSUM_READ_BUFFER_SIZE_IN_BYTES_KW.data());
+        }
+
+        return default_checksum_read_buffer_size;
+    }
+
+    // Returns whether the file descriptor held by a file object opened in the resource
+    // hierarchy is a file descriptor of the local file system. Only then can the kernel
+    // be advised about how the replica will be read.
+    auto is_local_file_descriptor(const char* _resource_hierarchy) -> bool
+    {
+        std::string type;
+        if (const auto error = irods::get_resc_type_for_hier_string(_resource_hierarchy, type); !error.ok()) {
+            return false;
+        }
+
+        return irods::RESOURCE_TYPE_NATIVE == type;
+    }
+} // anonymous namespace
+
 int rsFileChksum(rsComm_t* rsComm, fileChksumInp_t* fileChksumInp, char** chksumStr)
 {
     rodsServerHost_t* rodsServerHost;
@@ -221,7 +269,7 @@ int fileChksum(rsComm_t* rsComm,
     while ( read_err.ok() && bytes_read > 0 ) {
         // =-=-=-=-=-=-=-
         // update hasher
-        hasher.update( std::string( buffer, bytes_read ) );
+        hasher.update( buffer, bytes_read );
 
         // =-=-=-=-=-=-=-
         // read some more
@@ -260,13 +308,7 @@ int fileChksum(rsComm_t* rsComm,
     return 0;
 } // fileChksum
 
-int file_checksum(RsComm* _comm,
-                  const char* _logical_path,
-                  const char* _filename,
-                  const char* _resource_hierarchy,
-                  const char* _original_checksum,
-                  rodsLong_t _data_size,
-                  char* _calculated_checksum)
+int get_checksum_scheme(const char* _original_checksum, std::string& _scheme)
 {
     // Capture server hashing settings.
     std::string hash_scheme = irods::MD5_NAME;
@@ -291,7 +333,7 @@ int file_checksum(RsComm* _comm,
     }
 
     // Check the hash scheme against the policy if necessary.
-    std::string_view final_scheme = hash_scheme;
+    _scheme = hash_scheme;
     if (!chkstr_scheme.empty()) {
         if (!hash_policy.empty()) {
             if (irods::STRICT_HASH_POLICY == hash_policy) {
@@ -301,15 +343,37 @@ int file_checksum(RsComm* _comm,
             }
         }
 
-        final_scheme = chkstr_scheme;
+        _scheme = chkstr_scheme;
+    }
+
+    rodsLog(LOG_DEBUG, "get_checksum_scheme :: final_scheme [%s]  chkstr_scheme [%s]  hash_policy [%s]",
+            _scheme.c_str(), chkstr_scheme.c_str(), hash_policy.data());
+
+    return 0;
+} // get_checksum_scheme
+
+int file_checksum(RsComm* _comm,
+                  const char* _logical_path,
+                  const char* _filename,
+                  const char* _resource_hierarchy,
+                  const char* _original_checksum,
+                  rodsLong_t _data_size,
+                  char* _calculated_checksum)
+{
+    std::string final_scheme;
+    if (const auto ec = get_checksum_scheme(_original_checksum, final_scheme); ec < 0) {
+        return ec;
     }
 
-    rodsLog(LOG_DEBUG, "file_checksum :: final_scheme [%s]  chkstr_scheme [%s]  hash_policy [%s]",
-            final_scheme.data(), chkstr_scheme.c_str(), hash_policy.data());
+    // Use the checksum computed while the replica was being written, if there is one.
+    if (auto digest = ix::inline_checksum_table::take_digest(_resource_hierarchy, _filename, final_scheme, _data_size); digest) {
+        std::strncpy(_calculated_checksum, digest->c_str(), NAME_LEN);
+        return 0;
+    }
 
     // Create a hasher object and init given a scheme if it is unsupported then default to md5.
     irods::Hasher hasher;
-    if (const auto error = irods::getHasher(final_scheme.data(), hasher); !error.ok()) {
+    if (const auto error = irods::getHasher(final_scheme, hasher); !error.ok()) {
         irods::log(PASS(error));
         irods::getHasher(irods::MD5_NAME, hasher);
     }
@@ -339,11 +403,34 @@ int file_checksum(RsComm* _comm,
         }
     }};
 
-    char buffer[SVR_MD5_BUF_SZ];
+    const int fd = is_local_file_descriptor(_resource_hierarchy) ? file_ptr->file_descriptor() : -1;
+
+    if (fd >= 0) {
+        // Allow the kernel to read ahead aggressively. This is advice only, so errors are ignored.
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    // Two buffers are used so that the next block can be read while the previous
+    // block is hashed by another thread.
+    const auto buffer_size = get_checksum_read_buffer_size();
+    std::array<std::vector<char>, 2> buffers{std::vector<char>(buffer_size), std::vector<char>(buffer_size)};
+    std::size_t current_buffer = 0;
+    std::int64_t offset = 0;
+
+    // Declared after the buffers so that a pending update completes before the
+    // buffers are destroyed.
+    std::future<irods::error> pending_update;
+
+    const auto wait_for_pending_update = [&pending_update] {
+        return pending_update.valid() ? pending_update.get() : SUCCESS();
+    };
+
     irods::error error = SUCCESS();
 
     while (_data_size > 0) {
-        error = fileRead(_comm, file_ptr, buffer, std::min<std::int64_t>(_data_size, sizeof(buffer)));
+        auto& buffer = buffers[current_buffer];
+
+        error = fileRead(_comm, file_ptr, buffer.data(), std::min<std::int64_t>(_data_size, buffer.size()));
 
         if (error.code() <= 0) {
             const auto msg = fmt::format("{} - fileRead failed for [{}].", __func__, _filename);
@@ -358,8 +445,38 @@ int file_checksum(RsComm* _comm,
             return error.code();
         }
 
-        _data_size -= error.code();
-        hasher.update(std::string(buffer, error.code()));
+        const auto bytes_read = error.code();
+        _data_size -= bytes_read;
+        offset += bytes_read;
+
+        if (fd >= 0 && _data_size > 0) {
+            posix_fadvise(fd, offset, std::min<std::int64_t>(_data_size, buffer_size), POSIX_FADV_WILLNEED);
+        }
+
+        if (const auto error = wait_for_pending_update(); !error.ok()) {
+            irods::log(PASS(error));
+            return error.code();
+        }
+
+        try {
+            pending_update = std::async(std::launch::async, [&hasher, &buffer, bytes_read] {
+                return hasher.update(buffer.data(), bytes_read);
+            });
+        }
+        catch (const std::system_error&) {
+            // A thread could not be started. Hash the block on this thread instead.
+            if (const auto error = hasher.update(buffer.data(), bytes_read); !error.ok()) {
+                irods::log(PASS(error));
+                return error.code();
+            }
+        }
+
+        current_buffer = 1 - current_buffer;
+    }
+
+    if (const auto error = wait_for_pending_update(); !error.ok()) {
+        irods::log(PASS(error));
+        return error.code();
     }
 
     // extract the digest from the hasher object
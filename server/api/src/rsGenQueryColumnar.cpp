@@ -0,0 +1,170 @@
+/* See genQueryColumnar.h for a description of this API call.*/
+
+#include "rsGenQueryColumnar.hpp"
+
+#include "genquery_columnar.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "rsGenQuery.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+namespace
+{
+    constexpr int default_max_rows_per_page = 8192;
+    constexpr std::size_t default_max_bytes_per_page = 32 * 1024 * 1024;
+
+    auto get_max_rows_per_page() noexcept -> int
+    {
+        try {
+            const int rows = irods::get_advanced_setting<const int>(irods::CFG_MAX_NUMBER_OF_ROWS_PER_GENQUERY_PAGE_KW);
+            if (rows > 0) {
+                return rows;
+            }
+            rodsLog(LOG_ERROR, "Invalid maximum number of rows per GenQuery page [rows=%d].", rows);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_MAX_NUMBER_OF_ROWS_PER_GENQUERY_PAGE_KW.data());
+        }
+
+        return default_max_rows_per_page;
+    }
+
+    // A page stops growing once its values reach the size of the largest single buffer.
+    auto get_max_bytes_per_page() noexcept -> std::size_t
+    {
+        try {
+            const int megabytes = irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER);
+            if (megabytes > 0) {
+                return static_cast<std::size_t>(megabytes) * 1024 * 1024;
+            }
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER.data());
+        }
+
+        return default_max_bytes_per_page;
+    }
+
+    // Closes the statement of a query which still has rows available.
+    auto close_statement(rsComm_t* _comm, genQueryInp_t* _inp, int _continue_index) -> void
+    {
+        _inp->maxRows = 0;
+        _inp->continueInx = _continue_index;
+
+        genQueryOut_t* out{};
+        const int status = rsGenQuery(_comm, _inp, &out);
+        freeGenQueryOut(&out);
+
+        if (status < 0 && CAT_NO_ROWS_FOUND != status) {
+            rodsLog(LOG_NOTICE, "rsGenQueryColumnar: failed to close statement [continueInx=%d, status=%d]",
+                    _continue_index, status);
+        }
+    }
+} // anonymous namespace
+
+int
+rsGenQueryColumnar( rsComm_t *rsComm, genQueryInp_t *genQueryInp,
+                    genQueryColumnarOut_t **genQueryColumnarOut ) {
+    if ( genQueryInp == NULL || genQueryColumnarOut == NULL ) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    *genQueryColumnarOut = NULL;
+
+    // the caller is closing out the query, there are no rows to convert
+    if ( genQueryInp->maxRows <= 0 ) {
+        genQueryOut_t* out{};
+        const int status = rsGenQuery( rsComm, genQueryInp, &out );
+        freeGenQueryOut( &out );
+        return status;
+    }
+
+    const int max_rows = genQueryInp->maxRows;
+    const int options = genQueryInp->options;
+    const int continue_inx = genQueryInp->continueInx;
+
+    const int page_size = std::min( max_rows, get_max_rows_per_page() );
+    const std::size_t max_bytes = get_max_bytes_per_page();
+
+    // The page is filled from parts of at most MAX_SQL_ROWS rows, so the fixed width
+    // genQueryOut_t each part is read into stays small whatever the page size.
+    // AUTO_CLOSE applies to the page, not to each part.
+    genQueryInp->options &= ~AUTO_CLOSE;
+
+    irods::experimental::genquery::columnar_page_builder builder;
+    int status = 0;
+    int continueInx = 0;
+    int totalRowCount = 0;
+
+    for ( bool first = true;; first = false ) {
+        genQueryInp->maxRows = std::min( page_size - builder.row_count(), MAX_SQL_ROWS );
+
+        genQueryOut_t* out{};
+        status = rsGenQuery( rsComm, genQueryInp, &out );
+
+        if ( status < 0 ) {
+            if ( CAT_NO_ROWS_FOUND == status && builder.row_count() > 0 ) {
+                // a continuation found no more rows and closed the statement
+                status = 0;
+                continueInx = 0;
+            }
+            else if ( out != NULL && out->continueInx > 0 ) {
+                continueInx = out->continueInx;
+            }
+            else if ( CAT_NO_ROWS_FOUND != status ) {
+                // the statement may still be open, let the caller close it
+                continueInx = genQueryInp->continueInx;
+            }
+            freeGenQueryOut( &out );
+            break;
+        }
+
+        if ( first ) {
+            totalRowCount = out->totalRowCount;
+        }
+
+        continueInx = out->continueInx;
+        status = builder.append( *out );
+        freeGenQueryOut( &out );
+
+        if ( status < 0 ||
+             continueInx <= 0 ||
+             builder.row_count() >= page_size ||
+             builder.byte_count() >= max_bytes ) {
+            break;
+        }
+
+        genQueryInp->continueInx = continueInx;
+    }
+
+    if ( status >= 0 && ( options & AUTO_CLOSE ) && continueInx > 0 ) {
+        close_statement( rsComm, genQueryInp, continueInx );
+        continueInx = -1; // more rows might have been available
+    }
+
+    genQueryInp->maxRows = max_rows;
+    genQueryInp->options = options;
+    genQueryInp->continueInx = continue_inx;
+
+    *genQueryColumnarOut = ( genQueryColumnarOut_t* )calloc( 1, sizeof( genQueryColumnarOut_t ) );
+    if ( *genQueryColumnarOut == NULL ) {
+        return SYS_MALLOC_ERR;
+    }
+
+    if ( status >= 0 ) {
+        status = builder.release( **genQueryColumnarOut );
+    }
+
+    ( *genQueryColumnarOut )->continueInx = continueInx;
+    ( *genQueryColumnarOut )->totalRowCount = totalRowCount;
+
+    return status;
+}
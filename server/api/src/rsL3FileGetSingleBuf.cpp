@@ -81,6 +81,12 @@ rsL3FileGetSingleBuf( rsComm_t *rsComm, int *l1descInx,
                       bytesBuf_t *dataObjOutBBuf ) {
     int bytesRead;
 
+    if ( !L1desc.in_range( *l1descInx ) ) {
+        rodsLog( LOG_ERROR,
+                 "rsL3FileGetSingleBuf: l1descInx %d out of range", *l1descInx );
+        return SYS_FILE_DESC_OUT_OF_RANGE;
+    }
+
     if ( L1desc[*l1descInx].dataObjInfo->dataSize > 0 ) {
         if ( L1desc[*l1descInx].remoteZoneHost != NULL ) {
             bytesRead = rcL3FileGetSingleBuf(
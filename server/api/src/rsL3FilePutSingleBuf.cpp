@@ -28,6 +28,12 @@ rsL3FilePutSingleBuf( rsComm_t *rsComm, int *l1descInx,
                       bytesBuf_t *dataObjInBBuf ) {
     int bytesWritten;
 
+    if ( !L1desc.in_range( *l1descInx ) ) {
+        rodsLog( LOG_ERROR,
+                 "rsL3FilePutSingleBuf: l1descInx %d out of range", *l1descInx );
+        return SYS_FILE_DESC_OUT_OF_RANGE;
+    }
+
     if ( dataObjInBBuf->len >= 0 ) {
         if ( L1desc[*l1descInx].remoteZoneHost != NULL ) {
             bytesWritten = rcL3FilePutSingleBuf(
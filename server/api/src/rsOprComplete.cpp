@@ -10,6 +10,11 @@ int rsOprComplete( rsComm_t *rsComm, int *retval ) {
     if ( *retval >= 2 ) {
         int l1descInx = *retval;
 
+        if ( !L1desc.in_range( l1descInx ) ) {
+            rodsLog( LOG_NOTICE, "rsOprComplete: l1descInx %d out of range", l1descInx );
+            return SYS_FILE_DESC_OUT_OF_RANGE;
+        }
+
         if ( L1desc[l1descInx].remoteZoneHost != NULL ) {
             *retval = rcOprComplete( L1desc[l1descInx].remoteZoneHost->conn,
                                      L1desc[l1descInx].remoteL1descInx );
@@ -15,10 +15,13 @@
 #include "ruleExecSubmit.h"
 #include "server_utilities.hpp"
 #include "json_serialization.hpp"
+#include "delay_server_notification.hpp"
 
 #include <json.hpp>
 
+#include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <string>
 
 namespace
@@ -33,6 +36,17 @@ namespace
                _input->packedReiAndArgBBuf->len > 0;
     }
 
+    // Returns true if the rule should be picked up by the delay server's next poll.
+    // Rules scheduled for later are found by the regular polling.
+    auto is_due(const ruleExecSubmitInp_t& _input) noexcept -> bool
+    {
+        if (std::strlen(_input.exeTime) == 0) {
+            return true;
+        }
+
+        return std::strtoll(_input.exeTime, nullptr, 10) <= std::time(nullptr) + 1;
+    }
+
     auto _rsRuleExecSubmit(RsComm* rsComm, ruleExecSubmitInp_t* ruleExecSubmitInp) -> int
     {
         // Do not allow clients to schedule delay rules with session variables in them.
@@ -86,6 +100,10 @@ namespace
             if (status < 0) {
                 rodsLog(LOG_ERROR, "_rsRuleExecSubmit: chlRegRuleExec error. status = %d", status);
             }
+            else if (is_due(*ruleExecSubmitInp)) {
+                // Wake the delay server if it is running on this host.
+                irods::experimental::delay_server::notify();
+            }
 
             return status;
         }
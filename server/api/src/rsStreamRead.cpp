@@ -18,7 +18,7 @@ rsStreamRead( rsComm_t *rsComm, fileReadInp_t *streamReadInp,
     int fileInx = streamReadInp->fileInx;
     int status;
 
-    if ( fileInx < 3 || fileInx >= NUM_FILE_DESC ) {
+    if ( !FileDesc.in_range( fileInx ) ) {
         rodsLog( LOG_ERROR,
                  "rsStreamRead: fileInx %d out of range", fileInx );
         return SYS_FILE_DESC_OUT_OF_RANGE;
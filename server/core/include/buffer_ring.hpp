@@ -0,0 +1,223 @@
+#ifndef IRODS_BUFFER_RING_HPP
+#define IRODS_BUFFER_RING_HPP
+
+/// \file
+
+#include "rodsType.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace irods::experimental
+{
+    /// A fixed set of reusable, aligned buffers passed between a producer and a consumer thread.
+    ///
+    /// The producer fills empty buffers and submits them. The consumer takes filled buffers in
+    /// the order they were submitted and releases them once processed, which makes them
+    /// available to the producer again. No memory is allocated after construction.
+    ///
+    /// Either side may cancel the ring. Cancellation wakes both threads and causes every
+    /// blocking call to return null, so a failure in one stage stops the other.
+    ///
+    /// \since 4.3.0
+    class buffer_ring
+    {
+    public:
+        /// A buffer owned by the ring.
+        struct buffer
+        {
+            unsigned char* data;    ///< The memory of the buffer. Aligned to the ring's alignment.
+            std::size_t capacity;   ///< The number of bytes \p data can hold.
+            std::size_t size;       ///< The number of bytes in use. Set by the producer.
+            rodsLong_t offset;      ///< The position of the bytes within the replica. Set by the producer.
+        }; // struct buffer
+
+        static constexpr std::size_t default_alignment = 4096;
+
+        /// Allocates the buffers.
+        ///
+        /// \param[in] _count     The number of buffers. At least one buffer is allocated.
+        /// \param[in] _capacity  The minimum size of each buffer in bytes.
+        /// \param[in] _alignment The alignment of each buffer. Must be a power of two.
+        ///
+        /// \throws std::bad_alloc If memory could not be allocated.
+        buffer_ring(std::size_t _count, std::size_t _capacity, std::size_t _alignment = default_alignment)
+        {
+            _count = std::max<std::size_t>(_count, 1);
+
+            // aligned_alloc requires the size to be a multiple of the alignment.
+            const auto capacity = (std::max<std::size_t>(_capacity, 1) + _alignment - 1) / _alignment * _alignment;
+
+            memory_.reserve(_count);
+            buffers_.resize(_count);
+            empty_.reserve(_count);
+            filled_.reserve(_count);
+
+            for (auto& b : buffers_) {
+                auto* p = static_cast<unsigned char*>(std::aligned_alloc(_alignment, capacity));
+
+                if (!p) {
+                    throw std::bad_alloc{};
+                }
+
+                memory_.emplace_back(p);
+                b = buffer{p, capacity, 0, 0};
+                empty_.push_back(&b);
+            }
+        }
+
+        buffer_ring(const buffer_ring&) = delete;
+        auto operator=(const buffer_ring&) -> buffer_ring& = delete;
+
+        /// Blocks until an empty buffer is available.
+        ///
+        /// \return A buffer for the producer to fill, or null if the ring was cancelled.
+        auto acquire_empty() -> buffer*
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return cancelled_ || !empty_.empty(); });
+
+            if (cancelled_) {
+                return nullptr;
+            }
+
+            auto* b = empty_.pop_front();
+            b->size = 0;
+            b->offset = 0;
+
+            return b;
+        }
+
+        /// Hands a buffer obtained from acquire_empty() to the consumer.
+        auto submit(buffer* _buffer) -> void
+        {
+            {
+                std::lock_guard lock{mutex_};
+                filled_.push_back(_buffer);
+            }
+
+            cv_.notify_all();
+        }
+
+        /// Blocks until a filled buffer is available.
+        ///
+        /// \return The oldest submitted buffer, or null if the ring was cancelled or the
+        ///         producer finished and every buffer has been consumed.
+        auto acquire_filled() -> buffer*
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return cancelled_ || finished_ || !filled_.empty(); });
+
+            if (cancelled_ || filled_.empty()) {
+                return nullptr;
+            }
+
+            return filled_.pop_front();
+        }
+
+        /// Returns a buffer obtained from acquire_filled() to the producer.
+        auto release(buffer* _buffer) -> void
+        {
+            {
+                std::lock_guard lock{mutex_};
+                empty_.push_back(_buffer);
+            }
+
+            cv_.notify_all();
+        }
+
+        /// Signals that the producer will not submit any more buffers.
+        auto finish() -> void
+        {
+            {
+                std::lock_guard lock{mutex_};
+                finished_ = true;
+            }
+
+            cv_.notify_all();
+        }
+
+        /// Stops both sides. Buffers which were submitted but not consumed are discarded.
+        auto cancel() -> void
+        {
+            {
+                std::lock_guard lock{mutex_};
+                cancelled_ = true;
+            }
+
+            cv_.notify_all();
+        }
+
+        /// Returns whether cancel() has been called.
+        auto cancelled() const -> bool
+        {
+            std::lock_guard lock{mutex_};
+            return cancelled_;
+        }
+
+        /// The number of buffers owned by the ring.
+        auto size() const noexcept -> std::size_t
+        {
+            return buffers_.size();
+        }
+
+    private:
+        // A first-in first-out queue of buffers whose storage is reserved once. Each buffer
+        // is in at most one queue at a time, so neither queue holds more than size() entries.
+        class buffer_queue
+        {
+        public:
+            auto reserve(std::size_t _capacity) -> void
+            {
+                slots_.resize(_capacity);
+            }
+
+            auto empty() const noexcept -> bool
+            {
+                return 0 == count_;
+            }
+
+            auto push_back(buffer* _buffer) noexcept -> void
+            {
+                slots_[(head_ + count_) % slots_.size()] = _buffer;
+                ++count_;
+            }
+
+            auto pop_front() noexcept -> buffer*
+            {
+                auto* b = slots_[head_];
+                head_ = (head_ + 1) % slots_.size();
+                --count_;
+                return b;
+            }
+
+        private:
+            std::vector<buffer*> slots_;
+            std::size_t head_ = 0;
+            std::size_t count_ = 0;
+        }; // class buffer_queue
+
+        struct free_deleter
+        {
+            auto operator()(unsigned char* _p) const noexcept -> void { std::free(_p); }
+        };
+
+        std::vector<std::unique_ptr<unsigned char, free_deleter>> memory_;
+        std::vector<buffer> buffers_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        buffer_queue empty_;
+        buffer_queue filled_;
+        bool finished_ = false;
+        bool cancelled_ = false;
+    }; // class buffer_ring
+} // namespace irods::experimental
+
+#endif // IRODS_BUFFER_RING_HPP
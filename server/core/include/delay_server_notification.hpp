@@ -0,0 +1,60 @@
+#ifndef IRODS_DELAY_SERVER_NOTIFICATION_HPP
+#define IRODS_DELAY_SERVER_NOTIFICATION_HPP
+
+/// \file
+
+#include <string>
+
+/// A local channel which allows agents to wake the delay server before its next poll.
+///
+/// The channel is a datagram socket in the Linux abstract socket namespace. The name
+/// is derived from the zone port so that multiple servers on the same host do not
+/// interfere with each other. Notifications carry no data and are coalesced by the
+/// delay server. If no delay server is listening on the local host, notifications
+/// are dropped and the delay server falls back to polling.
+namespace irods::experimental::delay_server
+{
+    /// Returns the name of the socket the delay server listens on.
+    ///
+    /// The leading null byte of the abstract socket name is not included.
+    ///
+    /// \since 4.3.0
+    auto notification_socket_name() -> std::string;
+
+    /// Creates the socket the delay server listens on for notifications.
+    ///
+    /// \return An integer.
+    /// \retval File-Descriptor On success.
+    /// \retval <0              If the socket could not be created.
+    ///
+    /// \since 4.3.0
+    auto open_notification_socket() noexcept -> int;
+
+    /// Waits until a notification is received or \p _timeout_in_milliseconds elapses.
+    ///
+    /// All pending notifications are consumed.
+    ///
+    /// \param[in] _socket                  The socket returned by open_notification_socket().
+    /// \param[in] _timeout_in_milliseconds The maximum amount of time to wait.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If at least one notification was received.
+    /// \retval false Otherwise.
+    ///
+    /// \since 4.3.0
+    auto wait_for_notification(int _socket, int _timeout_in_milliseconds) noexcept -> bool;
+
+    /// Wakes the delay server running on the local host, if any.
+    ///
+    /// This function never blocks.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the notification was delivered.
+    /// \retval false Otherwise.
+    ///
+    /// \since 4.3.0
+    auto notify() noexcept -> bool;
+} // namespace irods::experimental::delay_server
+
+#endif // IRODS_DELAY_SERVER_NOTIFICATION_HPP
+
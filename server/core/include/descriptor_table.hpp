@@ -0,0 +1,141 @@
+#ifndef IRODS_DESCRIPTOR_TABLE_HPP
+#define IRODS_DESCRIPTOR_TABLE_HPP
+
+/// \file
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace irods::experimental
+{
+    /// A table of descriptors addressed by integer index, such as the agent's L1 and L3
+    /// descriptor tables.
+    ///
+    /// Free indices are kept in a free list, so allocating and freeing a descriptor takes
+    /// constant time. The table grows in chunks as more descriptors are needed. Descriptors
+    /// never move, so references to them remain valid while the table grows. New descriptors
+    /// are value-initialized.
+    ///
+    /// \since 4.3.0
+    template <typename T>
+    class descriptor_table
+    {
+    public:
+        /// Constructs an empty table.
+        ///
+        /// \param[in] _first_index The lowest index handed out by allocate(). Lower indices
+        ///                         exist but are reserved.
+        /// \param[in] _chunk_size  The number of descriptors added each time the table grows.
+        explicit descriptor_table(int _first_index = 0, std::size_t _chunk_size = 256)
+            : first_index_{_first_index}
+            , chunk_size_{_chunk_size > 0 ? _chunk_size : 1}
+        {
+        }
+
+        descriptor_table(const descriptor_table&) = delete;
+        auto operator=(const descriptor_table&) -> descriptor_table& = delete;
+
+        /// Reserves a free index, growing the table if none is available.
+        ///
+        /// \throws std::bad_alloc If the table could not grow.
+        ///
+        /// \return The index of a value-initialized descriptor.
+        auto allocate() -> int
+        {
+            if (free_.empty()) {
+                grow();
+            }
+
+            const auto index = free_.back();
+            free_.pop_back();
+            in_use_[index] = true;
+
+            return index;
+        }
+
+        /// Returns an index obtained from allocate() to the free list.
+        ///
+        /// The descriptor itself is not reset. Freeing an index which is not allocated has no effect.
+        ///
+        /// \return Whether the index was allocated.
+        auto release(int _index) -> bool
+        {
+            if (!is_allocated(_index)) {
+                return false;
+            }
+
+            in_use_[_index] = false;
+            free_.push_back(_index);
+
+            return true;
+        }
+
+        /// Destroys every descriptor and shrinks the table to zero size.
+        auto clear() -> void
+        {
+            chunks_.clear();
+            in_use_.clear();
+            free_.clear();
+        }
+
+        /// Returns whether \p _index refers to a descriptor which allocate() can hand out.
+        auto in_range(int _index) const noexcept -> bool
+        {
+            return _index >= first_index_ && static_cast<std::size_t>(_index) < size();
+        }
+
+        /// Returns whether \p _index has been allocated and not released.
+        auto is_allocated(int _index) const noexcept -> bool
+        {
+            return in_range(_index) && in_use_[_index];
+        }
+
+        /// The number of indices the table can currently address. Valid indices are below this value.
+        auto size() const noexcept -> std::size_t
+        {
+            return chunks_.size() * chunk_size_;
+        }
+
+        /// Returns the descriptor at \p _index, which must be less than size().
+        auto operator[](int _index) noexcept -> T&
+        {
+            return chunks_[_index / chunk_size_][_index % chunk_size_];
+        }
+
+        /// Returns the descriptor at \p _index, which must be less than size().
+        auto operator[](int _index) const noexcept -> const T&
+        {
+            return chunks_[_index / chunk_size_][_index % chunk_size_];
+        }
+
+    private:
+        auto grow() -> void
+        {
+            const auto first = static_cast<int>(size());
+
+            chunks_.push_back(std::make_unique<T[]>(chunk_size_));
+            in_use_.resize(size(), false);
+
+            // Indices are handed out from the back of the free list, lowest first.
+            for (auto i = static_cast<int>(size()) - 1; i >= first; --i) {
+                if (i >= first_index_) {
+                    free_.push_back(i);
+                }
+            }
+
+            // A chunk made up entirely of reserved indices does not satisfy the allocation.
+            if (free_.empty()) {
+                grow();
+            }
+        }
+
+        int first_index_;
+        std::size_t chunk_size_;
+        std::vector<std::unique_ptr<T[]>> chunks_;
+        std::vector<bool> in_use_;
+        std::vector<int> free_;
+    }; // class descriptor_table
+} // namespace irods::experimental
+
+#endif // IRODS_DESCRIPTOR_TABLE_HPP
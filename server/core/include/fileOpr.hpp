@@ -13,7 +13,10 @@
 #include "fileDriver.hpp"
 #include "chkNVPathPerm.h"
 
-#define NUM_FILE_DESC   1026    /* number of FileDesc */
+/* Deprecated.  FileDesc is a growable irods::experimental::descriptor_table
+ * and no longer has a fixed number of entries.  Only indices below
+ * FileDesc.size() may be accessed, so iterate up to that instead. */
+#define NUM_FILE_DESC   1026
 
 /* definition for inuseFlag */
 
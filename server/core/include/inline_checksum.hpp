@@ -0,0 +1,125 @@
+#ifndef IRODS_INLINE_CHECKSUM_HPP
+#define IRODS_INLINE_CHECKSUM_HPP
+
+/// \file
+
+#include "rodsType.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace irods::experimental
+{
+    /// Computes the checksum of a replica while its bytes stream through a transfer.
+    ///
+    /// A transfer is split into stripes, one per transfer thread. Each stripe must receive
+    /// a contiguous range of the replica in order. The stripes are combined when the digest
+    /// is requested. Only ADLER32 digests can be combined, so transfers using more than one
+    /// thread can only be checksummed inline when ADLER32 is the hash scheme.
+    ///
+    /// Each stripe may be updated by a different thread. The digest must not be requested
+    /// until all threads have finished.
+    ///
+    /// \since 4.3.0
+    class inline_checksum
+    {
+    public:
+        /// Returns whether a transfer using \p _stripe_count threads can be checksummed
+        /// inline using \p _scheme.
+        ///
+        /// \since 4.3.0
+        static auto is_supported(std::string_view _scheme, int _stripe_count) -> bool;
+
+        /// \throws irods::exception If \p _scheme is not supported with \p _stripe_count stripes.
+        ///
+        /// \since 4.3.0
+        inline_checksum(std::string_view _scheme, int _stripe_count);
+
+        inline_checksum(const inline_checksum&) = delete;
+        auto operator=(const inline_checksum&) -> inline_checksum& = delete;
+
+        ~inline_checksum();
+
+        /// \since 4.3.0
+        auto scheme() const noexcept -> const std::string&;
+
+        /// Hashes bytes that were written to the replica at \p _offset.
+        ///
+        /// If the bytes do not immediately follow the bytes previously given to the stripe,
+        /// the stripe is invalidated and no digest will be produced.
+        ///
+        /// \param[in] _stripe The stripe (i.e. transfer thread) the bytes belong to.
+        /// \param[in] _offset The offset of the bytes within the replica.
+        /// \param[in] _data   The bytes.
+        /// \param[in] _size   The number of bytes.
+        ///
+        /// \since 4.3.0
+        auto update(int _stripe, rodsLong_t _offset, const void* _data, std::size_t _size) noexcept -> void;
+
+        /// Returns the digest of the replica.
+        ///
+        /// \param[in] _size The size of the replica.
+        ///
+        /// \return An optional string.
+        /// \retval std::nullopt If the stripes do not cover the replica from offset zero to
+        ///                      \p _size without gaps, or any stripe was invalidated.
+        /// \retval digest       Otherwise. The digest has the same format as the digest
+        ///                      produced by irods::Hasher.
+        ///
+        /// \since 4.3.0
+        auto digest(rodsLong_t _size) -> std::optional<std::string>;
+
+    private:
+        struct stripe;
+
+        std::string scheme_;
+        std::vector<std::unique_ptr<stripe>> stripes_;
+    }; // class inline_checksum
+
+    /// Holds the inline checksums of replicas being written by this agent until they are
+    /// requested by the checksum API.
+    ///
+    /// Entries are identified by the resource hierarchy and physical path of the replica.
+    /// An entry is removed when its digest is requested, when the replica is written to by
+    /// any other means, or when the L1 descriptor that wrote the replica is freed.
+    ///
+    /// \since 4.3.0
+    namespace inline_checksum_table
+    {
+        /// Stores \p _checksum for the replica, replacing any existing entry.
+        ///
+        /// \since 4.3.0
+        auto insert(std::string_view _hierarchy,
+                    std::string_view _physical_path,
+                    std::shared_ptr<inline_checksum> _checksum) -> void;
+
+        /// Removes the entry for the replica and returns its digest.
+        ///
+        /// \param[in] _hierarchy     The resource hierarchy of the replica.
+        /// \param[in] _physical_path The physical path of the replica.
+        /// \param[in] _scheme        The hash scheme the caller requires.
+        /// \param[in] _size          The size of the replica.
+        ///
+        /// \return An optional string.
+        /// \retval std::nullopt If there is no entry, the entry uses a different scheme or
+        ///                      the entry could not produce a digest for \p _size bytes.
+        /// \retval digest       Otherwise.
+        ///
+        /// \since 4.3.0
+        auto take_digest(std::string_view _hierarchy,
+                         std::string_view _physical_path,
+                         std::string_view _scheme,
+                         rodsLong_t _size) -> std::optional<std::string>;
+
+        /// Removes the entry for the replica, if any.
+        ///
+        /// \since 4.3.0
+        auto erase(std::string_view _hierarchy, std::string_view _physical_path) -> void;
+    } // namespace inline_checksum_table
+} // namespace irods::experimental
+
+#endif // IRODS_INLINE_CHECKSUM_HPP
@@ -392,6 +392,17 @@ int call_genQueryInp_genQueryOut(
 #define CALL_GENQUERYINP_GENQUERYOUT nullptr
 #endif
 
+#ifdef CREATE_API_TABLE_FOR_SERVER
+int call_genQueryInp_genQueryColumnarOut(
+    irods::api_entry*,
+    rsComm_t*,
+    genQueryInp_t*,
+    genQueryColumnarOut_t**);
+#define CALL_GENQUERYINP_GENQUERYCOLUMNAROUT call_genQueryInp_genQueryColumnarOut
+#else
+#define CALL_GENQUERYINP_GENQUERYCOLUMNAROUT nullptr
+#endif
+
 #ifdef CREATE_API_TABLE_FOR_SERVER
 int call_authRequestOut(
     irods::api_entry*,
@@ -18,6 +18,7 @@ namespace irods {
     const std::string DATABASE_OP_UPDATE_RESC_OBJ_COUNT( "database_update_resc_obj_count" );
     const std::string DATABASE_OP_MOD_DATA_OBJ_META( "database_mod_data_obj_meta" );
     const std::string DATABASE_OP_REG_DATA_OBJ( "database_reg_data_obj" );
+    const std::string DATABASE_OP_BULK_REG_DATA_OBJ( "database_bulk_reg_data_obj" );
     const std::string DATABASE_OP_REG_REPLICA( "database_reg_replica" );
     const std::string DATABASE_OP_UNREG_REPLICA( "database_unreg_replica" );
     const std::string DATABASE_OP_REG_RULE_EXEC( "database_reg_rule_exec" );
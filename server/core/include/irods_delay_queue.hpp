@@ -1,12 +1,15 @@
 #ifndef IRODS_DELAY_QUEUE_HPP
 #define IRODS_DELAY_QUEUE_HPP
 
-#include <algorithm>
+#include <cstddef>
 #include <mutex>
 #include <string>
-#include <vector>
+#include <unordered_set>
 
 namespace irods {
+    // Tracks the rules which have been handed to the thread pool and have not
+    // finished executing yet. All operations are O(1) so that the delay server
+    // can keep up with very large numbers of queued delay rules.
     class delay_queue {
         public:
             delay_queue() = default;
@@ -15,30 +18,29 @@ namespace irods {
 
             bool contains_rule_id(const std::string& _rule_id) {
                 std::lock_guard rules_lock{rules_mutex_};
-                return std::any_of(queued_rules_.begin(), queued_rules_.end(),
-                           [&](const std::string& q_rule) { return q_rule == _rule_id; });
+                return queued_rules_.count(_rule_id) > 0;
             }
 
-            void enqueue_rule(const std::string& rule_id) {
+            // Returns false if the rule is already in the queue.
+            bool enqueue_rule(const std::string& rule_id) {
                 std::lock_guard rules_lock{rules_mutex_};
-                queued_rules_.emplace_back(rule_id);
+                return queued_rules_.insert(rule_id).second;
             }
 
             void dequeue_rule(const std::string& rule_id) {
                 std::lock_guard rules_lock{rules_mutex_};
-                for (auto it = queued_rules_.begin(); it != queued_rules_.end(); ++it) {
-                    if (*it == rule_id) {
-                        queued_rules_.erase(it);
-                        break;
-                    }
-                }
+                queued_rules_.erase(rule_id);
+            }
+
+            std::size_t size() {
+                std::lock_guard rules_lock{rules_mutex_};
+                return queued_rules_.size();
             }
 
         private:
             std::mutex rules_mutex_;
-            std::vector<std::string> queued_rules_;
+            std::unordered_set<std::string> queued_rules_;
     };
 } // namespace irods
 
 #endif // IRODS_DELAY_QUEUE_HPP
-
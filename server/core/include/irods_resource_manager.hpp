@@ -256,8 +256,16 @@ namespace irods
                 const std::string);
 
             // =-=-=-=-=-=-=-
-            /// @brief take results from genQuery, extract values and create resources
-            error process_init_results( genQueryOut_t* );
+            /// @brief query the catalog for the values of every resource, one row per resource
+            error query_resource_rows( rsComm_t*, std::vector<std::vector<std::string>>& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief take results from genQuery and extract the values for each resource
+            error process_init_results( genQueryOut_t*, std::vector<std::vector<std::string>>& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief given a series of rows, each being a resource, create the resources
+            error process_resource_rows( const std::vector<std::vector<std::string>>& );
 
             // =-=-=-=-=-=-=-
             /// @brief Initialize the child map from the resources lookup table
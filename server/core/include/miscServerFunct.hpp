@@ -25,6 +25,11 @@
 
 #define MAX_RECON_ERROR_CNT	10
 
+namespace irods::experimental
+{
+    class inline_checksum;
+} // namespace irods::experimental
+
 typedef struct PortalTransferInp {
     rsComm_t *rsComm;
     int destFd;
@@ -45,6 +50,9 @@ typedef struct PortalTransferInp {
     char encryption_algorithm[ NAME_LEN ];
     char shared_secret[ NAME_LEN ]; // JMC - shared secret for each portal thread
 
+    // Hashes the bytes written by the thread, if not null.
+    irods::experimental::inline_checksum* checksum;
+
 } portalTransferInp_t;
 
 int
@@ -20,7 +20,10 @@
 
 #include <string>
 
-#define NUM_L1_DESC     1026    /* number of L1Desc */
+/* Deprecated.  L1desc is a growable irods::experimental::descriptor_table
+ * and no longer has a fixed number of entries.  Only indices below
+ * L1desc.size() may be accessed, so iterate up to that instead. */
+#define NUM_L1_DESC     1026
 
 #define CHK_ORPHAN_CNT_LIMIT  20  /* number of failed check before stopping */
 /* definition for getNumThreads */
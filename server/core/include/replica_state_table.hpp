@@ -10,6 +10,7 @@
 #include <string_view>
 #include <tuple>
 #include <variant>
+#include <vector>
 
 /// \file
 
@@ -91,6 +92,10 @@ struct RsComm;
 ///
 /// Each entry uses the data_id (std::uint64_t) for the represented data object as the key into the map.
 ///
+/// Internally, the replica states are stored as typed columns and replicas are looked up by
+/// replica number or resource id without parsing strings. The JSON structure is only produced
+/// when requested through at() and when an entry is published to the catalog.
+///
 /// \endparblock
 ///
 /// \since 4.2.9
@@ -498,6 +503,21 @@ namespace irods::replica_state_table
     auto update(const key_type& _key,
                 const irods::experimental::replica::replica_proxy_t& _replica) -> void;
 
+    /// \brief Sets the replica status (data_is_dirty) of the specified replica (after state only)
+    ///
+    /// Equivalent to updating "data_is_dirty" through update() without building JSON.
+    ///
+    /// \param[in] _key
+    /// \param[in] _replica_number Replica number in the "before" entry
+    /// \param[in] _replica_status The new replica status
+    ///
+    /// \throws irods::exception If specified replica does not exist
+    ///
+    /// \since 4.3.0
+    auto update_replica_status(const key_type& _key,
+                               const int _replica_number,
+                               const int _replica_status) -> void;
+
     /// \brief Returns the value of a given property of the given replica in the state table
     ///
     /// \param[in] _key
@@ -514,6 +534,30 @@ namespace irods::replica_state_table
         const std::string_view _property_name,
         const state_type _state = state_type::before) -> std::string;
 
+    /// \brief Returns the replica status (data_is_dirty) of the given replica in the state table
+    ///
+    /// \param[in] _key
+    /// \param[in] _replica_number Replica number in the "before" entry
+    /// \param[in] _state Must be state_type::before or state_type::after
+    ///
+    /// \throws irods::exception If specified replica does not exist
+    ///
+    /// \since 4.3.0
+    auto get_replica_status(
+        const key_type& _key,
+        const int _replica_number,
+        const state_type _state = state_type::before) -> int;
+
+    /// \brief Returns the replica numbers of the replicas in the entry with key _key
+    ///
+    /// The replica numbers are taken from the "before" entries and are listed in the same
+    /// order as the replicas returned by at().
+    ///
+    /// \throws irods::exception If the entry does not exist
+    ///
+    /// \since 4.3.0
+    auto get_replica_numbers(const key_type& _key) -> std::vector<int>;
+
     /// \brief Get the logical path for the entry with key _key
     ///
     /// \parblock
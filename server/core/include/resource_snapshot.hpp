@@ -0,0 +1,83 @@
+#ifndef IRODS_RESOURCE_SNAPSHOT_HPP
+#define IRODS_RESOURCE_SNAPSHOT_HPP
+
+/// \file
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+
+/// A read-only copy of the resource rows stored in the catalog, shared by all agents.
+///
+/// The server populates the snapshot on demand. Agents compare the version string
+/// of the snapshot against a cheap query of the catalog and only fall back to the
+/// full resource query when the two disagree.
+namespace irods::experimental::resource_snapshot
+{
+    /// The type used to represent a single resource row. One string per column.
+    using row_type = std::vector<std::string>;
+
+    /// Initializes the resource snapshot.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_resource_snapshot",
+              std::size_t _shm_size = 2'500'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Returns whether the resource snapshot is available to the calling process.
+    ///
+    /// \since 4.3.0
+    auto is_initialized() noexcept -> bool;
+
+    /// Replaces the contents of the snapshot.
+    ///
+    /// If \p _rows does not fit into shared memory, the snapshot is left empty.
+    ///
+    /// \param[in] _version The version string identifying the catalog state \p _rows were read from.
+    /// \param[in] _rows    The resource rows.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the snapshot was updated.
+    /// \retval false Otherwise.
+    ///
+    /// \since 4.3.0
+    auto store(const std::string_view _version, const std::vector<row_type>& _rows) -> bool;
+
+    /// Returns a copy of the resource rows if the snapshot matches \p _version.
+    ///
+    /// \param[in] _version The version string of the catalog state the caller expects.
+    ///
+    /// \return An optional containing the resource rows.
+    /// \retval rows         If the snapshot's version is equivalent to \p _version.
+    /// \retval std::nullopt Otherwise.
+    ///
+    /// \since 4.3.0
+    auto load(const std::string_view _version) -> std::optional<std::vector<row_type>>;
+
+    /// Returns the version string of the snapshot.
+    ///
+    /// An empty string is returned if the snapshot has not been populated.
+    ///
+    /// \since 4.3.0
+    auto version() -> std::string;
+
+    /// Discards the contents of the snapshot.
+    ///
+    /// \since 4.3.0
+    auto clear() -> void;
+} // namespace irods::experimental::resource_snapshot
+
+#endif // IRODS_RESOURCE_SNAPSHOT_HPP
+
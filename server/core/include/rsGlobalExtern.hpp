@@ -15,6 +15,7 @@
 #include "miscUtil.h"
 #include "authenticate.h"
 #include "openCollection.h"
+#include "descriptor_table.hpp"
 
 // =-=-=-=-=-=-=-
 #include "irods_resource_manager.hpp"
@@ -32,10 +33,14 @@ extern rodsServerHost_t *ServerHostHead;
 extern rodsServerHost_t *HostConfigHead;
 extern zoneInfo_t *ZoneInfoHead;
 extern int RescGrpInit;
-extern fileDesc_t FileDesc[NUM_FILE_DESC];
-extern l1desc_t L1desc[NUM_L1_DESC];
-extern specCollDesc_t SpecCollDesc[NUM_SPEC_COLL_DESC];
-extern std::vector<collHandle_t> CollHandle;;
+// The descriptor tables were fixed-size arrays (and a std::vector for CollHandle)
+// before 4.3.0. They are indexed the same way, but grow on demand, so only indices
+// below size() are valid and a descriptor is obtained with allocate() rather than
+// by scanning for a free entry.
+extern irods::experimental::descriptor_table<fileDesc_t> FileDesc;
+extern irods::experimental::descriptor_table<l1desc_t> L1desc;
+extern irods::experimental::descriptor_table<specCollDesc_t> SpecCollDesc;
+extern irods::experimental::descriptor_table<collHandle_t> CollHandle;
 
 /* global Rule Engine File Initialization String */
 
@@ -167,6 +167,7 @@ namespace irods
                        GET_TEMP_PASSWORD_FOR_OTHER_AN,
                        PAM_AUTH_REQUEST_AN,
                        GET_LIMITED_PASSWORD_AN,
+                       GEN_QUERY_COLUMNAR_AN,
 
                         // 1100 - 1200 - SSL API calls
                        SSL_START_AN,
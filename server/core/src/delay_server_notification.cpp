@@ -0,0 +1,125 @@
+#include "delay_server_notification.hpp"
+
+#include "irods_server_properties.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_logger.hpp"
+#include "rodsErrorTable.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    using log = irods::experimental::log;
+
+    // Fills in the address of the abstract socket and returns its length.
+    auto make_address(sockaddr_un& _addr) -> socklen_t
+    {
+        const auto name = irods::experimental::delay_server::notification_socket_name();
+
+        std::memset(&_addr, 0, sizeof(sockaddr_un));
+        _addr.sun_family = AF_UNIX;
+
+        // The first byte of sun_path is left as zero, placing the socket in the abstract namespace.
+        const auto size = std::min(name.size(), sizeof(_addr.sun_path) - 1);
+        std::memcpy(_addr.sun_path + 1, name.data(), size);
+
+        return offsetof(sockaddr_un, sun_path) + 1 + size;
+    }
+} // anonymous namespace
+
+namespace irods::experimental::delay_server
+{
+    auto notification_socket_name() -> std::string
+    {
+        int zone_port = 0;
+
+        try {
+            zone_port = irods::get_server_property<const int>(irods::CFG_ZONE_PORT);
+        }
+        catch (...) {
+            // Fall through and use the default name.
+        }
+
+        return fmt::format("irods_delay_server_{}", zone_port);
+    } // notification_socket_name
+
+    auto open_notification_socket() noexcept -> int
+    {
+        try {
+            const int sock = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (sock < 0) {
+                log::delay_server::error("Could not create notification socket [errno={}].", errno);
+                return SYS_SOCK_OPEN_ERR - errno;
+            }
+
+            sockaddr_un addr{};
+            const auto addr_len = make_address(addr);
+
+            if (bind(sock, reinterpret_cast<sockaddr*>(&addr), addr_len) < 0) {
+                const auto ec = errno;
+                close(sock);
+                log::delay_server::error("Could not bind notification socket [name={}, errno={}].",
+                                         notification_socket_name(), ec);
+                return SYS_SOCK_BIND_ERR - ec;
+            }
+
+            return sock;
+        }
+        catch (...) {
+            return SYS_INTERNAL_ERR;
+        }
+    } // open_notification_socket
+
+    auto wait_for_notification(int _socket, int _timeout_in_milliseconds) noexcept -> bool
+    {
+        pollfd pfd{};
+        pfd.fd = _socket;
+        pfd.events = POLLIN;
+
+        if (poll(&pfd, 1, _timeout_in_milliseconds) <= 0 || !(pfd.revents & POLLIN)) {
+            return false;
+        }
+
+        // Drain every pending notification so that a burst of submissions
+        // results in a single wake-up.
+        char buf[16];
+        while (recv(_socket, buf, sizeof(buf), 0) >= 0);
+
+        return true;
+    } // wait_for_notification
+
+    auto notify() noexcept -> bool
+    {
+        try {
+            const int sock = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (sock < 0) {
+                return false;
+            }
+
+            sockaddr_un addr{};
+            const auto addr_len = make_address(addr);
+
+            const char msg = 1;
+            const auto sent = sendto(sock, &msg, sizeof(msg), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&addr), addr_len);
+            close(sock);
+
+            return sent == sizeof(msg);
+        }
+        catch (...) {
+            return false;
+        }
+    } // notify
+} // namespace irods::experimental::delay_server
+
@@ -21,27 +21,28 @@
 #include "irods_resource_manager.hpp"
 #include "irods_resource_plugin.hpp"
 
+#include <new>
+
 int
 initFileDesc() {
-    memset( FileDesc, 0, sizeof( FileDesc ) );
+    // The table starts out empty and grows as descriptors are allocated.
+    FileDesc.clear();
     return 0;
 }
 
 int
 allocFileDesc() {
-    int i;
-
-    for ( i = 3; i < NUM_FILE_DESC; i++ ) {
-        if ( FileDesc[i].inuseFlag == FD_FREE ) {
-            FileDesc[i].inuseFlag = FD_INUSE;
-            return i;
-        };
+    try {
+        const int i = FileDesc.allocate();
+        FileDesc[i].inuseFlag = FD_INUSE;
+        return i;
     }
+    catch ( const std::bad_alloc& ) {
+        rodsLog( LOG_NOTICE,
+                 "allocFileDesc: out of FileDesc" );
 
-    rodsLog( LOG_NOTICE,
-             "allocFileDesc: out of FileDesc" );
-
-    return SYS_OUT_OF_FILE_DESC;
+        return SYS_OUT_OF_FILE_DESC;
+    }
 }
 
 int
@@ -68,7 +69,7 @@ allocAndFillFileDesc( rodsServerHost_t *rodsServerHost,
 
 int
 freeFileDesc( int fileInx ) {
-    if ( fileInx < 3 || fileInx >= NUM_FILE_DESC ) {
+    if ( !FileDesc.in_range( fileInx ) ) {
         rodsLog( LOG_NOTICE,
                  "freeFileDesc: fileInx %d out of range", fileInx );
         return SYS_FILE_DESC_OUT_OF_RANGE;
@@ -89,6 +90,7 @@ freeFileDesc( int fileInx ) {
     /* don't free driverDep (dirPtr is not malloced */
 
     memset( &FileDesc[fileInx], 0, sizeof( fileDesc_t ) );
+    FileDesc.release( fileInx );
 
     return 0;
 }
@@ -96,7 +98,7 @@ freeFileDesc( int fileInx ) {
 int
 getServerHostByFileInx( int fileInx, rodsServerHost_t **rodsServerHost ) {
     int remoteFlag;
-    if ( fileInx < 3 || fileInx >= NUM_FILE_DESC ) {
+    if ( !FileDesc.in_range( fileInx ) ) {
         rodsLog( LOG_DEBUG,
                  "getServerHostByFileInx: Bad fileInx value %d", fileInx );
         return SYS_BAD_FILE_DESCRIPTOR;
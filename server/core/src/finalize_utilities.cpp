@@ -306,7 +306,7 @@ namespace irods
 
         // Set the target replica to stale and keep the other replica statuses the
         // same - they should be unlocked as specified by the previous unlock.
-        rst::update(_data_id, _replica_number, json{{"data_is_dirty", std::to_string(STALE_REPLICA)}});
+        rst::update_replica_status(_data_id, _replica_number, STALE_REPLICA);
 
         // Elevate privileges to ensure that publishing goes through
         {
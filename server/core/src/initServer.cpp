@@ -120,7 +120,7 @@ namespace
     {
         rodsLog(LOG_DEBUG, "[%s:%d] Closing all L1 descriptors ...", __func__, __LINE__);
 
-        for (int fd = 3; fd < NUM_L1_DESC; ++fd) {
+        for (int fd = 3; fd < static_cast<int>(L1desc.size()); ++fd) {
             auto& l1desc = L1desc[fd];
             if (FD_INUSE != l1desc.inuseFlag || l1desc.l3descInx < 3) {
                 continue;
@@ -0,0 +1,253 @@
+#include "inline_checksum.hpp"
+
+#include "irods_hasher_factory.hpp"
+#include "ADLER32Strategy.hpp"
+#include "checksum.h"
+#include "irods_exception.hpp"
+#include "rodsErrorTable.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    namespace ix = irods::experimental;
+
+    constexpr std::uint64_t adler32_base = 65521;
+
+    // Returns the ADLER32 checksum of two concatenated byte sequences given the checksum of each
+    // sequence and the length of the second sequence (see adler32_combine in zlib).
+    auto combine_adler32(std::uint32_t _first, std::uint32_t _second, std::uint64_t _second_length) -> std::uint32_t
+    {
+        const std::uint64_t rem = _second_length % adler32_base;
+
+        std::uint64_t sum1 = _first & 0xffff;
+        std::uint64_t sum2 = (rem * sum1) % adler32_base;
+
+        sum1 += (_second & 0xffff) + adler32_base - 1;
+        sum2 += ((_first >> 16) & 0xffff) + ((_second >> 16) & 0xffff) + adler32_base - rem;
+
+        if (sum1 >= adler32_base) { sum1 -= adler32_base; }
+        if (sum1 >= adler32_base) { sum1 -= adler32_base; }
+        if (sum2 >= (adler32_base << 1)) { sum2 -= (adler32_base << 1); }
+        if (sum2 >= adler32_base) { sum2 -= adler32_base; }
+
+        return static_cast<std::uint32_t>(sum1 | (sum2 << 16));
+    } // combine_adler32
+
+    auto parse_adler32(const std::string& _digest) -> std::optional<std::uint32_t>
+    {
+        const std::string_view prefix = ADLER32_CHKSUM_PREFIX;
+
+        if (_digest.compare(0, prefix.size(), prefix) != 0) {
+            return std::nullopt;
+        }
+
+        return static_cast<std::uint32_t>(std::strtoul(_digest.c_str() + prefix.size(), nullptr, 16));
+    } // parse_adler32
+
+    auto make_key(std::string_view _hierarchy, std::string_view _physical_path) -> std::string
+    {
+        return fmt::format("{}:{}", _hierarchy, _physical_path);
+    } // make_key
+
+    std::mutex g_mutex;
+    std::map<std::string, std::shared_ptr<ix::inline_checksum>> g_checksums;
+} // anonymous namespace
+
+namespace irods::experimental
+{
+    struct inline_checksum::stripe
+    {
+        irods::Hasher hasher;
+        rodsLong_t offset = -1;
+        rodsLong_t size = 0;
+        bool valid = true;
+    }; // struct stripe
+
+    auto inline_checksum::is_supported(std::string_view _scheme, int _stripe_count) -> bool
+    {
+        if (_stripe_count == 1) {
+            irods::Hasher hasher;
+            return irods::getHasher(std::string{_scheme}, hasher).ok();
+        }
+
+        return _stripe_count > 1 && irods::ADLER32_NAME == _scheme;
+    } // is_supported
+
+    inline_checksum::inline_checksum(std::string_view _scheme, int _stripe_count)
+        : scheme_{_scheme}
+        , stripes_{}
+    {
+        if (!is_supported(_scheme, _stripe_count)) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("Inline checksums are not supported for [{}] with [{}] stripes",
+                                                       _scheme, _stripe_count));
+        }
+
+        stripes_.reserve(_stripe_count);
+
+        for (int i = 0; i < _stripe_count; ++i) {
+            auto& s = stripes_.emplace_back(std::make_unique<stripe>());
+
+            if (const auto error = irods::getHasher(scheme_, s->hasher); !error.ok()) {
+                THROW(error.code(), error.result());
+            }
+        }
+    } // inline_checksum
+
+    inline_checksum::~inline_checksum() = default;
+
+    auto inline_checksum::scheme() const noexcept -> const std::string&
+    {
+        return scheme_;
+    } // scheme
+
+    auto inline_checksum::update(int _stripe, rodsLong_t _offset, const void* _data, std::size_t _size) noexcept -> void
+    {
+        if (_stripe < 0 || _stripe >= static_cast<int>(stripes_.size())) {
+            return;
+        }
+
+        auto& s = *stripes_[_stripe];
+
+        if (!s.valid || _size == 0) {
+            return;
+        }
+
+        if (s.offset < 0) {
+            s.offset = _offset;
+        }
+        else if (s.offset + s.size != _offset) {
+            // The bytes are not contiguous with the bytes already hashed.
+            s.valid = false;
+            return;
+        }
+
+        if (!s.hasher.update(static_cast<const char*>(_data), _size).ok()) {
+            s.valid = false;
+            return;
+        }
+
+        s.size += _size;
+    } // update
+
+    auto inline_checksum::digest(rodsLong_t _size) -> std::optional<std::string>
+    {
+        std::vector<stripe*> stripes;
+        stripes.reserve(stripes_.size());
+
+        for (auto& s : stripes_) {
+            if (!s->valid) {
+                return std::nullopt;
+            }
+
+            // Stripes which did not receive any bytes do not contribute to the digest.
+            if (s->size > 0) {
+                stripes.push_back(s.get());
+            }
+        }
+
+        std::sort(std::begin(stripes), std::end(stripes), [](const stripe* _lhs, const stripe* _rhs) {
+            return _lhs->offset < _rhs->offset;
+        });
+
+        rodsLong_t end = 0;
+
+        for (const auto* s : stripes) {
+            if (s->offset != end) {
+                return std::nullopt;
+            }
+
+            end += s->size;
+        }
+
+        if (end != _size) {
+            return std::nullopt;
+        }
+
+        // An empty replica still produces the digest of zero bytes.
+        if (stripes.empty()) {
+            std::string digest;
+            if (!stripes_.front()->hasher.digest(digest).ok()) {
+                return std::nullopt;
+            }
+            return digest;
+        }
+
+        if (stripes.size() == 1) {
+            std::string digest;
+            if (!stripes.front()->hasher.digest(digest).ok()) {
+                return std::nullopt;
+            }
+            return digest;
+        }
+
+        // Only ADLER32 stripes are ever combined (see is_supported).
+        std::optional<std::uint32_t> combined;
+
+        for (auto* s : stripes) {
+            std::string digest;
+            if (!s->hasher.digest(digest).ok()) {
+                return std::nullopt;
+            }
+
+            const auto value = parse_adler32(digest);
+            if (!value) {
+                return std::nullopt;
+            }
+
+            combined = combined ? combine_adler32(*combined, *value, s->size) : *value;
+        }
+
+        return fmt::format("{}{:08x}", ADLER32_CHKSUM_PREFIX, *combined);
+    } // digest
+
+    namespace inline_checksum_table
+    {
+        auto insert(std::string_view _hierarchy,
+                    std::string_view _physical_path,
+                    std::shared_ptr<inline_checksum> _checksum) -> void
+        {
+            std::lock_guard lock{g_mutex};
+            g_checksums.insert_or_assign(make_key(_hierarchy, _physical_path), std::move(_checksum));
+        } // insert
+
+        auto take_digest(std::string_view _hierarchy,
+                         std::string_view _physical_path,
+                         std::string_view _scheme,
+                         rodsLong_t _size) -> std::optional<std::string>
+        {
+            std::shared_ptr<inline_checksum> checksum;
+
+            {
+                std::lock_guard lock{g_mutex};
+
+                auto iter = g_checksums.find(make_key(_hierarchy, _physical_path));
+                if (iter == std::end(g_checksums)) {
+                    return std::nullopt;
+                }
+
+                checksum = std::move(iter->second);
+                g_checksums.erase(iter);
+            }
+
+            if (checksum->scheme() != _scheme) {
+                return std::nullopt;
+            }
+
+            return checksum->digest(_size);
+        } // take_digest
+
+        auto erase(std::string_view _hierarchy, std::string_view _physical_path) -> void
+        {
+            std::lock_guard lock{g_mutex};
+            g_checksums.erase(make_key(_hierarchy, _physical_path));
+        } // erase
+    } // namespace inline_checksum_table
+} // namespace irods::experimental
@@ -1,5 +1,6 @@
 #include "connection_pool.hpp"
 #include "client_connection.hpp"
+#include "delay_server_notification.hpp"
 #include "initServer.hpp"
 #include "irods_at_scope_exit.hpp"
 #include "irods_delay_queue.hpp"
@@ -39,6 +40,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -48,9 +50,13 @@
 #include <string>
 #include <string_view>
 #include <fstream>
+#include <vector>
+
+#include <unistd.h>
 
 // clang-format off
 namespace ix = irods::experimental;
+namespace ds = irods::experimental::delay_server;
 
 using logger = irods::experimental::log;
 using json   = nlohmann::json;
@@ -86,29 +92,33 @@ namespace {
         }
     }
 
-    ruleExecSubmitInp_t fill_rule_exec_submit_inp(rcComm_t& comm, const std::string_view rule_id)
+    // The columns fetched for every delay rule. The order of the columns determines the
+    // position of each value in a result row.
+    constexpr const char* delay_rule_columns = "RULE_EXEC_ID, "
+                                               "RULE_EXEC_NAME, "
+                                               "RULE_EXEC_REI_FILE_PATH, "
+                                               "RULE_EXEC_USER_NAME, "
+                                               "RULE_EXEC_ADDRESS, "
+                                               "RULE_EXEC_TIME, "
+                                               "RULE_EXEC_FREQUENCY, "
+                                               "ORDER_DESC(RULE_EXEC_PRIORITY), "
+                                               "RULE_EXEC_LAST_EXE_TIME, "
+                                               "RULE_EXEC_STATUS, "
+                                               "RULE_EXEC_ESTIMATED_EXE_TIME, "
+                                               "RULE_EXEC_NOTIFICATION_ADDR, "
+                                               "RULE_EXEC_CONTEXT";
+
+    // The minimum amount of time between two polls of the catalog. This keeps a burst
+    // of submissions from turning into a burst of queries.
+    constexpr std::chrono::seconds minimum_poll_interval{1};
+
+    ruleExecSubmitInp_t fill_rule_exec_submit_inp(const std::vector<std::string>& exec_info)
     {
-        const auto gql = fmt::format("SELECT RULE_EXEC_NAME, \
-                                             RULE_EXEC_REI_FILE_PATH, \
-                                             RULE_EXEC_USER_NAME, \
-                                             RULE_EXEC_ADDRESS, \
-                                             RULE_EXEC_TIME, \
-                                             RULE_EXEC_FREQUENCY, \
-                                             RULE_EXEC_PRIORITY, \
-                                             RULE_EXEC_LAST_EXE_TIME, \
-                                             RULE_EXEC_STATUS, \
-                                             RULE_EXEC_ESTIMATED_EXE_TIME, \
-                                             RULE_EXEC_NOTIFICATION_ADDR, \
-                                             RULE_EXEC_CONTEXT \
-                                      WHERE RULE_EXEC_ID = '{}'", rule_id);
-
-        irods::query q{&comm, gql};
-
-        if (q.size() == 0) {
-            THROW(CAT_NO_ROWS_FOUND, fmt::format("Could not find row matching rule id [rule_id={}]", rule_id));
+        if (exec_info.size() < 13) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("Incomplete delay rule information [columns={}]", exec_info.size()));
         }
 
-        const auto exec_info = q.front();
+        const auto& rule_id = exec_info[0];
 
         namespace fs = boost::filesystem;
 
@@ -120,8 +130,8 @@ namespace {
         // - r_rule_exec.rei_file_path will be set to a valid file path on the file system.
         //
         // These rules will be migrated if and only if the rule text does not contain session variables.
-        if (const auto& rei_file_path = exec_info[1];
-            exec_info[11].empty() &&
+        if (const auto& rei_file_path = exec_info[2];
+            exec_info[12].empty() &&
             rei_file_path != "EMPTY_REI_PATH" &&
             fs::exists(rei_file_path))
         {
@@ -148,21 +158,21 @@ namespace {
             }
         }
 
-        rstrcpy(rule_exec_submit_inp.ruleExecId, rule_id.data(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.ruleName, exec_info[0].c_str(), META_STR_LEN);
-        rstrcpy(rule_exec_submit_inp.reiFilePath, exec_info[1].c_str(), MAX_NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.userName, exec_info[2].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.exeAddress, exec_info[3].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.exeTime, exec_info[4].c_str(), TIME_LEN);
-        rstrcpy(rule_exec_submit_inp.exeFrequency, exec_info[5].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.priority, exec_info[6].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.lastExecTime, exec_info[7].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.exeStatus, exec_info[8].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.estimateExeTime, exec_info[9].c_str(), NAME_LEN);
-        rstrcpy(rule_exec_submit_inp.notificationAddr, exec_info[10].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.ruleExecId, rule_id.c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.ruleName, exec_info[1].c_str(), META_STR_LEN);
+        rstrcpy(rule_exec_submit_inp.reiFilePath, exec_info[2].c_str(), MAX_NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.userName, exec_info[3].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.exeAddress, exec_info[4].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.exeTime, exec_info[5].c_str(), TIME_LEN);
+        rstrcpy(rule_exec_submit_inp.exeFrequency, exec_info[6].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.priority, exec_info[7].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.lastExecTime, exec_info[8].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.exeStatus, exec_info[9].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.estimateExeTime, exec_info[10].c_str(), NAME_LEN);
+        rstrcpy(rule_exec_submit_inp.notificationAddr, exec_info[11].c_str(), NAME_LEN);
 
         ix::key_value_proxy kvp{rule_exec_submit_inp.condInput};
-        kvp[RULE_EXECUTION_CONTEXT_KW] = exec_info[11];
+        kvp[RULE_EXECUTION_CONTEXT_KW] = exec_info[12];
 
         return rule_exec_submit_inp;
     }
@@ -442,7 +452,7 @@ namespace {
         return status;
     }
 
-    void execute_rule(irods::delay_queue& queue, const std::string_view rule_id)
+    void execute_rule(irods::delay_queue& queue, const std::vector<std::string>& rule_info)
     {
         if (re_server_terminated) {
             return;
@@ -454,16 +464,17 @@ namespace {
             freeBBuf(rule_exec_submit_inp.packedReiAndArgBBuf);
         }};
 
-        ix::client_connection conn;
-
         try {
-            rule_exec_submit_inp = fill_rule_exec_submit_inp(conn, rule_id);
+            rule_exec_submit_inp = fill_rule_exec_submit_inp(rule_info);
         }
         catch (const irods::exception& e) {
             irods::log(e);
+            queue.dequeue_rule(rule_info[0]);
             return;
         }
 
+        ix::client_connection conn;
+
         try {
             if (const int status = run_rule_exec(conn, rule_exec_submit_inp); status < 0) {
                 logger::delay_server::error("Rule exec for [{}] failed. status = [{}]", rule_exec_submit_inp.ruleExecId, status);
@@ -488,18 +499,19 @@ namespace {
         const auto job = [&](const result_row& result) -> void
         {
             const auto& rule_id = result[0];
-            if (queue.contains_rule_id(rule_id)) {
+            if (!queue.enqueue_rule(rule_id)) {
                 return;
             }
             logger::delay_server::debug("Enqueueing rule [{}]", rule_id);
-            queue.enqueue_rule(rule_id);
             irods::thread_pool::post(thread_pool, [&queue, result] {
-                execute_rule(queue, result[0]);
+                execute_rule(queue, result);
             });
         };
 
-        const auto qstr = fmt::format("SELECT RULE_EXEC_ID, ORDER_DESC(RULE_EXEC_PRIORITY) "
-                                      "WHERE RULE_EXEC_TIME <= '{}'", std::time(nullptr));
+        // Every column needed to execute a rule is fetched by this one (paged) query
+        // so that executing a rule does not require another round trip to the catalog.
+        const auto qstr = fmt::format("SELECT {} WHERE RULE_EXEC_TIME <= '{}'",
+                                      delay_rule_columns, std::time(nullptr));
 
         return {qstr, job};
     }
@@ -551,11 +563,52 @@ int main(int argc, char **argv)
         return irods::default_re_server_sleep_time;
     }();
 
-    const auto go_to_sleep = [&sleep_time]() {
-        std::unique_lock<std::mutex> sleep_lock{term_m};
-        const auto until = std::chrono::system_clock::now() + std::chrono::seconds(sleep_time);
-        if (std::cv_status::no_timeout == term_cv.wait_until(sleep_lock, until)) {
-            logger::delay_server::debug("Rule execution server awoken by a notification");
+    // Agents on this host notify the delay server when a rule is submitted so that
+    // it does not have to wait for the next poll. If the socket cannot be created,
+    // the delay server only polls.
+    const int notification_socket = ds::open_notification_socket();
+    irods::at_scope_exit close_notification_socket{[notification_socket] {
+        if (notification_socket >= 0) {
+            close(notification_socket);
+        }
+    }};
+
+    auto last_poll_time = std::chrono::system_clock::now();
+
+    const auto go_to_sleep = [&sleep_time, &last_poll_time, notification_socket]() {
+        const auto until = last_poll_time + std::chrono::seconds(sleep_time);
+
+        if (notification_socket < 0) {
+            std::unique_lock<std::mutex> sleep_lock{term_m};
+            if (std::cv_status::no_timeout == term_cv.wait_until(sleep_lock, until)) {
+                logger::delay_server::debug("Rule execution server awoken by a notification");
+            }
+            return;
+        }
+
+        // Wait in short slices so that termination is noticed promptly.
+        while (!re_server_terminated) {
+            using std::chrono::duration_cast;
+            using std::chrono::milliseconds;
+
+            const auto now = std::chrono::system_clock::now();
+            const auto remaining = duration_cast<milliseconds>(until - now).count();
+
+            if (remaining <= 0) {
+                return;
+            }
+
+            if (ds::wait_for_notification(notification_socket, std::min<long>(remaining, 1000))) {
+                logger::delay_server::debug("Rule execution server awoken by a submitted rule");
+
+                const auto earliest = last_poll_time + minimum_poll_interval;
+                if (const auto now = std::chrono::system_clock::now(); now < earliest) {
+                    std::unique_lock<std::mutex> sleep_lock{term_m};
+                    term_cv.wait_until(sleep_lock, earliest);
+                }
+
+                return;
+            }
         }
     };
 
@@ -574,6 +627,7 @@ int main(int argc, char **argv)
     try {
         while(!re_server_terminated) {
             logger::delay_server::trace("Rule execution server is awake.");
+            last_poll_time = std::chrono::system_clock::now();
 
             try {
                 irods::parse_and_store_hosts_configuration_file_as_json();
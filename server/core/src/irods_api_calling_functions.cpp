@@ -423,6 +423,19 @@ int call_genQueryInp_genQueryOut(
                    _out);
 }
 
+int call_genQueryInp_genQueryColumnarOut(
+    irods::api_entry*       _api,
+    rsComm_t*               _comm,
+    genQueryInp_t*          _inp,
+    genQueryColumnarOut_t** _out ) {
+    return _api->call_handler<
+               genQueryInp_t*,
+               genQueryColumnarOut_t**>(
+                   _comm,
+                   _inp,
+                   _out);
+}
+
 int call_authRequestOut(
     irods::api_entry*  _api,
     rsComm_t*          _comm,
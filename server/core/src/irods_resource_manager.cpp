@@ -19,6 +19,8 @@
 #include "phyBundleColl.h"
 #include "miscServerFunct.hpp"
 #include "genQuery.h"
+#include "irods_at_scope_exit.hpp"
+#include "resource_snapshot.hpp"
 
 #include "fmt/format.h"
 
@@ -27,11 +29,92 @@
 #include <iostream>
 #include <vector>
 #include <iterator>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
 
 // =-=-=-=-=-=-=-
 // global singleton
 irods::resource_manager resc_mgr;
 
+namespace
+{
+    namespace rsnp = irods::experimental::resource_snapshot;
+
+    // The position of each catalog column within a resource row.  This matches the
+    // order in which the columns are selected by init_from_catalog.
+    namespace column
+    {
+        enum : std::size_t
+        {
+            id,
+            name,
+            zone,
+            type,
+            klass,
+            location,
+            vault_path,
+            free_space,
+            info,
+            comment,
+            create_time,
+            modify_time,
+            status,
+            children,
+            context,
+            parent,
+            parent_context,
+            count
+        };
+    } // namespace column
+
+    // Catalog timestamps have a resolution of one second.  Rows read within this many
+    // seconds of the latest modification are not published to the snapshot because a
+    // second update within the same second would not change the version.
+    constexpr std::int64_t snapshot_settle_time_in_seconds = 2;
+
+    // Produces a string identifying the current state of R_RESC_MAIN without fetching
+    // every row.  Adding or removing a resource changes the count and every other update
+    // bumps either modify_ts or free_space_ts.
+    irods::error query_resource_version( rsComm_t* _comm, std::string& _version, bool& _settled ) {
+        genQueryInp_t  genQueryInp{};
+        genQueryOut_t* genQueryOut = nullptr;
+
+        irods::at_scope_exit free_query{[&genQueryInp, &genQueryOut] {
+            freeGenQueryOut( &genQueryOut );
+            clearGenQueryInp( &genQueryInp );
+        }};
+
+        addInxIval( &genQueryInp.selectInp, COL_R_RESC_ID,         SELECT_COUNT );
+        addInxIval( &genQueryInp.selectInp, COL_R_MODIFY_TIME,     SELECT_MAX );
+        addInxIval( &genQueryInp.selectInp, COL_R_FREE_SPACE_TIME, SELECT_MAX );
+
+        genQueryInp.maxRows = 1;
+
+        const int status = rsGenQuery( _comm, &genQueryInp, &genQueryOut );
+        if ( status < 0 ) {
+            return ERROR( status, "genQuery for resource version failed." );
+        }
+
+        if ( !genQueryOut || genQueryOut->rowCnt < 1 || genQueryOut->attriCnt < 3 ) {
+            return ERROR( CAT_NO_ROWS_FOUND, "genQuery for resource version returned no rows." );
+        }
+
+        const char* count       = genQueryOut->sqlResult[ 0 ].value;
+        const char* modify_time = genQueryOut->sqlResult[ 1 ].value;
+        const char* free_time   = genQueryOut->sqlResult[ 2 ].value;
+
+        _version = fmt::format( "{}:{}:{}", count, modify_time, free_time );
+
+        const std::int64_t latest = std::max( std::strtoll( modify_time, nullptr, 10 ),
+                                              std::strtoll( free_time, nullptr, 10 ) );
+        _settled = std::time( nullptr ) - latest >= snapshot_settle_time_in_seconds;
+
+        return SUCCESS();
+
+    } // query_resource_version
+} // anonymous namespace
+
 namespace irods
 {
     const std::string EMPTY_RESC_HOST( "EMPTY_RESC_HOST" );
@@ -232,12 +315,11 @@ namespace irods
     } // validate_vault_path
 
 // =-=-=-=-=-=-=-
-// public - connect to the catalog and query for all the
-//          attached resources and instantiate them
-    error resource_manager::init_from_catalog( rsComm_t* _comm ) {
-        // =-=-=-=-=-=-=-
-        // clear existing resource map and initialize
-        resource_name_map_.clear();
+// private - query the catalog for all of the attached resources
+    error resource_manager::query_resource_rows(
+        rsComm_t*                               _comm,
+        std::vector<std::vector<std::string>>&  _rows ) {
+        _rows.clear();
 
         // =-=-=-=-=-=-=-
         // set up data structures for a gen query
@@ -296,13 +378,13 @@ namespace irods
             } // if
 
             // =-=-=-=-=-=-=-
-            // given a series of rows, each being a resource, create a resource and add it to the table
-            proc_ret = process_init_results( genQueryOut );
+            // given a series of rows, extract the values for each resource
+            proc_ret = process_init_results( genQueryOut, _rows );
 
             // =-=-=-=-=-=-=-
             // if error is not valid, clear query and bail
             if ( !proc_ret.ok() ) {
-                irods::error log_err = PASSMSG( "init_from_catalog - process_init_results failed", proc_ret );
+                irods::error log_err = PASSMSG( "query_resource_rows - process_init_results failed", proc_ret );
                 irods::log( log_err );
                 freeGenQueryOut( &genQueryOut );
                 break;
@@ -329,6 +411,60 @@ namespace irods
             return PASSMSG( "process_init_results failed.", proc_ret );
         }
 
+        return SUCCESS();
+
+    } // query_resource_rows
+
+// =-=-=-=-=-=-=-
+// public - connect to the catalog and query for all the
+//          attached resources and instantiate them
+    error resource_manager::init_from_catalog( rsComm_t* _comm ) {
+        // =-=-=-=-=-=-=-
+        // clear existing resource map and initialize
+        resource_name_map_.clear();
+
+        std::vector<std::vector<std::string>> rows;
+        std::string version;
+        bool settled = false;
+        bool found_in_snapshot = false;
+
+        // =-=-=-=-=-=-=-
+        // the resource rows are shared between agents.  only query for all of
+        // the resources when the catalog has changed since the snapshot was taken
+        if ( rsnp::is_initialized() ) {
+            error ret = query_resource_version( _comm, version, settled );
+            if ( !ret.ok() ) {
+                irods::log( PASSMSG( "init_from_catalog - query_resource_version failed", ret ) );
+                version.clear();
+            }
+            else if ( auto snapshot = rsnp::load( version ); snapshot ) {
+                rows = std::move( *snapshot );
+                found_in_snapshot = true;
+            }
+        }
+
+        if ( !found_in_snapshot ) {
+            error ret = query_resource_rows( _comm, rows );
+            if ( !ret.ok() ) {
+                return PASS( ret );
+            }
+
+            if ( settled && !version.empty() && !rsnp::store( version, rows ) ) {
+                rodsLog( LOG_DEBUG, "init_from_catalog - resource snapshot could not be updated [version=%s].",
+                         version.c_str() );
+            }
+        }
+
+        // =-=-=-=-=-=-=-
+        // given a series of rows, each being a resource, create a resource and add it to the table
+        error proc_ret = process_resource_rows( rows );
+
+        // =-=-=-=-=-=-=-
+        // pass along the error if we are in an error state
+        if ( !proc_ret.ok() ) {
+            return PASSMSG( "process_resource_rows failed.", proc_ret );
+        }
+
         // =-=-=-=-=-=-=-
         // Update child resource maps
         proc_ret = init_child_map();
@@ -589,8 +725,10 @@ namespace irods
     }
 
 // =-=-=-=-=-=-=-
-// public - take results from genQuery, extract values and create resources
-    error resource_manager::process_init_results( genQueryOut_t* _result ) {
+// private - take results from genQuery and extract the values for each resource
+    error resource_manager::process_init_results(
+        genQueryOut_t*                          _result,
+        std::vector<std::vector<std::string>>&  _rows ) {
         // =-=-=-=-=-=-=-
         // extract results from query
         if ( !_result ) {
@@ -675,27 +813,63 @@ namespace irods
         }
 
         // =-=-=-=-=-=-=-
-        // iterate through the rows, initialize a resource for each entry
+        // iterate through the rows, extracting the values in column order
         for ( int i = 0; i < _result->rowCnt; ++i ) {
+            _rows.push_back( {
+                &rescId->value[ rescId->len * i ],
+                &rescName->value[ rescName->len * i ],
+                &zoneName->value[ zoneName->len * i ],
+                &rescType->value[ rescType->len * i ],
+                &rescClass->value[ rescClass->len * i ],
+                &rescLoc->value[ rescLoc->len * i ],
+                &rescVaultPath->value[ rescVaultPath->len * i ],
+                &freeSpace->value[ freeSpace->len * i ],
+                &rescInfo->value[ rescInfo->len * i ],
+                &rescComments->value[ rescComments->len * i ],
+                &rescCreate->value[ rescCreate->len * i ],
+                &rescModify->value[ rescModify->len * i ],
+                &rescStatus->value[ rescStatus->len * i ],
+                &rescChildren->value[ rescChildren->len * i ],
+                &rescContext->value[ rescContext->len * i ],
+                &rescParent->value[ rescParent->len * i ],
+                &rescParentContext->value[ rescParentContext->len * i ]
+            } );
+
+        } // for i
+
+        return SUCCESS();
+
+    } // process_init_results
+
+// =-=-=-=-=-=-=-
+// private - given a series of resource rows, create the resources
+    error resource_manager::process_resource_rows( const std::vector<std::vector<std::string>>& _rows ) {
+        // =-=-=-=-=-=-=-
+        // iterate through the rows, initialize a resource for each entry
+        for ( const auto& row : _rows ) {
+            if ( row.size() != column::count ) {
+                return ERROR( SYS_INVALID_INPUT_PARAM, "resource row has an unexpected number of columns" );
+            }
+
             // =-=-=-=-=-=-=-
             // extract row values
-            std::string tmpRescId        = &rescId->value[ rescId->len * i ];
-            std::string tmpRescLoc       = &rescLoc->value[ rescLoc->len * i ];
-            std::string tmpRescName      = &rescName->value[ rescName->len * i ];
-            std::string tmpZoneName      = &zoneName->value[ zoneName->len * i ];
-            std::string tmpRescType      = &rescType->value[ rescType->len * i ];
-            std::string tmpRescInfo      = &rescInfo->value[ rescInfo->len * i ];
-            std::string tmpFreeSpace     = &freeSpace->value[ freeSpace->len * i ];
-            std::string tmpRescClass     = &rescClass->value[ rescClass->len * i ];
-            std::string tmpRescCreate    = &rescCreate->value[ rescCreate->len * i ];
-            std::string tmpRescModify    = &rescModify->value[ rescModify->len * i ];
-            std::string tmpRescStatus    = &rescStatus->value[ rescStatus->len * i ];
-            std::string tmpRescComments  = &rescComments->value[ rescComments->len * i ];
-            std::string tmpRescVaultPath = &rescVaultPath->value[ rescVaultPath->len * i ];
-            std::string tmpRescChildren  = &rescChildren->value[ rescChildren->len * i ];
-            std::string tmpRescContext   = &rescContext->value[ rescContext->len * i ];
-            std::string tmpRescParent    = &rescParent->value[ rescParent->len * i ];
-            std::string tmpRescParentCtx = &rescParentContext->value[ rescParent->len * i ];
+            const std::string& tmpRescId        = row[ column::id ];
+            const std::string& tmpRescLoc       = row[ column::location ];
+            const std::string& tmpRescName      = row[ column::name ];
+            const std::string& tmpZoneName      = row[ column::zone ];
+            const std::string& tmpRescType      = row[ column::type ];
+            const std::string& tmpRescInfo      = row[ column::info ];
+            const std::string& tmpFreeSpace     = row[ column::free_space ];
+            const std::string& tmpRescClass     = row[ column::klass ];
+            const std::string& tmpRescCreate    = row[ column::create_time ];
+            const std::string& tmpRescModify    = row[ column::modify_time ];
+            const std::string& tmpRescStatus    = row[ column::status ];
+            const std::string& tmpRescComments  = row[ column::comment ];
+            const std::string& tmpRescVaultPath = row[ column::vault_path ];
+            const std::string& tmpRescChildren  = row[ column::children ];
+            const std::string& tmpRescContext   = row[ column::context ];
+            const std::string& tmpRescParent    = row[ column::parent ];
+            const std::string& tmpRescParentCtx = row[ column::parent_context ];
 
             // =-=-=-=-=-=-=-
             // create the resource and add properties for column values
@@ -758,11 +932,11 @@ namespace irods
             resource_name_map_[ tmpRescName ] = resc;
             resource_id_map_[ resource_id ] = resc;
 
-        } // for i
+        } // for row
 
         return SUCCESS();
 
-    } // process_init_results
+    } // process_resource_rows
 
 // =-=-=-=-=-=-=-
 // public - given a type, load up a resource plugin
@@ -3,6 +3,7 @@
 #include "dataObjOpr.hpp"
 #include "miscUtil.h"
 #include "openCollection.h"
+#include "descriptor_table.hpp"
 
 // =-=-=-=-=-=-=-
 #include "irods_resource_manager.hpp"
@@ -25,10 +26,12 @@ int RescGrpInit = 0;    /* whether initRescGrp has been called */
 
 /* global fileDesc */
 
-fileDesc_t FileDesc[NUM_FILE_DESC];
-l1desc_t L1desc[NUM_L1_DESC];
-specCollDesc_t SpecCollDesc[NUM_SPEC_COLL_DESC];
-std::vector<collHandle_t> CollHandle;
+// Indices 0 through 2 of the L1 and L3 tables are reserved, like stdin, stdout and stderr.
+// Index 0 of the special collection table is reserved.
+irods::experimental::descriptor_table<fileDesc_t> FileDesc{3};
+irods::experimental::descriptor_table<l1desc_t> L1desc{3};
+irods::experimental::descriptor_table<specCollDesc_t> SpecCollDesc{1};
+irods::experimental::descriptor_table<collHandle_t> CollHandle{0};
 
 /* global Rule Engine File Initialization String */
 
@@ -20,11 +20,9 @@ namespace
         {ill::lock_type::write, WRITE_LOCKED}
     };
 
-    auto get_original_replica_status_impl(const json& _json_replica) -> int
+    auto get_original_replica_status_impl(const std::string& _data_status) -> int
     {
-        const auto data_status_str = _json_replica.at("after").at("data_status").get<std::string>();
-
-        if (data_status_str.empty()) {
+        if (_data_status.empty()) {
             irods::log(LOG_DEBUG, fmt::format(
                 "[{}:{}] - data_status empty",
                 __FUNCTION__, __LINE__));
@@ -34,10 +32,10 @@ namespace
 
         irods::log(LOG_DEBUG, fmt::format(
             "[{}:{}] - data_status:[{}]",
-            __FUNCTION__, __LINE__, data_status_str));
+            __FUNCTION__, __LINE__, _data_status));
 
         try {
-            const auto data_status_json = json::parse(data_status_str);
+            const auto data_status_json = json::parse(_data_status);
 
             if (!data_status_json.empty() && data_status_json.contains("original_status")) {
                 return std::stoi(data_status_json.at("original_status").get<std::string>());
@@ -48,7 +46,7 @@ namespace
         catch (const json::exception& e) {
             irods::log(LOG_WARNING, fmt::format(
                 "[{}:{}] - failed to parse data_status value [{}]",
-                __FUNCTION__, __LINE__, data_status_str));
+                __FUNCTION__, __LINE__, _data_status));
 
             throw;
         }
@@ -56,18 +54,14 @@ namespace
 
     auto insert_data_status(const std::uint64_t _data_id) -> void
     {
-        auto entry = rst::at(_data_id);
-
-        const auto logical_path = rst::get_logical_path(_data_id);
-
-        for (auto& json_replica : entry) {
-            const auto replica_number = std::stoi(json_replica.at("before").at("data_repl_num").get<std::string>());
+        for (const auto replica_number : rst::get_replica_numbers(_data_id)) {
+            const auto data_status = rst::get_property(_data_id, replica_number, "data_status", rst::state_type::after);
 
             irods::log(LOG_DEBUG, fmt::format(
-                "[{}:{}] - replica:[{}]",
-                __FUNCTION__, __LINE__, json_replica.dump()));
+                "[{}:{}] - data_id:[{}], repl_num:[{}], data_status:[{}]",
+                __FUNCTION__, __LINE__, _data_id, replica_number, data_status));
 
-            if (const auto original_status = get_original_replica_status_impl(json_replica); -1 != original_status) {
+            if (const auto original_status = get_original_replica_status_impl(data_status); -1 != original_status) {
                 irods::log(LOG_DEBUG, fmt::format(
                     "[{}:{}] - existing data_status entry; "
                     "[data_id:[{}], repl_num:[{}], status:[{}]]",
@@ -91,8 +85,7 @@ namespace
 
     auto remove_data_status(const std::uint64_t _data_id) -> void
     {
-        for (const auto& json_replica : rst::at(_data_id)) {
-            const auto replica_number = std::stoi(json_replica.at("before").at("data_repl_num").get<std::string>());
+        for (const auto replica_number : rst::get_replica_numbers(_data_id)) {
             rst::update(_data_id, replica_number, json{{"data_status", ""}});
         }
     } // remove_data_status
@@ -101,18 +94,13 @@ namespace
         const std::uint64_t _data_id,
         const int           _replica_number) -> void
     {
-        auto entry = rst::at(_data_id);
-
-        const auto logical_path = rst::get_logical_path(_data_id);
-
-        for (auto& json_replica : entry) {
-            const auto replica_number = std::stoi(json_replica.at("before").at("data_repl_num").get<std::string>());
-
+        for (const auto replica_number : rst::get_replica_numbers(_data_id)) {
             if (_replica_number == replica_number) {
                 continue;
             }
 
-            const auto original_status = get_original_replica_status_impl(json_replica);
+            const auto original_status = get_original_replica_status_impl(
+                rst::get_property(_data_id, replica_number, "data_status", rst::state_type::after));
 
             if (-1 == original_status) {
                 irods::log(LOG_ERROR, fmt::format(
@@ -124,7 +112,7 @@ namespace
                 continue;
             }
 
-            rst::update(_data_id, replica_number, json{{"data_is_dirty", std::to_string(original_status)}});
+            rst::update_replica_status(_data_id, replica_number, original_status);
         }
     } // restore_replica_statuses
 
@@ -133,11 +121,7 @@ namespace
         const int           _replica_number,
         const repl_status_t _replica_status) -> void
     {
-        auto entry = rst::at(_data_id);
-
-        for (auto& json_replica : entry) {
-            const auto replica_number = std::stoi(json_replica.at("before").at("data_repl_num").get<std::string>());
-
+        for (const auto replica_number : rst::get_replica_numbers(_data_id)) {
             irods::log(LOG_DEBUG, fmt::format(
                 "[{}:{}] - data_id:[{}], repl_num:[{}], status:[{}], target repl_num:[{}]",
                 __FUNCTION__, __LINE__,
@@ -146,8 +130,7 @@ namespace
                 _replica_number));
 
             if (_replica_number != replica_number) {
-                rst::update(_data_id, replica_number,
-                    json{{"data_is_dirty", std::to_string(_replica_status)}});
+                rst::update_replica_status(_data_id, replica_number, _replica_status);
             }
         }
     } // set_replica_statuses
@@ -166,13 +149,11 @@ namespace
             if (rst::unknown_replica_id != _replica_number) {
                 if (ill::lock_type::write == _lock_type) {
                     // A replica opened for write should be set to intermediate
-                    rst::update(_data_id, _replica_number,
-                        json{{"data_is_dirty", std::to_string(INTERMEDIATE_REPLICA)}});
+                    rst::update_replica_status(_data_id, _replica_number, INTERMEDIATE_REPLICA);
                 }
                 else {
                     // Even the target replica enters read lock state, so set that here
-                    rst::update(_data_id, _replica_number,
-                        json{{"data_is_dirty", std::to_string(lock_status)}});
+                    rst::update_replica_status(_data_id, _replica_number, lock_status);
                 }
             }
 
@@ -220,8 +201,7 @@ namespace
                     }
                 }
 
-                rst::update(_data_id, _replica_number,
-                    json{{"data_is_dirty", std::to_string(replica_status)}});
+                rst::update_replica_status(_data_id, _replica_number, replica_status);
             }
 
             if (ill::restore_status == _other_replica_statuses) {
@@ -320,7 +300,8 @@ namespace irods::logical_locking
         const std::uint64_t _data_id,
         const int           _replica_number) -> int
     {
-        return get_original_replica_status_impl(rst::at(_data_id, _replica_number));
+        return get_original_replica_status_impl(
+            rst::get_property(_data_id, _replica_number, "data_status", rst::state_type::after));
     } // get_original_replica_status
 
     auto lock(
@@ -34,8 +34,14 @@
 #include "rsModAVUMetadata.hpp"
 #include "rsModAccessControl.hpp"
 #include "rsFileClose.hpp"
+#include "rsFileChksum.hpp"
+#include "inline_checksum.hpp"
+#include "buffer_ring.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/scoped_thread.hpp>
@@ -64,6 +70,7 @@ char *__loc1;
 #include "sockCommNetworkInterface.hpp"
 #include "irods_random.hpp"
 #include "irods_resource_manager.hpp"
+#include "irods_resource_backport.hpp"
 #include "irods_default_paths.hpp"
 using leaf_bundle_t = irods::resource_manager::leaf_bundle_t;
 
@@ -91,6 +98,71 @@ int _l3Close( rsComm_t *rsComm, int l3descInx ) {
     return rsFileClose( rsComm, &fileCloseInp );
 } // _l3Close
 
+namespace ix = irods::experimental;
+
+// Starts an inline checksum for the replica written through the L3 descriptor if the
+// replica will be checksummed when it is finalized. Returns null otherwise.
+auto start_inline_checksum(int _l3descInx, int _numThreads) -> std::shared_ptr<ix::inline_checksum>
+{
+    const l1desc_t* l1desc = nullptr;
+    for (int i = 3; i < static_cast<int>(L1desc.size()); ++i) {
+        if (FD_INUSE == L1desc[i].inuseFlag && _l3descInx == L1desc[i].l3descInx) {
+            l1desc = &L1desc[i];
+            break;
+        }
+    }
+
+    if (!l1desc || !l1desc->dataObjInfo) {
+        return {};
+    }
+
+    // The checksum is calculated by the server hosting the replica.
+    int remote_flag = 0;
+    rodsServerHost_t* host = nullptr;
+    if (const auto err = irods::get_host_for_hier_string(l1desc->dataObjInfo->rescHier, remote_flag, host);
+        !err.ok() || LOCAL_HOST != remote_flag) {
+        return {};
+    }
+
+    // The checksum the replica will be verified against determines the hash scheme.
+    const char* original_checksum = nullptr;
+    if (l1desc->chksum[0] != '\0') {
+        original_checksum = l1desc->chksum;
+    }
+    else if (const int src = l1desc->srcL1descInx;
+             src >= 3 && L1desc[src].dataObjInfo && L1desc[src].dataObjInfo->chksum[0] != '\0') {
+        original_checksum = L1desc[src].dataObjInfo->chksum;
+    }
+    else if (l1desc->dataObjInfo->chksum[0] != '\0') {
+        original_checksum = l1desc->dataObjInfo->chksum;
+    }
+    else if (0 == l1desc->chksumFlag) {
+        return {};
+    }
+
+    std::string scheme;
+    if (get_checksum_scheme(original_checksum, scheme) < 0 || !ix::inline_checksum::is_supported(scheme, _numThreads)) {
+        return {};
+    }
+
+    try {
+        auto checksum = std::make_shared<ix::inline_checksum>(scheme, _numThreads);
+        ix::inline_checksum_table::insert(l1desc->dataObjInfo->rescHier, l1desc->dataObjInfo->filePath, checksum);
+        return checksum;
+    }
+    catch (const irods::exception& e) {
+        irods::log(e);
+    }
+
+    return {};
+} // start_inline_checksum
+
+// Discards the inline checksum of the replica written through the L3 descriptor.
+void discard_inline_checksum(int _l3descInx)
+{
+    ix::inline_checksum_table::erase(FileDesc[_l3descInx].rescHier, FileDesc[_l3descInx].fileName);
+} // discard_inline_checksum
+
 }
 
 int
@@ -459,6 +531,16 @@ svrPortalPutGet( rsComm_t *rsComm ) {
 
     memset( myInput, 0, sizeof( myInput ) );
 
+    // Hash the bytes as they are written so that the replica does not need to be
+    // read again when it is checksummed.
+    std::shared_ptr<ix::inline_checksum> checksum;
+    if ( oprType == PUT_OPR ) {
+        checksum = start_inline_checksum( dataOprInp->destL3descInx, numThreads );
+        for ( i = 0; i < numThreads; i++ ) {
+            myInput[i].checksum = checksum.get();
+        }
+    }
+
     size0 = dataOprInp->dataSize / numThreads;
 
     size1 = dataOprInp->dataSize - size0 * ( numThreads - 1 );
@@ -500,6 +582,10 @@ svrPortalPutGet( rsComm_t *rsComm ) {
 
         CLOSE_SOCK( lsock );
 
+        if ( checksum && myInput[0].status < 0 ) {
+            discard_inline_checksum( dataOprInp->destL3descInx );
+        }
+
         return myInput[0].status;
     }
     else {
@@ -568,6 +654,11 @@ svrPortalPutGet( rsComm_t *rsComm ) {
             }
         } // for i
         CLOSE_SOCK( lsock );
+
+        if ( checksum && retVal < 0 ) {
+            discard_inline_checksum( dataOprInp->destL3descInx );
+        }
+
         return retVal;
 
     } // else
@@ -619,6 +710,406 @@ int fillPortalTransferInp(
 }
 
 
+namespace {
+
+// Returns the number of buffers each portal thread cycles through. With more than one
+// buffer, network and resource I/O run in separate threads.
+int get_transfer_buffer_count() noexcept
+{
+    constexpr int default_count = 2;
+
+    try {
+        const int count = irods::get_advanced_setting<const int>(irods::CFG_NUMBER_OF_TRANSFER_BUFFERS_FOR_PARA_TRANS_KW);
+        if (count > 0) {
+            return count;
+        }
+        rodsLog(LOG_ERROR, "Invalid number of transfer buffers [count=%d].", count);
+    }
+    catch (...) {
+        rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_NUMBER_OF_TRANSFER_BUFFERS_FOR_PARA_TRANS_KW.data());
+    }
+
+    return default_count;
+} // get_transfer_buffer_count
+
+// Returns the number of bytes announced by the next transfer header.
+rodsLong_t next_chunk_size(const portalTransferInp_t& _input, rodsLong_t _bytes_left, int _chunk_size)
+{
+    if (_input.flags & STREAMING_FLAG) {
+        return _bytes_left;
+    }
+
+    return std::min<rodsLong_t>(_bytes_left, _chunk_size);
+} // next_chunk_size
+
+// The pipelined form of partialDataPut. A network thread receives and decrypts buffers
+// while the calling thread writes them to the resource.
+void pipelined_data_put(portalTransferInp_t* myInput,
+                        irods::buffer_crypt& crypt,
+                        const irods::buffer_crypt::array_t& shared_secret,
+                        rodsLong_t myOffset,
+                        int chunk_size,
+                        int trans_buff_size,
+                        int buffer_count)
+{
+    const int destL3descInx = myInput->destFd;
+    const int srcFd = myInput->srcFd;
+    const bool use_encryption_flg = ( myInput->rsComm->negotiation_results == irods::CS_NEG_USE_SSL );
+    const int iv_size = use_encryption_flg ? crypt.key_size() : 0;
+
+    // The size of an encrypted buffer is chosen by the client, so leave the same room
+    // the synchronous path does.
+    const std::size_t buffer_size = use_encryption_flg ? 2 * trans_buff_size + EVP_MAX_BLOCK_LENGTH : trans_buff_size;
+
+    std::unique_ptr<ix::buffer_ring> ring;
+    try {
+        ring = std::make_unique<ix::buffer_ring>(buffer_count, buffer_size);
+    }
+    catch (const std::bad_alloc&) {
+        rodsLog( LOG_ERROR, "pipelined_data_put: could not allocate %d transfer buffers", buffer_count );
+        myInput->status = SYS_MALLOC_ERR;
+    }
+
+    int read_status = 0;
+    bool header_failed = false;
+
+    const auto receive = [&] {
+        irods::buffer_crypt::array_t this_iv;
+        irods::buffer_crypt::array_t cipher;
+        rodsLong_t offset = myOffset;
+        rodsLong_t bytesToGet = myInput->size;
+
+        while ( bytesToGet > 0 ) {
+            rodsLong_t toread0 = next_chunk_size( *myInput, bytesToGet, chunk_size );
+
+            if ( const int status = sendTranHeader( srcFd, PUT_OPR, myInput->flags, offset, toread0 ); status < 0 ) {
+                rodsLog( LOG_NOTICE, "partialDataPut: sendTranHeader error. status = %d", status );
+                read_status = status;
+                header_failed = true;
+                return;
+            }
+
+            while ( toread0 > 0 ) {
+                // =-=-=-=-=-=-=-
+                // read the incoming size as it might differ due to encryption
+                int new_size = std::min<rodsLong_t>( toread0, trans_buff_size );
+                if ( use_encryption_flg ) {
+                    if ( myRead( srcFd, &new_size, sizeof( int ), NULL, NULL ) != sizeof( int ) ) {
+                        rodsLog( LOG_ERROR, "_partialDataPut:Bytes Read != %d", sizeof( int ) );
+                        read_status = SYS_COPY_LEN_ERR;
+                        return;
+                    }
+
+                    if ( new_size <= iv_size || static_cast<std::size_t>( new_size - iv_size ) > buffer_size - EVP_MAX_BLOCK_LENGTH ) {
+                        rodsLog( LOG_ERROR, "_partialDataPut: invalid encrypted buffer size %d", new_size );
+                        read_status = SYS_COPY_LEN_ERR;
+                        return;
+                    }
+                }
+
+                auto* buffer = ring->acquire_empty();
+                if ( !buffer ) {
+                    return;
+                }
+
+                // =-=-=-=-=-=-=-
+                // unencrypted data is received directly into the buffer which is written
+                // to the resource. encrypted data is decrypted into it.
+                auto* dest = buffer->data;
+                if ( use_encryption_flg ) {
+                    cipher.resize( new_size );
+                    dest = cipher.data();
+                }
+
+                const int bytesRead = myRead( srcFd, dest, new_size, NULL, NULL );
+
+                if ( bytesRead != new_size ) {
+                    if ( bytesRead < 0 ) {
+                        read_status = bytesRead;
+                    }
+                    else {
+                        rodsLog( LOG_NOTICE,
+                                 "_partialDataPut: toread %d bytes, %d bytes read, errno = %d",
+                                 new_size, bytesRead, errno );
+                        read_status = SYS_COPY_LEN_ERR;
+                    }
+                    return;
+                }
+
+                int plain_size = bytesRead;
+                if ( use_encryption_flg ) {
+                    this_iv.assign( &cipher[0], &cipher[iv_size] );
+                    irods::error ret = crypt.decrypt( shared_secret,
+                                                      this_iv,
+                                                      &cipher[iv_size],
+                                                      new_size - iv_size,
+                                                      buffer->data,
+                                                      plain_size );
+                    if ( !ret.ok() ) {
+                        irods::log( PASS( ret ) );
+                        read_status = SYS_COPY_LEN_ERR;
+                        return;
+                    }
+                }
+
+                buffer->size = plain_size;
+                buffer->offset = offset;
+                ring->submit( buffer );
+
+                bytesToGet -= plain_size;
+                toread0    -= plain_size;
+                offset     += plain_size;
+            }
+        }
+    };
+
+    int write_status = 0;
+    rodsLong_t bytes_written = 0;
+
+    if ( ring ) {
+        std::thread network_thread{[&] {
+            try {
+                receive();
+            }
+            catch (const std::bad_alloc&) {
+                read_status = SYS_MALLOC_ERR;
+            }
+
+            // The buffers received before a failure are still written.
+            ring->finish();
+        }};
+
+        while ( auto* buffer = ring->acquire_filled() ) {
+            const int bytesWritten = _l3Write( myInput->rsComm, destL3descInx, buffer->data, buffer->size );
+
+            if ( bytesWritten != static_cast<int>( buffer->size ) ) {
+                rodsLog( LOG_NOTICE,
+                         "_partialDataPut:Bytes written %d don't match read %d",
+                         bytesWritten, static_cast<int>( buffer->size ) );
+                write_status = bytesWritten < 0 ? bytesWritten : SYS_COPY_LEN_ERR;
+                ring->cancel();
+                break;
+            }
+
+            if ( myInput->checksum ) {
+                myInput->checksum->update( myInput->threadNum, buffer->offset, buffer->data, bytesWritten );
+            }
+
+            bytes_written += bytesWritten;
+            ring->release( buffer );
+        }
+
+        network_thread.join();
+
+        myInput->status = read_status < 0 ? read_status : write_status;
+    }
+
+    if ( header_failed ) {
+        if ( myInput->threadNum > 0 ) {
+            _l3Close( myInput->rsComm, destL3descInx );
+        }
+        CLOSE_SOCK( srcFd );
+        return;
+    }
+
+    applyRuleForSvrPortal( srcFd, PUT_OPR, 1, bytes_written, myInput->rsComm );
+
+    sendTranHeader( srcFd, DONE_OPR, 0, 0, 0 );
+    if ( myInput->threadNum > 0 ) {
+        _l3Close( myInput->rsComm, destL3descInx );
+    }
+    mySockClose( srcFd );
+} // pipelined_data_put
+
+// The pipelined form of partialDataGet. The calling thread reads buffers from the resource
+// while a network thread encrypts and sends them.
+void pipelined_data_get(portalTransferInp_t* myInput,
+                        irods::buffer_crypt& crypt,
+                        const irods::buffer_crypt::array_t& shared_secret,
+                        rodsLong_t myOffset,
+                        int chunk_size,
+                        int trans_buff_size,
+                        int buffer_count)
+{
+    const int srcL3descInx = myInput->srcFd;
+    const int destFd = myInput->destFd;
+    const bool use_encryption_flg = ( myInput->rsComm->negotiation_results == irods::CS_NEG_USE_SSL );
+    const int iv_size = use_encryption_flg ? crypt.key_size() : 0;
+
+    std::unique_ptr<ix::buffer_ring> ring;
+    try {
+        ring = std::make_unique<ix::buffer_ring>(buffer_count, trans_buff_size);
+    }
+    catch (const std::bad_alloc&) {
+        rodsLog( LOG_ERROR, "pipelined_data_get: could not allocate %d transfer buffers", buffer_count );
+        myInput->status = SYS_MALLOC_ERR;
+    }
+
+    int send_status = 0;
+    bool header_failed = false;
+    rodsLong_t bytes_sent = 0;
+
+    const auto send = [&] {
+        irods::buffer_crypt::array_t iv;
+        irods::buffer_crypt::array_t cipher;
+        rodsLong_t bytes_left = myInput->size;
+        rodsLong_t chunk_left = 0;
+
+        if ( use_encryption_flg ) {
+            cipher.resize( iv_size + trans_buff_size + EVP_MAX_BLOCK_LENGTH );
+        }
+
+        while ( auto* buffer = ring->acquire_filled() ) {
+            // The buffers never span chunks, so a header is due whenever the previous
+            // chunk has been sent completely.
+            if ( 0 == chunk_left ) {
+                chunk_left = next_chunk_size( *myInput, bytes_left, chunk_size );
+
+                if ( const int status = sendTranHeader( destFd, GET_OPR, myInput->flags, buffer->offset, chunk_left ); status < 0 ) {
+                    rodsLog( LOG_NOTICE, "partialDataGet: sendTranHeader error. status = %d", status );
+                    send_status = status;
+                    header_failed = true;
+                    return;
+                }
+            }
+
+            auto* src = buffer->data;
+            int new_size = buffer->size;
+
+            // =-=-=-=-=-=-=-
+            // compute an iv for this particular transmission and use
+            // it to encrypt this buffer. the iv is sent in front of the cipher text.
+            if ( use_encryption_flg ) {
+                irods::error ret = crypt.initialization_vector( iv );
+                if ( !ret.ok() ) {
+                    irods::log( PASS( ret ) );
+                    send_status = SYS_COPY_LEN_ERR;
+                    return;
+                }
+
+                int cipher_size = 0;
+                ret = crypt.encrypt( shared_secret, iv, buffer->data, buffer->size, &cipher[iv_size], cipher_size );
+                if ( !ret.ok() ) {
+                    irods::log( PASS( ret ) );
+                    send_status = SYS_COPY_LEN_ERR;
+                    return;
+                }
+
+                std::copy( iv.begin(), iv.end(), cipher.begin() );
+                src = cipher.data();
+                new_size = iv_size + cipher_size;
+
+                // =-=-=-=-=-=-=-
+                // need to send the incoming size as encryption might change
+                // the size of the data from the written values
+                int bytesWritten = 0;
+                myWrite( destFd, &new_size, sizeof( int ), &bytesWritten );
+            }
+
+            int bytesWritten = 0;
+            bytesWritten = myWrite( destFd, src, new_size, &bytesWritten );
+
+            if ( bytesWritten != new_size ) {
+                rodsLog( LOG_NOTICE,
+                         "_partialDataGet:Bytes written %d don't match read %d",
+                         bytesWritten, static_cast<int>( buffer->size ) );
+                send_status = bytesWritten < 0 ? bytesWritten : SYS_COPY_LEN_ERR;
+                return;
+            }
+
+            bytes_left -= buffer->size;
+            chunk_left -= buffer->size;
+            bytes_sent += buffer->size;
+
+            ring->release( buffer );
+        }
+    };
+
+    int read_status = 0;
+
+    if ( ring ) {
+        std::thread network_thread{[&] {
+            try {
+                send();
+            }
+            catch (const std::bad_alloc&) {
+                send_status = SYS_MALLOC_ERR;
+            }
+
+            if ( send_status < 0 ) {
+                ring->cancel();
+            }
+        }};
+
+        // Reads are split exactly as the network thread splits the chunks.
+        rodsLong_t bytesToGet = myInput->size;
+
+        while ( bytesToGet > 0 && read_status >= 0 ) {
+            rodsLong_t toread0 = next_chunk_size( *myInput, bytesToGet, chunk_size );
+
+            while ( toread0 > 0 ) {
+                auto* buffer = ring->acquire_empty();
+                if ( !buffer ) {
+                    break;
+                }
+
+                const int toread1 = std::min<rodsLong_t>( toread0, trans_buff_size );
+                const int bytesRead = _l3Read( myInput->rsComm, srcL3descInx, buffer->data, toread1 );
+
+                if ( bytesRead != toread1 ) {
+                    if ( bytesRead < 0 ) {
+                        read_status = bytesRead;
+                    }
+                    else {
+                        rodsLog( LOG_NOTICE,
+                                 "_partialDataGet: toread %d bytes, %d bytes read",
+                                 toread1, bytesRead );
+                        read_status = SYS_COPY_LEN_ERR;
+                    }
+                    break;
+                }
+
+                buffer->size = bytesRead;
+                buffer->offset = myOffset;
+                ring->submit( buffer );
+
+                bytesToGet -= bytesRead;
+                toread0    -= bytesRead;
+                myOffset   += bytesRead;
+            }
+
+            if ( ring->cancelled() ) {
+                break;
+            }
+        }
+
+        // The buffers read before a failure are still sent.
+        ring->finish();
+        network_thread.join();
+
+        myInput->status = read_status < 0 ? read_status : send_status;
+    }
+
+    if ( header_failed ) {
+        if ( myInput->threadNum > 0 ) {
+            _l3Close( myInput->rsComm, srcL3descInx );
+        }
+        CLOSE_SOCK( destFd );
+        return;
+    }
+
+    applyRuleForSvrPortal( destFd, GET_OPR, 1, bytes_sent, myInput->rsComm );
+
+    sendTranHeader( destFd, DONE_OPR, 0, 0, 0 );
+    if ( myInput->threadNum > 0 ) {
+        _l3Close( myInput->rsComm, srcL3descInx );
+    }
+    CLOSE_SOCK( destFd );
+} // pipelined_data_get
+
+} // anonymous namespace
+
 void
 partialDataPut( portalTransferInp_t *myInput ) {
     int destL3descInx = 0, srcFd = 0;
@@ -700,6 +1191,11 @@ partialDataPut( portalTransferInp_t *myInput ) {
         return;
     }
 
+    if ( const int buffer_count = get_transfer_buffer_count(); buffer_count > 1 ) {
+        pipelined_data_put( myInput, crypt, shared_secret, myOffset, chunk_size, trans_buff_size, buffer_count );
+        return;
+    }
+
     buf = ( unsigned char* )malloc( ( 2 * trans_buff_size ) + sizeof( unsigned char ) );
 
     while ( bytesToGet > 0 ) {
@@ -812,6 +1308,11 @@ partialDataPut( portalTransferInp_t *myInput ) {
                     }
                     break;
                 }
+
+                if ( myInput->checksum ) {
+                    myInput->checksum->update( myInput->threadNum, myOffset, buf, bytesWritten );
+                }
+
                 bytesToGet -= bytesWritten;
                 toread0    -= bytesWritten;
                 myOffset   += bytesWritten;
@@ -918,11 +1419,6 @@ void partialDataGet(
         return;
     }
 
-    size_t buf_size = ( 2 * trans_buff_size ) * sizeof( unsigned char ) ;
-    unsigned char * buf = ( unsigned char* )malloc( buf_size );
-
-    bytesToGet = myInput->size;
-
     int chunk_size;
     try {
         chunk_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_CHUNK_SIZE_PARA_TRANS) * 1024 * 1024;
@@ -931,6 +1427,16 @@ void partialDataGet(
         return;
     }
 
+    if ( const int buffer_count = get_transfer_buffer_count(); buffer_count > 1 ) {
+        pipelined_data_get( myInput, crypt, shared_secret, myOffset, chunk_size, trans_buff_size, buffer_count );
+        return;
+    }
+
+    size_t buf_size = ( 2 * trans_buff_size ) * sizeof( unsigned char ) ;
+    unsigned char * buf = ( unsigned char* )malloc( buf_size );
+
+    bytesToGet = myInput->size;
+
     while ( bytesToGet > 0 ) {
         int toread0;
         int bytesRead;
@@ -1263,6 +1769,10 @@ remToLocPartialCopy( portalTransferInp_t *myInput ) {
                 break;
             }
 
+            if ( myInput->checksum ) {
+                myInput->checksum->update( myInput->threadNum, curOffset + ( myHeader.length - toGet ), buf, bytesWritten );
+            }
+
             toGet -= bytesWritten;
         }
         curOffset += myHeader.length;
@@ -1374,6 +1884,16 @@ int remLocCopy(rsComm_t *rsComm, dataCopyInp_t *dataCopyInp)
 
     portalTransferInp_t myInput[MAX_NUM_CONFIG_TRAN_THR]{};
 
+    // Hash the bytes as they are written so that the replica does not need to be
+    // read again when it is checksummed.
+    std::shared_ptr<ix::inline_checksum> checksum;
+    if (COPY_TO_LOCAL_OPR == oprType) {
+        checksum = start_inline_checksum(dataOprInp->destL3descInx, numThreads);
+        for (int i = 0; i < numThreads; i++) {
+            myInput[i].checksum = checksum.get();
+        }
+    }
+
     int sock = connectToRhostPortal( myPortList->hostAddr,
                                  myPortList->portNum, myPortList->cookie, rsComm->windowSize );
     if ( sock < 0 ) {
@@ -1404,6 +1924,9 @@ int remLocCopy(rsComm_t *rsComm, dataCopyInp_t *dataCopyInp)
         }
 
         if (myInput[0].status < 0) {
+            if (checksum) {
+                discard_inline_checksum(dataOprInp->destL3descInx);
+            }
             return myInput[0].status;
         }
 
@@ -1484,6 +2007,9 @@ int remLocCopy(rsComm_t *rsComm, dataCopyInp_t *dataCopyInp)
     }
 
     if (retVal < 0) {
+        if (checksum) {
+            discard_inline_checksum(dataOprInp->destL3descInx);
+        }
         return retVal;
     }
 
@@ -1531,6 +2057,13 @@ sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
 
     memset( myInput, 0, sizeof( myInput ) );
 
+    // Hash the bytes as they are written so that the replica does not need to be
+    // read again when it is checksummed.
+    std::shared_ptr<ix::inline_checksum> checksum = start_inline_checksum( dataOprInp->destL3descInx, numThreads );
+    for ( i = 0; i < numThreads; i++ ) {
+        myInput[i].checksum = checksum.get();
+    }
+
     size0 = dataOprInp->dataSize / numThreads;
     size1 = dataOprInp->dataSize - size0 * ( numThreads - 1 );
     offset0 = dataOprInp->offset;
@@ -1550,6 +2083,9 @@ sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
             myInput[0].flags = NO_CHK_COPY_LEN_FLAG;
         }
         sameHostPartialCopy( &myInput[0] );
+        if ( checksum && myInput[0].status < 0 ) {
+            discard_inline_checksum( dataOprInp->destL3descInx );
+        }
         return myInput[0].status;
     }
     else {
@@ -1611,6 +2147,9 @@ sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
             }
         }
         if ( retVal < 0 ) {
+            if ( checksum ) {
+                discard_inline_checksum( dataOprInp->destL3descInx );
+            }
             return retVal;
         }
         else {
@@ -1731,6 +2270,10 @@ sameHostPartialCopy( portalTransferInp_t *myInput ) {
             break;
         }
 
+        if ( myInput->checksum ) {
+            myInput->checksum->update( myInput->threadNum, myInput->offset + myInput->bytesWritten, buf, bytesWritten );
+        }
+
         toCopy -= bytesWritten;
         myInput->bytesWritten += bytesWritten;
     }
@@ -28,37 +28,45 @@
 #include "irods_stacktrace.hpp"
 #include "irods_re_structs.hpp"
 #include "get_hier_from_leaf_id.h"
+#include "inline_checksum.hpp"
 #include "key_value_proxy.hpp"
 #include "replica_proxy.hpp"
 
+#include <new>
+#include <unordered_map>
+
+namespace
+{
+    // Maps the dataObjInfo of each open L1 descriptor to the index of the descriptor.
+    std::unordered_map<const dataObjInfo_t*, int> l1desc_index_by_data_obj_info;
+} // anonymous namespace
+
 int
 initL1desc() {
-    memset( L1desc, 0, sizeof( L1desc ) );
+    // The table starts out empty and grows as descriptors are allocated.
+    L1desc.clear();
+    l1desc_index_by_data_obj_info.clear();
     return 0;
 }
 
 int
 allocL1desc() {
-    int i;
-
-    for ( i = 3; i < NUM_L1_DESC; i++ ) {
-        if ( L1desc[i].inuseFlag <= FD_FREE ) {
-            L1desc[i].inuseFlag = FD_INUSE;
-            return i;
-        };
+    try {
+        const int i = L1desc.allocate();
+        L1desc[i].inuseFlag = FD_INUSE;
+        return i;
     }
+    catch ( const std::bad_alloc& ) {
+        rodsLog( LOG_NOTICE,
+                 "allocL1desc: out of L1desc" );
 
-    rodsLog( LOG_NOTICE,
-             "allocL1desc: out of L1desc" );
-
-    return SYS_OUT_OF_FILE_DESC;
+        return SYS_OUT_OF_FILE_DESC;
+    }
 }
 
 int
 isL1descInuse() {
-    int i;
-
-    for ( i = 3; i < NUM_L1_DESC; i++ ) {
+    for ( int i = 3; i < static_cast<int>( L1desc.size() ); i++ ) {
         if ( L1desc[i].inuseFlag == FD_INUSE ) {
             return 1;
         };
@@ -68,30 +76,28 @@ isL1descInuse() {
 
 int
 initSpecCollDesc() {
-    memset( SpecCollDesc, 0, sizeof( SpecCollDesc ) );
+    SpecCollDesc.clear();
     return 0;
 }
 
 int
 allocSpecCollDesc() {
-    int i;
-
-    for ( i = 1; i < NUM_SPEC_COLL_DESC; i++ ) {
-        if ( SpecCollDesc[i].inuseFlag <= FD_FREE ) {
-            SpecCollDesc[i].inuseFlag = FD_INUSE;
-            return i;
-        };
+    try {
+        const int i = SpecCollDesc.allocate();
+        SpecCollDesc[i].inuseFlag = FD_INUSE;
+        return i;
     }
+    catch ( const std::bad_alloc& ) {
+        rodsLog( LOG_NOTICE,
+                 "allocSpecCollDesc: out of SpecCollDesc" );
 
-    rodsLog( LOG_NOTICE,
-             "allocSpecCollDesc: out of SpecCollDesc" );
-
-    return SYS_OUT_OF_FILE_DESC;
+        return SYS_OUT_OF_FILE_DESC;
+    }
 }
 
 int
 freeSpecCollDesc( int specCollInx ) {
-    if ( specCollInx < 1 || specCollInx >= NUM_SPEC_COLL_DESC ) {
+    if ( !SpecCollDesc.in_range( specCollInx ) ) {
         rodsLog( LOG_NOTICE,
                  "freeSpecCollDesc: specCollInx %d out of range", specCollInx );
         return SYS_FILE_DESC_OUT_OF_RANGE;
@@ -102,6 +108,7 @@ freeSpecCollDesc( int specCollInx ) {
     }
 
     memset( &SpecCollDesc[specCollInx], 0, sizeof( specCollDesc_t ) );
+    SpecCollDesc.release( specCollInx );
 
     return 0;
 }
@@ -113,7 +120,7 @@ closeAllL1desc( rsComm_t *rsComm ) {
     if ( rsComm == NULL ) {
         return 0;
     }
-    for ( i = 3; i < NUM_L1_DESC; i++ ) {
+    for ( i = 3; i < static_cast<int>( L1desc.size() ); i++ ) {
         if ( L1desc[i].inuseFlag == FD_INUSE &&
                 L1desc[i].l3descInx > 2 ) {
             l3Close( rsComm, i );
@@ -152,12 +159,29 @@ int freeL1desc_struct(l1desc& _l1desc)
 } // freeL1desc
 
 int freeL1desc(const int l1descInx) {
-    if ( l1descInx < 3 || l1descInx >= NUM_L1_DESC ) {
+    if ( !L1desc.in_range( l1descInx ) ) {
         rodsLog( LOG_NOTICE, "freeL1desc: l1descInx %d out of range", l1descInx );
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
 
-    return freeL1desc_struct(L1desc[l1descInx]);
+    if ( const auto* info = L1desc[l1descInx].dataObjInfo; info ) {
+        if ( const auto it = l1desc_index_by_data_obj_info.find( info );
+             it != l1desc_index_by_data_obj_info.end() && it->second == l1descInx ) {
+            l1desc_index_by_data_obj_info.erase( it );
+        }
+
+        // The checksum of a replica written through this descriptor is requested while it
+        // is closed. If it was not, drop the inline checksum so it does not outlive the
+        // descriptor.
+        if ( OPEN_FOR_READ_TYPE != L1desc[l1descInx].openType ) {
+            irods::experimental::inline_checksum_table::erase( info->rescHier, info->filePath );
+        }
+    }
+
+    const int ec = freeL1desc_struct(L1desc[l1descInx]);
+    L1desc.release( l1descInx );
+
+    return ec;
 } // freeL1desc
 
 int
@@ -206,6 +230,7 @@ fillL1desc( int l1descInx, dataObjInp_t *dataObjInp,
     }
 
     L1desc[l1descInx].dataObjInfo = dataObjInfo;
+    l1desc_index_by_data_obj_info[dataObjInfo] = l1descInx;
     if ( dataObjInp != NULL ) {
         L1desc[l1descInx].oprType = dataObjInp->oprType;
     }
@@ -290,9 +315,15 @@ initDataObjInfoWithInp( dataObjInfo_t *dataObjInfo, dataObjInp_t *dataObjInp ) {
 
 int
 getL1descIndexByDataObjInfo( const dataObjInfo_t * dataObjInfo ) {
-    int index;
-    for ( index = 3; index < NUM_L1_DESC; index++ ) {
+    if ( const auto it = l1desc_index_by_data_obj_info.find( dataObjInfo );
+         it != l1desc_index_by_data_obj_info.end() && L1desc[it->second].dataObjInfo == dataObjInfo ) {
+        return it->second;
+    }
+
+    // The dataObjInfo of a descriptor may be replaced without going through fillL1desc.
+    for ( int index = 3; index < static_cast<int>( L1desc.size() ); index++ ) {
         if ( L1desc[index].dataObjInfo == dataObjInfo ) {
+            l1desc_index_by_data_obj_info[dataObjInfo] = index;
             return index;
         }
     }
@@ -586,30 +617,19 @@ convL3descInx( int l3descInx ) {
 }
 
 int allocCollHandle() {
-    // look for a free collHandle_t
-    for (std::vector<collHandle_t>::iterator it = CollHandle.begin(); it != CollHandle.end(); ++it) {
-    	if (it->inuseFlag <= FD_FREE) {
-    		it->inuseFlag = FD_INUSE;
-    		return it - CollHandle.begin();
-    	}
+    try {
+        const int i = CollHandle.allocate();
+        CollHandle[i].inuseFlag = FD_INUSE;
+        return i;
+    }
+    catch ( const std::bad_alloc& ) {
+        rodsLog( LOG_NOTICE, "allocCollHandle: out of CollHandle" );
+        return SYS_OUT_OF_FILE_DESC;
     }
-
-    // if none found make a new one
-    collHandle_t my_coll_handle;
-    memset(&my_coll_handle, 0, sizeof(collHandle_t));
-
-    // mark as in use
-    my_coll_handle.inuseFlag = FD_INUSE;
-
-    // add to vector
-    CollHandle.push_back(my_coll_handle);
-
-    // return index
-    return CollHandle.size() - 1;
 }
 
 int freeCollHandle( int handleInx ) {
-    if ( handleInx < 0 || static_cast<std::size_t>(handleInx) >= CollHandle.size() ) {
+    if ( !CollHandle.in_range( handleInx ) ) {
         rodsLog( LOG_NOTICE,
                  "freeCollHandle: handleInx %d out of range", handleInx );
         return SYS_FILE_DESC_OUT_OF_RANGE;
@@ -618,6 +638,7 @@ int freeCollHandle( int handleInx ) {
     /* don't free specColl. It is in cache */
     clearCollHandle( &CollHandle[handleInx], 1 );
     memset( &CollHandle[handleInx], 0, sizeof( collHandle_t ) );
+    CollHandle.release( handleInx );
 
     return 0;
 }
@@ -658,6 +679,7 @@ allocAndSetL1descForZoneOpr( int remoteL1descInx, dataObjInp_t *dataObjInp,
                       ( dataObjInfo_t* )malloc( sizeof( dataObjInfo_t ) );
     bzero( dataObjInfo, sizeof( dataObjInfo_t ) );
     rstrcpy( dataObjInfo->objPath, dataObjInp->objPath, MAX_NAME_LEN );
+    l1desc_index_by_data_obj_info[dataObjInfo] = l1descInx;
 
     if ( openStat != NULL ) {
         dataObjInfo->dataSize = openStat->dataSize;
@@ -711,6 +733,7 @@ namespace irods
 
         auto [duplicate_replica, duplicate_replica_lm] = ir::duplicate_replica(_info);
         l1desc.dataObjInfo = duplicate_replica_lm.release();
+        l1desc_index_by_data_obj_info[l1desc.dataObjInfo] = l1_index;
 
         l1desc.dataObjInpReplFlag = 1;
         l1desc.oprType = _inp.oprType;
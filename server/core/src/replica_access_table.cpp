@@ -1,14 +1,9 @@
 #include "replica_access_table.hpp"
 
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-#include <boost/interprocess/containers/map.hpp>
-#include <boost/interprocess/containers/vector.hpp>
-#include <boost/interprocess/containers/string.hpp>
-#include <boost/interprocess/sync/named_upgradable_mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/sharable_lock.hpp>
-#include <boost/interprocess/sync/upgradable_lock.hpp>
+#include "shared_hash_table.hpp"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -16,6 +11,8 @@
 
 #include <memory>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <vector>
 
 namespace irods::experimental::replica_access_table
@@ -23,35 +20,65 @@ namespace irods::experimental::replica_access_table
     namespace
     {
         namespace bi = boost::interprocess;
-
-        // clang-format off
-        using segment_manager_type  = bi::managed_shared_memory::segment_manager;
-        using void_allocator_type   = bi::allocator<void, segment_manager_type>;
-        // clang-format on
+        namespace ipc = irods::experimental::interprocess;
 
         // The value type mapped to a specific replica token.
         struct access_entry
         {
-            // clang-format off
-            using value_type     = pid_t;
-            using allocator_type = bi::allocator<value_type, segment_manager_type>;
-            using container_type = bi::vector<value_type, allocator_type>;
-            // clang-format on
+            // The maximum number of agents which can access a replica through the same token.
+            static constexpr std::size_t max_agent_pids = 64;
 
             data_id_type data_id;
             replica_number_type replica_number;
-            container_type agent_pids;
+            std::uint32_t agent_pid_count;
+            pid_t agent_pids[max_agent_pids];
         }; // struct access_entry
 
+        // The value type mapped to a (data id, replica number) tuple. Allows the token of a
+        // replica to be found without visiting every entry.
+        struct replica_entry
+        {
+            replica_entry() = default;
+
+            explicit replica_entry(replica_token_view_type _token)
+                : token{}
+            {
+                std::memcpy(token, _token.data(), std::min(_token.size(), sizeof(token) - 1));
+            }
+
+            char token[40];
+        }; // struct replica_entry
+
         // clang-format off
-        using char_allocator_type  = bi::allocator<char, segment_manager_type>;
-        using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
-        using mapped_type          = access_entry;
-        using value_type           = std::pair<const key_type, mapped_type>;
-        using value_allocator_type = bi::allocator<value_type, segment_manager_type>;
-        using map_type             = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
+        using token_map_type   = ipc::shared_hash_table<access_entry, 40>;
+        using replica_map_type = ipc::shared_hash_table<replica_entry, 32>;
         // clang-format on
 
+        // The key of a (data id, replica number) tuple, e.g. "10101:2".
+        class replica_key
+        {
+        public:
+            replica_key(data_id_type _data_id, replica_number_type _replica_number) noexcept
+                : buffer_{}
+                , size_{}
+            {
+                auto* end = buffer_ + sizeof(buffer_);
+                auto* p = std::to_chars(buffer_, end, _data_id).ptr;
+                *p++ = ':';
+                p = std::to_chars(p, end, _replica_number).ptr;
+                size_ = p - buffer_;
+            }
+
+            operator std::string_view() const noexcept
+            {
+                return {buffer_, size_};
+            }
+
+        private:
+            char buffer_[32];
+            std::size_t size_;
+        }; // class replica_key
+
         //
         // Global Variables
         //
@@ -59,32 +86,86 @@ namespace irods::experimental::replica_access_table
         // The following variables define the names of shared memory objects and other properties.
         std::string g_segment_name;
         std::size_t g_segment_size;
-        std::string g_mutex_name;
 
         // On initialization, holds the PID of the process that initialized the replica access table.
         // This ensures that only the process that initialized the system can deinitialize it.
         pid_t g_owner_pid;
 
-        // The following are pointers to the shared memory objects and allocator.
+        // The following are pointers to the shared memory objects.
         // Allocating on the heap allows us to know when the replica access table is constructed/destructed.
-        std::unique_ptr<bi::managed_shared_memory> g_segment;
-        std::unique_ptr<void_allocator_type> g_allocator;
-        std::unique_ptr<bi::named_upgradable_mutex> g_mutex;
-        map_type* g_map;
+        std::unique_ptr<bi::shared_memory_object> g_segment;
+        std::unique_ptr<bi::mapped_region> g_region;
+
+        // Maps replica tokens to entries. This table is authoritative.
+        token_map_type* g_token_map;
+
+        // Maps (data id, replica number) tuples to replica tokens. An entry is only valid while
+        // its token is present in g_token_map.
+        replica_map_type* g_replica_map;
 
-        // Returns a new replica token (i.e. UUID) allocated in shared memory.
-        auto generate_replica_token() -> key_type
+        // Returns a new replica token (i.e. UUID).
+        auto generate_replica_token() -> replica_token_type
         {
-            key_type uuid{*g_allocator};
-            uuid.reserve(36);
-            uuid = to_string(boost::uuids::random_generator{}()).data();
+            auto uuid = to_string(boost::uuids::random_generator{}());
 
-            while (g_map->find(uuid) != g_map->end()) {
-                uuid = to_string(boost::uuids::random_generator{}()).data();
+            while (g_token_map->contains(uuid)) {
+                uuid = to_string(boost::uuids::random_generator{}());
             }
 
             return uuid;
         } // generate_replica_token
+
+        // Returns whether the token held by _entry belongs to the replica.
+        auto token_is_valid(const replica_entry& _entry,
+                            data_id_type _data_id,
+                            replica_number_type _replica_number) -> bool
+        {
+            const auto e = g_token_map->find(_entry.token);
+            return e && e->data_id == _data_id && e->replica_number == _replica_number;
+        } // token_is_valid
+
+        // Maps the replica to _token unless the replica is mapped to another valid token.
+        auto map_replica_to_token(data_id_type _data_id,
+                                  replica_number_type _replica_number,
+                                  replica_token_view_type _token) -> bool
+        {
+            const replica_key key{_data_id, _replica_number};
+
+            const auto inserted = g_replica_map->try_insert(key, replica_entry{_token});
+
+            if (!inserted) {
+                throw replica_access_table_error{"replica_access_table: Out of memory"};
+            }
+
+            if (*inserted) {
+                return true;
+            }
+
+            bool mapped = false;
+
+            // The existing entry is stale if its token has been erased. Erasing a token and its
+            // replica entry does not happen atomically.
+            g_replica_map->modify(key, [&](replica_entry& _entry) {
+                if (_token == _entry.token || !token_is_valid(_entry, _data_id, _replica_number)) {
+                    _entry = replica_entry{_token};
+                    mapped = true;
+                }
+
+                return true;
+            });
+
+            return mapped;
+        } // map_replica_to_token
+
+        // Erases the replica's entry if it is still mapped to _token.
+        auto unmap_replica(data_id_type _data_id,
+                           replica_number_type _replica_number,
+                           replica_token_view_type _token) -> void
+        {
+            g_replica_map->modify(replica_key{_data_id, _replica_number}, [_token](const replica_entry& _entry) {
+                return _token != _entry.token;
+            });
+        } // unmap_replica
     } // anonymous namespace
 
     auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
@@ -95,16 +176,21 @@ namespace irods::experimental::replica_access_table
 
         g_segment_name = _shm_name;
         g_segment_size = _shm_size;
-        g_mutex_name = g_segment_name + "_mutex";
 
-        bi::named_upgradable_mutex::remove(g_mutex_name.data());
         bi::shared_memory_object::remove(g_segment_name.data());
 
         g_owner_pid = getpid();
-        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
-        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
-        g_mutex = std::make_unique<bi::named_upgradable_mutex>(bi::create_only, g_mutex_name.data());
-        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+        g_segment = std::make_unique<bi::shared_memory_object>(bi::create_only, g_segment_name.data(), bi::read_write);
+        g_segment->truncate(g_segment_size);
+        g_region = std::make_unique<bi::mapped_region>(*g_segment, bi::read_write);
+
+        // Both tables hold one entry per open replica, so they are given the same capacity.
+        const auto capacity = g_segment_size / (token_map_type::slot_size + replica_map_type::slot_size);
+        const auto token_map_size = token_map_type::required_size(capacity);
+
+        auto* address = static_cast<char*>(g_region->get_address());
+        g_token_map = token_map_type::construct(address, token_map_size);
+        g_replica_map = replica_map_type::construct(address + token_map_size, g_region->get_size() - token_map_size);
     } // init
 
     auto deinit() noexcept -> void
@@ -117,18 +203,14 @@ namespace irods::experimental::replica_access_table
         try {
             g_owner_pid = 0;
 
-            if (g_segment && g_map) {
-                g_segment->destroy_ptr(g_map);
-                g_map = nullptr;
-            }
+            g_token_map = nullptr;
+            g_replica_map = nullptr;
 
             // clang-format off
-            if (g_mutex)     { g_mutex.reset(); }
-            if (g_allocator) { g_allocator.reset(); }
-            if (g_segment)   { g_segment.reset(); }
+            if (g_region)  { g_region.reset(); }
+            if (g_segment) { g_segment.reset(); }
             // clang-format on
 
-            bi::named_upgradable_mutex::remove(g_mutex_name.data());
             bi::shared_memory_object::remove(g_segment_name.data());
         }
         catch (...) {}
@@ -138,23 +220,31 @@ namespace irods::experimental::replica_access_table
                           replica_number_type _replica_number,
                           pid_t _pid) -> replica_token_type
     {
-        bi::scoped_lock lk{*g_mutex};
-
-        const auto end = g_map->end();
-        const auto exists = [_data_id, _replica_number](const value_type& v)
-        {
-            return v.second.data_id == _data_id && v.second.replica_number == _replica_number;
-        };
-
-        if (auto iter = std::find_if(g_map->begin(), end, exists); iter != end) {
-            throw replica_access_table_error{"replica_access_table: Entry already exists"};
+        auto token = generate_replica_token();
+
+        access_entry entry{};
+        entry.data_id = _data_id;
+        entry.replica_number = _replica_number;
+        entry.agent_pid_count = 1;
+        entry.agent_pids[0] = _pid;
+
+        // The token is inserted first so that a replica is never mapped to a token which
+        // does not exist yet.
+        if (!g_token_map->try_insert(token, entry).value_or(false)) {
+            throw replica_access_table_error{"replica_access_table: Out of memory"};
         }
 
-        auto uuid = generate_replica_token();
-        mapped_type v{_data_id, _replica_number, access_entry::container_type{{_pid}, *g_allocator}};
-        g_map->insert(value_type{uuid, v});
+        try {
+            if (!map_replica_to_token(_data_id, _replica_number, token)) {
+                throw replica_access_table_error{"replica_access_table: Entry already exists"};
+            }
+        }
+        catch (...) {
+            g_token_map->erase(token);
+            throw;
+        }
 
-        return uuid.data();
+        return token;
     } // create_new_entry
 
     auto append_pid(replica_token_view_type _token,
@@ -162,45 +252,37 @@ namespace irods::experimental::replica_access_table
                     replica_number_type _replica_number,
                     pid_t _pid) -> void
     {
-        bi::scoped_lock lk{*g_mutex};
+        const auto found = g_token_map->modify(_token, [&](access_entry& _entry) {
+            if (_entry.data_id != _data_id || _entry.replica_number != _replica_number) {
+                throw replica_access_table_error{"replica_access_table: Invalid data id or replica number"};
+            }
 
-        auto iter = g_map->find(key_type{_token.data(), *g_allocator});
+            if (_entry.agent_pid_count == access_entry::max_agent_pids) {
+                throw replica_access_table_error{"replica_access_table: Too many agents"};
+            }
 
-        if (iter == g_map->end()) {
-            throw replica_access_table_error{"replica_access_table: Invalid token"};
-        }
+            _entry.agent_pids[_entry.agent_pid_count++] = _pid;
 
-        auto& [k, v] = *iter;
+            return true;
+        });
 
-        if (v.data_id != _data_id || v.replica_number != _replica_number) {
-            throw replica_access_table_error{"replica_access_table: Invalid data id or replica number"};
+        if (!found) {
+            throw replica_access_table_error{"replica_access_table: Invalid token"};
         }
-
-        v.agent_pids.push_back(_pid);
     } // append_pid
 
     auto contains(data_id_type _data_id, replica_number_type _replica_number) -> bool
     {
-        bi::sharable_lock lk{*g_mutex};
-
-        for (auto&& [k, v] : *g_map) {
-            if (v.data_id == _data_id && v.replica_number == _replica_number) {
-                return true;
-            }
-        }
-
-        return false;
+        const auto e = g_replica_map->find(replica_key{_data_id, _replica_number});
+        return e && token_is_valid(*e, _data_id, _replica_number);
     } // contains
 
     auto contains(replica_token_view_type _token,
                       data_id_type _data_id,
                       replica_number_type _replica_number) -> bool
     {
-        bi::sharable_lock lk{*g_mutex};
-
-        if (const auto iter = g_map->find(key_type{_token.data(), *g_allocator}); iter != g_map->end()) {
-            return iter->second.data_id == _data_id &&
-                   iter->second.replica_number == _replica_number;
+        if (const auto e = g_token_map->find(_token); e) {
+            return e->data_id == _data_id && e->replica_number == _replica_number;
         }
 
         return false;
@@ -208,76 +290,97 @@ namespace irods::experimental::replica_access_table
 
     auto erase_pid(replica_token_view_type _token, pid_t _pid) -> std::optional<restorable_entry>
     {
-        // Acquiring the upgradable lock allows more readers to use the replica access table.
-        // This is required so that if the target entry to remove is found, the lock can be
-        // transistioned to an exclusive lock atomically.
-        bi::upgradable_lock lk{*g_mutex};
+        std::optional<access_entry> erased_from;
+        bool entry_removed = false;
 
-        if (const auto iter = g_map->find(key_type{_token.data(), *g_allocator}); iter != g_map->end()) {
-            auto& pids = iter->second.agent_pids;
+        g_token_map->modify(_token, [&](access_entry& _entry) {
+            auto* end = _entry.agent_pids + _entry.agent_pid_count;
 
-            if (const auto pos = std::find(pids.begin(), pids.end(), _pid); pos != pids.end()) {
-                // We found the PID, acquire the exclusive lock atomically and remove the PID.
-                bi::scoped_lock<bi::named_upgradable_mutex> write_lk{std::move(lk)};
-
-                restorable_entry entry{_token, iter->second.data_id, iter->second.replica_number, *pos};
+            if (auto* pos = std::find(_entry.agent_pids, end, _pid); pos != end) {
+                erased_from = _entry;
+                std::copy(pos + 1, end, pos);
+                --_entry.agent_pid_count;
+                entry_removed = (0 == _entry.agent_pid_count);
+            }
 
-                pids.erase(pos);
+            return !entry_removed;
+        });
 
-                if (pids.empty()) {
-                    g_map->erase(iter);
-                }
+        if (!erased_from) {
+            return std::nullopt;
+        }
 
-                return entry;
-            }
+        if (entry_removed) {
+            unmap_replica(erased_from->data_id, erased_from->replica_number, _token);
         }
 
-        return std::nullopt;
+        return restorable_entry{_token, erased_from->data_id, erased_from->replica_number, _pid};
     } // erase_pid
 
     auto erase_pid(pid_t _pid) -> void
     {
-        bi::scoped_lock lk{*g_mutex};
+        struct removed_entry
+        {
+            replica_token_type token;
+            data_id_type data_id;
+            replica_number_type replica_number;
+        };
 
-        std::vector<const key_type*> keys_to_remove;
+        std::vector<removed_entry> removed;
 
-        for (auto&& [k, v] : *g_map) {
-            auto end = std::end(v.agent_pids);
-            v.agent_pids.erase(std::remove(std::begin(v.agent_pids), end, _pid), end);
+        g_token_map->erase_if([&](std::string_view _token, access_entry& _entry) {
+            auto* end = _entry.agent_pids + _entry.agent_pid_count;
+            _entry.agent_pid_count = std::remove(_entry.agent_pids, end, _pid) - _entry.agent_pids;
 
             // Remember which entries have an empty PID list.
-            if (v.agent_pids.empty()) {
-                keys_to_remove.push_back(&k);
+            if (0 == _entry.agent_pid_count) {
+                removed.push_back({std::string{_token}, _entry.data_id, _entry.replica_number});
+                return true;
             }
-        }
 
-        for (auto&& k : keys_to_remove) {
-            g_map->erase(*k);
+            return false;
+        });
+
+        for (auto&& e : removed) {
+            unmap_replica(e.data_id, e.replica_number, e.token);
         }
     } // erase_pid
 
     auto restore(const restorable_entry& _entry) -> void
     {
-        bi::scoped_lock lk{*g_mutex};
+        const auto append = [&_entry](access_entry& _e) {
+            if (_e.data_id != _entry.data_id || _e.replica_number != _entry.replica_number) {
+                throw replica_access_table_error{"replica_access_table: Invalid data id or replica number"};
+            }
 
-        const key_type key{_entry.token.data(), *g_allocator};
+            if (_e.agent_pid_count == access_entry::max_agent_pids) {
+                throw replica_access_table_error{"replica_access_table: Too many agents"};
+            }
 
-        if (auto iter = g_map->find(key); iter != g_map->end()) {
-            auto& [k, v] = *iter;
+            _e.agent_pids[_e.agent_pid_count++] = _entry.pid;
 
-            if (v.data_id != _entry.data_id || v.replica_number != _entry.replica_number) {
-                throw replica_access_table_error{"replica_access_table: Invalid data id or replica number"};
+            return true;
+        };
+
+        if (!g_token_map->modify(_entry.token, append)) {
+            access_entry value{};
+            value.data_id = _entry.data_id;
+            value.replica_number = _entry.replica_number;
+            value.agent_pid_count = 1;
+            value.agent_pids[0] = _entry.pid;
+
+            const auto inserted = g_token_map->try_insert(_entry.token, value);
+
+            if (!inserted) {
+                throw replica_access_table_error{"replica_access_table: Out of memory"};
             }
 
-            v.agent_pids.push_back(_entry.pid);
+            // Another agent restored the token first.
+            if (!*inserted) {
+                g_token_map->modify(_entry.token, append);
+            }
         }
-        else {
-            mapped_type value{_entry.data_id,
-                              _entry.replica_number,
-                              access_entry::container_type{{_entry.pid}, *g_allocator}};
 
-            g_map->insert(value_type{key, value});
-        }
+        map_replica_to_token(_entry.data_id, _entry.replica_number, _entry.token);
     } // restore
 } // namespace irods::experimental::replica_access_table
-
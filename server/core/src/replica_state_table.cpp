@@ -9,8 +9,14 @@
 
 #include "fmt/format.h"
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 extern irods::resource_manager resc_mgr;
 
@@ -29,141 +35,343 @@ namespace irods::replica_state_table
         static const std::string AFTER_KW = "after";
         static const std::string REPLICAS_KW = "replicas";
 
+        // The columns of R_DATA_MAIN describing a replica. Numeric columns are stored as
+        // integers so that lookups and updates do not need to parse strings. The JSON
+        // representation (see ir::to_json) is only produced at the API boundary.
+        struct replica_state
+        {
+            rodsLong_t  data_id{};
+            rodsLong_t  coll_id{};
+            std::string data_name;
+            rodsLong_t  data_repl_num{};
+            std::string data_version;
+            std::string data_type_name;
+            rodsLong_t  data_size{};
+            std::string data_path;
+            std::string data_owner_name;
+            std::string data_owner_zone;
+            rodsLong_t  data_is_dirty{};
+            std::string data_status;
+            std::string data_checksum;
+            std::string data_expiry_ts;
+            rodsLong_t  data_map_id{};
+            std::string data_mode;
+            std::string r_comment;
+            std::string create_ts;
+            std::string modify_ts;
+            rodsLong_t  resc_id{};
+        }; // struct replica_state
+
+        struct replica_entry
+        {
+            replica_state before;
+            replica_state after;
+            json file_modified; // null unless the replica is published with file_modified parameters
+        }; // struct replica_entry
+
+        struct table_entry
+        {
+            std::string logical_path;
+            std::vector<replica_entry> replicas;
+        }; // struct table_entry
+
+        // Maps the JSON property names onto the members of replica_state.
+        struct property
+        {
+            std::string_view name;
+            std::variant<rodsLong_t replica_state::*, std::string replica_state::*> member;
+        }; // struct property
+
+        // clang-format off
+        const std::array<property, 20> properties{{
+            {"data_id",         &replica_state::data_id},
+            {"coll_id",         &replica_state::coll_id},
+            {"data_name",       &replica_state::data_name},
+            {"data_repl_num",   &replica_state::data_repl_num},
+            {"data_version",    &replica_state::data_version},
+            {"data_type_name",  &replica_state::data_type_name},
+            {"data_size",       &replica_state::data_size},
+            {"data_path",       &replica_state::data_path},
+            {"data_owner_name", &replica_state::data_owner_name},
+            {"data_owner_zone", &replica_state::data_owner_zone},
+            {"data_is_dirty",   &replica_state::data_is_dirty},
+            {"data_status",     &replica_state::data_status},
+            {"data_checksum",   &replica_state::data_checksum},
+            {"data_expiry_ts",  &replica_state::data_expiry_ts},
+            {"data_map_id",     &replica_state::data_map_id},
+            {"data_mode",       &replica_state::data_mode},
+            {"r_comment",       &replica_state::r_comment},
+            {"create_ts",       &replica_state::create_ts},
+            {"modify_ts",       &replica_state::modify_ts},
+            {"resc_id",         &replica_state::resc_id}
+        }};
+        // clang-format on
+
         // Global Variables
-        std::map<key_type, json> replica_state_json_map;
+        std::unordered_map<key_type, table_entry> replica_state_map;
 
         std::mutex rst_mutex;
 
         // Local functions
         // extracts the key information from the replica_proxy and returns
-        // the string-ified key for use with the JSON map.
+        // the key for use with the map.
         auto get_key(const ir::replica_proxy_t& _r) -> key_type
         {
             return _r.data_id();
         } // get_key
 
         // extracts the key information from the data_object_proxy and returns
-        // the string-ified key for use with the JSON map.
+        // the key for use with the map.
         auto get_key(const id::data_object_proxy_t& _o) -> key_type
         {
             return _o.data_id();
         } // get_key
 
-        auto index_of(const key_type& _key, const int _replica_number) -> int
+        auto find_property(const std::string_view _property_name) -> const property&
         {
-            std::scoped_lock rst_lock{rst_mutex};
+            const auto p = std::find_if(std::begin(properties), std::end(properties),
+                [_property_name](const property& _p) { return _property_name == _p.name; });
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(_key)) {
-                int index = -1;
+            if (std::end(properties) == p) {
+                THROW(KEY_NOT_FOUND, fmt::format(
+                    "[{}:{}] - unknown replica property [{}]",
+                    __FUNCTION__, __LINE__, _property_name));
+            }
 
-                for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                    ++index;
-                    if (_replica_number == std::stoi(e.at(BEFORE_KW).at("data_repl_num").get<std::string>())) {
-                        return index;
-                    }
+            return *p;
+        } // find_property
+
+        auto make_replica_state(const ir::replica_proxy_t& _r) -> replica_state
+        {
+            namespace fs = irods::experimental::filesystem;
+
+            return replica_state{
+                _r.data_id(),
+                _r.collection_id(),
+                fs::path{_r.logical_path().data()}.object_name().c_str(),
+                _r.replica_number(),
+                std::string{_r.version()},
+                std::string{_r.type()},
+                _r.size(),
+                std::string{_r.physical_path()},
+                std::string{_r.owner_user_name()},
+                std::string{_r.owner_zone_name()},
+                _r.replica_status(),
+                std::string{_r.status()},
+                std::string{_r.checksum()},
+                _r.get()->dataExpiry,
+                _r.get()->dataMapId,
+                std::string{_r.mode()},
+                std::string{_r.comments()},
+                std::string{_r.ctime()},
+                std::string{_r.mtime()},
+                _r.resource_id()
+            };
+        } // make_replica_state
+
+        auto property_to_string(const replica_state& _state, const property& _property) -> std::string
+        {
+            return std::visit([&_state](auto _member) -> std::string {
+                if constexpr (std::is_same_v<decltype(_member), std::string replica_state::*>) {
+                    return _state.*_member;
                 }
+                else {
+                    return std::to_string(_state.*_member);
+                }
+            }, _property.member);
+        } // property_to_string
+
+        auto set_property(replica_state& _state, const property& _property, const json& _value) -> void
+        {
+            if (auto* member = std::get_if<std::string replica_state::*>(&_property.member); member) {
+                _state.*(*member) = _value.get_ref<const std::string&>();
+                return;
             }
 
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - replica number [{}] not found for [{}]",
-                __FUNCTION__, __LINE__, _replica_number, _key));
-        } // index_of
+            auto& target = _state.*std::get<rodsLong_t replica_state::*>(_property.member);
+
+            if (_value.is_number_integer()) {
+                target = _value.get<rodsLong_t>();
+                return;
+            }
+
+            const auto& s = _value.get_ref<const std::string&>();
+            rodsLong_t value{};
 
-        auto index_of(const key_type& _key, const rodsLong_t _leaf_resource_id) -> int
+            if (const auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+                std::errc{} != ec || s.data() + s.size() != p)
+            {
+                THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
+                    "[{}:{}] - invalid value [{}] for replica property [{}]",
+                    __FUNCTION__, __LINE__, s, _property.name));
+            }
+
+            target = value;
+        } // set_property
+
+        auto to_json(const replica_state& _state) -> json
         {
-            std::scoped_lock rst_lock{rst_mutex};
+            json j = json::object();
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(_key)) {
-                int index = -1;
+            for (const auto& p : properties) {
+                j[p.name.data()] = property_to_string(_state, p);
+            }
 
-                irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - entry:[{}]", __FUNCTION__, __LINE__, replica_state_json_map.at(_key).dump()));
+            return j;
+        } // to_json
 
-                for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                    ++index;
-                    if (_leaf_resource_id == std::stol(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                        return index;
-                    }
-                }
+        auto to_json(const replica_entry& _replica) -> json
+        {
+            json j{
+                {BEFORE_KW, to_json(_replica.before)},
+                {AFTER_KW, to_json(_replica.after)}
+            };
+
+            if (!_replica.file_modified.is_null()) {
+                j[FILE_MODIFIED_KW] = _replica.file_modified;
             }
 
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - resource id [{}] not found for [{}]",
-                __FUNCTION__, __LINE__, _leaf_resource_id, _key));
-        } // index_of
+            return j;
+        } // to_json
 
-        auto index_of(const key_type& _key, const std::string_view _leaf_resource_name) -> int
+        auto to_json(const table_entry& _entry) -> json
         {
-            std::scoped_lock rst_lock{rst_mutex};
+            json replicas = json::array();
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(_key)) {
-                int index = -1;
+            for (const auto& r : _entry.replicas) {
+                replicas.push_back(to_json(r));
+            }
 
-                const auto resc_id = resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+            return replicas;
+        } // to_json
 
-                for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                    ++index;
-                    if (resc_id == std::stoi(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                        return index;
-                    }
-                }
+        auto to_json(const replica_entry& _replica, const state_type _state) -> json
+        {
+            switch (_state) {
+                // clang-format off
+                case state_type::before:    return to_json(_replica.before);   break;
+                case state_type::after:     return to_json(_replica.after);    break;
+                case state_type::both:      return to_json(_replica);          break;
+                // clang-format on
+
+                default:
+                    THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
+                        "[{}:{}] - invalid state_type",
+                        __FUNCTION__, __LINE__));
+            }
+        } // to_json
+
+        auto leaf_resource_id(const std::string_view _leaf_resource_name) -> rodsLong_t
+        {
+            return resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+        } // leaf_resource_id
+
+        // The following functions must be called while holding rst_mutex.
+
+        auto entry_at(const key_type& _key) -> table_entry&
+        {
+            if (auto e = replica_state_map.find(_key); std::end(replica_state_map) != e) {
+                return e->second;
             }
 
             THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - resource name [{}] not found for [{}]",
-                __FUNCTION__, __LINE__, _leaf_resource_name, _key));
-        } // index_of
+                "[{}:{}] - no key found for [{}]",
+                __FUNCTION__, __LINE__, _key));
+        } // entry_at
 
-        // Only for use when restoring an entry
-        auto insert_entry(const key_type& _key, const json& _entry) -> int
+        auto find_replica_number(table_entry& _entry, const int _replica_number) -> std::vector<replica_entry>::iterator
         {
-            try {
-                std::scoped_lock rst_lock{rst_mutex};
+            return std::find_if(std::begin(_entry.replicas), std::end(_entry.replicas),
+                [_replica_number](const replica_entry& _r) { return _replica_number == _r.before.data_repl_num; });
+        } // find_replica_number
 
-                replica_state_json_map[_key] = _entry;
+        auto find_resource_id(table_entry& _entry, const rodsLong_t _resource_id) -> std::vector<replica_entry>::iterator
+        {
+            return std::find_if(std::begin(_entry.replicas), std::end(_entry.replicas),
+                [_resource_id](const replica_entry& _r) { return _resource_id == _r.before.resc_id; });
+        } // find_resource_id
 
-                return 0;
-            }
-            catch (const irods::exception& e) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
-                return e.code();
-            }
-            catch (const json::exception& e) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
-                return SYS_LIBRARY_ERROR;
-            }
-            catch (const std::exception& e) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.what()));
-                return SYS_INTERNAL_ERR;
+        auto replica_at(const key_type& _key, const int _replica_number) -> replica_entry&
+        {
+            auto& entry = entry_at(_key);
+
+            if (const auto r = find_replica_number(entry, _replica_number); std::end(entry.replicas) != r) {
+                return *r;
             }
-            catch (...) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - unknown error occurred", __FUNCTION__, __LINE__));
-                return SYS_UNKNOWN_ERROR;
+
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - replica number [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _replica_number, _key));
+        } // replica_at
+
+        auto replica_at_resource(const key_type& _key, const rodsLong_t _leaf_resource_id) -> replica_entry&
+        {
+            auto& entry = entry_at(_key);
+
+            if (const auto r = find_resource_id(entry, _leaf_resource_id); std::end(entry.replicas) != r) {
+                return *r;
             }
-        } // insert_entry
 
-        auto update_impl(
-            const key_type& _key,
-            const int _replica_index,
-            const json& _updates) -> void
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - resource id [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _leaf_resource_id, _key));
+        } // replica_at_resource
+
+        auto update_impl(replica_entry& _replica, const json& _updates) -> void
         {
             try {
-                std::scoped_lock rst_lock{rst_mutex};
-
-                auto& target_replica = replica_state_json_map.at(_key).at(REPLICAS_KW).at(_replica_index);
+                if (!_updates.is_object()) {
+                    THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
+                        "[{}:{}] - updates must be a JSON object:[{}]",
+                        __FUNCTION__, __LINE__, _updates.dump()));
+                }
 
-                irods::log(LOG_DEBUG8, fmt::format("[{}:{}] - replica[{}],update:[{}]",
-                    __FUNCTION__, __LINE__, target_replica.dump(), _updates.dump()));
+                // Apply the updates to a copy so that the replica is unchanged if any update is invalid.
+                auto after = _replica.after;
 
-                target_replica.at(AFTER_KW).update(_updates);
+                for (const auto& [name, value] : _updates.items()) {
+                    set_property(after, find_property(name), value);
+                }
 
-                irods::log(LOG_DEBUG8, fmt::format("[{}:{}] - [{}]",
-                    __FUNCTION__, __LINE__, target_replica.dump()));
+                _replica.after = std::move(after);
             }
             catch (const json::exception& e) {
                 THROW(SYS_LIBRARY_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
             }
         } // update_impl
 
+        auto index_of(const key_type& _key, const int _replica_number) -> int
+        {
+            std::scoped_lock rst_lock{rst_mutex};
+
+            auto& entry = entry_at(_key);
+
+            if (const auto r = find_replica_number(entry, _replica_number); std::end(entry.replicas) != r) {
+                return std::distance(std::begin(entry.replicas), r);
+            }
+
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - replica number [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _replica_number, _key));
+        } // index_of
+
+        auto index_of(const key_type& _key, const std::string_view _leaf_resource_name) -> int
+        {
+            const auto resc_id = leaf_resource_id(_leaf_resource_name);
+
+            std::scoped_lock rst_lock{rst_mutex};
+
+            auto& entry = entry_at(_key);
+
+            if (const auto r = find_resource_id(entry, resc_id); std::end(entry.replicas) != r) {
+                return std::distance(std::begin(entry.replicas), r);
+            }
+
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - resource name [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _leaf_resource_name, _key));
+        } // index_of
+
         auto publish_to_catalog_impl(
             RsComm& _comm,
             const key_type& _key,
@@ -174,53 +382,54 @@ namespace irods::replica_state_table
         {
             const bool trigger_file_modified = !_file_modified_parameters.empty();
 
+            // Store a backup of this replica state table entry. If anything goes wrong in the data_object_finalize
+            // step, the replica_state_table entry should be restored so that the caller can determine what to do
+            // with the object (e.g. retry, unlock and stale, etc.). A backup is only needed when the entry is
+            // erased below, so the entry is moved into the backup rather than copied.
+            std::optional<table_entry> backup_entry;
+
             const auto input = [&]() -> json
             {
                 std::scoped_lock rst_lock{rst_mutex};
 
-                auto& target_entry = replica_state_json_map.at(_key);
+                auto& target_entry = entry_at(_key);
 
                 if (trigger_file_modified) {
-                    target_entry.at(REPLICAS_KW).at(_replica_index)[FILE_MODIFIED_KW] = _file_modified_parameters;
+                    target_entry.replicas.at(_replica_index).file_modified = _file_modified_parameters;
                 }
 
-                return json{
+                json input{
                     {"irods_admin", _privileged},
                     {"bytes_written", std::to_string(_bytes_written)},
-                    {REPLICAS_KW, target_entry.at(REPLICAS_KW)},
+                    {REPLICAS_KW, to_json(target_entry)},
                     {"trigger_file_modified", trigger_file_modified}
                 };
-            }();
-
-            // Store a backup of this replica state table entry. If anything goes wrong in the data_object_finalize
-            // step, the replica_state_table entry should be restored so that the caller can determine what to do
-            // with the object (e.g. retry, unlock and stale, etc.)
-            json backup_entry;
 
-            {
-                std::scoped_lock rst_lock{rst_mutex};
+                // Completely erase the replica state table entry -- file_modified could open other replicas
+                if (trigger_file_modified) {
+                    backup_entry = std::move(target_entry);
+                    replica_state_map.erase(_key);
+                }
 
-                backup_entry = replica_state_json_map.at(_key);
-            }
+                return input;
+            }();
 
             int ec = 0;
             const auto restore_entry = irods::at_scope_exit{[&]
             {
-                if (ec < 0 && trigger_file_modified) {
-                    if (const auto restore_ec = insert_entry(_key, backup_entry); restore_ec < 0) {
+                if (ec < 0 && backup_entry) {
+                    try {
+                        std::scoped_lock rst_lock{rst_mutex};
+
+                        replica_state_map.insert_or_assign(_key, std::move(*backup_entry));
+                    }
+                    catch (const std::exception& e) {
                         irods::log(LOG_NOTICE, fmt::format(
-                            "failed to restore replica_state_table_entry [error_code=[{}]]", restore_ec));
+                            "failed to restore replica_state_table_entry [error=[{}]]", e.what()));
                     }
                 }
             }};
 
-            // Completely erase the replica state table entry -- file_modified could open other replicas
-            if (trigger_file_modified) {
-                std::scoped_lock rst_lock{rst_mutex};
-
-                replica_state_json_map.erase(_key);
-            }
-
             char* error_string{};
             const irods::at_scope_exit free_error_string{[&error_string] { free(error_string); }};
 
@@ -242,7 +451,7 @@ namespace irods::replica_state_table
 
         irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - initializing state table", __FUNCTION__, __LINE__));
 
-        replica_state_json_map.clear();
+        replica_state_map.clear();
     } // init
 
     auto deinit() -> void
@@ -251,7 +460,7 @@ namespace irods::replica_state_table
 
         irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - de-initializing state table", __FUNCTION__, __LINE__));
 
-        replica_state_json_map.clear();
+        replica_state_map.clear();
     } // deinit
 
     auto insert(const id::data_object_proxy_t& _obj) -> int
@@ -261,30 +470,23 @@ namespace irods::replica_state_table
         try {
             std::scoped_lock rst_lock{rst_mutex};
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(key)) {
+            if (std::end(replica_state_map) != replica_state_map.find(key)) {
                 irods::log(LOG_DEBUG, fmt::format("[{}:{}] - entry exists;path:[{}]", __FUNCTION__, __LINE__, _obj.logical_path()));
                 return 0;
             }
 
-            json replica_list;
+            table_entry entry{std::string{_obj.logical_path()}, {}};
+            entry.replicas.reserve(_obj.replica_count());
 
             for (const auto& r : _obj.replicas()) {
-                const auto json_replica = ir::to_json(r);
-
-                replica_list.push_back({
-                    {BEFORE_KW, json_replica},
-                    {AFTER_KW, json_replica}
-                });
+                auto state = make_replica_state(r);
+                entry.replicas.push_back({state, std::move(state), {}});
             }
 
-            const json entry{
-                {REPLICAS_KW, replica_list},
-                {"logical_path", _obj.logical_path()}
-            };
-
-            irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - entry:[{}]", __FUNCTION__, __LINE__, entry.dump()));
+            irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - inserted entry;path:[{}],replicas:[{}]",
+                __FUNCTION__, __LINE__, entry.logical_path, entry.replicas.size()));
 
-            replica_state_json_map[key] = entry;
+            replica_state_map.emplace(key, std::move(entry));
 
             return 0;
         }
@@ -305,19 +507,15 @@ namespace irods::replica_state_table
 
             const auto& key = get_key(_replica);
 
-            std::scoped_lock rst_lock{rst_mutex};
+            auto state = make_replica_state(_replica);
 
-            const auto json_replica = ir::to_json(_replica);
+            std::scoped_lock rst_lock{rst_mutex};
 
-            auto& entry = replica_state_json_map.at(key);
-            entry.at(REPLICAS_KW).push_back(
-                {
-                    {BEFORE_KW, json_replica},
-                    {AFTER_KW, json_replica}
-                }
-            );
+            auto& entry = entry_at(key);
+            entry.replicas.push_back({state, std::move(state), {}});
 
-            irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - entry:[{}]", __FUNCTION__, __LINE__, entry.dump()));
+            irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - inserted replica;path:[{}],repl_num:[{}]",
+                __FUNCTION__, __LINE__, entry.logical_path, _replica.replica_number()));
 
             return 0;
         }
@@ -330,44 +528,56 @@ namespace irods::replica_state_table
 
     auto erase(const key_type& _key) -> void
     {
-        if (!contains(_key)) {
+        std::scoped_lock rst_lock{rst_mutex};
+
+        if (0 == replica_state_map.erase(_key)) {
             THROW(KEY_NOT_FOUND, fmt::format(
                 "[{}:{}] - no key found for [{}]",
                 __FUNCTION__, __LINE__, _key));
         }
-
-        std::scoped_lock rst_lock{rst_mutex};
-
-        replica_state_json_map.erase(_key);
     } // erase
 
     auto erase(const key_type& _key, const std::string_view _leaf_resource_name) -> void
     {
-        const auto replica_index = index_of(_key, _leaf_resource_name);
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
         std::scoped_lock rst_lock{rst_mutex};
 
-        auto& entry = replica_state_json_map.at(_key).at(REPLICAS_KW);
+        auto& entry = entry_at(_key);
+
+        const auto r = find_resource_id(entry, resc_id);
+
+        if (std::end(entry.replicas) == r) {
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - resource name [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _leaf_resource_name, _key));
+        }
 
-        return entry.erase(replica_index);
+        entry.replicas.erase(r);
     } // erase
 
     auto erase(const key_type& _key, const int _replica_number) -> void
     {
-        const auto replica_index = index_of(_key, _replica_number);
-
         std::scoped_lock rst_lock{rst_mutex};
 
-        auto& entry = replica_state_json_map.at(_key).at(REPLICAS_KW);
+        auto& entry = entry_at(_key);
+
+        const auto r = find_replica_number(entry, _replica_number);
+
+        if (std::end(entry.replicas) == r) {
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - replica number [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _replica_number, _key));
+        }
 
-        return entry.erase(replica_index);
+        entry.replicas.erase(r);
     } // erase
 
     auto contains(const key_type& _key) -> bool
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        return std::end(replica_state_json_map) != replica_state_json_map.find(_key);
+        return std::end(replica_state_map) != replica_state_map.find(_key);
     } // contains
 
     auto contains(const key_type& _key, const std::string_view _leaf_resource_name) -> bool
@@ -376,47 +586,29 @@ namespace irods::replica_state_table
             return false;
         }
 
-        const auto resc_id = resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
         std::scoped_lock rst_lock{rst_mutex};
 
-        for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-            if (resc_id == std::stoll(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                return true;
-            }
-        }
+        const auto e = replica_state_map.find(_key);
 
-        return false;
+        return std::end(replica_state_map) != e && std::end(e->second.replicas) != find_resource_id(e->second, resc_id);
     } // contains
 
     auto contains(const key_type& _key, const int _replica_number) -> bool
     {
-        if (!contains(_key)) {
-            return false;
-        }
-
         std::scoped_lock rst_lock{rst_mutex};
 
-        for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-            if (_replica_number == std::stoi(e.at(BEFORE_KW).at("data_repl_num").get<std::string>())) {
-                return true;
-            }
-        }
+        const auto e = replica_state_map.find(_key);
 
-        return false;
+        return std::end(replica_state_map) != e && std::end(e->second.replicas) != find_replica_number(e->second, _replica_number);
     } // contains
 
     auto at(const key_type& _key) -> json
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        if (std::end(replica_state_json_map) == replica_state_json_map.find(_key)) {
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no key found for [{}]",
-                __FUNCTION__, __LINE__, _key));
-        }
-
-        return replica_state_json_map.at(_key).at(REPLICAS_KW);
+        return to_json(entry_at(_key));
     } // at
 
     auto at(
@@ -424,35 +616,11 @@ namespace irods::replica_state_table
         const std::string_view _leaf_resource_name,
         const state_type _state) -> json
     {
-        std::scoped_lock rst_lock{rst_mutex};
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
-        const auto resc_id = resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
-
-        const auto& replica_json = [&_key, &resc_id]
-        {
-            for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                if (resc_id == std::stoll(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                    return e;
-                }
-            }
+        std::scoped_lock rst_lock{rst_mutex};
 
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no resc id [{}] found for [{}]",
-                __FUNCTION__, __LINE__, resc_id, _key));
-        }();
-
-        switch (_state) {
-            // clang-format off
-            case state_type::before:    return replica_json.at(BEFORE_KW);   break;
-            case state_type::after:     return replica_json.at(AFTER_KW);    break;
-            case state_type::both:      return replica_json;                 break;
-            // clang-format on
-
-            default:
-                THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
-                    "[{}:{}] - invalid state_type",
-                    __FUNCTION__, __LINE__));
-        }
+        return to_json(replica_at_resource(_key, resc_id), _state);
     } // at
 
     auto at(
@@ -462,31 +630,7 @@ namespace irods::replica_state_table
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        const auto& replica_json = [&_key, &_replica_number]
-        {
-            for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                if (_replica_number == std::stoi(e.at(BEFORE_KW).at("data_repl_num").get<std::string>())) {
-                    return e;
-                }
-            }
-
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no replica number [{}] found for [{}]",
-                __FUNCTION__, __LINE__, _replica_number, _key));
-        }();
-
-        switch (_state) {
-            // clang-format off
-            case state_type::before:    return replica_json.at(BEFORE_KW);   break;
-            case state_type::after:     return replica_json.at(AFTER_KW);    break;
-            case state_type::both:      return replica_json;                 break;
-            // clang-format on
-
-            default:
-                THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
-                    "[{}:{}] - invalid state_type",
-                    __FUNCTION__, __LINE__));
-        }
+        return to_json(replica_at(_key, _replica_number), _state);
     } // at
 
     auto update(
@@ -494,9 +638,11 @@ namespace irods::replica_state_table
         const std::string_view _leaf_resource_name,
         const json& _updates) -> void
     {
-        const auto replica_index = index_of(_key, _leaf_resource_name);
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
+
+        std::scoped_lock rst_lock{rst_mutex};
 
-        return update_impl(_key, replica_index, _updates);
+        update_impl(replica_at_resource(_key, resc_id), _updates);
     } // update
 
     auto update(
@@ -504,20 +650,32 @@ namespace irods::replica_state_table
         const int _replica_number,
         const json& _updates) -> void
     {
-        const auto replica_index = index_of(_key, _replica_number);
+        std::scoped_lock rst_lock{rst_mutex};
 
-        return update_impl(_key, replica_index, _updates);
+        update_impl(replica_at(_key, _replica_number), _updates);
     } // update
 
     auto update(
         const key_type& _key,
         const ir::replica_proxy_t& _replica) -> void
     {
-        const auto replica_index = index_of(_key, _replica.resource_id());
+        auto state = make_replica_state(_replica);
+
+        std::scoped_lock rst_lock{rst_mutex};
 
-        return update_impl(_key, replica_index, ir::to_json(_replica));
+        replica_at_resource(_key, _replica.resource_id()).after = std::move(state);
     } // update
 
+    auto update_replica_status(
+        const key_type& _key,
+        const int _replica_number,
+        const int _replica_status) -> void
+    {
+        std::scoped_lock rst_lock{rst_mutex};
+
+        replica_at(_key, _replica_number).after.data_is_dirty = _replica_status;
+    } // update_replica_status
+
     auto get_property(
         const key_type& _key,
         const int _replica_number,
@@ -528,9 +686,13 @@ namespace irods::replica_state_table
             THROW(SYS_INVALID_INPUT_PARAM, fmt::format("state type must be before or after"));
         }
 
-        const auto replica_json = at(_key, _replica_number, _state);
+        const auto& property = find_property(_property_name);
+
+        std::scoped_lock rst_lock{rst_mutex};
 
-        return replica_json.at(_property_name.data());
+        const auto& replica = replica_at(_key, _replica_number);
+
+        return property_to_string(state_type::before == _state ? replica.before : replica.after, property);
     } // get_property
 
     auto get_property(
@@ -543,16 +705,53 @@ namespace irods::replica_state_table
             THROW(SYS_INVALID_INPUT_PARAM, fmt::format("state type must be before or after"));
         }
 
-        const auto replica_json = at(_key, _leaf_resource_name, _state);
+        const auto& property = find_property(_property_name);
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
+
+        std::scoped_lock rst_lock{rst_mutex};
+
+        const auto& replica = replica_at_resource(_key, resc_id);
 
-        return replica_json.at(_property_name.data());
+        return property_to_string(state_type::before == _state ? replica.before : replica.after, property);
     } // get_property
 
+    auto get_replica_status(
+        const key_type& _key,
+        const int _replica_number,
+        const state_type _state) -> int
+    {
+        if (state_type::both == _state) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("state type must be before or after"));
+        }
+
+        std::scoped_lock rst_lock{rst_mutex};
+
+        const auto& replica = replica_at(_key, _replica_number);
+
+        return static_cast<int>(state_type::before == _state ? replica.before.data_is_dirty : replica.after.data_is_dirty);
+    } // get_replica_status
+
+    auto get_replica_numbers(const key_type& _key) -> std::vector<int>
+    {
+        std::scoped_lock rst_lock{rst_mutex};
+
+        const auto& entry = entry_at(_key);
+
+        std::vector<int> replica_numbers;
+        replica_numbers.reserve(entry.replicas.size());
+
+        for (const auto& r : entry.replicas) {
+            replica_numbers.push_back(static_cast<int>(r.before.data_repl_num));
+        }
+
+        return replica_numbers;
+    } // get_replica_numbers
+
     auto get_logical_path(const key_type& _key) -> std::string
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        return replica_state_json_map.at(_key).at("logical_path").get<std::string>();
+        return entry_at(_key).logical_path;
     } // get_logical_path
 
     namespace publish
@@ -584,4 +783,3 @@ namespace irods::replica_state_table
         } // to_catalog
     } // namespace publish
 } // namespace irods
-
@@ -0,0 +1,211 @@
+#include "resource_snapshot.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/vector.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+
+    // clang-format off
+    using segment_manager_type  = bi::managed_shared_memory::segment_manager;
+    using void_allocator_type   = bi::allocator<void, segment_manager_type>;
+    using char_allocator_type   = bi::allocator<char, segment_manager_type>;
+    using string_type           = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+    using string_allocator_type = bi::allocator<string_type, segment_manager_type>;
+    using string_vector_type    = bi::vector<string_type, string_allocator_type>;
+    // clang-format on
+
+    // The shared memory representation of the resource rows.
+    //
+    // Rows are stored back to back in row-major order so that the snapshot is made up
+    // of a single vector of strings, regardless of the number of resources.
+    struct snapshot
+    {
+        explicit snapshot(const void_allocator_type& _alloc)
+            : version{_alloc}
+            , values{_alloc}
+            , column_count{}
+        {
+        }
+
+        string_type version;
+        string_vector_type values;
+        std::uint32_t column_count;
+    }; // struct snapshot
+
+    //
+    // Global Variables
+    //
+
+    // The following variables define the names of shared memory objects and other properties.
+    std::string g_segment_name;
+    std::size_t g_segment_size;
+    std::string g_mutex_name;
+
+    // On initialization, holds the PID of the process that initialized the resource snapshot.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    // The following are pointers to the shared memory objects and allocator.
+    // Allocating on the heap allows us to know when the resource snapshot is constructed/destructed.
+    std::unique_ptr<bi::managed_shared_memory> g_segment;
+    std::unique_ptr<void_allocator_type> g_allocator;
+    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+    snapshot* g_snapshot;
+
+    auto reset_snapshot() -> void
+    {
+        g_snapshot->version.clear();
+        g_snapshot->column_count = 0;
+
+        // Swapping with an empty vector returns the memory held by the strings to the segment.
+        string_vector_type{*g_allocator}.swap(g_snapshot->values);
+    } // reset_snapshot
+} // anonymous namespace
+
+namespace irods::experimental::resource_snapshot
+{
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_snapshot = g_segment->construct<snapshot>(bi::anonymous_instance)(*g_allocator);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_snapshot) {
+                g_segment->destroy_ptr(g_snapshot);
+                g_snapshot = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto is_initialized() noexcept -> bool
+    {
+        return g_segment && g_mutex && g_snapshot;
+    } // is_initialized
+
+    auto store(const std::string_view _version, const std::vector<row_type>& _rows) -> bool
+    {
+        const std::uint32_t column_count = _rows.empty() ? 0 : _rows.front().size();
+
+        for (auto&& row : _rows) {
+            if (row.size() != column_count) {
+                return false;
+            }
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+
+        reset_snapshot();
+
+        try {
+            g_snapshot->values.reserve(_rows.size() * column_count);
+
+            for (auto&& row : _rows) {
+                for (auto&& value : row) {
+                    g_snapshot->values.emplace_back(value.data(), value.size(), *g_allocator);
+                }
+            }
+
+            g_snapshot->column_count = column_count;
+            g_snapshot->version.assign(_version.data(), _version.size());
+        }
+        catch (const std::exception&) {
+            // The resource rows do not fit (bi::bad_alloc or std::length_error). Leave the
+            // snapshot empty so that agents continue to query the catalog directly.
+            reset_snapshot();
+            return false;
+        }
+
+        return true;
+    } // store
+
+    auto load(const std::string_view _version) -> std::optional<std::vector<row_type>>
+    {
+        bi::sharable_lock lk{*g_mutex};
+
+        const auto& version = g_snapshot->version;
+
+        if (version.empty() || std::string_view{version.data(), version.size()} != _version) {
+            return std::nullopt;
+        }
+
+        std::vector<row_type> rows;
+
+        if (const auto column_count = g_snapshot->column_count; column_count > 0) {
+            const auto& values = g_snapshot->values;
+
+            rows.reserve(values.size() / column_count);
+
+            for (std::size_t i = 0; i < values.size(); i += column_count) {
+                auto& row = rows.emplace_back();
+                row.reserve(column_count);
+
+                for (std::size_t j = i; j < i + column_count; ++j) {
+                    row.emplace_back(values[j].data(), values[j].size());
+                }
+            }
+        }
+
+        return rows;
+    } // load
+
+    auto version() -> std::string
+    {
+        bi::sharable_lock lk{*g_mutex};
+        return {g_snapshot->version.data(), g_snapshot->version.size()};
+    } // version
+
+    auto clear() -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+        reset_snapshot();
+    } // clear
+} // namespace irods::experimental::resource_snapshot
+
@@ -38,11 +38,128 @@
 #include <sys/wait.h>
 
 #include <cstring>
+#include <ctime>
+#include <deque>
 #include <memory>
 #include <sstream>
 
 namespace ix = irods::experimental;
 
+namespace
+{
+    // An agent forked ahead of time which waits on its control socket for the
+    // agent factory to hand it a connection.
+    struct pooled_agent
+    {
+        pid_t pid;
+        int control_socket;
+        std::time_t spawn_time;
+    };
+
+    // Idle agents owned by the agent factory, oldest first.
+    std::deque<pooled_agent> agent_pool;
+
+    // Set in a pooled agent once its API tables have been loaded.
+    bool agent_is_prewarmed = false;
+
+    // Pooled agents are not respawned before this time after one exited while idle.
+    std::time_t agent_pool_respawn_time = 0;
+
+    int get_agent_pool_size() noexcept
+    {
+        try {
+            const int size = irods::get_advanced_setting<const int>(irods::CFG_AGENT_FACTORY_POOL_SIZE_KW);
+            if (size >= 0) {
+                return size;
+            }
+            rodsLog(LOG_ERROR, "Invalid agent factory pool size [size=%d].", size);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_AGENT_FACTORY_POOL_SIZE_KW.data());
+        }
+
+        return 0;
+    }
+
+    int get_agent_pool_max_idle_time() noexcept
+    {
+        try {
+            const int seconds = irods::get_advanced_setting<const int>(irods::CFG_AGENT_FACTORY_POOL_MAX_IDLE_TIME_IN_SECONDS_KW);
+            if (seconds > 0) {
+                return seconds;
+            }
+            rodsLog(LOG_ERROR, "Invalid agent factory pool idle time [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s].",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_AGENT_FACTORY_POOL_MAX_IDLE_TIME_IN_SECONDS_KW.data());
+        }
+
+        return 600;
+    }
+
+    // Closes the factory's end of every control socket. Must be called in each
+    // process forked by the agent factory so that only the factory holds them.
+    void release_agent_pool()
+    {
+        for (const auto& agent : agent_pool) {
+            close(agent.control_socket);
+        }
+
+        agent_pool.clear();
+    }
+
+    ssize_t send_socket_over_socket(int _write_fd, int _socket)
+    {
+        union {
+            struct cmsghdr cm;
+            char control[CMSG_SPACE(sizeof(int))];
+        } control_un;
+
+        struct msghdr msg{};
+        memset(control_un.control, 0, sizeof(control_un.control));
+        msg.msg_control = control_un.control;
+        msg.msg_controllen = sizeof(control_un.control);
+
+        struct cmsghdr* cmptr = CMSG_FIRSTHDR(&msg);
+        cmptr->cmsg_len = CMSG_LEN(sizeof(int));
+        cmptr->cmsg_level = SOL_SOCKET;
+        cmptr->cmsg_type = SCM_RIGHTS;
+        *((int*) CMSG_DATA(cmptr)) = _socket;
+
+        struct iovec iov[1];
+        iov[0].iov_base = (void*) "i";
+        iov[0].iov_len = 1;
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 1;
+
+        return sendmsg(_write_fd, &msg, 0);
+    }
+
+    irods::error load_api_tables()
+    {
+        // =-=-=-=-=-=-=-
+        // load server side pluggable api entries
+        irods::api_entry_table&  RsApiTable   = irods::get_server_api_table();
+        irods::pack_entry_table& ApiPackTable = irods::get_pack_table();
+        irods::error ret = irods::init_api_table(RsApiTable, ApiPackTable, false);
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // load client side pluggable api entries
+        irods::api_entry_table& RcApiTable = irods::get_client_api_table();
+        ret = irods::init_api_table(RcApiTable, ApiPackTable, false);
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        return SUCCESS();
+    }
+} // anonymous namespace
+
 ssize_t receiveSocketFromSocket( int readFd, int *socket) {
     struct msghdr msg;
     memset(&msg, 0, sizeof(msg));
@@ -194,6 +311,166 @@ irodsAgentSignalExit( int ) {
     exit( 1 );
 }
 
+// Runs in a process forked by the agent factory once it has a connection from
+// the main server. Receives the client socket and reloads the configuration.
+static int
+initialize_agent_process( int conn_tmp_socket ) {
+    using log = irods::experimental::log;
+
+    log::set_server_type("agent");
+
+    // Child process - reload properties and receive data from server process
+    irods::environment_properties::instance().capture();
+
+    const int status = receiveDataFromServer(conn_tmp_socket);
+    if (status < 0) {
+        const auto err{ERROR(status, "Error in receiveDataFromServer")};
+        irods::log(err);
+        //return err.code();
+    }
+
+    irods::server_properties::instance().capture();
+    irods::parse_and_store_hosts_configuration_file_as_json();
+
+    using key_path_t = irods::configuration_parser::key_path_t;
+
+    // Update the eviction age for DNS cache entries.
+    irods::set_server_property(
+        key_path_t{irods::CFG_ADVANCED_SETTINGS_KW, irods::CFG_DNS_CACHE_KW, irods::CFG_EVICTION_AGE_IN_SECONDS_KW},
+        irods::get_dns_cache_eviction_age());
+
+    // Update the eviction age for hostname cache entries.
+    irods::set_server_property(
+        key_path_t{irods::CFG_ADVANCED_SETTINGS_KW, irods::CFG_HOSTNAME_CACHE_KW, irods::CFG_EVICTION_AGE_IN_SECONDS_KW},
+        irods::get_hostname_cache_eviction_age());
+
+    log::agent::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_AGENT_KW));
+    log::legacy::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_LEGACY_KW));
+    log::resource::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_RESOURCE_KW));
+    log::database::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_DATABASE_KW));
+    log::authentication::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_AUTHENTICATION_KW));
+    log::api::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_API_KW));
+    log::microservice::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_MICROSERVICE_KW));
+    log::network::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_NETWORK_KW));
+    log::rule_engine::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_RULE_ENGINE_KW));
+
+    log::agent::trace("Agent started.");
+
+    irods::error ret2 = setRECacheSaltFromEnv();
+    if ( !ret2.ok() ) {
+        rodsLog( LOG_ERROR, "rodsAgent::main: Failed to set RE cache mutex name\n%s", ret2.result().c_str() );
+        return SYS_INTERNAL_ERR;
+    }
+
+    return 0;
+} // initialize_agent_process
+
+// Forks an agent which loads its API tables ahead of time and then waits for
+// the agent factory to hand it a connection. Returns the pid of the agent in
+// the factory. In the agent, returns 0 once the connection has been received
+// into conn_tmp_socket.
+static pid_t
+spawn_pooled_agent( int& conn_tmp_socket ) {
+    int control_sockets[2];
+    if ( socketpair( AF_UNIX, SOCK_STREAM, 0, control_sockets ) < 0 ) {
+        rodsLog( LOG_ERROR, "socketpair() failed in rodsAgent process factory, errno = [%d]: %s", errno, strerror( errno ) );
+        return -1;
+    }
+
+    const pid_t pid = fork();
+    if ( pid < 0 ) {
+        rodsLog( LOG_ERROR, "fork() failed while filling the agent pool, errno = [%d]: %s", errno, strerror( errno ) );
+        close( control_sockets[0] );
+        close( control_sockets[1] );
+        return pid;
+    }
+
+    if ( pid > 0 ) {
+        close( control_sockets[1] );
+        agent_pool.push_back( pooled_agent{pid, control_sockets[0], time( 0 )} );
+        return pid;
+    }
+
+    close( control_sockets[0] );
+    release_agent_pool();
+
+    irods::server_properties::instance().capture();
+    irods::environment_properties::instance().capture();
+
+    // The configuration, and with it the rule engines, may have changed since the
+    // factory looked up any rules.
+    RuleExistsHelper::Instance()->invalidateCache();
+
+    if ( const auto ret = load_api_tables(); !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        exit( 1 );
+    }
+    agent_is_prewarmed = true;
+
+    // Block until the factory hands over a connection. End of file means the
+    // agent has been recycled or the factory has gone away.
+    const ssize_t num_bytes = receiveSocketFromSocket( control_sockets[1], &conn_tmp_socket );
+    close( control_sockets[1] );
+    if ( num_bytes <= 0 ) {
+        exit( 0 );
+    }
+
+    return 0;
+} // spawn_pooled_agent
+
+// Hands conn_tmp_socket to an idle pooled agent. Returns false if no agent could take it.
+static bool
+dispatch_to_pooled_agent( int conn_tmp_socket ) {
+    while ( !agent_pool.empty() ) {
+        const pooled_agent agent = agent_pool.front();
+        agent_pool.pop_front();
+
+        const bool sent = send_socket_over_socket( agent.control_socket, conn_tmp_socket ) > 0;
+        close( agent.control_socket );
+
+        if ( sent ) {
+            ix::log::agent_factory::trace("Handed connection to pooled agent [{}].", agent.pid);
+            return true;
+        }
+
+        rodsLog( LOG_DEBUG, "Pooled agent [%d] is no longer available, errno = [%d]", agent.pid, errno );
+    }
+
+    return false;
+} // dispatch_to_pooled_agent
+
+// Replaces idle agents which have been waiting for longer than the configured
+// idle time and tops up the pool. Returns true in a newly forked pooled agent
+// once it has been handed a connection.
+static bool
+maintain_agent_pool( int pool_size, int& conn_tmp_socket ) {
+    const std::time_t now = time( 0 );
+    const int max_idle_time = get_agent_pool_max_idle_time();
+
+    while ( !agent_pool.empty() && now - agent_pool.front().spawn_time > max_idle_time ) {
+        // The agent exits when it sees the end of its control socket.
+        close( agent_pool.front().control_socket );
+        agent_pool.pop_front();
+    }
+
+    if ( now < agent_pool_respawn_time ) {
+        return false;
+    }
+
+    while ( agent_pool.size() < static_cast<std::size_t>( pool_size ) ) {
+        const pid_t pid = spawn_pooled_agent( conn_tmp_socket );
+        if ( pid == 0 ) {
+            return true;
+        }
+        if ( pid < 0 ) {
+            agent_pool_respawn_time = now + 5;
+            break;
+        }
+    }
+
+    return false;
+} // maintain_agent_pool
+
 int
 runIrodsAgentFactory( sockaddr_un agent_addr ) {
     int status{};
@@ -257,6 +534,13 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
         return SYS_SOCK_ACCEPT_ERR;
     }
 
+    // Idle agents are forked ahead of time so that a new connection does not
+    // have to wait for the agent to load its plugins.
+    const int pool_size = get_agent_pool_size();
+    if ( pool_size > 0 ) {
+        log::agent_factory::info("Maintaining a pool of {} idle agents.", pool_size);
+    }
+
     while ( true ) {
         // Reap any zombie processes from completed agents
         int reaped_pid, child_status;
@@ -274,10 +558,30 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
 
             rmProcLog( reaped_pid );
 
+            // An agent which dies while waiting in the pool is removed from it and
+            // not replaced right away in case it failed to initialize.
+            for ( auto it = agent_pool.begin(); it != agent_pool.end(); ++it ) {
+                if ( it->pid == reaped_pid ) {
+                    close( it->control_socket );
+                    agent_pool.erase( it );
+                    agent_pool_respawn_time = time( 0 ) + 5;
+                    break;
+                }
+            }
+
             ix::log::agent_factory::trace("Removing agent PID [{}] from replica access table ...", reaped_pid);
             ix::replica_access_table::erase_pid(reaped_pid);
         }
 
+        if ( pool_size > 0 && maintain_agent_pool( pool_size, conn_tmp_socket ) ) {
+            status = initialize_agent_process( conn_tmp_socket );
+            if ( status < 0 ) {
+                return status;
+            }
+
+            break;
+        }
+
         fd_set read_socket;
         FD_ZERO( &read_socket );
         FD_SET( conn_socket, &read_socket);
@@ -364,53 +668,29 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
                 }
             }
 
+            if ( dispatch_to_pooled_agent( conn_tmp_socket ) ) {
+                status = close( conn_tmp_socket );
+                if ( status < 0 ) {
+                    rodsLog( LOG_ERROR, "close(conn_tmp_socket) failed with errno = [%d]: %s", errno, strerror( errno ) );
+                }
+
+                status = close( tmp_socket );
+                if ( status < 0 ) {
+                    rodsLog( LOG_ERROR, "close(tmp_socket) failed with errno = [%d]: %s", errno, strerror( errno ) );
+                }
+
+                continue;
+            }
+
             // Data is ready on conn_socket, fork a child process to handle it
             log::agent_factory::trace("Spawning agent to handle request ...");
             pid_t child_pid = fork();
             if ( child_pid == 0 ) {
-                log::set_server_type("agent");
-
-                // Child process - reload properties and receive data from server process
-                irods::environment_properties::instance().capture();
-
-                status = receiveDataFromServer(conn_tmp_socket);
-                if (status < 0) {
-                    const auto err{ERROR(status, "Error in receiveDataFromServer")};
-                    irods::log(err);
-                    //return err.code();
-                }
+                release_agent_pool();
 
-                irods::server_properties::instance().capture();
-                irods::parse_and_store_hosts_configuration_file_as_json();
-
-                using key_path_t = irods::configuration_parser::key_path_t;
-
-                // Update the eviction age for DNS cache entries.
-                irods::set_server_property(
-                    key_path_t{irods::CFG_ADVANCED_SETTINGS_KW, irods::CFG_DNS_CACHE_KW, irods::CFG_EVICTION_AGE_IN_SECONDS_KW},
-                    irods::get_dns_cache_eviction_age());
-
-                // Update the eviction age for hostname cache entries.
-                irods::set_server_property(
-                    key_path_t{irods::CFG_ADVANCED_SETTINGS_KW, irods::CFG_HOSTNAME_CACHE_KW, irods::CFG_EVICTION_AGE_IN_SECONDS_KW},
-                    irods::get_hostname_cache_eviction_age());
-
-                log::agent::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_AGENT_KW));
-                log::legacy::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_LEGACY_KW));
-                log::resource::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_RESOURCE_KW));
-                log::database::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_DATABASE_KW));
-                log::authentication::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_AUTHENTICATION_KW));
-                log::api::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_API_KW));
-                log::microservice::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_MICROSERVICE_KW));
-                log::network::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_NETWORK_KW));
-                log::rule_engine::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_RULE_ENGINE_KW));
-
-                log::agent::trace("Agent started.");
-
-                irods::error ret2 = setRECacheSaltFromEnv();
-                if ( !ret2.ok() ) {
-                    rodsLog( LOG_ERROR, "rodsAgent::main: Failed to set RE cache mutex name\n%s", ret2.result().c_str() );
-                    return SYS_INTERNAL_ERR;
+                status = initialize_agent_process( conn_tmp_socket );
+                if ( status < 0 ) {
+                    return status;
                 }
 
                 break;
@@ -474,23 +754,13 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
         cleanupAndExit( status );
     }
 
-    // =-=-=-=-=-=-=-
-    // load server side pluggable api entries
-    irods::api_entry_table&  RsApiTable   = irods::get_server_api_table();
-    irods::pack_entry_table& ApiPackTable = irods::get_pack_table();
-    ret = irods::init_api_table(RsApiTable, ApiPackTable, false);
-    if ( !ret.ok() ) {
-        irods::log( PASS( ret ) );
-        return 1;
-    }
-
-    // =-=-=-=-=-=-=-
-    // load client side pluggable api entries
-    irods::api_entry_table& RcApiTable = irods::get_client_api_table();
-    ret = irods::init_api_table(RcApiTable, ApiPackTable, false);
-    if ( !ret.ok() ) {
-        irods::log( PASS( ret ) );
-        return 1;
+    // pooled agents loaded their api tables before they were handed the connection
+    if ( !agent_is_prewarmed ) {
+        ret = load_api_tables();
+        if ( !ret.ok() ) {
+            irods::log( PASS( ret ) );
+            return 1;
+        }
     }
 
     std::string svc_role;
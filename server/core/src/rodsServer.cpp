@@ -26,6 +26,7 @@
 #include "irods_logger.hpp"
 #include "hostname_cache.hpp"
 #include "dns_cache.hpp"
+#include "resource_snapshot.hpp"
 #include "server_utilities.hpp"
 
 #include <pthread.h>
@@ -54,6 +55,7 @@
 namespace ix   = irods::experimental;
 namespace hnc  = irods::experimental::net::hostname_cache;
 namespace dnsc = irods::experimental::net::dns_cache;
+namespace rsnp = irods::experimental::resource_snapshot;
 // clang-format on
 
 using namespace boost::filesystem;
@@ -341,6 +343,9 @@ int main(int argc, char** argv)
     dnsc::init("irods_dns_cache", irods::get_dns_cache_shared_memory_size());
     irods::at_scope_exit deinit_dns_cache{[] { dnsc::deinit(); }};
 
+    rsnp::init("irods_resource_snapshot", irods::get_resource_snapshot_shared_memory_size());
+    irods::at_scope_exit deinit_resource_snapshot{[] { rsnp::deinit(); }};
+
     ix::replica_access_table::init();
     irods::at_scope_exit deinit_replica_access_table{[] { ix::replica_access_table::deinit(); }};
 
@@ -52,6 +52,49 @@ namespace
         log::set_request_proxy_user(_comm->proxyUser.userName);
         log::set_request_api_number(_api_number);
     }
+
+    // Returns whether the input struct of the API is unpacked into the agent's request
+    // arena instead of the heap. This is only safe for handlers which never free or
+    // reallocate any part of their input, e.g. with rmKeyVal() or addKeyVal(). The
+    // data object read, write and seek handlers only update scalar members, and they
+    // are by far the most frequent requests of a transfer.
+    auto unpacks_into_arena(int _api_number) noexcept -> bool
+    {
+        switch (_api_number) {
+            case DATA_OBJ_READ_AN:
+            case DATA_OBJ_WRITE_AN:
+            case DATA_OBJ_LSEEK_AN:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    // Whether the request arena holds the input struct of a request being processed.
+    // A request nested inside the handler of another then unpacks onto the heap.
+    bool request_arena_in_use = false;
+
+    // Returns the arena for the input struct of the request being processed, or nullptr
+    // if it is in use or could not be created. It is released after each request with
+    // release_request_arena(), keeping its blocks for the next one.
+    auto acquire_request_arena() -> unpackArena_t*
+    {
+        static unpackArena_t* arena = create_unpack_arena(0);
+
+        if (request_arena_in_use || !arena) {
+            return nullptr;
+        }
+
+        request_arena_in_use = true;
+        return arena;
+    }
+
+    auto release_request_arena(unpackArena_t* _arena) -> void
+    {
+        reset_unpack_arena(_arena);
+        request_arena_in_use = false;
+    }
 } // anonymous namespace
 
 int rsApiHandler(rsComm_t*   rsComm,
@@ -68,6 +111,13 @@ int rsApiHandler(rsComm_t*   rsComm,
     if (const auto [supported, ec] = irods::is_api_number_supported(apiNumber); !supported) {
         log::server::error({{"log_message", "unsupported api number"},
                             {"error_code", std::to_string(ec)}});
+
+        // Reply so that the client is not left waiting and can fall back to another API.
+        irods::network_object_ptr net_obj;
+        if (const auto ret = irods::network_factory(rsComm, net_obj); ret.ok()) {
+            sendRodsMsg(net_obj, RODS_API_REPLY_T, NULL, NULL, NULL, ec, rsComm->irodsProt);
+        }
+
         return ec;
     }
 
@@ -147,12 +197,23 @@ int rsApiHandler(rsComm_t*   rsComm,
     }
 
     char *myInStruct = NULL;
+    unpackArena_t* arena = unpacks_into_arena( apiNumber ) ? acquire_request_arena() : NULL;
 
     if ( inputStructBBuf->len > 0 ) {
-        status = unpack_struct( inputStructBBuf->buf, ( void ** )( static_cast< void * >( &myInStruct ) ),
-                               ( char* )RsApiTable[apiInx]->inPackInstruct, RodsPackTable, rsComm->irodsProt,
-                               rsComm->cliVersion.relVersion);
+        if ( arena ) {
+            status = unpack_struct_with_arena( inputStructBBuf->buf, ( void ** )( static_cast< void * >( &myInStruct ) ),
+                                               ( char* )RsApiTable[apiInx]->inPackInstruct, RodsPackTable, rsComm->irodsProt,
+                                               rsComm->cliVersion.relVersion, arena );
+        }
+        else {
+            status = unpack_struct( inputStructBBuf->buf, ( void ** )( static_cast< void * >( &myInStruct ) ),
+                                   ( char* )RsApiTable[apiInx]->inPackInstruct, RodsPackTable, rsComm->irodsProt,
+                                   rsComm->cliVersion.relVersion);
+        }
         if ( status < 0 ) {
+            if ( arena ) {
+                release_request_arena( arena );
+            }
             rodsLog( LOG_NOTICE, "rsApiHandler: unpackStruct error for apiNumber %d, status = %d",
                      apiNumber, status );
             sendApiReply( rsComm, apiInx, status, myOutStruct, &myOutBsBBuf );
@@ -165,6 +226,9 @@ int rsApiHandler(rsComm_t*   rsComm,
     irods::api_entry_ptr api_entry = RsApiTable[apiInx];
     if ( !api_entry.get() ) {
         rodsLog( LOG_ERROR, "Null handler encountered for api number %d in rsApiHandler.", apiNumber );
+        if ( arena ) {
+            release_request_arena( arena );
+        }
         return SYS_API_INPUT_ERR;
     }
 
@@ -235,7 +299,12 @@ int rsApiHandler(rsComm_t*   rsComm,
 
     // =-=-=-=-=-=-=-
     // clear the incoming packing instruction
-    if ( myInStruct != NULL ) {
+    if ( arena ) {
+        // The struct and its members live in the arena.
+        release_request_arena( arena );
+        myInStruct = NULL;
+    }
+    else if ( myInStruct != NULL ) {
         if ( RsApiTable[apiInx]->clearInStruct ) {
             RsApiTable[apiInx]->clearInStruct( myInStruct );
         }
@@ -441,7 +510,7 @@ apply_acPostProcForParallelTransferReceived(rsComm_t *rsComm) {
     }
 
     const int l3_index = rsComm->portalOpr->dataOprInp.destL3descInx;
-    if (l3_index < 3 || l3_index >= NUM_FILE_DESC) {
+    if (!FileDesc.in_range(l3_index)) {
         rodsLog(LOG_ERROR, "apply_acPostProcForParallelTransferReceived: bad l3 descriptor index %d", l3_index);
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
@@ -36,6 +36,7 @@ int chlModDataObjMeta( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo,
                        keyValPair_t *regParam );
 int chlUpdateRescObjCount( const std::string& _resc, int _delta );
 int chlRegDataObj( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo );
+int chlBulkRegDataObj( rsComm_t *rsComm, dataObjInfo_t *dataObjInfos, int count );
 int chlRegRuleExecObj( rsComm_t *rsComm,
                        ruleExecSubmitInp_t *ruleExecSubmitInp );
 int chlRegReplica( rsComm_t *rsComm, dataObjInfo_t *srcDataObjInfo,
@@ -225,6 +226,7 @@ int chlGetReplListForLeafBundles(
     size_t                      _child_idx,
     const std::vector<leaf_bundle_t>* _bundles,
     const std::string*          _invocation_timestamp,
+    rodsLong_t                  _after_data_id,
     dist_child_result_t*        _results );
 
 /// \brief High-level wrapper for database operation which calls cmlCheckDataObjId
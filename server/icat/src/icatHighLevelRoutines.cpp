@@ -533,6 +533,67 @@ int chlRegDataObj(
 
 } // chlRegDataObj
 
+// =-=-=-=-=-=-=-
+// chlBulkRegDataObj - Register a batch of new iRODS data objects
+// Input - rsComm_t *rsComm  - the server handle
+//         dataObjInfo_t *dataObjInfos - array of _count data objects to register.
+//             On success, dataId and collId of each entry are filled in.
+//         int _count - number of entries in dataObjInfos
+// The objects are registered in a single transaction which is committed
+// unless NO_COMMIT_FLAG is set in the flags of any of the entries.
+// Only the database_bulk_reg_data_obj PEPs are invoked, not the per-object
+// database_reg_data_obj PEPs of chlRegDataObj.
+int chlBulkRegDataObj(
+    rsComm_t*      _comm,
+    dataObjInfo_t* _data_obj_infos,
+    int            _count ) {
+    // =-=-=-=-=-=-=-
+    // call factory for database object
+    irods::database_object_ptr db_obj_ptr;
+    irods::error ret = irods::database_factory(
+                           database_plugin_type,
+                           db_obj_ptr );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // resolve a plugin for that object
+    irods::plugin_ptr db_plug_ptr;
+    ret = db_obj_ptr->resolve(
+              irods::DATABASE_INTERFACE,
+              db_plug_ptr );
+    if ( !ret.ok() ) {
+        irods::log(
+            PASSMSG(
+                "failed to resolve database interface",
+                ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // cast plugin and object to db and fco for call
+    irods::first_class_object_ptr ptr = boost::dynamic_pointer_cast <
+                                        irods::first_class_object > ( db_obj_ptr );
+    irods::database_ptr           db = boost::dynamic_pointer_cast <
+                                       irods::database > ( db_plug_ptr );
+
+    // =-=-=-=-=-=-=-
+    // call the operation on the plugin
+    ret = db->call <
+          dataObjInfo_t*,
+          int > (
+              _comm,
+              irods::DATABASE_OP_BULK_REG_DATA_OBJ,
+              ptr,
+              _data_obj_infos,
+              _count );
+
+    return ret.code();
+
+} // chlBulkRegDataObj
+
 // =-=-=-=-=-=-=-
 // chlRegReplica - Register a new iRODS replica file (data object)
 // Input - rsComm_t *rsComm  - the server handle
@@ -4664,6 +4725,7 @@ int chlGetReplListForLeafBundles(
     size_t                      _child_idx,
     const std::vector<leaf_bundle_t>* _bundles,
     const std::string*          _invocation_timestamp,
+    rodsLong_t                  _after_data_id,
     dist_child_result_t*        _results ) {
     // =-=-=-=-=-=-=-
     // call factory for database object
@@ -4702,6 +4764,7 @@ int chlGetReplListForLeafBundles(
               size_t,
               const std::vector<leaf_bundle_t>*,
               const std::string*,
+              rodsLong_t,
               dist_child_result_t* >(
                   0,
                   irods::DATABASE_OP_GET_REPL_LIST_FOR_LEAF_BUNDLES,
@@ -4710,6 +4773,7 @@ int chlGetReplListForLeafBundles(
                   _child_idx,
                   _bundles,
                   _invocation_timestamp,
+                  _after_data_id,
                   _results );
     if (!ret.ok()) {
         irods::log(PASS(ret));
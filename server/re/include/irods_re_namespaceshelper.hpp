@@ -11,7 +11,7 @@
 class NamespacesHelper {
 public:
     static NamespacesHelper* Instance();
-    std::vector<std::string> getNamespaces();
+    const std::vector<std::string>& getNamespaces();
 protected:
 private:
     NamespacesHelper(){};
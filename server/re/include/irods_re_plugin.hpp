@@ -6,7 +6,9 @@
 #include "irods_lookup_table.hpp"
 #include "irods_re_structs.hpp"
 #include "irods_state_table.h"
+#include "irods_re_ruleexistshelper.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <vector>
@@ -422,12 +424,21 @@ namespace irods {
             std::for_each(begin(re_packs_), end(re_packs_), [](re_pack_inp<T> &_inp) {
                 _inp.re_->start_operation(_inp.re_ctx_);
             });
+
+            // the rule engines have (re)loaded their rules. lookups are only
+            // cached if every rule engine reports later changes to its rules.
+            const bool cacheable = std::all_of(begin(re_packs_), end(re_packs_), [](const re_pack_inp<T> &_inp) {
+                return RuleExistsHelper::reportsRuleChanges(_inp.plugin_name_);
+            });
+            RuleExistsHelper::Instance()->enableCache(cacheable);
         }
 
         void call_stop_operations() {
             std::for_each(begin(re_packs_), end(re_packs_), [](re_pack_inp<T> &_inp) {
                 _inp.re_->stop_operation(_inp.re_ctx_);
             });
+
+            RuleExistsHelper::Instance()->invalidateCache();
         }
 
         microservice_manager<C> &ms_mgr_;
@@ -5,6 +5,10 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <shared_mutex>
+#include <optional>
+#include <cstdint>
 
 #include "boost/regex.hpp"
 
@@ -16,11 +20,71 @@ public:
     bool checkPrePep( const std::string& _ns, const std::string& _op_name );
     bool checkPostPep( const std::string& _ns, const std::string& _op_name );
     bool checkDynPeps( const std::string& _ns, const std::string& _op_name );
+
+    // Returns whether _rule_name passes the regex test and a rule engine plugin
+    // reports that it exists, or std::nullopt if a rule engine plugin could not
+    // answer.  Answers are remembered until invalidateCache() is called.
+    // _re_mgr must provide rule_exists(const std::string&, bool&).
+    template <typename RuleExistsManager>
+    std::optional<bool> ruleExists( const std::string& _rule_name, RuleExistsManager& _re_mgr ) {
+        if ( auto exists = lookupRule( _rule_name ); exists ) {
+            return exists;
+        }
+
+        if ( !checkOperation( _rule_name ) ) {
+            cacheRule( _rule_name, false );
+            return false;
+        }
+
+        bool exists = false;
+        if ( !_re_mgr.rule_exists( _rule_name, exists ).ok() ) {
+            return std::nullopt;
+        }
+
+        cacheRule( _rule_name, exists );
+        return exists;
+    }
+
+    // Returns false only if it is known that no namespace defines a PEP for the
+    // operation and class (e.g. "pre", "post").  This allows callers to skip
+    // building rule names for operations which have no policy at all.
+    bool pepMayExist( const std::string& _op_name, const std::string& _class );
+    void cachePepExistence( const std::string& _op_name, const std::string& _class, bool _exists );
+
+    // Discards everything remembered by ruleExists() and cachePepExistence().
+    // This must be called whenever the set of rules known to the rule engine
+    // plugins changes.
+    void invalidateCache();
+
+    // Enables or disables the caches.  The caches are enabled by default.
+    void enableCache( bool _enable );
+
+    // Returns whether the rule engine plugin reports every change to its rules
+    // through invalidateCache().  Other plugins (e.g. the Python rule engine)
+    // may change their rules at any time, so nothing can be cached while one of
+    // them is active.
+    static bool reportsRuleChanges( const std::string& _plugin_name );
 protected:
 private:
     RuleExistsHelper(){};
+
+    std::optional<bool> lookupRule( const std::string& _rule_name );
+    void cacheRule( const std::string& _rule_name, bool _exists );
+
+    // Bit masks indexed by PEP class.  "known" records the classes which have
+    // been looked up, "present" those for which at least one rule exists.
+    struct pep_summary {
+        std::uint8_t known;
+        std::uint8_t present;
+    };
+
     static RuleExistsHelper* _instance;
     std::vector<boost::regex> ruleRegexes;
+
+    bool cacheEnabled{true};
+    std::shared_mutex cacheMutex;
+    std::unordered_map<std::string, bool> ruleCache;
+    std::unordered_map<std::string, pep_summary> pepCache;
 };
 
 #endif
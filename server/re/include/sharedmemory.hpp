@@ -12,10 +12,19 @@
 #include <string>
 
 #define SHMMAX 30000000
-#define SHM_BASE_ADDR ((void *)0x80000000)
+/* The address the rule engine cache is laid out for and mapped at. It lies above the heap and below the
+ * shared libraries of 64-bit processes, and outside of the shadow memory of address sanitized builds. */
+#define SHM_BASE_ADDR ((void *)0x200000000000)
 unsigned char *prepareServerSharedMemory( const std::string& );
 void detachSharedMemory( const std::string& );
 int removeSharedMemory( const std::string& );
 unsigned char *prepareNonServerSharedMemory( const std::string& );
+/* Maps the shared memory copy-on-write at the given address, so that pointers laid out for that
+ * address can be used in place. Writes go to private copies of the pages written to.
+ * Returns NULL if the shared memory does not exist or the address is not available.
+ * The mapping outlives removeSharedMemory and stays until unmapSharedMemory is called. */
+unsigned char *mapSharedMemoryAt( const std::string&, void *_address );
+/* Returns 1 if the address was mapped by mapSharedMemoryAt and is now unmapped, 0 otherwise. */
+int unmapSharedMemory( unsigned char *_address );
 irods::error getSharedMemoryName( const std::string&, std::string &shared_memory_name );
 #endif /* SHAREDMEMORY_H */
@@ -16,6 +16,6 @@ NamespacesHelper* NamespacesHelper::Instance() {
     return _instance;
 }
 
-std::vector<std::string> NamespacesHelper::getNamespaces() {
+const std::vector<std::string>& NamespacesHelper::getNamespaces() {
     return namespaces;
 }
@@ -1,6 +1,22 @@
 #include "irods_re_ruleexistshelper.hpp"
 #include "irods_log.hpp"
 
+#include <mutex>
+
+namespace
+{
+    // Maps a PEP class to its bit in RuleExistsHelper::pep_summary.
+    // Returns zero for classes which are not summarized.
+    std::uint8_t pep_class_bit( const std::string& _class )
+    {
+        if ( _class == "pre" )     { return 1 << 0; }
+        if ( _class == "post" )    { return 1 << 1; }
+        if ( _class == "except" )  { return 1 << 2; }
+        if ( _class == "finally" ) { return 1 << 3; }
+        return 0;
+    }
+} // anonymous namespace
+
 RuleExistsHelper* RuleExistsHelper::_instance = 0;
 
 RuleExistsHelper* RuleExistsHelper::Instance() {
@@ -14,6 +30,9 @@ RuleExistsHelper* RuleExistsHelper::Instance() {
 void RuleExistsHelper::registerRuleRegex( const std::string& _regex ) {
     boost::regex expr(_regex);
     ruleRegexes.push_back(expr);
+
+    // Rules which failed the regex test before may pass it now.
+    invalidateCache();
 }
 
 bool RuleExistsHelper::checkOperation( const std::string& _op_name ) {
@@ -41,3 +60,88 @@ bool RuleExistsHelper::checkPostPep( const std::string& _ns, const std::string&
 bool RuleExistsHelper::checkDynPeps( const std::string& _ns, const std::string& _op_name ) {
     return checkPrePep(_ns, _op_name) || checkPostPep(_ns, _op_name); 
 }
+
+bool RuleExistsHelper::pepMayExist( const std::string& _op_name, const std::string& _class ) {
+    const auto bit = pep_class_bit( _class );
+    if ( !bit ) {
+        return true;
+    }
+
+    std::shared_lock lock{cacheMutex};
+
+    if ( !cacheEnabled ) {
+        return true;
+    }
+
+    if ( auto iter = pepCache.find( _op_name ); iter != std::end( pepCache ) ) {
+        const auto& summary = iter->second;
+        return !( summary.known & bit ) || ( summary.present & bit );
+    }
+
+    return true;
+}
+
+void RuleExistsHelper::cachePepExistence( const std::string& _op_name, const std::string& _class, bool _exists ) {
+    const auto bit = pep_class_bit( _class );
+    if ( !bit ) {
+        return;
+    }
+
+    std::unique_lock lock{cacheMutex};
+
+    if ( !cacheEnabled ) {
+        return;
+    }
+
+    auto& summary = pepCache[ _op_name ];
+    summary.known |= bit;
+
+    if ( _exists ) {
+        summary.present |= bit;
+    }
+    else {
+        summary.present &= ~bit;
+    }
+}
+
+void RuleExistsHelper::invalidateCache() {
+    std::unique_lock lock{cacheMutex};
+    ruleCache.clear();
+    pepCache.clear();
+}
+
+void RuleExistsHelper::enableCache( bool _enable ) {
+    std::unique_lock lock{cacheMutex};
+    cacheEnabled = _enable;
+    ruleCache.clear();
+    pepCache.clear();
+}
+
+bool RuleExistsHelper::reportsRuleChanges( const std::string& _plugin_name ) {
+    // The iRODS Rule Language reports its changes.  The C++ default policy
+    // plugin's rules are compiled in and never change.
+    return _plugin_name == "irods_rule_engine_plugin-irods_rule_language" ||
+           _plugin_name == "irods_rule_engine_plugin-cpp_default_policy";
+}
+
+std::optional<bool> RuleExistsHelper::lookupRule( const std::string& _rule_name ) {
+    std::shared_lock lock{cacheMutex};
+
+    if ( !cacheEnabled ) {
+        return std::nullopt;
+    }
+
+    if ( auto iter = ruleCache.find( _rule_name ); iter != std::end( ruleCache ) ) {
+        return iter->second;
+    }
+
+    return std::nullopt;
+}
+
+void RuleExistsHelper::cacheRule( const std::string& _rule_name, bool _exists ) {
+    std::unique_lock lock{cacheMutex};
+
+    if ( cacheEnabled ) {
+        ruleCache.insert_or_assign( _rule_name, _exists );
+    }
+}
@@ -10,6 +10,7 @@ namespace bi = boost::interprocess;
 
 static std::map<std::string,std::unique_ptr<bi::shared_memory_object>> shm_obj;
 static std::map<std::string,std::unique_ptr<bi::mapped_region>>        mapped; 
+static std::map<unsigned char*,std::unique_ptr<bi::mapped_region>>     mapped_at;
 
 unsigned char *prepareServerSharedMemory( const std::string& _key ) {
     std::string shared_memory_name;
@@ -94,6 +95,32 @@ unsigned char *prepareNonServerSharedMemory( const std::string& _key ) {
     }
 }
 
+unsigned char *mapSharedMemoryAt( const std::string& _key, void *_address ) {
+    std::string shared_memory_name;
+    irods::error ret = getSharedMemoryName( _key, shared_memory_name );
+    if ( !ret.ok() ) {
+        rodsLog( LOG_ERROR, "mapSharedMemoryAt: failed to get shared memory name [%s]", shared_memory_name.c_str() );
+        return NULL;
+    }
+
+    try {
+        /* the mapping keeps the shared memory alive after the object is closed or removed */
+        bi::shared_memory_object shm( bi::open_only, shared_memory_name.c_str(), bi::read_only );
+        std::unique_ptr<bi::mapped_region> region( new bi::mapped_region( shm, bi::copy_on_write, 0, 0, _address ) );
+        unsigned char *buf = ( unsigned char * ) region->get_address();
+        mapped_at[buf] = std::move( region );
+        return buf;
+    }
+    catch ( const bi::interprocess_exception &e ) {
+        rodsLog( LOG_DEBUG, "mapSharedMemoryAt: failed to map shared memory object [%s] at [%p]. Exception caught [%s]", shared_memory_name.c_str(), _address, e.what() );
+        return NULL;
+    }
+}
+
+int unmapSharedMemory( unsigned char *_address ) {
+    return mapped_at.erase( _address ) > 0 ? 1 : 0;
+}
+
 irods::error getSharedMemoryName( const std::string& _key, std::string &shared_memory_name ) {
     try {
         const auto& shared_memory_name_salt = irods::get_server_property<const std::string>(irods::CFG_RE_CACHE_SALT_KW);
@@ -0,0 +1,9 @@
+set(IRODS_TEST_TARGET irods_bulk_registration_sql)
+
+set(IRODS_TEST_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                            ${CMAKE_CURRENT_SOURCE_DIR}/src/test_bulk_registration_sql.cpp)
+
+set(IRODS_TEST_INCLUDE_PATH ${CMAKE_SOURCE_DIR}/plugins/database/include
+                            ${CMAKE_BINARY_DIR}/lib/core/include
+                            ${CMAKE_SOURCE_DIR}/lib/core/include
+                            ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include)
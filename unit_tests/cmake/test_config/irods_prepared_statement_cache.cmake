@@ -0,0 +1,7 @@
+set(IRODS_TEST_TARGET irods_prepared_statement_cache)
+
+set(IRODS_TEST_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                            ${CMAKE_CURRENT_SOURCE_DIR}/src/test_prepared_statement_cache.cpp)
+
+set(IRODS_TEST_INCLUDE_PATH ${CMAKE_SOURCE_DIR}/plugins/database/include
+                            ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include)
@@ -0,0 +1,52 @@
+set(IRODS_TEST_TARGET irods_rule_language_dispatch)
+
+set(IRODS_RULE_LANGUAGE_SOURCE_DIR ${CMAKE_SOURCE_DIR}/plugins/rule_engines/irods_rule_engine_plugin-irods_rule_language)
+
+set(IRODS_TEST_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                            ${CMAKE_CURRENT_SOURCE_DIR}/src/test_rule_language_dispatch.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/arithmetics.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/astCache.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/cache.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/configuration.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/conversion.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/datetime.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/filesystem.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/functions.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/index.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/libirods_rule_engine_plugin-irods_rule_language.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/msiHelper.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/nre.reHelpers1.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/nre.reHelpers2.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/nre.reLib1.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/parser.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/reVariableMap.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/reVariableMap.gen.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/reVariableMap.table.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/restructs.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/rsRe.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/rules.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/typing.cpp
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/utils.cpp)
+
+set(IRODS_TEST_INCLUDE_PATH ${CMAKE_BINARY_DIR}/lib/core/include
+                            ${CMAKE_SOURCE_DIR}/lib/api/include
+                            ${CMAKE_SOURCE_DIR}/lib/core/include
+                            ${CMAKE_SOURCE_DIR}/lib/hasher/include
+                            ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/include
+                            ${CMAKE_SOURCE_DIR}/server/api/include
+                            ${CMAKE_SOURCE_DIR}/server/core/include
+                            ${CMAKE_SOURCE_DIR}/server/drivers/include
+                            ${CMAKE_SOURCE_DIR}/server/icat/include
+                            ${CMAKE_SOURCE_DIR}/server/re/include
+                            ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include
+                            ${IRODS_EXTERNALS_FULLPATH_BOOST}/include
+                            ${IRODS_EXTERNALS_FULLPATH_FMT}/include
+                            ${OPENSSL_INCLUDE_DIR})
+
+set(IRODS_TEST_LINK_LIBRARIES irods_server
+                              irods_common
+                              ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_filesystem.so
+                              ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_system.so
+                              ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_regex.so
+                              ${IRODS_EXTERNALS_FULLPATH_FMT}/lib/libfmt.so
+                              dl)
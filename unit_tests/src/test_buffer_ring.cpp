@@ -0,0 +1,280 @@
+#include "catch.hpp"
+
+#include "buffer_ring.hpp"
+#include "irods_buffer_encryption.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace ix = irods::experimental;
+
+namespace
+{
+    constexpr std::size_t buffer_size = 1024 * 1024;
+    constexpr std::size_t transfer_size = 8 * 1024 * 1024;
+
+    // A connected pair of TCP sockets on the loopback interface.
+    struct loopback_connection
+    {
+        loopback_connection()
+        {
+            const int listener = socket(AF_INET, SOCK_STREAM, 0);
+            REQUIRE(listener >= 0);
+
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t addr_size = sizeof(addr);
+
+            REQUIRE(bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+            REQUIRE(listen(listener, 1) == 0);
+            REQUIRE(getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_size) == 0);
+
+            sender = socket(AF_INET, SOCK_STREAM, 0);
+            REQUIRE(connect(sender, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+            receiver = accept(listener, nullptr, nullptr);
+            REQUIRE(receiver >= 0);
+
+            close(listener);
+        }
+
+        ~loopback_connection()
+        {
+            close(sender);
+            close(receiver);
+        }
+
+        int sender;
+        int receiver;
+    };
+
+    auto read_fully(int _fd, unsigned char* _buf, std::size_t _size) -> std::size_t
+    {
+        std::size_t total = 0;
+
+        while (total < _size) {
+            const auto n = read(_fd, _buf + total, _size - total);
+            if (n <= 0) {
+                break;
+            }
+            total += n;
+        }
+
+        return total;
+    }
+
+    // Writes the whole buffer at _offset, retrying after short writes.
+    auto pwrite_fully(int _fd, const unsigned char* _buf, std::size_t _size, off_t _offset) -> bool
+    {
+        while (_size > 0) {
+            const auto n = pwrite(_fd, _buf, _size, _offset);
+            if (n < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                return false;
+            }
+            _buf += n;
+            _size -= n;
+            _offset += n;
+        }
+
+        return true;
+    }
+
+    // Sends the transfer from a separate thread, the way a client would.
+    auto start_sender(int _fd) -> std::thread
+    {
+        return std::thread{[_fd] {
+            std::vector<unsigned char> data(buffer_size, 'x');
+
+            for (std::size_t sent = 0; sent < transfer_size;) {
+                const auto n = write(_fd, data.data(), std::min(data.size(), transfer_size - sent));
+                if (n <= 0) {
+                    return;
+                }
+                sent += n;
+            }
+        }};
+    }
+} // anonymous namespace
+
+TEST_CASE("buffer_ring")
+{
+    ix::buffer_ring ring{3, 1000};
+
+    REQUIRE(ring.size() == 3);
+
+    SECTION("buffers are aligned and reused")
+    {
+        auto* b = ring.acquire_empty();
+        REQUIRE(b);
+        CHECK(b->capacity >= 1000);
+        CHECK(reinterpret_cast<std::uintptr_t>(b->data) % ix::buffer_ring::default_alignment == 0);
+
+        ring.submit(b);
+        CHECK(ring.acquire_filled() == b);
+        ring.release(b);
+
+        std::vector<ix::buffer_ring::buffer*> buffers;
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            buffers.push_back(ring.acquire_empty());
+        }
+
+        CHECK(std::find(buffers.begin(), buffers.end(), b) != buffers.end());
+    }
+
+    SECTION("buffers are consumed in order and drained after finish")
+    {
+        constexpr int count = 1000;
+
+        std::thread producer{[&ring] {
+            for (int i = 0; i < count; ++i) {
+                auto* b = ring.acquire_empty();
+                b->offset = i;
+                ring.submit(b);
+            }
+            ring.finish();
+        }};
+
+        std::vector<rodsLong_t> offsets;
+        while (auto* b = ring.acquire_filled()) {
+            offsets.push_back(b->offset);
+            ring.release(b);
+        }
+
+        producer.join();
+
+        std::vector<rodsLong_t> expected(count);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK(offsets == expected);
+    }
+
+    SECTION("cancel wakes a blocked producer and consumer")
+    {
+        std::thread producer{[&ring] {
+            while (auto* b = ring.acquire_empty()) {
+                ring.submit(b);
+            }
+        }};
+
+        // The producer blocks once every buffer has been submitted.
+        auto* b = ring.acquire_filled();
+        REQUIRE(b);
+        ring.cancel();
+
+        producer.join();
+        CHECK(ring.cancelled());
+        CHECK_FALSE(ring.acquire_filled());
+        CHECK_FALSE(ring.acquire_empty());
+    }
+}
+
+TEST_CASE("buffer_crypt encrypts into caller owned memory")
+{
+    irods::buffer_crypt crypt{32, 8, 16, "AES-256-CBC"};
+
+    irods::buffer_crypt::array_t key;
+    irods::buffer_crypt::array_t iv;
+    REQUIRE(irods::buffer_crypt::generate_key(key, crypt.key_size()).ok());
+    REQUIRE(crypt.initialization_vector(iv).ok());
+
+    const irods::buffer_crypt::array_t plain(10000, 'p');
+
+    std::vector<unsigned char> cipher(plain.size() + EVP_MAX_BLOCK_LENGTH);
+    int cipher_size = 0;
+    REQUIRE(crypt.encrypt(key, iv, plain.data(), plain.size(), cipher.data(), cipher_size).ok());
+
+    // The vector and pointer interfaces produce the same cipher text.
+    irods::buffer_crypt::array_t expected_cipher;
+    REQUIRE(crypt.encrypt(key, iv, plain, expected_cipher).ok());
+    CHECK(std::equal(expected_cipher.begin(), expected_cipher.end(), cipher.begin(), cipher.begin() + cipher_size));
+
+    std::vector<unsigned char> decrypted(cipher_size + EVP_MAX_BLOCK_LENGTH);
+    int decrypted_size = 0;
+    REQUIRE(crypt.decrypt(key, iv, cipher.data(), cipher_size, decrypted.data(), decrypted_size).ok());
+    CHECK(std::equal(plain.begin(), plain.end(), decrypted.begin(), decrypted.begin() + decrypted_size));
+}
+
+TEST_CASE("buffer_ring loopback throughput benchmark", "[.benchmark]")
+{
+    auto* file = std::tmpfile();
+    REQUIRE(file);
+    const int file_fd = fileno(file);
+
+    // Receives a buffer and then writes it, like the synchronous portal threads.
+    BENCHMARK("8 MiB, synchronous")
+    {
+        loopback_connection conn;
+        auto sender = start_sender(conn.sender);
+
+        std::vector<unsigned char> buf(buffer_size);
+        std::size_t total = 0;
+        bool written = true;
+
+        while (total < transfer_size) {
+            const auto n = read_fully(conn.receiver, buf.data(), std::min(buf.size(), transfer_size - total));
+            if (n == 0) {
+                break;
+            }
+            written = pwrite_fully(file_fd, buf.data(), n, total) && written;
+            total += n;
+        }
+
+        sender.join();
+        REQUIRE(written);
+        REQUIRE(total == transfer_size);
+        return total;
+    };
+
+    // Receives into the ring on one thread while another thread writes.
+    BENCHMARK("8 MiB, pipelined")
+    {
+        loopback_connection conn;
+        auto sender = start_sender(conn.sender);
+
+        ix::buffer_ring ring{2, buffer_size};
+
+        std::thread receiver{[&] {
+            for (std::size_t total = 0; total < transfer_size;) {
+                auto* b = ring.acquire_empty();
+                b->offset = total;
+                b->size = read_fully(conn.receiver, b->data, std::min(b->capacity, transfer_size - total));
+                if (b->size == 0) {
+                    ring.release(b);
+                    break;
+                }
+                total += b->size;
+                ring.submit(b);
+            }
+            ring.finish();
+        }};
+
+        std::size_t total = 0;
+        bool written = true;
+
+        while (auto* b = ring.acquire_filled()) {
+            written = pwrite_fully(file_fd, b->data, b->size, b->offset) && written;
+            total += b->size;
+            ring.release(b);
+        }
+
+        receiver.join();
+        sender.join();
+        REQUIRE(written);
+        REQUIRE(total == transfer_size);
+        return total;
+    };
+
+    std::fclose(file);
+}
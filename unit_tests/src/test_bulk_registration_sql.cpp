@@ -0,0 +1,175 @@
+#include "catch.hpp"
+
+#include "bulk_registration_sql.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bulk = irods::experimental::bulk_registration;
+
+namespace
+{
+    auto count_of(const std::string& _str, const std::string& _token) -> int
+    {
+        int n = 0;
+        for (auto pos = _str.find(_token); pos != std::string::npos; pos = _str.find(_token, pos + _token.size())) {
+            ++n;
+        }
+        return n;
+    }
+
+    // Lays out _values the way cmlGetMultiRowStringValuesFromSql returns them.
+    auto to_slots(const std::vector<std::string>& _values, int _width) -> std::vector<char>
+    {
+        std::vector<char> slots(_values.size() * _width, '\0');
+        for (std::size_t i = 0; i < _values.size(); ++i) {
+            std::copy(std::begin(_values[i]), std::end(_values[i]), &slots[i * _width]);
+        }
+        return slots;
+    }
+} // anonymous namespace
+
+TEST_CASE("bulk registration chunks")
+{
+    std::vector<std::pair<int, int>> chunks;
+    const auto record = [&chunks](int _offset, int _n) {
+        chunks.emplace_back(_offset, _n);
+        return 0;
+    };
+
+    SECTION("rows are split into statements of at most the chunk size")
+    {
+        CHECK(bulk::for_each_chunk(250, 100, record) == 0);
+        CHECK(chunks == std::vector<std::pair<int, int>>{{0, 100}, {100, 100}, {200, 50}});
+    }
+
+    SECTION("a batch which fills its last statement exactly")
+    {
+        bulk::for_each_chunk(200, 100, record);
+        CHECK(chunks == std::vector<std::pair<int, int>>{{0, 100}, {100, 100}});
+    }
+
+    SECTION("one row per statement")
+    {
+        bulk::for_each_chunk(3, 1, record);
+        CHECK(chunks == std::vector<std::pair<int, int>>{{0, 1}, {1, 1}, {2, 1}});
+    }
+
+    SECTION("no rows means no statements")
+    {
+        bulk::for_each_chunk(0, 100, record);
+        CHECK(chunks.empty());
+    }
+
+    SECTION("the first failure stops the batch")
+    {
+        const auto fail_second = [&chunks](int _offset, int _n) {
+            chunks.emplace_back(_offset, _n);
+            return chunks.size() == 2 ? -806000 : 0;
+        };
+
+        CHECK(bulk::for_each_chunk(300, 100, fail_second) == -806000);
+        CHECK(chunks.size() == 2);
+    }
+}
+
+TEST_CASE("bulk registration multi-row inserts")
+{
+    SECTION("placeholders")
+    {
+        CHECK(bulk::placeholder_list(1) == "?");
+        CHECK(bulk::placeholder_list(3) == "?, ?, ?");
+        CHECK(bulk::values_list(1, 2) == "(?, ?)");
+        CHECK(bulk::values_list(3, 2) == "(?, ?), (?, ?), (?, ?)");
+    }
+
+    SECTION("R_DATA_MAIN binds one group of values per data object")
+    {
+        for (int rows : {1, 2, bulk::rows_per_statement}) {
+            const auto sql = bulk::insert_data_objects_sql(rows);
+
+            CHECK(sql.rfind("insert into R_DATA_MAIN (data_id, coll_id, data_name,", 0) == 0);
+            CHECK(count_of(sql, "?") == rows * bulk::data_object_columns);
+            CHECK(count_of(sql, "), (") == rows - 1);
+        }
+
+        // The column list and the values of each row must agree.
+        const auto sql = bulk::insert_data_objects_sql(1);
+        const auto columns = sql.substr(0, sql.find(" values "));
+        CHECK(count_of(columns, ",") + 1 == bulk::data_object_columns);
+    }
+
+    SECTION("R_OBJT_ACCESS owner rows")
+    {
+        const auto sql = bulk::insert_owner_access_sql(4);
+
+        CHECK(sql.rfind("insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts) values ", 0) == 0);
+        CHECK(count_of(sql, "?") == 4 * bulk::access_columns);
+    }
+
+    SECTION("existing collections are looked up for all data objects at once")
+    {
+        CHECK(bulk::find_collections_sql(3) == "select coll_name from R_COLL_MAIN where coll_name in (?, ?, ?)");
+    }
+}
+
+TEST_CASE("bulk registration inherited access")
+{
+    const auto sql = bulk::insert_inherited_access_sql(3);
+
+    // One INSERT ... SELECT copies the access rows of each parent collection.
+    CHECK(sql ==
+          "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts) "
+          "(select d.data_id, a.user_id, a.access_type_id, ?, ? from R_DATA_MAIN d, R_OBJT_ACCESS a "
+          "where a.object_id = d.coll_id and d.data_id in (?, ?, ?))");
+
+    // The two timestamps come first, then one id per data object.
+    CHECK(count_of(sql, "?") == 2 + 3);
+    CHECK(count_of(bulk::insert_inherited_access_sql(bulk::rows_per_statement), "?") == 2 + bulk::rows_per_statement);
+}
+
+TEST_CASE("bulk registration reserved ids")
+{
+    constexpr int width = 33;
+
+    SECTION("the query reserves exactly the requested number of values")
+    {
+        const auto sql = bulk::reserve_sequence_values_sql("nextval('R_ObjectID')", 250);
+#ifdef ORA_ICAT
+        CHECK(sql == "select nextval('R_ObjectID') from DUAL connect by level <= 250");
+#else
+        CHECK(sql == "select nextval('R_ObjectID') from generate_series(1, 250)");
+#endif
+    }
+
+    SECTION("each data object receives its own id in order")
+    {
+        const auto slots = to_slots({"10010", "10011", "10013"}, width);
+
+        std::vector<rodsLong_t> ids;
+        REQUIRE(bulk::parse_sequence_values(slots.data(), width, 3, ids));
+        CHECK(ids == std::vector<rodsLong_t>{10010, 10011, 10013});
+    }
+
+    SECTION("values outside the id range are rejected")
+    {
+        std::vector<rodsLong_t> ids;
+
+        for (const char* bad : {"0", "-5", "", "12ab"}) {
+            const auto slots = to_slots({"10010", bad}, width);
+            CHECK_FALSE(bulk::parse_sequence_values(slots.data(), width, 2, ids));
+            CHECK(ids.empty());
+        }
+    }
+
+    SECTION("an id is never handed out twice")
+    {
+        const auto slots = to_slots({"10010", "10011", "10010"}, width);
+
+        std::vector<rodsLong_t> ids;
+        CHECK_FALSE(bulk::parse_sequence_values(slots.data(), width, 3, ids));
+        CHECK(ids.empty());
+    }
+}
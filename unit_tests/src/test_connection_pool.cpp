@@ -5,6 +5,13 @@
 #include "filesystem.hpp"
 #include "irods_at_scope_exit.hpp"
 
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
 TEST_CASE("connection pool")
 {
     rodsEnv env;
@@ -104,5 +111,98 @@ TEST_CASE("connection pool")
 
         REQUIRE(released_conn_ptr);
     }
-}
 
+    SECTION("checkouts time out when every connection is in use")
+    {
+        auto conn_pool = irods::make_connection_pool();
+
+        auto conn = conn_pool->get_connection();
+        REQUIRE(conn);
+
+        auto other = conn_pool->try_get_connection(50ms);
+        REQUIRE_FALSE(other);
+
+        const auto stats = conn_pool->get_statistics();
+        REQUIRE(stats.timeouts == 1);
+        REQUIRE(stats.waits == 1);
+        REQUIRE(stats.in_use == 1);
+        REQUIRE(stats.waiting == 0);
+        REQUIRE(stats.max_wait_time >= 50ms);
+
+        // The connection is handed out again once it is returned.
+        conn = {};
+        REQUIRE(conn_pool->try_get_connection(50ms));
+    }
+
+    SECTION("waiting threads are served in the order they arrived")
+    {
+        auto conn_pool = irods::make_connection_pool();
+        auto conn = conn_pool->get_connection();
+
+        std::mutex mutex;
+        std::vector<int> order;
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&, i] {
+                auto c = conn_pool->get_connection();
+                std::lock_guard lock{mutex};
+                order.push_back(i);
+            });
+
+            // Wait until the thread is queued before starting the next one.
+            while (conn_pool->get_statistics().waiting != i + 1) {
+                std::this_thread::sleep_for(1ms);
+            }
+        }
+
+        conn = {};
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        REQUIRE(order == std::vector<int>{0, 1, 2, 3});
+    }
+
+    SECTION("the pool grows on demand and closes idle connections")
+    {
+        irods::connection_pool_options options;
+        options.min_size = 1;
+        options.max_size = 3;
+        options.idle_timeout = 1s;
+        options.maintenance_interval = 1s;
+
+        auto conn_pool = irods::make_connection_pool(options);
+        REQUIRE(conn_pool->get_statistics().open == 1);
+
+        {
+            std::vector<irods::connection_pool::connection_proxy> conns;
+            for (int i = 0; i < options.max_size; ++i) {
+                conns.push_back(conn_pool->get_connection());
+                REQUIRE(conns.back());
+            }
+
+            const auto stats = conn_pool->get_statistics();
+            REQUIRE(stats.open == 3);
+            REQUIRE(stats.in_use == 3);
+            REQUIRE(stats.waits == 0);
+
+            REQUIRE_FALSE(conn_pool->try_get_connection(10ms));
+        }
+
+        REQUIRE(conn_pool->get_statistics().in_use == 0);
+
+        // Give the maintenance thread time to close the connections above the minimum.
+        std::this_thread::sleep_for(3500ms);
+
+        const auto stats = conn_pool->get_statistics();
+        REQUIRE(stats.open == options.min_size);
+        REQUIRE(stats.health_check_failures == 0);
+
+        namespace fs = irods::experimental::filesystem;
+
+        auto conn = conn_pool->get_connection();
+        REQUIRE(fs::client::exists(conn, env.rodsHome));
+    }
+}
@@ -0,0 +1,78 @@
+#include "catch.hpp"
+
+#include "irods_delay_queue.hpp"
+#include "delay_server_notification.hpp"
+
+#include <string>
+
+#include <unistd.h>
+
+namespace ds = irods::experimental::delay_server;
+
+TEST_CASE("delay queue")
+{
+    irods::delay_queue queue;
+
+    CHECK(queue.enqueue_rule("10001"));
+    CHECK(queue.enqueue_rule("10002"));
+    CHECK(queue.size() == 2);
+
+    SECTION("rules cannot be enqueued twice")
+    {
+        CHECK_FALSE(queue.enqueue_rule("10001"));
+        CHECK(queue.size() == 2);
+    }
+
+    SECTION("dequeued rules can be enqueued again")
+    {
+        queue.dequeue_rule("10001");
+        CHECK_FALSE(queue.contains_rule_id("10001"));
+        CHECK(queue.contains_rule_id("10002"));
+
+        CHECK(queue.enqueue_rule("10001"));
+        CHECK(queue.contains_rule_id("10001"));
+    }
+
+    SECTION("dequeueing an unknown rule is harmless")
+    {
+        queue.dequeue_rule("99999");
+        CHECK(queue.size() == 2);
+    }
+}
+
+TEST_CASE("delay server notifications")
+{
+    const int sock = ds::open_notification_socket();
+    REQUIRE(sock >= 0);
+
+    SECTION("no notification results in a timeout")
+    {
+        CHECK_FALSE(ds::wait_for_notification(sock, 10));
+    }
+
+    SECTION("notifications wake the listener")
+    {
+        REQUIRE(ds::notify());
+        CHECK(ds::wait_for_notification(sock, 1000));
+    }
+
+    SECTION("a burst of notifications results in a single wake-up")
+    {
+        for (int i = 0; i < 100; ++i) {
+            ds::notify();
+        }
+
+        CHECK(ds::wait_for_notification(sock, 1000));
+        CHECK_FALSE(ds::wait_for_notification(sock, 10));
+    }
+
+    SECTION("only one listener can exist")
+    {
+        CHECK(ds::open_notification_socket() < 0);
+    }
+
+    close(sock);
+
+    // Notifications without a listener are dropped.
+    CHECK_FALSE(ds::notify());
+}
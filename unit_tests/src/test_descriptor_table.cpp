@@ -0,0 +1,122 @@
+#include "catch.hpp"
+
+#include "descriptor_table.hpp"
+
+#include <set>
+#include <vector>
+
+namespace
+{
+    struct descriptor
+    {
+        int in_use;
+        int value;
+    };
+} // anonymous namespace
+
+using descriptor_table = irods::experimental::descriptor_table<descriptor>;
+
+TEST_CASE("descriptor_table starts out empty")
+{
+    descriptor_table table{3, 4};
+
+    CHECK(table.size() == 0);
+    CHECK_FALSE(table.in_range(0));
+    CHECK_FALSE(table.in_range(3));
+    CHECK_FALSE(table.is_allocated(3));
+}
+
+TEST_CASE("descriptor_table hands out the lowest free index first and skips reserved indices")
+{
+    descriptor_table table{3, 4};
+
+    CHECK(table.allocate() == 3);
+    CHECK(table.size() == 4);
+
+    // The next allocation grows the table.
+    CHECK(table.allocate() == 4);
+    CHECK(table.allocate() == 5);
+    CHECK(table.size() == 8);
+
+    CHECK_FALSE(table.in_range(2));
+    CHECK(table.in_range(7));
+    CHECK_FALSE(table.in_range(8));
+    CHECK_FALSE(table.in_range(-1));
+}
+
+TEST_CASE("descriptor_table grows past a chunk made up of reserved indices")
+{
+    descriptor_table table{5, 2};
+
+    CHECK(table.allocate() == 5);
+    CHECK(table.size() == 6);
+}
+
+TEST_CASE("descriptor_table reuses released indices")
+{
+    descriptor_table table{0, 8};
+
+    const auto a = table.allocate();
+    const auto b = table.allocate();
+    const auto c = table.allocate();
+
+    CHECK(table.is_allocated(b));
+    CHECK(table.release(b));
+    CHECK_FALSE(table.is_allocated(b));
+
+    // Releasing twice is rejected and does not put the index on the free list again.
+    CHECK_FALSE(table.release(b));
+
+    CHECK(table.allocate() == b);
+    CHECK(table.allocate() == c + 1);
+
+    CHECK(table.is_allocated(a));
+    CHECK_FALSE(table.release(static_cast<int>(table.size())));
+}
+
+TEST_CASE("descriptor_table value-initializes new descriptors")
+{
+    descriptor_table table{0, 4};
+
+    for (int i = 0; i < 10; ++i) {
+        const auto index = table.allocate();
+        CHECK(table[index].in_use == 0);
+        CHECK(table[index].value == 0);
+    }
+}
+
+TEST_CASE("descriptor_table references stay valid while the table grows")
+{
+    descriptor_table table{0, 2};
+
+    const auto first = table.allocate();
+    auto& d = table[first];
+    d.value = 42;
+
+    std::vector<int> indices;
+    for (int i = 0; i < 100; ++i) {
+        indices.push_back(table.allocate());
+    }
+
+    CHECK(&table[first] == &d);
+    CHECK(d.value == 42);
+
+    const std::set<int> unique(indices.begin(), indices.end());
+    CHECK(unique.size() == indices.size());
+    CHECK(unique.count(first) == 0);
+}
+
+TEST_CASE("descriptor_table clear discards every descriptor")
+{
+    descriptor_table table{1, 4};
+
+    const auto index = table.allocate();
+    table[index].value = 7;
+    table.clear();
+
+    CHECK(table.size() == 0);
+    CHECK_FALSE(table.is_allocated(index));
+
+    CHECK(table.allocate() == 1);
+    CHECK(table[1].value == 0);
+}
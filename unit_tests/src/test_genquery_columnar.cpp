@@ -0,0 +1,305 @@
+#include <catch.hpp>
+
+#include "genquery_columnar.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "packStruct.h"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsGenQuery.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gq = irods::experimental::genquery;
+
+namespace
+{
+    // Returns a page in the fixed-width format holding _row_count rows of three columns.
+    // The first column is unique per row, the second holds a single repeated value and the
+    // third holds a long value that is unique per row.
+    auto make_gen_query_out(int _row_count, int _first_row = 0) -> genQueryOut_t
+    {
+        genQueryOut_t output{};
+        output.rowCnt = _row_count;
+        output.attriCnt = 3;
+
+        const int attribute_indexes[] = {COL_DATA_NAME, COL_D_RESC_NAME, COL_D_DATA_PATH};
+
+        for (int i = 0; i < output.attriCnt; ++i) {
+            auto& column = output.sqlResult[i];
+            column.attriInx = attribute_indexes[i];
+            column.len = COL_D_DATA_PATH == column.attriInx ? MAX_NAME_LEN : NAME_LEN;
+            column.value = static_cast<char*>(std::calloc(_row_count, column.len));
+
+            for (int row = 0; row < _row_count; ++row) {
+                const auto n = std::to_string(_first_row + row);
+                std::string value;
+
+                switch (column.attriInx) {
+                    case COL_DATA_NAME:   value = "file_" + n; break;
+                    case COL_D_RESC_NAME: value = "demoResc"; break;
+                    default:              value = "/var/lib/irods/Vault/home/rods/collection/file_" + n; break;
+                }
+
+                std::strncpy(column.value + row * column.len, value.c_str(), column.len - 1);
+            }
+        }
+
+        return output;
+    }
+
+    auto pack(const void* _input, const char* _pack_instruction, irodsProt_t _protocol) -> std::string
+    {
+        BytesBuf* packed_result = nullptr;
+        irods::at_scope_exit free_packed_result{[&packed_result] { freeBBuf(packed_result); }};
+
+        REQUIRE(pack_struct(_input, &packed_result, _pack_instruction, nullptr, 0, _protocol, nullptr) == 0);
+        REQUIRE(packed_result);
+
+        return {static_cast<const char*>(packed_result->buf), static_cast<std::size_t>(packed_result->len)};
+    }
+
+    auto check_rows_are_equal(const genQueryOut_t& _expected, const genQueryColumnarOut_t& _actual) -> void
+    {
+        REQUIRE(_actual.rowCnt == _expected.rowCnt);
+        REQUIRE(_actual.attriCnt == _expected.attriCnt);
+
+        for (int row = 0; row < _expected.rowCnt; ++row) {
+            const gq::row_view expected{_expected, row};
+            const gq::row_view actual{_actual, row};
+
+            REQUIRE(actual.size() == expected.size());
+
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                CHECK(actual.attribute_index(i) == expected.attribute_index(i));
+                CHECK(actual[i] == expected[i]);
+                CHECK(std::string_view{getGenQueryColumnValue(&_actual.columns[i], row)} == expected[i]);
+            }
+        }
+    }
+} // anonymous namespace
+
+TEST_CASE("columnar_page_builder")
+{
+    auto page = make_gen_query_out(64);
+    irods::at_scope_exit clear_page{[&page] { clearGenQueryOut(&page); }};
+
+    gq::columnar_page_builder builder;
+
+    SECTION("single page")
+    {
+        REQUIRE(builder.append(page) == 0);
+        CHECK(builder.row_count() == page.rowCnt);
+
+        genQueryColumnarOut_t output{};
+        irods::at_scope_exit clear_output{[&output] { clearGenQueryColumnarOut(&output); }};
+
+        REQUIRE(builder.release(output) == 0);
+        CHECK(builder.row_count() == 0);
+        CHECK(builder.byte_count() == 0);
+
+        check_rows_are_equal(page, output);
+
+        // Only the column holding a single repeated value is dictionary encoded.
+        CHECK(getGenQueryColumnByInx(&output, COL_DATA_NAME)->encoding == GEN_QUERY_COLUMN_PLAIN);
+        CHECK(getGenQueryColumnByInx(&output, COL_D_DATA_PATH)->encoding == GEN_QUERY_COLUMN_PLAIN);
+
+        const auto* resc_name = getGenQueryColumnByInx(&output, COL_D_RESC_NAME);
+        REQUIRE(resc_name);
+        CHECK(resc_name->encoding == GEN_QUERY_COLUMN_DICT);
+        CHECK(resc_name->offsetCnt == 1);
+        CHECK(resc_name->codeCnt == page.rowCnt);
+
+        CHECK(getGenQueryColumnByInx(&output, COL_COLL_NAME) == nullptr);
+        CHECK(getGenQueryColumnValue(resc_name, page.rowCnt) == nullptr);
+        CHECK(getGenQueryColumnValue(resc_name, -1) == nullptr);
+    }
+
+    SECTION("several pages")
+    {
+        auto second_page = make_gen_query_out(16, page.rowCnt);
+        irods::at_scope_exit clear_second_page{[&second_page] { clearGenQueryOut(&second_page); }};
+
+        REQUIRE(builder.append(page) == 0);
+        REQUIRE(builder.append(second_page) == 0);
+        CHECK(builder.row_count() == page.rowCnt + second_page.rowCnt);
+
+        genQueryColumnarOut_t output{};
+        irods::at_scope_exit clear_output{[&output] { clearGenQueryColumnarOut(&output); }};
+
+        REQUIRE(builder.release(output) == 0);
+        REQUIRE(output.rowCnt == page.rowCnt + second_page.rowCnt);
+
+        for (int row = 0; row < output.rowCnt; ++row) {
+            const gq::row_view actual{output, row};
+            const gq::row_view expected = row < page.rowCnt ? gq::row_view{page, row}
+                                                            : gq::row_view{second_page, row - page.rowCnt};
+            CHECK(actual.to_vector() == expected.to_vector());
+        }
+    }
+
+    SECTION("pages with different columns are rejected")
+    {
+        REQUIRE(builder.append(page) == 0);
+
+        auto other_page = make_gen_query_out(1);
+        irods::at_scope_exit clear_other_page{[&other_page] { clearGenQueryOut(&other_page); }};
+
+        other_page.sqlResult[0].attriInx = COL_COLL_NAME;
+        CHECK(builder.append(other_page) == SYS_INVALID_INPUT_PARAM);
+
+        other_page.sqlResult[0].attriInx = COL_DATA_NAME;
+        other_page.attriCnt = 2;
+        CHECK(builder.append(other_page) == SYS_INVALID_INPUT_PARAM);
+        other_page.attriCnt = 3;
+    }
+
+    SECTION("empty page")
+    {
+        genQueryColumnarOut_t output{};
+        irods::at_scope_exit clear_output{[&output] { clearGenQueryColumnarOut(&output); }};
+
+        REQUIRE(builder.release(output) == 0);
+        CHECK(output.rowCnt == 0);
+        CHECK(output.attriCnt == 0);
+        CHECK(output.columns == nullptr);
+    }
+}
+
+TEST_CASE("row_view")
+{
+    auto page = make_gen_query_out(2);
+    irods::at_scope_exit clear_page{[&page] { clearGenQueryOut(&page); }};
+
+    const gq::row_view row{page, 1};
+
+    CHECK(row.size() == 3);
+    CHECK(row.attribute_index(0) == COL_DATA_NAME);
+    CHECK(row[0] == "file_1");
+    CHECK(row.at(1) == "demoResc");
+    CHECK_THROWS_AS(row.at(3), std::out_of_range);
+}
+
+TEST_CASE("GenQueryColumnarOut_PI")
+{
+    auto page = make_gen_query_out(MAX_SQL_ROWS);
+    irods::at_scope_exit clear_page{[&page] { clearGenQueryOut(&page); }};
+
+    gq::columnar_page_builder builder;
+    REQUIRE(builder.append(page) == 0);
+
+    genQueryColumnarOut_t output{};
+    irods::at_scope_exit clear_output{[&output] { clearGenQueryColumnarOut(&output); }};
+    REQUIRE(builder.release(output) == 0);
+    output.continueInx = 7;
+
+    for (const auto protocol : {NATIVE_PROT, XML_PROT}) {
+        const auto packed = pack(&output, "GenQueryColumnarOut_PI", protocol);
+
+        genQueryColumnarOut_t* unpacked = nullptr;
+        irods::at_scope_exit free_unpacked{[&unpacked] { freeGenQueryColumnarOut(&unpacked); }};
+
+        REQUIRE(unpack_struct(packed.data(), (void**) &unpacked, "GenQueryColumnarOut_PI", nullptr, protocol, nullptr) == 0);
+        REQUIRE(unpacked);
+        CHECK(unpacked->continueInx == output.continueInx);
+        CHECK(validateGenQueryColumnarOut(unpacked) == 0);
+
+        check_rows_are_equal(page, *unpacked);
+    }
+
+    // Both protocols send the values of a genQueryOut_t without their padding, so only the
+    // unpacked page shrinks by dropping it.
+    std::size_t fixed_width_size = 0;
+    for (int i = 0; i < page.attriCnt; ++i) {
+        fixed_width_size += static_cast<std::size_t>(page.rowCnt) * page.sqlResult[i].len;
+    }
+
+    std::size_t columnar_size = 0;
+    for (int i = 0; i < output.attriCnt; ++i) {
+        const auto& column = output.columns[i];
+        columnar_size += (column.offsetCnt + column.codeCnt) * sizeof(int) + column.byteCnt;
+    }
+
+    CHECK(columnar_size < fixed_width_size / 4);
+}
+
+TEST_CASE("validateGenQueryColumnarOut")
+{
+    auto page = make_gen_query_out(8);
+    irods::at_scope_exit clear_page{[&page] { clearGenQueryOut(&page); }};
+
+    gq::columnar_page_builder builder;
+    REQUIRE(builder.append(page) == 0);
+
+    genQueryColumnarOut_t output{};
+    irods::at_scope_exit clear_output{[&output] { clearGenQueryColumnarOut(&output); }};
+    REQUIRE(builder.release(output) == 0);
+
+    REQUIRE(validateGenQueryColumnarOut(&output) == 0);
+    CHECK(validateGenQueryColumnarOut(nullptr) == SYS_INVALID_INPUT_PARAM);
+
+    auto& plain = *getGenQueryColumnByInx(&output, COL_DATA_NAME);
+    auto& dict = *getGenQueryColumnByInx(&output, COL_D_RESC_NAME);
+    REQUIRE(dict.encoding == GEN_QUERY_COLUMN_DICT);
+
+    // Each corruption is undone before the next one is tried.
+    const auto check_rejected = [&output](auto& _member, auto _bad_value) {
+        const auto good_value = _member;
+        _member = _bad_value;
+        CHECK(validateGenQueryColumnarOut(&output) == SYS_INVALID_INPUT_PARAM);
+        _member = good_value;
+        CHECK(validateGenQueryColumnarOut(&output) == 0);
+    };
+
+    check_rejected(output.rowCnt, output.rowCnt + 1);
+    check_rejected(output.attriCnt, MAX_SQL_ATTR + 1);
+    check_rejected(plain.encoding, 2);
+    check_rejected(plain.offsetCnt, plain.offsetCnt - 1);
+    check_rejected(plain.offsets[0], 1);
+    check_rejected(plain.offsets[2], plain.offsets[1]);
+    check_rejected(plain.offsets[2], plain.offsets[2] + 1);
+    check_rejected(plain.offsets[plain.offsetCnt - 1], plain.byteCnt);
+    check_rejected(plain.bytes[plain.byteCnt - 1], 'x');
+    check_rejected(dict.codeCnt, dict.codeCnt - 1);
+    check_rejected(dict.codes[3], dict.offsetCnt);
+    check_rejected(dict.codes[3], -1);
+
+    // getGenQueryColumnValue does not read outside of the column either.
+    const auto good_offset = plain.offsets[1];
+    plain.offsets[1] = plain.byteCnt;
+    CHECK(getGenQueryColumnValue(&plain, 1) == nullptr);
+    plain.offsets[1] = good_offset;
+}
+
+TEST_CASE("columnar page benchmark", "[.benchmark]")
+{
+    auto page = make_gen_query_out(MAX_SQL_ROWS);
+    irods::at_scope_exit clear_page{[&page] { clearGenQueryOut(&page); }};
+
+    constexpr int pages = 100;
+
+    BENCHMARK("pack GenQueryOut_PI")
+    {
+        for (int i = 0; i < pages; ++i) {
+            pack(&page, "GenQueryOut_PI", NATIVE_PROT);
+        }
+    };
+
+    BENCHMARK("build and pack GenQueryColumnarOut_PI")
+    {
+        gq::columnar_page_builder builder;
+
+        for (int i = 0; i < pages; ++i) {
+            builder.append(page);
+        }
+
+        genQueryColumnarOut_t output{};
+        irods::at_scope_exit clear_output{[&output] { clearGenQueryColumnarOut(&output); }};
+        builder.release(output);
+
+        return pack(&output, "GenQueryColumnarOut_PI", NATIVE_PROT).size();
+    };
+}
@@ -0,0 +1,103 @@
+#include "catch.hpp"
+
+#include "irods_hasher_factory.hpp"
+#include "MD5Strategy.hpp"
+#include "SHA1Strategy.hpp"
+#include "SHA256Strategy.hpp"
+#include "SHA512Strategy.hpp"
+#include "ADLER32Strategy.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    auto compute_digest(const std::string& _scheme, std::string_view _data, std::size_t _block_size) -> std::string
+    {
+        irods::Hasher hasher;
+        REQUIRE(irods::getHasher(_scheme, hasher).ok());
+
+        while (!_data.empty()) {
+            const auto n = std::min(_block_size, _data.size());
+            REQUIRE(hasher.update(_data.data(), n).ok());
+            _data.remove_prefix(n);
+        }
+
+        std::string digest;
+        REQUIRE(hasher.digest(digest).ok());
+
+        return digest;
+    }
+} // anonymous namespace
+
+TEST_CASE("hasher produces known digests")
+{
+    const std::string data = "The quick brown fox jumps over the lazy dog";
+
+    CHECK(compute_digest(irods::MD5_NAME, data, data.size()) == "9e107d9d372bb6826bd81d3542a419d6");
+    CHECK(compute_digest(irods::SHA1_NAME, data, data.size()) == "sha1:L9ThxnotKPzthJ7hu3bnORuT6xI=");
+    CHECK(compute_digest(irods::SHA256_NAME, data, data.size()) == "sha2:16j7swfXgJRpypq8sAguT41WUeRtPNt2LQLQvzfJ5ZI=");
+    CHECK(compute_digest(irods::SHA512_NAME, data, data.size()) ==
+          "sha512:B+VH2VhvanP3P7rAQ17XaVEhj7fQyNeIownXhUNru2Quk6JSqVTyORJUfR6KO17W4b/XCXghIz+gU489uFT+5g==");
+    CHECK(compute_digest(irods::ADLER32_NAME, data, data.size()) == "adler32:5bdc0fda");
+}
+
+TEST_CASE("hasher produces the same digest regardless of block size")
+{
+    std::vector<char> data(3 * 1024 * 1024 + 17);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>((i * 31) ^ (i >> 7));
+    }
+
+    const std::string_view view{data.data(), data.size()};
+
+    for (const auto& scheme : {irods::MD5_NAME, irods::SHA1_NAME, irods::SHA256_NAME, irods::SHA512_NAME, irods::ADLER32_NAME}) {
+        const auto expected = compute_digest(scheme, view, view.size());
+
+        for (std::size_t block_size : {1u, 4096u, 5553u, 1024u * 1024u}) {
+            // Hashing one byte at a time is slow, so only a prefix is compared.
+            if (block_size == 1) {
+                const auto prefix = view.substr(0, 20000);
+                CHECK(compute_digest(scheme, prefix, 1) == compute_digest(scheme, prefix, prefix.size()));
+                continue;
+            }
+
+            CHECK(compute_digest(scheme, view, block_size) == expected);
+        }
+    }
+}
+
+TEST_CASE("hasher rejects updates after the digest is generated")
+{
+    irods::Hasher hasher;
+    REQUIRE(irods::getHasher(irods::SHA256_NAME, hasher).ok());
+    REQUIRE(hasher.update("abc").ok());
+
+    std::string digest;
+    REQUIRE(hasher.digest(digest).ok());
+    CHECK(digest == "sha2:ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0=");
+
+    CHECK_FALSE(hasher.update("def").ok());
+
+    // Reinitializing the hasher starts a new digest.
+    REQUIRE(irods::getHasher(irods::SHA256_NAME, hasher).ok());
+    REQUIRE(hasher.update("abc").ok());
+
+    std::string second_digest;
+    REQUIRE(hasher.digest(second_digest).ok());
+    CHECK(second_digest == digest);
+}
+
+TEST_CASE("hasher benchmark", "[.benchmark]")
+{
+    std::vector<char> data(4 * 1024 * 1024, 'x');
+
+    for (const auto& scheme : {irods::MD5_NAME, irods::SHA256_NAME, irods::ADLER32_NAME}) {
+        BENCHMARK("4 MiB " + scheme)
+        {
+            return compute_digest(scheme, {data.data(), data.size()}, data.size());
+        };
+    }
+}
@@ -0,0 +1,209 @@
+#include "catch.hpp"
+
+#include "inline_checksum.hpp"
+#include "irods_hasher_factory.hpp"
+#include "irods_exception.hpp"
+#include "ADLER32Strategy.hpp"
+#include "MD5Strategy.hpp"
+#include "SHA256Strategy.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ix = irods::experimental;
+
+namespace
+{
+    auto make_data(std::size_t _size) -> std::vector<char>
+    {
+        std::vector<char> data(_size);
+        std::generate(std::begin(data), std::end(data), [i = 0u]() mutable { return static_cast<char>((i++ * 31) % 251); });
+        return data;
+    }
+
+    auto hash(const std::string& _scheme, const std::vector<char>& _data) -> std::string
+    {
+        irods::Hasher hasher;
+        REQUIRE(irods::getHasher(_scheme, hasher).ok());
+        REQUIRE(hasher.update(_data.data(), _data.size()).ok());
+
+        std::string digest;
+        REQUIRE(hasher.digest(digest).ok());
+
+        return digest;
+    }
+
+    // Feeds the stripe [_offset, _offset + _size) in chunks of _chunk_size bytes.
+    auto feed(ix::inline_checksum& _checksum,
+              int _stripe,
+              const std::vector<char>& _data,
+              std::size_t _offset,
+              std::size_t _size,
+              std::size_t _chunk_size) -> void
+    {
+        for (std::size_t n = 0; n < _size; n += _chunk_size) {
+            const auto count = std::min(_chunk_size, _size - n);
+            _checksum.update(_stripe, _offset + n, _data.data() + _offset + n, count);
+        }
+    }
+} // anonymous namespace
+
+TEST_CASE("inline_checksum scheme support")
+{
+    CHECK(ix::inline_checksum::is_supported(irods::MD5_NAME, 1));
+    CHECK(ix::inline_checksum::is_supported(irods::SHA256_NAME, 1));
+    CHECK(ix::inline_checksum::is_supported(irods::ADLER32_NAME, 1));
+    CHECK(ix::inline_checksum::is_supported(irods::ADLER32_NAME, 4));
+
+    CHECK_FALSE(ix::inline_checksum::is_supported(irods::MD5_NAME, 4));
+    CHECK_FALSE(ix::inline_checksum::is_supported(irods::SHA256_NAME, 2));
+    CHECK_FALSE(ix::inline_checksum::is_supported("unknown", 1));
+    CHECK_FALSE(ix::inline_checksum::is_supported(irods::ADLER32_NAME, 0));
+
+    CHECK_THROWS_AS(ix::inline_checksum(irods::MD5_NAME, 2), irods::exception);
+}
+
+TEST_CASE("inline_checksum of a single stripe matches the hasher")
+{
+    const auto data = make_data(1024 * 1024 + 7);
+
+    for (const auto& scheme : {irods::MD5_NAME, irods::SHA256_NAME, irods::ADLER32_NAME}) {
+        ix::inline_checksum checksum{scheme, 1};
+        feed(checksum, 0, data, 0, data.size(), 4096);
+
+        const auto digest = checksum.digest(data.size());
+        REQUIRE(digest);
+        CHECK(*digest == hash(scheme, data));
+    }
+}
+
+TEST_CASE("inline_checksum of an empty replica matches the hasher")
+{
+    ix::inline_checksum checksum{irods::MD5_NAME, 1};
+
+    const auto digest = checksum.digest(0);
+    REQUIRE(digest);
+    CHECK(*digest == hash(irods::MD5_NAME, {}));
+}
+
+TEST_CASE("inline_checksum combines adler32 stripes")
+{
+    const auto data = make_data(3 * 1000 * 1000 + 11);
+    const auto expected = hash(irods::ADLER32_NAME, data);
+
+    SECTION("evenly sized stripes")
+    {
+        constexpr int stripes = 4;
+        const std::size_t size0 = data.size() / stripes;
+
+        ix::inline_checksum checksum{irods::ADLER32_NAME, stripes};
+
+        // Feed the stripes in reverse so that the order of updates does not matter.
+        for (int i = stripes - 1; i >= 0; --i) {
+            const auto offset = i * size0;
+            const auto size = (i == stripes - 1) ? data.size() - offset : size0;
+            feed(checksum, i, data, offset, size, 65536);
+        }
+
+        const auto digest = checksum.digest(data.size());
+        REQUIRE(digest);
+        CHECK(*digest == expected);
+    }
+
+    SECTION("stripes which received no bytes are ignored")
+    {
+        ix::inline_checksum checksum{irods::ADLER32_NAME, 3};
+        feed(checksum, 2, data, 0, 5, 5);
+        feed(checksum, 0, data, 5, data.size() - 5, 1 << 20);
+
+        const auto digest = checksum.digest(data.size());
+        REQUIRE(digest);
+        CHECK(*digest == expected);
+    }
+}
+
+TEST_CASE("inline_checksum does not produce a digest for incomplete data")
+{
+    const auto data = make_data(100000);
+
+    SECTION("gap between stripes")
+    {
+        ix::inline_checksum checksum{irods::ADLER32_NAME, 2};
+        feed(checksum, 0, data, 0, 40000, 1000);
+        feed(checksum, 1, data, 50000, 50000, 1000);
+        CHECK_FALSE(checksum.digest(data.size()));
+    }
+
+    SECTION("size does not match")
+    {
+        ix::inline_checksum checksum{irods::MD5_NAME, 1};
+        feed(checksum, 0, data, 0, data.size(), 1000);
+        CHECK_FALSE(checksum.digest(data.size() + 1));
+    }
+
+    SECTION("data does not start at offset zero")
+    {
+        ix::inline_checksum checksum{irods::MD5_NAME, 1};
+        feed(checksum, 0, data, 10, data.size() - 10, 1000);
+        CHECK_FALSE(checksum.digest(data.size() - 10));
+    }
+
+    SECTION("out of order updates invalidate the stripe")
+    {
+        ix::inline_checksum checksum{irods::MD5_NAME, 1};
+        checksum.update(0, 1000, data.data() + 1000, 1000);
+        checksum.update(0, 0, data.data(), 1000);
+        CHECK_FALSE(checksum.digest(2000));
+    }
+}
+
+TEST_CASE("inline_checksum_table")
+{
+    namespace table = ix::inline_checksum_table;
+
+    const auto data = make_data(5000);
+    const std::string hier = "demoResc";
+    const std::string path = "/var/lib/irods/Vault/home/rods/foo";
+
+    const auto make_checksum = [&data](const std::string& _scheme) {
+        auto checksum = std::make_shared<ix::inline_checksum>(_scheme, 1);
+        checksum->update(0, 0, data.data(), data.size());
+        return checksum;
+    };
+
+    SECTION("digests are taken once")
+    {
+        table::insert(hier, path, make_checksum(irods::SHA256_NAME));
+
+        const auto digest = table::take_digest(hier, path, irods::SHA256_NAME, data.size());
+        REQUIRE(digest);
+        CHECK(*digest == hash(irods::SHA256_NAME, data));
+
+        CHECK_FALSE(table::take_digest(hier, path, irods::SHA256_NAME, data.size()));
+    }
+
+    SECTION("entries are keyed by hierarchy and path")
+    {
+        table::insert(hier, path, make_checksum(irods::MD5_NAME));
+
+        CHECK_FALSE(table::take_digest("otherResc", path, irods::MD5_NAME, data.size()));
+        CHECK_FALSE(table::take_digest(hier, path + "x", irods::MD5_NAME, data.size()));
+        CHECK(table::take_digest(hier, path, irods::MD5_NAME, data.size()));
+    }
+
+    SECTION("a different scheme does not produce a digest")
+    {
+        table::insert(hier, path, make_checksum(irods::MD5_NAME));
+        CHECK_FALSE(table::take_digest(hier, path, irods::SHA256_NAME, data.size()));
+    }
+
+    SECTION("erased entries do not produce a digest")
+    {
+        table::insert(hier, path, make_checksum(irods::MD5_NAME));
+        table::erase(hier, path);
+        CHECK_FALSE(table::take_digest(hier, path, irods::MD5_NAME, data.size()));
+    }
+}
@@ -0,0 +1,139 @@
+#include "catch.hpp"
+
+#include "job_tracker.hpp"
+#include "dispatch_processor.hpp"
+#include "thread_pool.hpp"
+#include "irods_exception.hpp"
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Produces a sequence of integers without holding them in memory, similar to the
+    // paging iterators used by the processors.
+    class counting_range
+    {
+    public:
+        using value_type = int;
+
+        class iterator
+        {
+        public:
+            explicit iterator(int _value) : value_{_value} {}
+
+            auto operator*() const -> int { return value_; }
+            auto operator++() -> iterator& { ++value_; return *this; }
+            auto operator!=(const iterator& _other) const -> bool { return value_ != _other.value_; }
+
+        private:
+            int value_;
+        };
+
+        explicit counting_range(int _count) : count_{_count} {}
+
+        auto begin() const -> iterator { return iterator{0}; }
+        auto end() const -> iterator { return iterator{count_}; }
+
+    private:
+        int count_;
+    };
+} // anonymous namespace
+
+TEST_CASE("job_tracker limits the number of jobs in flight")
+{
+    constexpr std::uint32_t max_in_flight = 8;
+    constexpr int job_count = 2000;
+
+    irods::thread_pool pool{4};
+    auto tracker = std::make_shared<irods::job_tracker>(max_in_flight);
+
+    std::atomic<std::uint32_t> running{};
+    std::atomic<std::uint32_t> peak{};
+
+    for (int i = 0; i < job_count; ++i) {
+        tracker->acquire();
+        REQUIRE(tracker->in_flight() <= max_in_flight);
+
+        irods::thread_pool::post(pool, [tracker, &running, &peak] {
+            tracker->run([&running, &peak] {
+                const auto now = ++running;
+                auto expected = peak.load();
+                while (now > expected && !peak.compare_exchange_weak(expected, now));
+                std::this_thread::sleep_for(std::chrono::microseconds{50});
+                --running;
+            });
+        });
+    }
+
+    CHECK(tracker->wait().empty());
+    CHECK(tracker->submitted() == job_count);
+    CHECK(tracker->in_flight() == 0);
+    CHECK(peak.load() <= max_in_flight);
+
+    pool.join();
+}
+
+TEST_CASE("job_tracker collects a bounded number of errors")
+{
+    irods::job_tracker tracker{4, 3};
+
+    const auto run = [&tracker](auto&& _func) {
+        tracker.acquire();
+        tracker.run(_func);
+    };
+
+    run([] {});
+    run([] { THROW(SYS_INVALID_INPUT_PARAM, "bad input"); });
+    run([] { throw std::runtime_error{"runtime error"}; });
+    run([] { throw 42; });
+    run([] { THROW(SYS_NOT_SUPPORTED, "not supported"); });
+    run([] { THROW(SYS_NOT_SUPPORTED, "not supported"); });
+
+    const auto errors = tracker.wait();
+    REQUIRE(errors.size() == 4);
+    CHECK(std::get<0>(errors[0]) == SYS_INVALID_INPUT_PARAM);
+    CHECK(std::get<0>(errors[1]) == SYS_UNKNOWN_ERROR);
+    CHECK(std::get<0>(errors[2]) == SYS_UNKNOWN_ERROR);
+
+    // The last entry summarizes the errors which were dropped.
+    CHECK(std::get<0>(errors[3]) == SYS_NOT_SUPPORTED);
+    CHECK(std::get<1>(errors[3]).find("2 additional jobs failed") == 0);
+
+    CHECK(tracker.submitted() == 6);
+}
+
+TEST_CASE("dispatch_processor applies back-pressure to the iterator")
+{
+    constexpr std::uint32_t max_in_flight = 16;
+    constexpr int entry_count = 10000;
+
+    irods::thread_pool pool{4};
+    std::atomic_bool stop{false};
+
+    std::atomic<int> processed{};
+
+    const auto job = [&processed](const int _entry) {
+        if (_entry % 1000 == 0) {
+            THROW(SYS_INVALID_INPUT_PARAM, "rejected entry");
+        }
+        ++processed;
+    };
+
+    irods::experimental::dispatch_processor<counting_range> dp{stop, counting_range{entry_count}, job, max_in_flight};
+    auto f = dp.execute(pool);
+
+    const auto errors = f.get();
+    CHECK(errors.size() == entry_count / 1000);
+    CHECK(processed.load() == entry_count - entry_count / 1000);
+    CHECK(f.size() == entry_count);
+
+    pool.join();
+}
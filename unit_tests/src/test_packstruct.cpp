@@ -4,8 +4,13 @@
 #include "irods_server_properties.hpp"
 #include "rcGlobalExtern.h"
 #include "irods_at_scope_exit.hpp"
+#include "pack_instruction_cache.hpp"
+#include "rodsGenQuery.h"
+#include "rcMisc.h"
+#include "objInfo.h"
 
 #include <cstring>
+#include <string>
 #include <string_view>
 
 TEST_CASE("packstruct xml encoding")
@@ -104,3 +109,239 @@ TEST_CASE("packstruct xml encoding")
     }
 }
 
+
+namespace
+{
+    namespace pic = irods::experimental::pack_instruction_cache;
+
+    auto make_data_obj_inp() -> DataObjInp
+    {
+        DataObjInp input{};
+        std::strncpy(input.objPath, "/tempZone/home/rods/foo", sizeof(input.objPath));
+        input.dataSize = 1024;
+        input.oprType = PUT_OPR;
+        addKeyVal(&input.condInput, RESC_NAME_KW, "demoResc");
+        addKeyVal(&input.condInput, DEST_RESC_NAME_KW, "demoResc");
+        addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+        return input;
+    }
+
+    auto make_gen_query_inp() -> GenQueryInp
+    {
+        GenQueryInp input{};
+        input.maxRows = MAX_SQL_ROWS;
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_COLL_NAME, 1);
+        addInxIval(&input.selectInp, COL_D_DATA_ID, 1);
+        addInxIval(&input.selectInp, COL_DATA_REPL_NUM, 1);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, "= '/tempZone/home/rods'");
+        addInxVal(&input.sqlCondInp, COL_D_RESC_ID, "= '10014'");
+        return input;
+    }
+
+    auto make_gen_query_out(int _row_count) -> GenQueryOut
+    {
+        GenQueryOut output{};
+        output.rowCnt = _row_count;
+        output.attriCnt = 2;
+
+        for (int i = 0; i < output.attriCnt; ++i) {
+            auto& column = output.sqlResult[i];
+            column.attriInx = COL_DATA_NAME + i;
+            column.len = NAME_LEN;
+            column.value = static_cast<char*>(std::calloc(_row_count, column.len));
+
+            for (int row = 0; row < _row_count; ++row) {
+                const auto value = "value_" + std::to_string(row);
+                std::strncpy(column.value + row * column.len, value.c_str(), column.len - 1);
+            }
+        }
+
+        return output;
+    }
+
+    auto pack(const void* _input, const char* _pack_instruction) -> std::string
+    {
+        BytesBuf* packed_result = nullptr;
+        irods::at_scope_exit free_packed_result{[&packed_result] { freeBBuf(packed_result); }};
+
+        REQUIRE(pack_struct(_input, &packed_result, _pack_instruction, nullptr, 0, NATIVE_PROT, nullptr) == 0);
+        REQUIRE(packed_result);
+
+        return {static_cast<const char*>(packed_result->buf), static_cast<std::size_t>(packed_result->len)};
+    }
+
+    auto round_trip(const void* _input, const char* _pack_instruction, void (*_free)(void*)) -> void
+    {
+        BytesBuf* packed_result = nullptr;
+        irods::at_scope_exit free_packed_result{[&packed_result] { freeBBuf(packed_result); }};
+
+        REQUIRE(pack_struct(_input, &packed_result, _pack_instruction, nullptr, 0, NATIVE_PROT, nullptr) == 0);
+
+        void* unpacked_result = nullptr;
+        REQUIRE(unpack_struct(packed_result->buf, &unpacked_result, _pack_instruction, nullptr, NATIVE_PROT, nullptr) == 0);
+        _free(unpacked_result);
+    }
+
+    auto free_data_obj_inp(void* _p) -> void
+    {
+        auto* p = static_cast<DataObjInp*>(_p);
+        clearKeyVal(&p->condInput);
+        std::free(p);
+    }
+
+    auto free_gen_query_inp(void* _p) -> void
+    {
+        clearGenQueryInp(_p);
+        std::free(_p);
+    }
+
+    auto free_gen_query_out(void* _p) -> void
+    {
+        auto* p = static_cast<GenQueryOut*>(_p);
+        freeGenQueryOut(&p);
+    }
+} // anonymous namespace
+
+TEST_CASE("pack instruction cache produces the same output as the interpreter")
+{
+    auto data_obj_inp = make_data_obj_inp();
+    irods::at_scope_exit clear_data_obj_inp{[&data_obj_inp] { clearKeyVal(&data_obj_inp.condInput); }};
+
+    auto gen_query_inp = make_gen_query_inp();
+    irods::at_scope_exit clear_gen_query_inp{[&gen_query_inp] { clearGenQueryInp(&gen_query_inp); }};
+
+    auto gen_query_out = make_gen_query_out(32);
+    irods::at_scope_exit clear_gen_query_out{[&gen_query_out] { clearGenQueryOut(&gen_query_out); }};
+
+    pic::clear();
+    pic::enable(false);
+    const auto expected_data_obj_inp = pack(&data_obj_inp, "DataObjInp_PI");
+    const auto expected_gen_query_inp = pack(&gen_query_inp, "GenQueryInp_PI");
+    const auto expected_gen_query_out = pack(&gen_query_out, "GenQueryOut_PI");
+    CHECK(pic::size() == 0);
+
+    pic::enable(true);
+
+    // The first pass populates the cache. The second pass is served from it.
+    for (int i = 0; i < 2; ++i) {
+        CHECK(pack(&data_obj_inp, "DataObjInp_PI") == expected_data_obj_inp);
+        CHECK(pack(&gen_query_inp, "GenQueryInp_PI") == expected_gen_query_inp);
+        CHECK(pack(&gen_query_out, "GenQueryOut_PI") == expected_gen_query_out);
+        CHECK(pic::size() > 0);
+    }
+
+    round_trip(&data_obj_inp, "DataObjInp_PI", free_data_obj_inp);
+    round_trip(&gen_query_inp, "GenQueryInp_PI", free_gen_query_inp);
+    round_trip(&gen_query_out, "GenQueryOut_PI", free_gen_query_out);
+}
+
+TEST_CASE("pack instruction cache benchmark", "[.benchmark]")
+{
+    auto data_obj_inp = make_data_obj_inp();
+    irods::at_scope_exit clear_data_obj_inp{[&data_obj_inp] { clearKeyVal(&data_obj_inp.condInput); }};
+
+    auto gen_query_inp = make_gen_query_inp();
+    irods::at_scope_exit clear_gen_query_inp{[&gen_query_inp] { clearGenQueryInp(&gen_query_inp); }};
+
+    auto gen_query_out = make_gen_query_out(MAX_SQL_ROWS);
+    irods::at_scope_exit clear_gen_query_out{[&gen_query_out] { clearGenQueryOut(&gen_query_out); }};
+
+    constexpr int iterations = 1000;
+
+    const auto run = [&] {
+        for (int i = 0; i < iterations; ++i) {
+            round_trip(&data_obj_inp, "DataObjInp_PI", free_data_obj_inp);
+            round_trip(&gen_query_inp, "GenQueryInp_PI", free_gen_query_inp);
+            round_trip(&gen_query_out, "GenQueryOut_PI", free_gen_query_out);
+        }
+    };
+
+    pic::enable(false);
+    BENCHMARK("interpreter: DataObjInp_PI, GenQueryInp_PI, GenQueryOut_PI") { run(); };
+
+    pic::enable(true);
+    BENCHMARK("cached plans: DataObjInp_PI, GenQueryInp_PI, GenQueryOut_PI") { run(); };
+}
+
+TEST_CASE("unpack_struct_with_arena")
+{
+    auto data_obj_inp = make_data_obj_inp();
+    irods::at_scope_exit clear_data_obj_inp{[&data_obj_inp] { clearKeyVal(&data_obj_inp.condInput); }};
+
+    auto gen_query_out = make_gen_query_out(MAX_SQL_ROWS);
+    irods::at_scope_exit clear_gen_query_out{[&gen_query_out] { clearGenQueryOut(&gen_query_out); }};
+
+    BytesBuf* packed_data_obj_inp = nullptr;
+    irods::at_scope_exit free_packed_data_obj_inp{[&packed_data_obj_inp] { freeBBuf(packed_data_obj_inp); }};
+    REQUIRE(pack_struct(&data_obj_inp, &packed_data_obj_inp, "DataObjInp_PI", nullptr, 0, NATIVE_PROT, nullptr) == 0);
+
+    BytesBuf* packed_gen_query_out = nullptr;
+    irods::at_scope_exit free_packed_gen_query_out{[&packed_gen_query_out] { freeBBuf(packed_gen_query_out); }};
+    REQUIRE(pack_struct(&gen_query_out, &packed_gen_query_out, "GenQueryOut_PI", nullptr, 0, NATIVE_PROT, nullptr) == 0);
+
+    // Use a small block size so that the messages span several blocks.
+    auto* arena = create_unpack_arena(4096);
+    REQUIRE(arena);
+    irods::at_scope_exit free_arena{[arena] { free_unpack_arena(arena); }};
+
+    // The second pass runs on the blocks kept by reset_unpack_arena().
+    for (int i = 0; i < 2; ++i) {
+        DataObjInp* d = nullptr;
+        REQUIRE(unpack_struct_with_arena(packed_data_obj_inp->buf, (void**) &d, "DataObjInp_PI", nullptr, NATIVE_PROT, nullptr, arena) == 0);
+
+        GenQueryOut* g = nullptr;
+        REQUIRE(unpack_struct_with_arena(packed_gen_query_out->buf, (void**) &g, "GenQueryOut_PI", nullptr, NATIVE_PROT, nullptr, arena) == 0);
+
+        CHECK(std::string_view{d->objPath} == data_obj_inp.objPath);
+        REQUIRE(d->condInput.len == data_obj_inp.condInput.len);
+        for (int j = 0; j < d->condInput.len; ++j) {
+            CHECK(std::string_view{d->condInput.keyWord[j]} == data_obj_inp.condInput.keyWord[j]);
+            CHECK(std::string_view{d->condInput.value[j]} == data_obj_inp.condInput.value[j]);
+        }
+
+        REQUIRE(g->rowCnt == gen_query_out.rowCnt);
+        REQUIRE(g->attriCnt == gen_query_out.attriCnt);
+        for (int col = 0; col < g->attriCnt; ++col) {
+            const auto& actual = g->sqlResult[col];
+            const auto& expected = gen_query_out.sqlResult[col];
+            for (int row = 0; row < g->rowCnt; ++row) {
+                CHECK(std::string_view{actual.value + row * actual.len} == expected.value + row * expected.len);
+            }
+        }
+
+        reset_unpack_arena(arena);
+    }
+}
+
+TEST_CASE("unpack_struct_with_arena benchmark", "[.benchmark]")
+{
+    auto data_obj_inp = make_data_obj_inp();
+    irods::at_scope_exit clear_data_obj_inp{[&data_obj_inp] { clearKeyVal(&data_obj_inp.condInput); }};
+
+    BytesBuf* packed_data_obj_inp = nullptr;
+    irods::at_scope_exit free_packed_data_obj_inp{[&packed_data_obj_inp] { freeBBuf(packed_data_obj_inp); }};
+    REQUIRE(pack_struct(&data_obj_inp, &packed_data_obj_inp, "DataObjInp_PI", nullptr, 0, NATIVE_PROT, nullptr) == 0);
+
+    auto* arena = create_unpack_arena(0);
+    REQUIRE(arena);
+    irods::at_scope_exit free_arena{[arena] { free_unpack_arena(arena); }};
+
+    BENCHMARK("unpack DataObjInp_PI with malloc")
+    {
+        for (int i = 0; i < 1000; ++i) {
+            void* p = nullptr;
+            unpack_struct(packed_data_obj_inp->buf, &p, "DataObjInp_PI", nullptr, NATIVE_PROT, nullptr);
+            free_data_obj_inp(p);
+        }
+    };
+
+    BENCHMARK("unpack DataObjInp_PI with arena")
+    {
+        for (int i = 0; i < 1000; ++i) {
+            void* p = nullptr;
+            unpack_struct_with_arena(packed_data_obj_inp->buf, &p, "DataObjInp_PI", nullptr, NATIVE_PROT, nullptr, arena);
+            reset_unpack_arena(arena);
+        }
+    };
+}
@@ -19,6 +19,7 @@
 #include <thread>
 #include <memory>
 #include <algorithm>
+#include <iterator>
 
 namespace ix = irods::experimental;
 namespace io = irods::experimental::io;
@@ -185,6 +186,185 @@ TEST_CASE("parallel transfer engine")
     }
 }
 
+// A file stream whose reads take at least a fixed amount of time. Used to simulate a slow channel.
+struct slow_fstream
+    : public std::fstream
+{
+    slow_fstream(const std::string& _path, std::ios_base::openmode _mode)
+        : std::fstream{_path, _mode}
+    {
+    }
+
+    slow_fstream(slow_fstream&& _other)
+        : std::fstream{std::move(_other)}
+        , delay{_other.delay}
+    {
+    }
+
+    auto read(char_type* _buffer, std::streamsize _count) -> slow_fstream&
+    {
+        std::this_thread::sleep_for(delay);
+        std::fstream::read(_buffer, _count);
+        return *this;
+    }
+
+    std::chrono::milliseconds delay{};
+};
+
+auto create_local_file_with_pattern(const boost::filesystem::path& _p, std::size_t _size) -> void
+{
+    std::ofstream out{_p.c_str(), std::ios::binary | std::ios::out};
+
+    for (std::size_t i = 0; i < _size; ++i) {
+        out.put(static_cast<char>(i % 251));
+    }
+}
+
+auto read_local_file(const boost::filesystem::path& _p) -> std::string
+{
+    std::ifstream in{_p.c_str(), std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+TEST_CASE("parallel transfer engine moves work from slow channels to idle channels")
+{
+    namespace fs = boost::filesystem;
+
+    const auto source_file = fs::current_path() / "irods_parallel_transfer_engine_work_stealing_source";
+    const auto sink_file = fs::current_path() / "irods_parallel_transfer_engine_work_stealing_sink";
+    const auto restart_dir = fs::current_path() / "irods_parallel_transfer_engine_work_stealing_restart";
+
+    irods::at_scope_exit remove_files{[&] {
+        fs::remove(source_file);
+        fs::remove(sink_file);
+        fs::remove_all(restart_dir);
+    }};
+
+    constexpr std::int64_t buffer_size = 64 * 1024;
+    constexpr std::int64_t total_bytes_to_transfer = 4_mb + 123;
+    constexpr std::int16_t number_of_channels = 4;
+
+    create_local_file_with_pattern(source_file, total_bytes_to_transfer);
+
+    using engine_type = io::parallel_transfer_engine<slow_fstream, std::fstream>;
+
+    const auto sink_stream_fac = io::make_fstream_factory(sink_file.c_str());
+
+    SECTION("slow primary channel")
+    {
+        // Only the primary stream (the one created without a base stream) is slow.
+        const auto source_stream_fac = [p = source_file.string()](std::ios_base::openmode _mode, slow_fstream* _base) {
+            slow_fstream in{p, _mode};
+
+            if (!_base) {
+                using namespace std::chrono_literals;
+                in.delay = 20ms;
+            }
+
+            return in;
+        };
+
+        engine_type transfer{source_stream_fac,
+                             sink_stream_fac,
+                             io::close_stream<std::fstream>,
+                             total_bytes_to_transfer,
+                             number_of_channels,
+                             0,
+                             buffer_size,
+                             restart_dir.string()};
+
+        transfer.wait();
+
+        REQUIRE(transfer.success());
+        REQUIRE(transfer.errors().empty());
+        CHECK(read_local_file(sink_file) == read_local_file(source_file));
+
+        const auto stats = transfer.statistics();
+        REQUIRE(stats.size() == number_of_channels);
+
+        std::int64_t bytes_transferred = 0;
+        std::int64_t ranges_stolen = 0;
+
+        for (auto&& s : stats) {
+            bytes_transferred += s.bytes_transferred;
+            ranges_stolen += s.ranges_stolen;
+            CHECK(s.elapsed.count() > 0);
+        }
+
+        CHECK(bytes_transferred == total_bytes_to_transfer);
+        CHECK(ranges_stolen > 0);
+        CHECK(stats[0].ranges_stolen == 0);
+        CHECK(stats[0].bytes_transferred < total_bytes_to_transfer / number_of_channels);
+    }
+
+    SECTION("restart from the journal")
+    {
+        const auto source_stream_fac = [p = source_file.string()](std::ios_base::openmode _mode, slow_fstream*) {
+            using namespace std::chrono_literals;
+            slow_fstream in{p, _mode};
+            in.delay = 10ms;
+            return in;
+        };
+
+        engine_type::restart_handle_type restart_handle;
+
+        {
+            engine_type transfer{source_stream_fac,
+                                 sink_stream_fac,
+                                 io::close_stream<std::fstream>,
+                                 total_bytes_to_transfer,
+                                 number_of_channels,
+                                 0,
+                                 buffer_size,
+                                 restart_dir.string()};
+
+            restart_handle = transfer.restart_handle();
+
+            using namespace std::chrono_literals;
+            std::this_thread::sleep_for(50ms);
+
+            transfer.stop_and_wait();
+
+            REQUIRE_FALSE(transfer.success());
+        }
+
+        REQUIRE(fs::exists(restart_handle));
+
+        {
+            engine_type transfer{restart_handle, source_stream_fac, sink_stream_fac, io::close_stream<std::fstream>};
+            transfer.wait();
+
+            REQUIRE(transfer.success());
+            REQUIRE(transfer.errors().empty());
+
+            std::int64_t bytes_transferred = 0;
+
+            for (auto&& s : transfer.statistics()) {
+                bytes_transferred += s.bytes_transferred;
+            }
+
+            CHECK(bytes_transferred < total_bytes_to_transfer);
+        }
+
+        CHECK_FALSE(fs::exists(restart_handle));
+        CHECK(read_local_file(sink_file) == read_local_file(source_file));
+    }
+
+    SECTION("restart files from other sources are rejected")
+    {
+        fs::create_directories(restart_dir);
+        const auto bogus_handle = (restart_dir / "bogus").string();
+        std::ofstream{bogus_handle} << std::string(256, 'x');
+
+        const auto source_stream_fac = [p = source_file.string()](std::ios_base::openmode _mode, slow_fstream*) {
+            return slow_fstream{p, _mode};
+        };
+
+        CHECK_THROWS_AS((engine_type{bogus_handle, source_stream_fac, sink_stream_fac, io::close_stream<std::fstream>}),
+                        io::parallel_transfer_engine_error);
+    }
+}
+
 auto create_local_file(const boost::filesystem::path& _p, std::size_t _size) noexcept -> bool
 {
     std::array<char, 1024 * 1024> buf{};
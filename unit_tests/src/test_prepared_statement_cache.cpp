@@ -0,0 +1,242 @@
+#include "catch.hpp"
+
+#include "prepared_statement_cache.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace ix = irods::experimental;
+
+namespace
+{
+    // Records what the cache asks of the database.
+    struct statement_log
+    {
+        std::vector<std::string> prepared;
+        std::vector<int> resets;
+        std::vector<int> freed;
+        bool fail_prepare = false;
+        int next_handle = 1;
+    };
+
+    struct fake_statements
+    {
+        using connection_type = int;
+        using handle_type = int;
+
+        auto prepare(int, const char* _sql) -> int
+        {
+            if (log->fail_prepare) {
+                return 0;
+            }
+
+            log->prepared.emplace_back(_sql);
+            return log->next_handle++;
+        }
+
+        auto reset(int _handle) -> void { log->resets.push_back(_handle); }
+
+        auto free(int _handle) -> void { log->freed.push_back(_handle); }
+
+        statement_log* log;
+    };
+
+    using cache_type = ix::prepared_statement_cache<fake_statements>;
+
+    constexpr int connection = 42;
+
+    auto was_freed(const statement_log& _log, int _handle) -> bool
+    {
+        return std::count(std::begin(_log.freed), std::end(_log.freed), _handle) == 1;
+    }
+
+    // Runs _sql once through the cache, like a catalog query would.
+    auto execute(cache_type& _cache, const char* _sql) -> int
+    {
+        const int handle = _cache.acquire(connection, _sql);
+        if (handle) {
+            _cache.release(handle);
+        }
+        return handle;
+    }
+} // anonymous namespace
+
+TEST_CASE("prepared_statement_cache hits")
+{
+    statement_log log;
+    cache_type cache{4, fake_statements{&log}};
+
+    const char* sql = "select data_id from R_DATA_MAIN where data_name = ?";
+
+    SECTION("one-off SQL is executed directly")
+    {
+        CHECK(execute(cache, sql) == 0);
+        CHECK(log.prepared.empty());
+        CHECK(cache.stats().size == 0);
+        CHECK(cache.stats().misses == 1);
+    }
+
+    SECTION("SQL seen a second time is prepared and then reused")
+    {
+        CHECK(execute(cache, sql) == 0);
+
+        const int handle = execute(cache, sql);
+        REQUIRE(handle != 0);
+        CHECK(log.prepared == std::vector<std::string>{sql});
+
+        CHECK(execute(cache, sql) == handle);
+        CHECK(execute(cache, sql) == handle);
+        CHECK(log.prepared.size() == 1);
+        CHECK(log.resets == std::vector<int>{handle, handle, handle});
+
+        const auto stats = cache.stats();
+        CHECK(stats.hits == 2);
+        CHECK(stats.misses == 2);
+        CHECK(stats.size == 1);
+        CHECK(stats.capacity == 4);
+    }
+
+    SECTION("a statement which is already open is not handed out twice")
+    {
+        execute(cache, sql);
+
+        const int outer = cache.acquire(connection, sql);
+        REQUIRE(outer != 0);
+        CHECK(cache.acquire(connection, sql) == 0);
+        CHECK(cache.release(outer));
+        CHECK(cache.acquire(connection, sql) == outer);
+    }
+
+    SECTION("handles the cache does not own are left to the caller")
+    {
+        CHECK_FALSE(cache.release(1000));
+        CHECK(log.resets.empty());
+        CHECK(log.freed.empty());
+    }
+
+    SECTION("a failed preparation is executed directly")
+    {
+        execute(cache, sql);
+        log.fail_prepare = true;
+        CHECK(execute(cache, sql) == 0);
+        CHECK(cache.stats().size == 0);
+    }
+
+    SECTION("a discarded handle is freed instead of reused")
+    {
+        execute(cache, sql);
+
+        const int handle = cache.acquire(connection, sql);
+        REQUIRE(handle != 0);
+        cache.discard(handle);
+        CHECK(cache.release(handle));
+        CHECK(was_freed(log, handle));
+        CHECK(cache.stats().size == 0);
+    }
+
+    SECTION("a capacity of zero disables the cache")
+    {
+        cache_type disabled{0, fake_statements{&log}};
+
+        for (int i = 0; i < 3; ++i) {
+            CHECK(execute(disabled, sql) == 0);
+        }
+
+        CHECK(log.prepared.empty());
+    }
+}
+
+TEST_CASE("prepared_statement_cache eviction")
+{
+    statement_log log;
+    cache_type cache{2, fake_statements{&log}};
+
+    const auto prepare = [&cache](const char* _sql) {
+        execute(cache, _sql);
+        return execute(cache, _sql);
+    };
+
+    const int a = prepare("select 1");
+    const int b = prepare("select 2");
+    REQUIRE(a != 0);
+    REQUIRE(b != 0);
+
+    SECTION("the least recently used handle is evicted")
+    {
+        // Touch "select 1" so that "select 2" becomes the oldest.
+        CHECK(execute(cache, "select 1") == a);
+
+        const int c = prepare("select 3");
+        REQUIRE(c != 0);
+        CHECK(was_freed(log, b));
+        CHECK_FALSE(was_freed(log, a));
+        CHECK(cache.stats().size == 2);
+        CHECK(cache.stats().evictions == 1);
+
+        // The evicted statement has to be seen twice again before it is prepared.
+        CHECK(execute(cache, "select 2") == 0);
+        CHECK(execute(cache, "select 2") != 0);
+    }
+
+    SECTION("handles being executed are not evicted")
+    {
+        REQUIRE(cache.acquire(connection, "select 1") == a);
+        REQUIRE(cache.acquire(connection, "select 2") == b);
+
+        execute(cache, "select 3");
+        const int c = cache.acquire(connection, "select 3");
+        REQUIRE(c != 0);
+        CHECK(log.freed.empty());
+        CHECK(cache.stats().size == 3);
+
+        // Once released, the cache shrinks back to its capacity on the next preparation.
+        cache.release(a);
+        cache.release(b);
+        cache.release(c);
+        prepare("select 4");
+        CHECK(cache.stats().size == 2);
+        CHECK(was_freed(log, a));
+        CHECK(was_freed(log, b));
+    }
+
+    SECTION("one-off SQL does not evict prepared handles")
+    {
+        for (int i = 0; i < 10; ++i) {
+            execute(cache, ("select " + std::to_string(100 + i)).c_str());
+        }
+
+        CHECK(log.freed.empty());
+        CHECK(execute(cache, "select 1") == a);
+        CHECK(execute(cache, "select 2") == b);
+    }
+}
+
+TEST_CASE("prepared_statement_cache invalidation on disconnect")
+{
+    statement_log log;
+    cache_type cache{4, fake_statements{&log}};
+
+    execute(cache, "select 1");
+    const int a = execute(cache, "select 1");
+    execute(cache, "select 2");
+    const int b = cache.acquire(connection, "select 2");
+    REQUIRE(a != 0);
+    REQUIRE(b != 0);
+
+    // Seen once, so it would be prepared on its next execution.
+    execute(cache, "select 3");
+
+    // Disconnecting clears the cache, including handles which are still open.
+    cache.clear();
+
+    CHECK(was_freed(log, a));
+    CHECK(was_freed(log, b));
+    CHECK(cache.stats().size == 0);
+    CHECK_FALSE(cache.release(b));
+
+    // Nothing carries over to the next connection.
+    CHECK(execute(cache, "select 1") == 0);
+    CHECK(execute(cache, "select 3") == 0);
+    CHECK(log.prepared.size() == 2);
+}
@@ -4,6 +4,9 @@
 #include "irods_at_scope_exit.hpp"
 #include "logical_locking.hpp"
 #include "replica_state_table.hpp"
+#include "irods_exception.hpp"
+
+#include "fmt/format.h"
 
 #include <sys/types.h>
 #include <unistd.h>
@@ -63,6 +66,37 @@ namespace
 
         return replicas;
     } // generate_data_object
+
+    auto generate_replica_list(
+        const std::uint64_t _data_id,
+        std::string_view _logical_path,
+        const int _replica_count) -> DataObjInfo*
+    {
+        DataObjInfo* head{};
+        DataObjInfo* prev{};
+
+        for (int i = 0; i < _replica_count; ++i) {
+            auto [proxy, lm] = irods::experimental::replica::make_replica_proxy();
+            proxy.logical_path(_logical_path);
+            proxy.physical_path(fmt::format("/var/lib/irods/vault{}/home/rods/foo", i));
+            proxy.size(SIZE_1);
+            proxy.replica_number(i);
+            proxy.data_id(_data_id);
+            proxy.replica_status(GOOD_REPLICA);
+            proxy.resource_id(i);
+
+            DataObjInfo* curr = lm.release();
+            if (!head) {
+                head = curr;
+            }
+            else {
+                prev->next = curr;
+            }
+            prev = curr;
+        }
+
+        return head;
+    } // generate_replica_list
 }
 
 TEST_CASE("replica state table", "[basic]")
@@ -411,3 +445,100 @@ TEST_CASE("logical_locking", "[basic]")
     rst::deinit();
 }
 
+TEST_CASE("typed replica properties", "[basic]")
+{
+    using json = nlohmann::json;
+
+    rst::init();
+
+    auto* head = generate_replica_list(DATA_ID_1, LOGICAL_PATH_1, REPLICA_COUNT);
+    REQUIRE(head);
+    const auto replica_list_lm = irods::experimental::lifetime_manager{*head};
+    const auto obj = irods::experimental::data_object::make_data_object_proxy(*head);
+
+    REQUIRE(0 == rst::insert(obj));
+
+    constexpr int target_replica_number = 1;
+
+    SECTION("replica numbers are listed in insertion order")
+    {
+        CHECK(rst::get_replica_numbers(DATA_ID_1) == std::vector<int>{0, 1, 2});
+    }
+
+    SECTION("replica status accessors")
+    {
+        rst::update_replica_status(DATA_ID_1, target_replica_number, STALE_REPLICA);
+
+        CHECK(STALE_REPLICA == rst::get_replica_status(DATA_ID_1, target_replica_number, rst::state_type::after));
+        CHECK(GOOD_REPLICA == rst::get_replica_status(DATA_ID_1, target_replica_number, rst::state_type::before));
+        CHECK(std::to_string(STALE_REPLICA) == rst::get_property(DATA_ID_1, target_replica_number, "data_is_dirty", rst::state_type::after));
+        CHECK_THROWS_AS(rst::get_replica_status(DATA_ID_1, REPLICA_COUNT, rst::state_type::after), irods::exception);
+    }
+
+    SECTION("numeric columns are published as strings")
+    {
+        REQUIRE_NOTHROW(rst::update(DATA_ID_1, target_replica_number, json{{"data_size", 42}}));
+
+        const auto after = rst::at(DATA_ID_1, target_replica_number, rst::state_type::after);
+        CHECK(after.at("data_size").get<std::string>() == "42");
+        CHECK(after.at("data_repl_num").get<std::string>() == std::to_string(target_replica_number));
+        CHECK(after.at("data_path").get<std::string>() == "/var/lib/irods/vault1/home/rods/foo");
+        CHECK(after.at("data_name").get<std::string>() == "foo");
+    }
+
+    SECTION("invalid updates leave the replica unchanged")
+    {
+        CHECK_THROWS_AS(rst::update(DATA_ID_1, target_replica_number, json{{"r_comment", UPDATED_COMMENT}, {"data_size", "42x"}}), irods::exception);
+        CHECK_THROWS_AS(rst::update(DATA_ID_1, target_replica_number, json{{"r_comment", UPDATED_COMMENT}, {"not_a_column", "x"}}), irods::exception);
+
+        CHECK(std::to_string(SIZE_1) == rst::get_property(DATA_ID_1, target_replica_number, "data_size", rst::state_type::after));
+        CHECK(rst::get_property(DATA_ID_1, target_replica_number, "r_comment", rst::state_type::after).empty());
+        CHECK_THROWS_AS(rst::get_property(DATA_ID_1, target_replica_number, "not_a_column", rst::state_type::after), irods::exception);
+    }
+
+    CHECK_NOTHROW(rst::erase(DATA_ID_1));
+    CHECK_THROWS_AS(rst::erase(DATA_ID_1), irods::exception);
+    rst::deinit();
+}
+
+TEST_CASE("replica state table benchmark", "[.benchmark]")
+{
+    namespace ill = irods::logical_locking;
+    using json = nlohmann::json;
+
+    rst::init();
+
+    constexpr int replica_count = 64;
+    constexpr int target_replica_number = replica_count / 2;
+
+    auto* head = generate_replica_list(DATA_ID_1, LOGICAL_PATH_1, replica_count);
+    REQUIRE(head);
+    const auto replica_list_lm = irods::experimental::lifetime_manager{*head};
+    const auto obj = irods::experimental::data_object::make_data_object_proxy(*head);
+
+    // Mirrors the table operations of opening a replica for write, writing to it and closing it.
+    const auto open_write_close = [&obj] {
+        REQUIRE(0 == rst::insert(obj));
+        REQUIRE(0 == ill::lock(DATA_ID_1, target_replica_number, ill::lock_type::write));
+
+        rst::update(DATA_ID_1, target_replica_number, json{{"data_size", std::to_string(SIZE_2)}, {"data_checksum", ""}});
+
+        REQUIRE(0 == ill::unlock(DATA_ID_1, target_replica_number, GOOD_REPLICA, STALE_REPLICA));
+
+        // The JSON which is sent to rs_data_object_finalize.
+        const auto replicas = rst::at(DATA_ID_1);
+
+        rst::erase(DATA_ID_1);
+
+        return replicas.size();
+    };
+
+    CHECK(replica_count == open_write_close());
+
+    BENCHMARK("open/write/close, 64 replicas")
+    {
+        return open_write_close();
+    };
+
+    rst::deinit();
+}
@@ -0,0 +1,121 @@
+#include "catch.hpp"
+
+#include "resource_snapshot.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+namespace rsnp = irods::experimental::resource_snapshot;
+
+TEST_CASE("resource_snapshot")
+{
+    rsnp::init("irods_resource_snapshot_test", 100'000);
+    irods::at_scope_exit cleanup{[] { rsnp::deinit(); }};
+
+    REQUIRE(rsnp::is_initialized());
+
+    const std::vector<rsnp::row_type> rows{
+        {"10014", "demoResc", "tempZone", "unixfilesystem"},
+        {"10015", "pt", "tempZone", "passthru"},
+        {"10016", "", "tempZone", ""}
+    };
+
+    SECTION("an empty snapshot never matches")
+    {
+        CHECK(rsnp::version().empty());
+        CHECK_FALSE(rsnp::load(""));
+        CHECK_FALSE(rsnp::load("3:01600000000:"));
+    }
+
+    SECTION("rows are only returned for a matching version")
+    {
+        REQUIRE(rsnp::store("3:01600000000:", rows));
+        CHECK(rsnp::version() == "3:01600000000:");
+
+        const auto snapshot = rsnp::load("3:01600000000:");
+        REQUIRE(snapshot);
+        CHECK(*snapshot == rows);
+
+        CHECK_FALSE(rsnp::load("3:01600000001:"));
+        CHECK_FALSE(rsnp::load("4:01600000000:"));
+    }
+
+    SECTION("storing replaces the previous snapshot")
+    {
+        REQUIRE(rsnp::store("3:01600000000:", rows));
+        REQUIRE(rsnp::store("1:01600000005:", {rows[0]}));
+
+        CHECK_FALSE(rsnp::load("3:01600000000:"));
+
+        const auto snapshot = rsnp::load("1:01600000005:");
+        REQUIRE(snapshot);
+        REQUIRE(snapshot->size() == 1);
+        CHECK(snapshot->front() == rows[0]);
+    }
+
+    SECTION("an empty set of rows is a valid snapshot")
+    {
+        REQUIRE(rsnp::store("0::", {}));
+
+        const auto snapshot = rsnp::load("0::");
+        REQUIRE(snapshot);
+        CHECK(snapshot->empty());
+    }
+
+    SECTION("rows with differing column counts are rejected")
+    {
+        REQUIRE(rsnp::store("3:01600000000:", rows));
+        CHECK_FALSE(rsnp::store("2:01600000009:", {rows[0], {"10017"}}));
+
+        // The previous snapshot remains usable.
+        CHECK(rsnp::load("3:01600000000:"));
+    }
+
+    SECTION("rows that do not fit into shared memory leave the snapshot empty")
+    {
+        REQUIRE(rsnp::store("3:01600000000:", rows));
+
+        const std::vector<rsnp::row_type> huge_rows(1, rsnp::row_type(1, std::string(200'000, 'x')));
+        CHECK_FALSE(rsnp::store("1:01600000010:", huge_rows));
+
+        CHECK(rsnp::version().empty());
+        CHECK_FALSE(rsnp::load("3:01600000000:"));
+        CHECK_FALSE(rsnp::load("1:01600000010:"));
+
+        // The memory is returned to the segment and can be reused.
+        CHECK(rsnp::store("3:01600000000:", rows));
+    }
+
+    SECTION("child processes share the snapshot")
+    {
+        REQUIRE(rsnp::store("3:01600000000:", rows));
+
+        if (const auto pid = fork(); pid == 0) {
+            const auto snapshot = rsnp::load("3:01600000000:");
+            const bool matches = snapshot && *snapshot == rows;
+            const bool stored = rsnp::store("1:01600000020:", {rows[1]});
+            _exit(matches && stored ? 0 : 1);
+        }
+        else {
+            REQUIRE(pid > 0);
+
+            int child_status = 0;
+            REQUIRE(waitpid(pid, &child_status, 0) == pid);
+            REQUIRE(WIFEXITED(child_status));
+            CHECK(WEXITSTATUS(child_status) == 0);
+
+            // Updates made by the child are visible to the parent.
+            const auto snapshot = rsnp::load("1:01600000020:");
+            REQUIRE(snapshot);
+            CHECK(snapshot->front() == rows[1]);
+        }
+    }
+
+    rsnp::clear();
+    CHECK(rsnp::version().empty());
+}
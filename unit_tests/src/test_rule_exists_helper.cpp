@@ -0,0 +1,262 @@
+#include "catch.hpp"
+
+#include "irods_re_ruleexistshelper.hpp"
+#include "irods_error.hpp"
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    // Stands in for rule_exists_manager. Each set represents the rules defined
+    // by one rule engine plugin instance.
+    struct fake_rule_engines
+    {
+        std::vector<std::unordered_set<std::string>> engines;
+        int lookups = 0;
+        bool fail = false;
+
+        auto rule_exists(const std::string& _rn, bool& _exists) -> irods::error
+        {
+            ++lookups;
+
+            if (fail) {
+                return ERROR(SYS_INTERNAL_ERR, "rule_exists failed");
+            }
+
+            _exists = std::any_of(std::begin(engines), std::end(engines), [&_rn](const auto& _rules) {
+                return _rules.count(_rn) > 0;
+            });
+
+            return SUCCESS();
+        }
+    };
+
+    auto helper() -> RuleExistsHelper*
+    {
+        static auto* instance = [] {
+            auto* h = RuleExistsHelper::Instance();
+            // The default regexes of the iRODS Rule Language plugin.
+            h->registerRuleRegex("ac[^ ]*");
+            h->registerRuleRegex("[^ ]*pep_[^ ]*_(pre|post)");
+            h->registerRuleRegex("msi[^ ]*");
+            return h;
+        }();
+
+        return instance;
+    }
+
+    // Performs the lookups plugin_base::invoke_policy_enforcement_point performs
+    // for one class of PEP. Returns the number of rules that would be executed.
+    auto invoke_pep(fake_rule_engines& _engines,
+                    const std::vector<std::string>& _namespaces,
+                    const std::string& _operation_name,
+                    const std::string& _class) -> int
+    {
+        auto* h = helper();
+
+        if (!h->pepMayExist(_operation_name, _class)) {
+            return 0;
+        }
+
+        int executed = 0;
+        bool lookup_failed = false;
+
+        for (const auto& ns : _namespaces) {
+            std::string rule_name = ns + "pep_" + _operation_name + "_" + _class;
+
+            const auto rule_exists = h->ruleExists(rule_name, _engines);
+
+            if (!rule_exists) {
+                lookup_failed = true;
+                continue;
+            }
+
+            if (*rule_exists) {
+                ++executed;
+            }
+        }
+
+        if (!lookup_failed) {
+            h->cachePepExistence(_operation_name, _class, executed > 0);
+        }
+
+        return executed;
+    }
+
+    // The PEPs fired by a successful resource operation.
+    auto invoke_resource_operation(fake_rule_engines& _engines,
+                                   const std::vector<std::string>& _namespaces,
+                                   const std::string& _operation_name) -> int
+    {
+        return invoke_pep(_engines, _namespaces, _operation_name, "pre") +
+               invoke_pep(_engines, _namespaces, _operation_name, "post") +
+               invoke_pep(_engines, _namespaces, _operation_name, "finally");
+    }
+} // anonymous namespace
+
+TEST_CASE("rule exists helper caches rule lookups")
+{
+    auto* h = helper();
+    h->enableCache(true);
+    h->invalidateCache();
+
+    fake_rule_engines engines{{{"pep_resource_read_pre"}, {"pep_resource_write_post"}}};
+
+    SECTION("positive and negative answers are remembered")
+    {
+        CHECK(h->ruleExists("pep_resource_read_pre", engines) == true);
+        CHECK(h->ruleExists("pep_resource_read_post", engines) == false);
+        CHECK(engines.lookups == 2);
+
+        CHECK(h->ruleExists("pep_resource_read_pre", engines) == true);
+        CHECK(h->ruleExists("pep_resource_read_post", engines) == false);
+        CHECK(engines.lookups == 2);
+    }
+
+    SECTION("rules which fail the regex test are not looked up")
+    {
+        CHECK(h->ruleExists("pep_resource_read_finally", engines) == false);
+        CHECK(engines.lookups == 0);
+    }
+
+    SECTION("failed lookups are not remembered")
+    {
+        engines.fail = true;
+        CHECK_FALSE(h->ruleExists("pep_resource_read_pre", engines));
+
+        engines.fail = false;
+        CHECK(h->ruleExists("pep_resource_read_pre", engines) == true);
+        CHECK(engines.lookups == 2);
+    }
+
+    SECTION("invalidating the cache picks up new rules")
+    {
+        CHECK(h->ruleExists("pep_resource_open_pre", engines) == false);
+
+        engines.engines[0].insert("pep_resource_open_pre");
+        CHECK(h->ruleExists("pep_resource_open_pre", engines) == false);
+
+        h->invalidateCache();
+        CHECK(h->ruleExists("pep_resource_open_pre", engines) == true);
+    }
+
+    SECTION("registering a regex invalidates the cache")
+    {
+        engines.engines[0].insert("pep_resource_open_except");
+        CHECK(h->ruleExists("pep_resource_open_except", engines) == false);
+
+        h->registerRuleRegex("[^ ]*pep_[^ ]*_except");
+        CHECK(h->ruleExists("pep_resource_open_except", engines) == true);
+    }
+
+    SECTION("a disabled cache always asks the rule engines")
+    {
+        h->enableCache(false);
+
+        CHECK(h->ruleExists("pep_resource_read_pre", engines) == true);
+        CHECK(h->ruleExists("pep_resource_read_pre", engines) == true);
+        CHECK(engines.lookups == 2);
+
+        h->enableCache(true);
+    }
+}
+
+TEST_CASE("rule exists helper skips operations without policy")
+{
+    auto* h = helper();
+    h->enableCache(true);
+    h->invalidateCache();
+
+    const std::vector<std::string> namespaces{"", "audit_"};
+    fake_rule_engines engines{{{"pep_resource_write_pre"}}};
+
+    CHECK(h->pepMayExist("resource_read", "pre"));
+    CHECK(invoke_resource_operation(engines, namespaces, "resource_read") == 0);
+
+    // Every PEP of resource_read is now known to be undefined.
+    CHECK_FALSE(h->pepMayExist("resource_read", "pre"));
+    CHECK_FALSE(h->pepMayExist("resource_read", "post"));
+    CHECK_FALSE(h->pepMayExist("resource_read", "finally"));
+
+    // Classes which have not been looked up yet are not skipped.
+    CHECK(h->pepMayExist("resource_read", "except"));
+
+    const auto lookups = engines.lookups;
+    CHECK(invoke_resource_operation(engines, namespaces, "resource_read") == 0);
+    CHECK(engines.lookups == lookups);
+
+    // Operations with policy continue to run it.
+    CHECK(invoke_resource_operation(engines, namespaces, "resource_write") == 1);
+    CHECK(h->pepMayExist("resource_write", "pre"));
+    CHECK_FALSE(h->pepMayExist("resource_write", "post"));
+    CHECK(invoke_resource_operation(engines, namespaces, "resource_write") == 1);
+
+    // Classes which are not summarized are never skipped.
+    invoke_pep(engines, namespaces, "resource_read", "custom");
+    CHECK(h->pepMayExist("resource_read", "custom"));
+
+    // A lookup failure must not mark the operation as having no policy.
+    engines.fail = true;
+    CHECK(invoke_pep(engines, namespaces, "resource_open", "pre") == 0);
+    CHECK(h->pepMayExist("resource_open", "pre"));
+    engines.fail = false;
+
+    h->invalidateCache();
+    CHECK(h->pepMayExist("resource_read", "pre"));
+}
+
+TEST_CASE("rule exists helper only caches rule engines which report changes")
+{
+    CHECK(RuleExistsHelper::reportsRuleChanges("irods_rule_engine_plugin-irods_rule_language"));
+    CHECK(RuleExistsHelper::reportsRuleChanges("irods_rule_engine_plugin-cpp_default_policy"));
+    CHECK_FALSE(RuleExistsHelper::reportsRuleChanges("irods_rule_engine_plugin-python"));
+    CHECK_FALSE(RuleExistsHelper::reportsRuleChanges(""));
+}
+
+TEST_CASE("rule exists helper benchmark", "[.benchmark]")
+{
+    auto* h = helper();
+    h->invalidateCache();
+
+    const std::vector<std::string> namespaces{""};
+
+    // Three rule engine plugin instances, similar to a deployment that has the
+    // iRODS Rule Language, the default policy and one other plugin enabled.
+    fake_rule_engines engines;
+    engines.engines.resize(3);
+
+    for (int i = 0; i < 200; ++i) {
+        engines.engines[0].insert("rule_" + std::to_string(i));
+    }
+
+    constexpr int iterations = 1000;
+
+    const auto run = [&](const std::string& _operation_name) {
+        int executed = 0;
+
+        for (int i = 0; i < iterations; ++i) {
+            executed += invoke_resource_operation(engines, namespaces, _operation_name);
+        }
+
+        return executed;
+    };
+
+    h->enableCache(false);
+    BENCHMARK("no policy, without cache") { return run("resource_read"); };
+
+    h->enableCache(true);
+    BENCHMARK("no policy, with cache") { return run("resource_read"); };
+
+    engines.engines[1].insert("pep_resource_write_pre");
+    engines.engines[2].insert("pep_resource_write_post");
+
+    h->enableCache(false);
+    BENCHMARK("pre and post policy, without cache") { return run("resource_write"); };
+
+    h->enableCache(true);
+    BENCHMARK("pre and post policy, with cache") { return run("resource_write"); };
+}
@@ -0,0 +1,679 @@
+#include "catch.hpp"
+
+#include "arithmetics.hpp"
+#include "astCache.hpp"
+#include "cache.hpp"
+#include "configuration.hpp"
+#include "conversion.hpp"
+#include "functions.hpp"
+#include "index.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "locks.hpp"
+#include "rcConnect.h"
+#include "reFuncDefs.hpp"
+#include "reVariableMap.hpp"
+#include "sharedmemory.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int number_of_policies = 300;
+    constexpr int number_of_put_overloads = 500;
+    constexpr int number_of_indexed_overloads = 300;
+
+    // Writes a rule base similar in size and shape to core.re files found in production.
+    //
+    // - Many PEPs with a single implementation.
+    // - acPostProcForPut with one overload per project collection plus a fallback.
+    // - acRescPolicy with one overload per resource. The conditions are string comparisons
+    //   against the same parameter, so the rules are grouped into a condition index.
+    auto write_rule_base(const boost::filesystem::path& _p) -> void
+    {
+        std::ofstream out{_p.c_str()};
+
+        for (int i = 0; i < number_of_policies; ++i) {
+            out << "acPolicy" << i << " { writeLine(\"serverLog\", \"policy " << i << "\"); }\n";
+        }
+
+        for (int i = 0; i < number_of_put_overloads; ++i) {
+            out << "acPostProcForPut { ON($objPath like \"/tempZone/home/project" << i << "/*\") { "
+                << "writeLine(\"serverLog\", \"project " << i << "\"); } }\n";
+        }
+
+        out << "acPostProcForPut { }\n";
+
+        for (int i = 0; i < number_of_indexed_overloads; ++i) {
+            out << "acRescPolicy(*resc, *op) { ON(*resc == \"resc" << i << "\") { writeLine(\"serverLog\", *op); } }\n";
+        }
+    }
+
+    auto load_rule_base() -> void
+    {
+        static const bool loaded = [] {
+            const auto path = boost::filesystem::temp_directory_path() / "irods_rule_language_dispatch_test.re";
+            irods::at_scope_exit remove_rule_base{[&path] { boost::filesystem::remove(path); }};
+
+            write_rule_base(path);
+
+            generateRegions();
+            generateRuleSets();
+            generateFunctionDescriptionTables();
+            getSystemFunctions(ruleEngineConfig.sysFuncDescIndex->current, ruleEngineConfig.sysRegion);
+
+            if (readRuleStructAndRuleSetFromFile("core", path.c_str()) != 0) {
+                return false;
+            }
+
+            createCoreRuleIndex();
+            ruleEngineConfig.ruleEngineStatus = INITIALIZED;
+
+            return true;
+        }();
+
+        REQUIRE(loaded);
+    }
+
+    auto rule_list(const char* _action) -> RuleIndexList*
+    {
+        auto* fd = (FunctionDesc*) (lookupFromHashTable(ruleEngineConfig.coreFuncDescIndex->current, _action));
+        REQUIRE(fd);
+        REQUIRE(getNodeType(fd) == N_FD_RULE_INDEX_LIST);
+        return FD_RULE_INDEX_LIST(fd);
+    }
+
+    auto find_rules_by_position(const char* _action) -> std::vector<RuleIndexListNode*>
+    {
+        std::vector<RuleIndexListNode*> nodes;
+        RuleIndexListNode* node{};
+
+        for (int i = 0; findNextRuleFromIndex(ruleEngineConfig.coreFuncDescIndex, _action, i, &node) == 0; ++i) {
+            nodes.push_back(node);
+        }
+
+        return nodes;
+    }
+
+    auto find_rules_with_cursor(const char* _action) -> std::vector<RuleIndexListNode*>
+    {
+        std::vector<RuleIndexListNode*> nodes;
+        RuleIndexListNode* node{};
+
+        RuleIndexCursor cursor;
+        initRuleIndexCursor(&cursor, ruleEngineConfig.coreFuncDescIndex);
+
+        while (findNextRuleFromCursor(&cursor, _action, &node) == 0) {
+            nodes.push_back(node);
+        }
+
+        return nodes;
+    }
+
+    // A rule text of the size typically submitted through irule or as a delayed rule.
+    constexpr const char* rule_text = "myTestRule {\n"
+                                      "    *total = 0;\n"
+                                      "    for (*i = 0; *i < 10; *i = *i + 1) {\n"
+                                      "        *total = *total + *i;\n"
+                                      "    }\n"
+                                      "    if (*total == 45) {\n"
+                                      "        *out = str(*total);\n"
+                                      "    }\n"
+                                      "    else {\n"
+                                      "        *out = \"unexpected\";\n"
+                                      "    }\n"
+                                      "}\n";
+
+    auto exec_rule_text(const char* _rule_text, ruleExecInfo_t* _rei = nullptr) -> std::string
+    {
+        rsComm_t comm{};
+        ruleExecInfo_t default_rei{};
+        default_rei.rsComm = &comm;
+        auto& rei = _rei ? *_rei : default_rei;
+
+        msParamArray_t params{};
+        irods::at_scope_exit free_params{[&params] { clearMsParamArray(&params, 1); }};
+
+        REQUIRE(execMyRule(const_cast<char*>(_rule_text), &params, "*out", &rei) == 0);
+
+        const auto* out = getMsParamByLabel(&params, "*out");
+        REQUIRE(out);
+        REQUIRE(out->inOutStruct);
+
+        return static_cast<const char*>(out->inOutStruct);
+    }
+
+    auto compute_expression(const std::string& _expr) -> int
+    {
+        char result[MAX_COND_LEN]{};
+        return computeExpression(const_cast<char*>(_expr.c_str()), nullptr, nullptr, 0, result);
+    }
+
+    // Mappings from core.dvm for the session variables most policies read.
+    constexpr const char* data_variable_mappings = "objPath||rei->doi->objPath\n"
+                                                   "objPath||rei->doinp->objPath\n"
+                                                   "dataSize||rei->doi->dataSize\n"
+                                                   "dataSize||rei->doinp->dataSize\n"
+                                                   "dataCreate||rei->doi-dataCreate\n"
+                                                   "rescName||rei->doi->rescName\n"
+                                                   "userClient||rei->uoic\n"
+                                                   "userClient||rei->rsComm->clientUser\n"
+                                                   "userNameClient||rei->uoic->userName\n"
+                                                   "userNameClient||rei->rsComm->clientUser->userName\n"
+                                                   "rodsZoneClient||rei->uoic->rodsZone\n"
+                                                   "rodsZoneClient||rei->rsComm->clientUser->rodsZone\n"
+                                                   "collName||rei->coi->collName\n"
+                                                   "status||rei->status\n";
+
+    constexpr const char* session_variables[] = {
+        "objPath", "dataSize", "dataCreate", "rescName", "userClient", "userNameClient", "rodsZoneClient", "collName", "status"};
+
+    auto load_data_variable_mappings() -> void
+    {
+        static const bool loaded = [] {
+            const auto path = boost::filesystem::temp_directory_path() / "irods_rule_language_dispatch_test.dvm";
+            irods::at_scope_exit remove_mappings{[&path] { boost::filesystem::remove(path); }};
+
+            std::ofstream{path.c_str()} << data_variable_mappings;
+
+            clearDVarStruct(&coreRuleVarDef);
+            return readDVarStructFromFile(const_cast<char*>(path.c_str()), &coreRuleVarDef) == 0;
+        }();
+
+        REQUIRE(loaded);
+    }
+
+    // A session like the one of a put.
+    struct session
+    {
+        rsComm_t comm{};
+        dataObjInfo_t doi{};
+        dataObjInp_t doinp{};
+        userInfo_t uoic{};
+        ruleExecInfo_t rei{};
+
+        session()
+        {
+            std::strcpy(doi.objPath, "/tempZone/home/rods/project/file.txt");
+            std::strcpy(doi.rescName, "demoResc");
+            doi.dataSize = 1024;
+            std::strcpy(doinp.objPath, "/tempZone/home/rods/project/file.txt");
+            std::strcpy(uoic.userName, "rods");
+            std::strcpy(uoic.rodsZone, "tempZone");
+            std::strcpy(comm.clientUser.userName, "rods");
+
+            rei.rsComm = &comm;
+            rei.doi = &doi;
+            rei.doinp = &doinp;
+            rei.uoic = &uoic;
+        }
+    };
+
+    // The status and value of a variable map as returned by the generated getters, or
+    // by the typed getter if _getter is not null.
+    auto read_variable_map(const char* _var_map, VarMapGetter _getter, ruleExecInfo_t* _rei) -> std::pair<int, std::string>
+    {
+        Region* r = make_region(0, nullptr);
+        irods::at_scope_exit free_region{[r] { region_free(r); }};
+
+        Res* value{};
+        std::string var_map = _var_map;
+        const int status = _getter ? _getter(_rei, &value, r) : getVarValue(&var_map[0], _rei, &value, r);
+        if (status < 0) {
+            return {status, ""};
+        }
+
+        char* str = convertResToString(value);
+        irods::at_scope_exit free_str{[str] { free(str); }};
+        return {status, str ? str : ""};
+    }
+
+    // What getSessionVar did before the mappings were indexed: a linear scan of the
+    // mappings, each variable map resolved by the generated getters.
+    auto read_session_variable_with_generated_getters(const char* _name, ruleExecInfo_t* _rei, Region* _r) -> Res*
+    {
+        for (int i = 0; i < coreRuleVarDef.MaxNumOfDVars; ++i) {
+            if (std::strcmp(coreRuleVarDef.varName[i], _name) == 0) {
+                char* var_map = strdup(coreRuleVarDef.var2CMap[i]);
+                irods::at_scope_exit free_var_map{[var_map] { free(var_map); }};
+
+                Res* value{};
+                const int status = getVarValue(var_map, _rei, &value, _r);
+                if (status >= 0) {
+                    return value;
+                }
+                if (status != NULL_VALUE_ERR) {
+                    return nullptr;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    auto read_session_variable(const char* _name, ruleExecInfo_t* _rei, Region* _r) -> Res*
+    {
+        rError_t errmsg{};
+        irods::at_scope_exit free_errmsg{[&errmsg] { freeRErrorContent(&errmsg); }};
+        return getSessionVar(const_cast<char*>(""), nullptr, const_cast<char*>(_name), _rei, &errmsg, _r);
+    }
+
+    // A policy similar to the ones found in production, reading several session variables.
+    constexpr const char* policy_rule_text = "myPolicy {\n"
+                                             "    if ($objPath like \"/tempZone/home/*/project/*\" && $rescName == \"demoResc\" &&\n"
+                                             "        $userNameClient == \"rods\" && $dataSize < 4096) {\n"
+                                             "        *out = \"accepted\";\n"
+                                             "    }\n"
+                                             "    else {\n"
+                                             "        *out = \"rejected\";\n"
+                                             "    }\n"
+                                             "}\n";
+
+    // Publishes the loaded rule base to shared memory the way the first agent after a server start does.
+    class shared_rule_base
+    {
+    public:
+        shared_rule_base()
+        {
+            irods::set_server_property<std::string>(irods::CFG_RE_CACHE_SALT_KW, "test_" + std::to_string(getpid()));
+
+            REQUIRE(prepareServerSharedMemory(instance_name));
+            REQUIRE(updateCache(instance_name, SHMMAX, &ruleEngineConfig) == 0);
+        }
+
+        ~shared_rule_base()
+        {
+            removeSharedMemory(instance_name);
+            resetMutex(instance_name);
+        }
+
+        static constexpr const char* instance_name = "irods_rule_language_dispatch_test";
+    };
+
+    auto restore_shared_rule_base() -> Cache*
+    {
+        auto* cache = restoreCache(shared_rule_base::instance_name);
+        REQUIRE(cache);
+        return cache;
+    }
+
+    auto shared_rule_list(Cache* _cache, const char* _action) -> RuleIndexList*
+    {
+        auto* fd = (FunctionDesc*) (lookupFromHashTable(_cache->coreFuncDescIndex->current, _action));
+        REQUIRE(fd);
+        REQUIRE(getNodeType(fd) == N_FD_RULE_INDEX_LIST);
+        return FD_RULE_INDEX_LIST(fd);
+    }
+
+    // Occupies the address shared rule bases are laid out for.
+    class occupied_base_address
+    {
+    public:
+        occupied_base_address()
+            : addr_{mmap(SHM_BASE_ADDR, SHMMAX, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)}
+        {
+            REQUIRE(addr_ == SHM_BASE_ADDR);
+        }
+
+        ~occupied_base_address() { munmap(addr_, SHMMAX); }
+
+    private:
+        void* addr_;
+    };
+} // anonymous namespace
+
+TEST_CASE("rule index lists are compiled when the rule base is loaded")
+{
+    load_rule_base();
+
+    auto* put_rules = rule_list("acPostProcForPut");
+    REQUIRE(put_rules->nodes);
+    CHECK(put_rules->len == number_of_put_overloads + 1);
+
+    auto* policy_rules = rule_list("acPolicy1");
+    REQUIRE(policy_rules->nodes);
+    CHECK(policy_rules->len == 1);
+
+    // The overloads of acRescPolicy are replaced by a single condition index.
+    auto* resc_rules = rule_list("acRescPolicy");
+    REQUIRE(resc_rules->nodes);
+    REQUIRE(resc_rules->len == 1);
+    REQUIRE(resc_rules->nodes[0]->secondaryIndex == 1);
+
+    auto* indexed = static_cast<const RuleIndexListNode*>(lookupFromHashTable(resc_rules->nodes[0]->condIndex->valIndex, "resc42"));
+    REQUIRE(indexed);
+    CHECK(indexed->secondaryIndex == 0);
+}
+
+TEST_CASE("rule index cursors visit rules in the same order as positional lookups")
+{
+    load_rule_base();
+
+    for (const auto* action : {"acPostProcForPut", "acPolicy7", "acRescPolicy", "writeLine", "acNoSuchRule"}) {
+        CHECK(find_rules_with_cursor(action) == find_rules_by_position(action));
+    }
+
+    CHECK(find_rules_with_cursor("acPostProcForPut").size() == number_of_put_overloads + 1);
+    CHECK(find_rules_with_cursor("acNoSuchRule").empty());
+
+    SECTION("modified lists fall back to the linked list")
+    {
+        auto* list = rule_list("acPolicy3");
+        const auto rule_index = list->head->ruleIndex;
+
+        appendRuleNodeToRuleIndexList(list, rule_index, ruleEngineConfig.coreRegion);
+        CHECK_FALSE(list->nodes);
+
+        const auto nodes = find_rules_with_cursor("acPolicy3");
+        CHECK(nodes.size() == 2);
+        CHECK(nodes == find_rules_by_position("acPolicy3"));
+
+        compileRuleIndexList(list, ruleEngineConfig.coreRegion);
+        CHECK(list->len == 2);
+        CHECK(find_rules_with_cursor("acPolicy3") == nodes);
+    }
+}
+
+TEST_CASE("rule texts and expressions are parsed and typed once")
+{
+    load_rule_base();
+    invalidateAstCache();
+
+    SECTION("expressions")
+    {
+        CHECK(compute_expression("40 + 2") == 42);
+        CHECK(astCacheSize() == 1);
+
+        auto* entry = lookupAstCache(AST_CACHE_EXPRESSION, "40 + 2", "");
+        REQUIRE(entry);
+        CHECK(entry->node);
+        releaseAstCacheEntry(entry);
+
+        CHECK(compute_expression("40 + 2") == 42);
+        CHECK(astCacheSize() == 1);
+    }
+
+    SECTION("rule texts")
+    {
+        CHECK(exec_rule_text(rule_text) == "45");
+        CHECK(astCacheSize() == 1);
+
+        CHECK(exec_rule_text(rule_text) == "45");
+        CHECK(astCacheSize() == 1);
+    }
+
+    SECTION("texts which do not parse are not cached")
+    {
+        CHECK(compute_expression("40 +") < 0);
+        CHECK(astCacheSize() == 0);
+    }
+
+    SECTION("the number of cached texts is bounded")
+    {
+        for (int i = 0; i < AST_CACHE_SIZE + 10; ++i) {
+            CHECK(compute_expression(std::to_string(i) + " + 1") == i + 1);
+        }
+
+        CHECK(astCacheSize() == AST_CACHE_SIZE);
+
+        // The least recently used expressions were evicted.
+        CHECK_FALSE(lookupAstCache(AST_CACHE_EXPRESSION, "0 + 1", ""));
+
+        auto* entry = lookupAstCache(AST_CACHE_EXPRESSION, "265 + 1", "");
+        REQUIRE(entry);
+        releaseAstCacheEntry(entry);
+    }
+
+    SECTION("entries in use outlive invalidation")
+    {
+        CHECK(compute_expression("40 + 2") == 42);
+
+        auto* entry = lookupAstCache(AST_CACHE_EXPRESSION, "40 + 2", "");
+        REQUIRE(entry);
+
+        invalidateAstCache();
+        CHECK(astCacheSize() == 0);
+        CHECK(entry->stale);
+        CHECK(entry->node);
+
+        releaseAstCacheEntry(entry);
+    }
+
+    invalidateAstCache();
+}
+
+TEST_CASE("session variables are read through typed getters")
+{
+    load_rule_base();
+    load_data_variable_mappings();
+
+    CHECK(lookupVarMapGetter("rei->doi->objPath"));
+    CHECK(lookupVarMapGetter("rei->uoic->userName"));
+    CHECK(lookupVarMapGetter("rei->uoic"));
+
+    // Malformed variable maps and variable maps the generated getters do not resolve.
+    CHECK_FALSE(lookupVarMapGetter("rei->doi-dataCreate"));
+    CHECK_FALSE(lookupVarMapGetter("rei->rsComm->clientUser->userName"));
+    CHECK_FALSE(lookupVarMapGetter("rei->doi"));
+
+    SECTION("typed getters return what the generated getters return")
+    {
+        session full;
+        ruleExecInfo_t empty{};
+
+        for (auto* rei : {&full.rei, &empty}) {
+            for (const auto* name : session_variables) {
+                const char* var_map{};
+                VarMapGetter getter{};
+
+                for (int vinx = getVarMapAndGetter("", name, &var_map, &getter, 0); vinx >= 0;
+                     vinx = getVarMapAndGetter("", name, &var_map, &getter, vinx + 1)) {
+                    CAPTURE(var_map);
+                    CHECK(getter == lookupVarMapGetter(var_map));
+
+                    if (getter) {
+                        CHECK(read_variable_map(var_map, getter, rei) == read_variable_map(var_map, nullptr, rei));
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("mappings are tried in order until one has a value")
+    {
+        session s;
+
+        char* value{};
+        REQUIRE(getSessionVarValue(const_cast<char*>(""), const_cast<char*>("objPath"), &s.rei, &value) == 0);
+        CHECK(std::string{value} == s.doi.objPath);
+        free(value);
+
+        std::strcpy(s.doinp.objPath, "/tempZone/home/rods/other.txt");
+        s.rei.doi = nullptr;
+
+        REQUIRE(getSessionVarValue(const_cast<char*>(""), const_cast<char*>("$objPath"), &s.rei, &value) == 0);
+        CHECK(std::string{value} == s.doinp.objPath);
+        free(value);
+
+        CHECK(getSessionVarValue(const_cast<char*>(""), const_cast<char*>("noSuchVariable"), &s.rei, &value) == UNKNOWN_VARIABLE_MAP_ERR);
+    }
+
+    SECTION("the index follows changes to the mappings")
+    {
+        const char* var_map{};
+        VarMapGetter getter{};
+
+        REQUIRE(getVarMapAndGetter("", "collName", &var_map, &getter, 0) >= 1000);
+
+        const auto count = coreRuleVarDef.MaxNumOfDVars;
+        coreRuleVarDef.varName[count] = strdup("collName");
+        coreRuleVarDef.action[count] = strdup("");
+        coreRuleVarDef.var2CMap[count] = strdup("rei->doi->objPath");
+        coreRuleVarDef.MaxNumOfDVars = count + 1;
+
+        irods::at_scope_exit remove_mapping{[count] {
+            free(coreRuleVarDef.varName[count]);
+            free(coreRuleVarDef.action[count]);
+            free(coreRuleVarDef.var2CMap[count]);
+            coreRuleVarDef.MaxNumOfDVars = count;
+            clearVarDefIndex();
+        }};
+
+        clearVarDefIndex();
+
+        session s;
+        char* value{};
+        REQUIRE(getSessionVarValue(const_cast<char*>(""), const_cast<char*>("collName"), &s.rei, &value) == 0);
+        CHECK(std::string{value} == s.doi.objPath);
+        free(value);
+    }
+}
+
+TEST_CASE("shared rule bases are used in place")
+{
+    load_rule_base();
+
+    shared_rule_base shared;
+
+    SECTION("the rule base is mapped at the address it is laid out for")
+    {
+        auto* cache = restore_shared_rule_base();
+        irods::at_scope_exit free_cache{[cache] { freeCacheAddress(cache->address); }};
+
+        CHECK(static_cast<void*>(cache) == SHM_BASE_ADDR);
+        CHECK(cache->address == reinterpret_cast<unsigned char*>(cache));
+        CHECK(std::string{cache->ruleBase} == ruleEngineConfig.ruleBase);
+        CHECK(shared_rule_list(cache, "acPolicy1")->len == 1);
+        CHECK(shared_rule_list(cache, "acPostProcForPut")->len == number_of_put_overloads + 1);
+    }
+
+    SECTION("writes to the rule base are private")
+    {
+        auto* cache = restore_shared_rule_base();
+        irods::at_scope_exit free_cache{[cache] { freeCacheAddress(cache->address); }};
+
+        shared_rule_list(cache, "acPolicy1")->len = 42;
+
+        auto* other = restore_shared_rule_base();
+        irods::at_scope_exit free_other{[other] { freeCacheAddress(other->address); }};
+
+        // The base address is taken, so the second restore copies the rule base from shared memory.
+        REQUIRE(other != cache);
+        CHECK(shared_rule_list(other, "acPolicy1")->len == 1);
+    }
+
+    SECTION("rule bases are copied when the address is not available")
+    {
+        occupied_base_address occupied;
+
+        auto* cache = restore_shared_rule_base();
+        irods::at_scope_exit free_cache{[cache] { freeCacheAddress(cache->address); }};
+
+        CHECK(static_cast<void*>(cache) != SHM_BASE_ADDR);
+        CHECK(cache->address == reinterpret_cast<unsigned char*>(cache));
+        CHECK(shared_rule_list(cache, "acPostProcForPut")->len == number_of_put_overloads + 1);
+    }
+
+    SECTION("updating the shared rule base does not affect agents using it")
+    {
+        auto* cache = restore_shared_rule_base();
+        irods::at_scope_exit free_cache{[cache] { freeCacheAddress(cache->address); }};
+
+        REQUIRE(updateCache(shared_rule_base::instance_name, SHMMAX, &ruleEngineConfig) == 0);
+
+        CHECK(shared_rule_list(cache, "acPostProcForPut")->len == number_of_put_overloads + 1);
+    }
+}
+
+TEST_CASE("rule language dispatch benchmark", "[.benchmark]")
+{
+    load_rule_base();
+
+    auto* put_rules = rule_list("acPostProcForPut");
+
+    BENCHMARK("acPostProcForPut: all alternatives by position") { return find_rules_by_position("acPostProcForPut").size(); };
+
+    BENCHMARK("acPostProcForPut: all alternatives by position, uncompiled list")
+    {
+        auto* nodes = put_rules->nodes;
+        put_rules->nodes = nullptr;
+        irods::at_scope_exit restore{[&] { put_rules->nodes = nodes; }};
+        return find_rules_by_position("acPostProcForPut").size();
+    };
+
+    BENCHMARK("acPostProcForPut: all alternatives with a cursor") { return find_rules_with_cursor("acPostProcForPut").size(); };
+
+    BENCHMARK("acRescPolicy: condition index")
+    {
+        RuleIndexListNode* node{};
+        RuleIndexCursor cursor;
+        initRuleIndexCursor(&cursor, ruleEngineConfig.coreFuncDescIndex);
+        findNextRuleFromCursor(&cursor, "acRescPolicy", &node);
+        return lookupFromHashTable(node->condIndex->valIndex, "resc250");
+    };
+
+    BENCHMARK("rule text: parsed every time")
+    {
+        invalidateAstCache();
+        return exec_rule_text(rule_text);
+    };
+
+    BENCHMARK("rule text: cached") { return exec_rule_text(rule_text); };
+
+    {
+        shared_rule_base shared;
+
+        BENCHMARK("shared rule base: mapped in place")
+        {
+            auto* cache = restoreCache(shared_rule_base::instance_name);
+            freeCacheAddress(cache->address);
+            return cache;
+        };
+
+        occupied_base_address occupied;
+
+        BENCHMARK("shared rule base: copied and relocated")
+        {
+            auto* cache = restoreCache(shared_rule_base::instance_name);
+            freeCacheAddress(cache->address);
+            return cache;
+        };
+    }
+
+    load_data_variable_mappings();
+
+    session s;
+
+    BENCHMARK("session variables: linear mappings and generated getters")
+    {
+        Region* r = make_region(0, nullptr);
+        irods::at_scope_exit free_region{[r] { region_free(r); }};
+        return read_session_variable_with_generated_getters("objPath", &s.rei, r) &&
+               read_session_variable_with_generated_getters("rescName", &s.rei, r) &&
+               read_session_variable_with_generated_getters("userNameClient", &s.rei, r);
+    };
+
+    BENCHMARK("session variables: indexed mappings and typed getters")
+    {
+        Region* r = make_region(0, nullptr);
+        irods::at_scope_exit free_region{[r] { region_free(r); }};
+        return read_session_variable("objPath", &s.rei, r) && read_session_variable("rescName", &s.rei, r) &&
+               read_session_variable("userNameClient", &s.rei, r);
+    };
+
+    REQUIRE(exec_rule_text(policy_rule_text, &s.rei) == "accepted");
+
+    BENCHMARK("policy rule reading session variables") { return exec_rule_text(policy_rule_text, &s.rei); };
+
+    invalidateAstCache();
+}
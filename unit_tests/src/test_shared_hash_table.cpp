@@ -0,0 +1,253 @@
+#include "catch.hpp"
+
+#include "shared_hash_table.hpp"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bi = boost::interprocess;
+namespace ipc = irods::experimental::interprocess;
+
+namespace
+{
+    using table_type = ipc::shared_hash_table<std::int64_t, 32>;
+
+    // Maps a shared memory object and constructs a table in it.
+    class shared_table
+    {
+    public:
+        shared_table(const char* _name, std::size_t _size)
+            : name_{_name}
+        {
+            bi::shared_memory_object::remove(name_);
+            segment_ = std::make_unique<bi::shared_memory_object>(bi::create_only, name_, bi::read_write);
+            segment_->truncate(_size);
+            region_ = std::make_unique<bi::mapped_region>(*segment_, bi::read_write);
+            table_ = table_type::construct(region_->get_address(), region_->get_size());
+        }
+
+        ~shared_table()
+        {
+            region_.reset();
+            segment_.reset();
+            bi::shared_memory_object::remove(name_);
+        }
+
+        auto operator->() const noexcept -> table_type* { return table_; }
+
+    private:
+        const char* name_;
+        std::unique_ptr<bi::shared_memory_object> segment_;
+        std::unique_ptr<bi::mapped_region> region_;
+        table_type* table_;
+    };
+} // anonymous namespace
+
+TEST_CASE("shared_hash_table")
+{
+    shared_table table{"irods_shared_hash_table_test", table_type::required_size(256)};
+
+    REQUIRE(table->capacity() >= 256);
+    REQUIRE(table->size() == 0);
+
+    SECTION("insert / assign / find")
+    {
+        CHECK(table->insert_or_assign("a", 1) == true);
+        CHECK(table->insert_or_assign("a", 2) == false);
+        CHECK(table->try_insert("a", 3) == false);
+        CHECK(table->try_insert("b", 4) == true);
+
+        CHECK(table->find("a") == 2);
+        CHECK(table->find("b") == 4);
+        CHECK_FALSE(table->find("c"));
+        CHECK(table->size() == 2);
+    }
+
+    SECTION("keys which do not fit are rejected")
+    {
+        const std::string key(table_type::max_key_size + 1, 'k');
+        CHECK_FALSE(table->insert_or_assign(key, 1));
+        CHECK_FALSE(table->contains(key));
+
+        const std::string longest_key(table_type::max_key_size, 'k');
+        CHECK(table->insert_or_assign(longest_key, 1) == true);
+        CHECK(table->contains(longest_key));
+    }
+
+    SECTION("expired entries are invisible and reusable")
+    {
+        CHECK(table->insert_or_assign("a", 1, table_type::now() - 1) == true);
+        CHECK_FALSE(table->contains("a"));
+        CHECK(table->try_insert("a", 2) == true);
+        CHECK(table->find("a") == 2);
+
+        CHECK(table->insert_or_assign("b", 3, table_type::now() - 1) == true);
+        CHECK(table->erase_expired() == 1);
+        CHECK(table->size() == 1);
+    }
+
+    SECTION("modify / erase / erase_if")
+    {
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(table->insert_or_assign(std::to_string(i), i) == true);
+        }
+
+        CHECK(table->modify("10", [](auto& _v) { _v *= 2; return true; }));
+        CHECK(table->find("10") == 20);
+
+        // Returning false from the function erases the entry.
+        CHECK(table->modify("10", [](auto&) { return false; }));
+        CHECK_FALSE(table->contains("10"));
+        CHECK_FALSE(table->modify("10", [](auto&) { return true; }));
+
+        CHECK(table->erase("11"));
+        CHECK_FALSE(table->erase("11"));
+
+        CHECK(table->erase_if([](std::string_view, auto& _v) { return _v % 2 == 1; }) == 49);
+        CHECK(table->size() == 49);
+
+        std::size_t count = 0;
+        table->for_each([&count](std::string_view, const auto& _v) { count += (_v % 2 == 0); });
+        CHECK(count == 49);
+
+        table->clear();
+        CHECK(table->size() == 0);
+    }
+
+    SECTION("slots of erased entries are reclaimed")
+    {
+        // Repeatedly filling and emptying the table forces the partitions to be compacted.
+        const auto count = table->capacity() / 2;
+
+        for (int round = 0; round < 20; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                REQUIRE(table->insert_or_assign(std::to_string(round) + ':' + std::to_string(i), i) == true);
+            }
+
+            CHECK(table->size() == count);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                REQUIRE(table->erase(std::to_string(round) + ':' + std::to_string(i)));
+            }
+
+            CHECK(table->size() == 0);
+        }
+    }
+
+    SECTION("a full table rejects new keys")
+    {
+        std::size_t inserted = 0;
+
+        for (std::size_t i = 0; i < 2 * table->capacity(); ++i) {
+            if (table->insert_or_assign(std::to_string(i), i).value_or(false)) {
+                ++inserted;
+            }
+        }
+
+        // Keys are spread over the partitions, so some partitions fill before others.
+        CHECK(inserted <= table->capacity());
+        CHECK(inserted == table->size());
+
+        // Existing entries can still be updated.
+        CHECK(table->insert_or_assign("0", 42) == false);
+        CHECK(table->find("0") == 42);
+    }
+}
+
+TEST_CASE("shared_hash_table is consistent across processes")
+{
+    constexpr int process_count = 8;
+    constexpr int keys_per_process = 500;
+
+    shared_table table{"irods_shared_hash_table_test", table_type::required_size(process_count * keys_per_process * 2)};
+
+    std::vector<pid_t> children;
+
+    for (int p = 0; p < process_count; ++p) {
+        if (const auto pid = fork(); pid == 0) {
+            int status = 0;
+
+            for (int i = 0; i < keys_per_process; ++i) {
+                const auto key = std::to_string(p) + ':' + std::to_string(i);
+
+                if (table->insert_or_assign(key, i) != true || table->find(key) != i) {
+                    status = 1;
+                }
+
+                // Every process also updates a shared counter.
+                table->try_insert("counter", 0);
+                table->modify("counter", [](auto& _v) { ++_v; return true; });
+            }
+
+            _exit(status);
+        }
+        else {
+            REQUIRE(pid > 0);
+            children.push_back(pid);
+        }
+    }
+
+    for (auto pid : children) {
+        int status = 0;
+        REQUIRE(waitpid(pid, &status, 0) == pid);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 0);
+    }
+
+    CHECK(table->size() == process_count * keys_per_process + 1);
+    CHECK(table->find("counter") == process_count * keys_per_process);
+}
+
+TEST_CASE("shared_hash_table benchmark", "[.benchmark]")
+{
+    constexpr int process_count = 8;
+    constexpr int operations_per_process = 20'000;
+    constexpr int key_count = 1000;
+
+    shared_table table{"irods_shared_hash_table_test", table_type::required_size(key_count * 2)};
+
+    for (int i = 0; i < key_count; ++i) {
+        REQUIRE(table->insert_or_assign(std::to_string(i), i) == true);
+    }
+
+    // Mostly lookups with some updates, which resembles how the hostname and DNS caches are used.
+    BENCHMARK("8 processes, 90% lookups")
+    {
+        std::vector<pid_t> children;
+
+        for (int p = 0; p < process_count; ++p) {
+            if (const auto pid = fork(); pid == 0) {
+                for (int i = 0; i < operations_per_process; ++i) {
+                    const auto key = std::to_string((i * 7919 + p) % key_count);
+
+                    if (i % 10 == 0) {
+                        table->insert_or_assign(key, i);
+                    }
+                    else {
+                        table->find(key);
+                    }
+                }
+
+                _exit(0);
+            }
+            else {
+                children.push_back(pid);
+            }
+        }
+
+        for (auto pid : children) {
+            waitpid(pid, nullptr, 0);
+        }
+
+        return children.size();
+    };
+}